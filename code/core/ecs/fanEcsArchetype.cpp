@@ -7,6 +7,11 @@ namespace fan
 	EcsArchetype::EcsArchetype()
 	{
 		mChunkVectors.resize( ecsSignatureLength );
+		for( int i = 0; i < int( ecsSignatureLength ); i++ )
+		{
+			mAddEdges[i]    = nullptr;
+			mRemoveEdges[i] = nullptr;
+		}
 	}
 
 	//========================================================================================================
@@ -55,6 +60,21 @@ namespace fan
 		}
 	}
 
+	//========================================================================================================
+	// removes the entities after _size
+	//========================================================================================================
+	void EcsArchetype::Shrink( const int _size )
+	{
+		for( int i = 0; i < int( ecsSignatureLength ); i++ )
+		{
+			if( mSignature[i] && mChunkVectors[i].NumChunk() > 0 )
+			{
+				mChunkVectors[i].Shrink( _size );
+			}
+		}
+		mEntities.resize( _size );
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void EcsArchetype::Clear()
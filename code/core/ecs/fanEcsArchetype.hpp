@@ -17,6 +17,7 @@ namespace fan
 		void Create( const std::vector< EcsComponentInfo >& _componentsInfo, const EcsSignature& _signature );
 		void AddComponentType( const EcsComponentInfo& _componentsInfo );
 		void RemoveEntity( const int _entityIndex );
+		void Shrink( const int _size );
 		void Clear();
 		int	 Size() const{ return int( mEntities.size() ); }
 		bool Empty() const{ return mEntities.empty(); }
@@ -28,8 +29,16 @@ namespace fan
 		EcsChunkVector&			GetChunkVector( const int _index )			{ return mChunkVectors[_index];}
 		const EcsSignature&		GetSignature  () const						{ return mSignature;			}
 
+		// archetypes with one more/less component or tag, cached when an entity transitions
+		EcsArchetype*	GetAddEdge	 ( const int _index ) const						{ return mAddEdges[_index];		}
+		EcsArchetype*	GetRemoveEdge( const int _index ) const						{ return mRemoveEdges[_index];	}
+		void			SetAddEdge	 ( const int _index, EcsArchetype* _archetype )	{ mAddEdges[_index] = _archetype;	}
+		void			SetRemoveEdge( const int _index, EcsArchetype* _archetype )	{ mRemoveEdges[_index] = _archetype;}
+
 	private:
 		EcsSignature                  mSignature;
+		EcsArchetype*                 mAddEdges[ecsSignatureLength];
+		EcsArchetype*                 mRemoveEdges[ecsSignatureLength];
 		std::vector< EcsChunkVector > mChunkVectors;		// one index per component type
 		std::vector< EcsEntityData >  mEntities;
 	};
@@ -5,6 +5,20 @@ namespace fan
 {
 	EcsChunkAllocator EcsChunk::sAllocator;
 
+	//========================================================================================================
+	//========================================================================================================
+	EcsChunk& EcsChunk::operator=( const EcsChunk& _other )
+	{
+        mCapacity      = _other.mCapacity;
+        mSize          = _other.mSize;
+        mComponentSize = _other.mComponentSize;
+        mBuffer        = _other.mBuffer;
+        mAlignedBuffer = _other.mAlignedBuffer;
+        mCpyFunction   = _other.mCpyFunction;
+		mVersion.store( _other.GetVersion(), std::memory_order_relaxed );
+		return *this;
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void EcsChunk::Create( CpyFunc _cpyFunction, const int _componentSize, const int _alignment )
@@ -13,6 +27,7 @@ namespace fan
         mComponentSize = _componentSize;
         mSize          = 0;
         mBuffer        = sAllocator.Alloc();
+		mVersion.store( 0, std::memory_order_relaxed );
 
 		size_t space = EcsChunkAllocator::sChunkSize;
         mAlignedBuffer = mBuffer;
@@ -42,7 +57,7 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	void* EcsChunk::At( const int _index )
+	void* EcsChunk::At( const int _index ) const
 	{
 		fanAssert( _index < mSize );
 		uint8_t* buffer = static_cast<uint8_t*>( mAlignedBuffer );
@@ -80,6 +95,17 @@ namespace fan
 		Set( index, _data );
 	}
 
+	//========================================================================================================
+	// copies _count contiguous components at once
+	//========================================================================================================
+	void EcsChunk::PushBack( void* _data, const int _count )
+	{
+        fanAssert( mSize + _count <= mCapacity );
+		const int index = mSize;
+		mSize += _count;
+		mCpyFunction( At( index ), _data, _count * mComponentSize );
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void EcsChunk::PopBack()
@@ -96,10 +122,28 @@ namespace fan
 		mSize++;
 	}
 
+	//========================================================================================================
+	//========================================================================================================
+	void EcsChunk::Shrink( const int _size )
+	{
+        fanAssert( _size <= mSize );
+		mSize = _size;
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void EcsChunk::Clear()
 	{
         mSize = 0;
 	}
+
+	//========================================================================================================
+	// keeps the most recent tick, only writes when the version changes to limit cache lines ping-pong
+	// when threads access the same chunk
+	//========================================================================================================
+	void EcsChunk::SetVersion( const EcsTick _tick )
+	{
+		EcsTick version = mVersion.load( std::memory_order_relaxed );
+		while( version < _tick && !mVersion.compare_exchange_weak( version, _tick, std::memory_order_relaxed ) ) {}
+	}
 }
\ No newline at end of file
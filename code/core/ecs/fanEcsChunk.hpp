@@ -1,12 +1,15 @@
 #pragma once
 
 #include <memory>
+#include <atomic>
 #include "core/ecs/fanEcsChunkAllocator.hpp"
+#include "core/ecs/fanEcsTypes.hpp"
 
 namespace fan
 {
 	//================================
 	// Small aligned memory buffer
+	// the version is the tick of the last write access to the chunk, used for change detection
 	//================================
 	class EcsChunk
 	{
@@ -14,19 +17,28 @@ namespace fan
 		static EcsChunkAllocator sAllocator;
 		using CpyFunc = void* ( * )( void*, const void*, size_t );
 
+		EcsChunk() = default;
+		EcsChunk( const EcsChunk& _other ) { *this = _other; }
+		EcsChunk& operator=( const EcsChunk& _other );
+
 		void	Create( CpyFunc _cpyFunction, const int _componentSize, const int _alignment );
 		void	Destroy();
 		bool	Empty() const;
 		bool	Full() const;
 		int		Size() const;
 		int		Capacity() const;
-		void*	At( const int _index );
+		void*	At( const int _index ) const;
+		void*	Data() { return mAlignedBuffer; }
 		void	Set( const int _index, void* _data );
 		void	Remove( const int _index );
 		void	PushBack( void* _data );
+		void	PushBack( void* _data, const int _count );
 		void	PopBack();
 		void	EmplaceBack();
+		void	Shrink( const int _size );
 		void	Clear();
+		EcsTick	GetVersion() const { return mVersion.load( std::memory_order_relaxed ); }
+		void	SetVersion( const EcsTick _tick );
 
 	private:
 		int     mCapacity      = 0;
@@ -35,5 +47,6 @@ namespace fan
 		void*	mBuffer        = nullptr;
 		void*	mAlignedBuffer = nullptr;
         CpyFunc mCpyFunction = nullptr;
+		std::atomic<EcsTick> mVersion{ 0 };	// atomic because parallel batches can share a chunk
 	};
 }
\ No newline at end of file
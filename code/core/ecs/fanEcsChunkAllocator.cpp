@@ -1,42 +1,259 @@
 #include "core/ecs/fanEcsChunkAllocator.hpp"
 #include "core/fanAssert.hpp"
+#include "core/time/fanProfiler.hpp"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+#endif
 
 namespace fan
 {
+	//========================================================================================================
+	// platform specific virtual memory
+	//========================================================================================================
+	namespace VirtualMemory
+	{
+		// reserves address space without committing physical memory
+		static uint8_t* Reserve( const size_t _size )
+		{
+#ifdef _WIN32
+			return static_cast<uint8_t*>( VirtualAlloc( nullptr, _size, MEM_RESERVE, PAGE_NOACCESS ) );
+#else
+			void* memory = mmap( nullptr, _size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+			return memory == MAP_FAILED ? nullptr : static_cast<uint8_t*>( memory );
+#endif
+		}
+
+		static void Unreserve( uint8_t* _memory, const size_t _size )
+		{
+#ifdef _WIN32
+			(void)_size;
+			VirtualFree( _memory, 0, MEM_RELEASE );
+#else
+			munmap( _memory, _size );
+#endif
+		}
+
+		// huge pages are only hinted on linux, windows large pages can't be committed in a reserved range
+		static bool Commit( uint8_t* _memory, const size_t _size, const bool _useHugePages )
+		{
+#ifdef _WIN32
+			(void)_useHugePages;
+			return VirtualAlloc( _memory, _size, MEM_COMMIT, PAGE_READWRITE ) != nullptr;
+#else
+			if( mprotect( _memory, _size, PROT_READ | PROT_WRITE ) != 0 ) { return false; }
+	#ifdef MADV_HUGEPAGE
+			if( _useHugePages ) { madvise( _memory, _size, MADV_HUGEPAGE ); }
+	#else
+			(void)_useHugePages;
+	#endif
+			return true;
+#endif
+		}
+
+		// returns physical memory to the OS, the address range stays reserved
+		static void Decommit( uint8_t* _memory, const size_t _size )
+		{
+#ifdef _WIN32
+			VirtualFree( _memory, _size, MEM_DECOMMIT );
+#else
+			madvise( _memory, _size, MADV_DONTNEED );
+#endif
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	EcsChunkAllocator::EcsChunkAllocator( const int _retentionCap, const bool _useHugePages ) :
+			mUseHugePages( _useHugePages ),
+			mNextFree( new std::atomic<int>[sMaxChunks] ),
+			mIsReleased( new std::atomic<bool>[sMaxChunks] ),
+			mFreeHead( 0 ),
+			mCommittedChunks( 0 ),
+			mLiveChunks( 0 ),
+			mFreeChunks( 0 ),
+			mReleasedChunks( 0 ),
+			mPeakLiveChunks( 0 ),
+			mRetentionCap( _retentionCap )
+	{
+		for( int i = 0; i < sMaxChunks; i++ )
+		{
+			mNextFree[i].store( 0, std::memory_order_relaxed );
+			mIsReleased[i].store( false, std::memory_order_relaxed );
+		}
+
+		// over reserves to align the base on the slab size
+		const size_t slabSize = sChunksPerSlab * sChunkSize;
+		mReservationSize = size_t( sMaxChunks ) * sChunkSize + slabSize;
+		mReservation     = VirtualMemory::Reserve( mReservationSize );
+		fanAssert( mReservation != nullptr );
+		const uintptr_t address = reinterpret_cast<uintptr_t>( mReservation );
+		mBase = mReservation + ( slabSize - address % slabSize ) % slabSize;
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	EcsChunkAllocator::~EcsChunkAllocator()
 	{
-		for( void* chunk : mFreeChunks )
+		if( mReservation != nullptr )
 		{
-			delete chunk;
+			VirtualMemory::Unreserve( mReservation, mReservationSize );
 		}
-		mFreeChunks.clear();
 	}
 
 	//========================================================================================================
 	//========================================================================================================
 	void* EcsChunkAllocator::Alloc()
 	{
-		void* chunk = nullptr;
-		if( mFreeChunks.empty() )
+		int chunkIndex = -1;
+		while( !PopFreeChunk( chunkIndex ) )
+		{
+			if( !CommitSlab() )
+			{
+				fanAssert( false ); // out of reserved address space
+				return nullptr;
+			}
+		}
+
+		if( mIsReleased[chunkIndex].load( std::memory_order_relaxed ) )
 		{
-			chunk = new uint8_t[sChunkSize];
-			mSize++;
+			mIsReleased[chunkIndex].store( false, std::memory_order_relaxed );
+			const bool committed = VirtualMemory::Commit( static_cast<uint8_t*>( ChunkAt( chunkIndex ) ),
+			                                              sChunkSize,
+			                                              mUseHugePages );
+			fanAssert( committed );
+			(void)committed;
+			mReleasedChunks--;
 		}
 		else
 		{
-			chunk = *mFreeChunks.rbegin();
-			mFreeChunks.pop_back();
+			mFreeChunks--;
 		}
-		return chunk;
+
+		// updates the peak
+		const int liveChunks = ++mLiveChunks;
+		int       peak       = mPeakLiveChunks.load( std::memory_order_relaxed );
+		while( liveChunks > peak && !mPeakLiveChunks.compare_exchange_weak( peak, liveChunks ) ) {}
+
+		return ChunkAt( chunkIndex );
 	}
 
 	//========================================================================================================
+	// past the retention cap the chunk memory is returned to the OS
 	//========================================================================================================
 	void EcsChunkAllocator::Free( void* _chunk )
 	{
 		fanAssert( _chunk != nullptr );
-		mFreeChunks.push_back( _chunk );
+		const size_t offset = size_t( static_cast<uint8_t*>( _chunk ) - mBase );
+		fanAssert( offset % sChunkSize == 0 );
+		const int chunkIndex = int( offset / sChunkSize );
+		fanAssert( chunkIndex >= 0 && chunkIndex < mCommittedChunks.load() );
+
+		mLiveChunks--;
+		const int retentionCap = mRetentionCap.load( std::memory_order_relaxed );
+		if( retentionCap != sNoRetentionCap && mFreeChunks.load( std::memory_order_relaxed ) >= retentionCap )
+		{
+			VirtualMemory::Decommit( static_cast<uint8_t*>( _chunk ), sChunkSize );
+			mIsReleased[chunkIndex].store( true, std::memory_order_relaxed );
+			mReleasedChunks++;
+		}
+		else
+		{
+			mFreeChunks++;
+		}
+		PushFreeChunk( chunkIndex );
+	}
+
+	//========================================================================================================
+	// Treiber stack, the ABA tag is incremented on every change of the head
+	//========================================================================================================
+	bool EcsChunkAllocator::PopFreeChunk( int& _outChunkIndex )
+	{
+		uint64_t head = mFreeHead.load( std::memory_order_acquire );
+		for( ;; )
+		{
+			const int chunkIndex = int( head & 0xffffffff ) - 1;
+			if( chunkIndex < 0 ) { return false; }
+
+			const uint64_t next    = uint64_t( mNextFree[chunkIndex].load( std::memory_order_relaxed ) + 1 );
+			const uint64_t newHead = ( ( ( head >> 32 ) + 1 ) << 32 ) | next;
+			if( mFreeHead.compare_exchange_weak( head, newHead, std::memory_order_acq_rel, std::memory_order_acquire ) )
+			{
+				_outChunkIndex = chunkIndex;
+				return true;
+			}
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void EcsChunkAllocator::PushFreeChunk( const int _chunkIndex )
+	{
+		uint64_t head = mFreeHead.load( std::memory_order_relaxed );
+		uint64_t newHead;
+		do
+		{
+			mNextFree[_chunkIndex].store( int( head & 0xffffffff ) - 1, std::memory_order_relaxed );
+			newHead = ( ( ( head >> 32 ) + 1 ) << 32 ) | uint64_t( _chunkIndex + 1 );
+		}
+		while( !mFreeHead.compare_exchange_weak( head, newHead, std::memory_order_release, std::memory_order_relaxed ) );
+	}
+
+	//========================================================================================================
+	// commits a new slab and pushes its chunks on the free list
+	//========================================================================================================
+	bool EcsChunkAllocator::CommitSlab()
+	{
+		std::lock_guard<std::mutex> lock( mCommitMutex );
+
+		// another thread may have committed a slab in the meantime
+		if( ( mFreeHead.load( std::memory_order_acquire ) & 0xffffffff ) != 0 ) { return true; }
+
+		const int firstChunk = mCommittedChunks.load();
+		if( firstChunk + sChunksPerSlab > sMaxChunks ) { return false; }
+		if( !VirtualMemory::Commit( static_cast<uint8_t*>( ChunkAt( firstChunk ) ),
+		                            sChunksPerSlab * sChunkSize,
+		                            mUseHugePages ) )
+		{
+			return false;
+		}
+		mCommittedChunks.store( firstChunk + sChunksPerSlab );
+
+		for( int chunkIndex = firstChunk + sChunksPerSlab - 1; chunkIndex >= firstChunk; chunkIndex-- )
+		{
+			mFreeChunks++;
+			PushFreeChunk( chunkIndex );
+		}
+		return true;
+	}
+
+	//========================================================================================================
+	// counters are read separately, they can be slightly inconsistent while other threads allocate
+	//========================================================================================================
+	EcsChunkAllocator::Stats EcsChunkAllocator::GetStats() const
+	{
+		Stats stats;
+		stats.mLiveChunks      = mLiveChunks.load();
+		stats.mFreeChunks      = mFreeChunks.load();
+		stats.mReleasedChunks  = mReleasedChunks.load();
+		stats.mPeakLiveChunks  = mPeakLiveChunks.load();
+		stats.mCommittedChunks = mCommittedChunks.load();
+		return stats;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void EcsChunkAllocator::ReportToProfiler() const
+	{
+		const Stats stats = GetStats();
+		Profiler& profiler = Profiler::Get();
+		profiler.SetCounter( "ecs live chunks", stats.mLiveChunks );
+		profiler.SetCounter( "ecs free chunks", stats.mFreeChunks );
+		profiler.SetCounter( "ecs released chunks", stats.mReleasedChunks );
+		profiler.SetCounter( "ecs peak live chunks", stats.mPeakLiveChunks );
 	}
-}
\ No newline at end of file
+}
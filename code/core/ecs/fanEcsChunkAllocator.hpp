@@ -1,23 +1,67 @@
-#include <vector>
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
 
 namespace fan
 {
 	//========================================================================================================
 	// Allocates chunks of a fixed size for use in the ecs archetypes.
-	// Manages a pool of chunks to allow easy reuse without unnecessary memory allocation
+	// Thread safe, shared by all the worlds of the process
+	// A large address range is reserved at construction and committed slab by slab ( page aligned )
+	// Free chunks are kept in a lock-free list for reuse,
+	// past the retention cap their memory is returned to the OS but their address stays reserved
 	//========================================================================================================
 	class EcsChunkAllocator
 	{
 	public:
-		static constexpr size_t sChunkSize = 65536;
+		static constexpr size_t sChunkSize      = 65536;
+		static constexpr int    sChunksPerSlab  = 32;		// 2Mo, the size of a huge page
+		static constexpr int    sMaxChunks      = 65536;	// 4Go of reserved address space
+		static constexpr int    sNoRetentionCap = -1;
+
+		struct Stats
+		{
+			int mLiveChunks      = 0;	// allocated & in use
+			int mFreeChunks      = 0;	// free & retained for reuse
+			int mReleasedChunks  = 0;	// free & returned to the OS
+			int mPeakLiveChunks  = 0;
+			int mCommittedChunks = 0;	// chunks that were committed at least once
+		};
 
+		EcsChunkAllocator( const int _retentionCap = sNoRetentionCap, const bool _useHugePages = false );
 		~EcsChunkAllocator();
+		EcsChunkAllocator( EcsChunkAllocator const& ) = delete;
+		EcsChunkAllocator& operator=( EcsChunkAllocator const& ) = delete;
+
 		void*	Alloc();
 		void	Free( void* _chunk );
-		size_t	Size() const { return mSize; }
+		void	SetRetentionCap( const int _maxFreeChunks ) { mRetentionCap.store( _maxFreeChunks ); }
+		Stats	GetStats() const;
+		void	ReportToProfiler() const;
+		size_t	Size() const { return size_t( mLiveChunks.load() + mFreeChunks.load() ); }// committed chunks
 
 	private:
-		std::vector<void*> mFreeChunks;
-		size_t             mSize;
+		bool	PopFreeChunk( int& _outChunkIndex );
+		void	PushFreeChunk( const int _chunkIndex );
+		bool	CommitSlab();
+		void*	ChunkAt( const int _chunkIndex ) const { return mBase + size_t( _chunkIndex ) * sChunkSize; }
+
+		uint8_t*                               mReservation = nullptr;
+		uint8_t*                               mBase        = nullptr;	// slab aligned
+		size_t                                 mReservationSize = 0;
+		bool                                   mUseHugePages;
+		std::unique_ptr< std::atomic<int>[] >  mNextFree;		// free list links, indexed by chunk
+		std::unique_ptr< std::atomic<bool>[] > mIsReleased;		// memory of the free chunk was returned to the OS
+		std::atomic<uint64_t>                  mFreeHead;		// ABA tag << 32 | ( chunk index + 1 ), 0 is empty
+		std::mutex                             mCommitMutex;
+		std::atomic<int>                       mCommittedChunks;
+		std::atomic<int>                       mLiveChunks;
+		std::atomic<int>                       mFreeChunks;
+		std::atomic<int>                       mReleasedChunks;
+		std::atomic<int>                       mPeakLiveChunks;
+		std::atomic<int>                       mRetentionCap;
 	};
-}
\ No newline at end of file
+}
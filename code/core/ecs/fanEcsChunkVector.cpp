@@ -1,4 +1,5 @@
 #include "core/ecs/fanEcsChunkVector.hpp"
+#include <algorithm>
 #include "core/fanAssert.hpp"
 
 namespace fan
@@ -49,7 +50,7 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	void* EcsChunkVector::At( const int& _index )
+	void* EcsChunkVector::At( const int& _index ) const
 	{
 		const int chunkIndex = _index / mChunkCapacity;
 		const int elementIndex = _index % mChunkCapacity;
@@ -78,6 +79,58 @@ namespace fan
 		return chunkIndex * mChunkCapacity + elementIndex;
 	}
 
+	//========================================================================================================
+	// appends _count contiguous components of another chunk vector of the same type
+	// components are copied in runs that do not cross the chunks boundaries
+	//========================================================================================================
+	void EcsChunkVector::PushBack( EcsChunkVector& _src, const int _srcIndex, const int _count )
+	{
+        fanAssert( _src.mComponentSize == mComponentSize );
+		int srcIndex  = _srcIndex;
+		int remaining = _count;
+		while( remaining > 0 )
+		{
+			if( mChunks.rbegin()->Full() )
+			{
+				mChunks.emplace_back();
+				mChunks.rbegin()->Create( mCpyFunction, mComponentSize, mAlignment );
+			}
+
+			EcsChunk& dstChunk = *mChunks.rbegin();
+			EcsChunk& srcChunk = _src.mChunks[srcIndex / _src.mChunkCapacity];
+			const int srcElementIndex = srcIndex % _src.mChunkCapacity;
+			const int count = std::min( { remaining,
+			                              dstChunk.Capacity() - dstChunk.Size(),
+			                              srcChunk.Size() - srcElementIndex } );
+			dstChunk.PushBack( srcChunk.At( srcElementIndex ), count );
+			srcIndex += count;
+			remaining -= count;
+		}
+	}
+
+	//========================================================================================================
+	// copies the component at _srcIndex over the component at _dstIndex
+	//========================================================================================================
+	void EcsChunkVector::Move( const int _dstIndex, const int _srcIndex )
+	{
+		mChunks[_dstIndex / mChunkCapacity].Set( _dstIndex % mChunkCapacity, At( _srcIndex ) );
+	}
+
+	//========================================================================================================
+	// removes the components after _size and destroys the chunks that become empty
+	//========================================================================================================
+	void EcsChunkVector::Shrink( const int _size )
+	{
+		const int numChunks = std::max( 1, ( _size + mChunkCapacity - 1 ) / mChunkCapacity );
+        fanAssert( numChunks <= NumChunk() );
+		while( NumChunk() > numChunks )
+		{
+			mChunks.rbegin()->Destroy();
+			mChunks.pop_back();
+		}
+		mChunks.rbegin()->Shrink( _size - ( numChunks - 1 ) * mChunkCapacity );
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	int EcsChunkVector::EmplaceBack()
@@ -115,4 +168,31 @@ namespace fan
         fanAssert( mChunks.size() == 1 );
         fanAssert( mChunks[0].Empty() );
 	}
+
+	//========================================================================================================
+	// stamps the chunks containing the components [_begin, _end[ with a write tick
+	//========================================================================================================
+	void EcsChunkVector::SetVersion( const int _begin, const int _end, const EcsTick _tick )
+	{
+		if( _begin >= _end ) { return; }
+		const int lastChunk = ( _end - 1 ) / mChunkCapacity;
+		for( int chunkIndex = _begin / mChunkCapacity; chunkIndex <= lastChunk; chunkIndex++ )
+		{
+			mChunks[chunkIndex].SetVersion( _tick );
+		}
+	}
+
+	//========================================================================================================
+	// returns true if a chunk containing the components [_begin, _end[ was written after _tick
+	//========================================================================================================
+	bool EcsChunkVector::ChangedSince( const int _begin, const int _end, const EcsTick _tick ) const
+	{
+		if( _begin >= _end ) { return false; }
+		const int lastChunk = ( _end - 1 ) / mChunkCapacity;
+		for( int chunkIndex = _begin / mChunkCapacity; chunkIndex <= lastChunk; chunkIndex++ )
+		{
+			if( mChunks[chunkIndex].GetVersion() > _tick ) { return true; }
+		}
+		return false;
+	}
 }
\ No newline at end of file
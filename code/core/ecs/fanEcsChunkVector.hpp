@@ -16,14 +16,20 @@ namespace fan
 
 		void	Create( CpyFunction _cpyFunction, const int _componentSize, const int _alignment );
 		void	Remove( const int& _index );
-		void*	At( const int& _index );
+		void*	At( const int& _index ) const;
 		int		PushBack( void* _data );
+		void	PushBack( EcsChunkVector& _src, const int _srcIndex, const int _count );
+		void	Move( const int _dstIndex, const int _srcIndex );
+		void	Shrink( const int _size );
 		int		EmplaceBack();
 		void	Clear();
+		void	SetVersion( const int _begin, const int _end, const EcsTick _tick );
+		bool	ChangedSince( const int _begin, const int _end, const EcsTick _tick ) const;
 
 		const EcsChunk& GetChunk( const int _index ) const	{ return mChunks[_index];		}
 		EcsChunk&		GetChunk( const int _index )		{ return mChunks[_index];		}
 		int				NumChunk() const					{ return int( mChunks.size() );}
+		int				ChunkCapacity() const				{ return mChunkCapacity;		}
 
 	private:
 		std::vector<EcsChunk> mChunks;
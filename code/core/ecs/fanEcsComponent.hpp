@@ -7,17 +7,15 @@
 #include "core/ecs/fanEcsEntity.hpp"
 #include "core/ecs/fanEcsTypes.hpp"
 
-namespace sf
-{
-	class Packet;
-}
-
 namespace fan
 {
+	class BitWriter;
+	class BitReader;
+
 	struct EcsComponent {};
 
 	//========================================================================================================
-	// Memcpy is a placement new that uses a copy constructor.
+	// Memcpy is a placement new that uses a copy constructor on the _count bytes of components
 	// If the component is trivially copyable, it is replaced with a fast std::memcpy
     //========================================================================================================
 	#define ECS_COMPONENT( _ComponentType)															\
@@ -28,9 +26,12 @@ namespace fan
 		static constexpr const char* sName		{ #_ComponentType		  };						\
 		static constexpr uint32_t	 sType		{ SSID( #_ComponentType ) };						\
 		static EcsComponent& Instanciate( void* _buffer ) { return *new( _buffer ) T(); }			\
-	    static void* Memcpy( void* _dst, const void* _src, size_t /*_count*/ )                      \
+	    static void* Memcpy( void* _dst, const void* _src, size_t _count )                          \
 	    {	                                                                                        \
-	        new( _dst )T( *static_cast<const T*>( _src ) );                                         \
+	        for( size_t i = 0; i < _count / sizeof( T ); i++ )                                      \
+	        {                                                                                       \
+	            new( static_cast<T*>( _dst ) + i )T( static_cast<const T*>( _src )[i] );            \
+	        }                                                                                       \
 	        return _dst;                                                                            \
         }                                                                                           \
 	};																								\
@@ -45,7 +46,8 @@ namespace fan
 	{
 		enum ComponentFlags { 
 			None = 0, 
-			RollbackNoOverwrite = 1 // on a rollback, old rollback states are not overwritten with new ones
+			RollbackNoOverwrite = 1, // on a rollback, old rollback states are not overwritten with new ones
+			PrefabPerInstance   = 2  // owns per instance data, prefabs instances apply compiled parameters to it
 		};
 
         std::string            mName;
@@ -54,6 +56,8 @@ namespace fan
 		uint32_t               mSize;
 		uint32_t               mAlignment;
 		int                    mFlags          = ComponentFlags::None;
+		uint32_t               mRollbackSize   = 0;				// size of the trivially copyable rollback state
+		uint32_t               mPrefabSize     = 0;				// size of the trivially copyable prefab parameters
 		std::vector<SlotBase*> mSlots;                         // callable methods
 
 		void ( *init )( EcsWorld&, EcsEntity, EcsComponent& ) = nullptr;			  // called once at creation
@@ -61,10 +65,12 @@ namespace fan
 		void ( *destroy )( EcsWorld&, EcsEntity, EcsComponent& ) = nullptr;			  // called at destruction
 		void ( *save )( const EcsComponent&, Json& ) = nullptr;						  // Serialize to json
 		void ( *load )( EcsComponent&, const Json& ) = nullptr;						  // Deserialize from json
-		void ( *netSave ) ( const EcsComponent&, sf::Packet& _packet ) = nullptr;	  // Serialize to packet
-		void ( *netLoad ) ( EcsComponent&, sf::Packet& _packet ) = nullptr;		      // Deserialize from packet
-		void ( *rollbackSave ) ( const EcsComponent&, sf::Packet& _packet ) = nullptr;// Serializes rollback
-		void ( *rollbackLoad ) ( EcsComponent&, sf::Packet& _packet ) = nullptr;	  // Deserializes rollback
+		void ( *netSave ) ( const EcsComponent&, BitWriter& _writer ) = nullptr;	  // Serialize for replication
+		void ( *netLoad ) ( EcsComponent&, BitReader& _reader ) = nullptr;		      // Deserialize for replication
+		void ( *rollbackSave ) ( const EcsComponent&, void* _state ) = nullptr;	  // Writes mRollbackSize bytes
+		void ( *rollbackLoad ) ( EcsComponent&, const void* _state ) = nullptr;	  // Restores rollback state
+		void ( *prefabSave ) ( const EcsComponent&, void* _params ) = nullptr;	  // Writes mPrefabSize bytes
+		void ( *prefabLoad ) ( EcsComponent&, const void* _params ) = nullptr;	  // Applies prefab parameters
 		EcsComponent& ( *construct )( void* ) = nullptr;
 		void* ( *copy )( void* _dst, const void* _src, size_t _count ) = nullptr;
 	};
@@ -0,0 +1,61 @@
+#include "core/ecs/fanEcsHandleTable.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// adds or updates the entity of a handle
+	//========================================================================================================
+	void EcsHandleTable::Set( const EcsHandle _handle, const EcsEntity _entity )
+	{
+		fanAssert( _handle != 0 );
+		fanAssert( _entity.mArchetype != nullptr );
+
+		const EcsHandle pageIndex = _handle / sPageSize;
+		if( pageIndex >= mPages.size() )
+		{
+			mPages.resize( pageIndex + 1 );
+		}
+		if( mPages[pageIndex] == nullptr )
+		{
+			mPages[pageIndex].reset( new Page() );
+		}
+
+		Page&      page   = *mPages[pageIndex];
+		EcsEntity& entity = page.mEntities[_handle % sPageSize];
+		if( entity.mArchetype == nullptr )
+		{
+			page.mSize++;
+			mSize++;
+		}
+		entity = _entity;
+	}
+
+	//========================================================================================================
+	// the page is freed when its last handle is removed
+	//========================================================================================================
+	void EcsHandleTable::Remove( const EcsHandle _handle )
+	{
+		EcsEntity* entity = Find( _handle );
+		if( entity == nullptr ) { return; }
+
+		*entity = EcsEntity();
+		mSize--;
+		const EcsHandle pageIndex = _handle / sPageSize;
+		if( --mPages[pageIndex]->mSize == 0 )
+		{
+			mPages[pageIndex].reset();
+			while( !mPages.empty() && mPages.back() == nullptr )
+			{
+				mPages.pop_back();
+			}
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void EcsHandleTable::Clear()
+	{
+		mPages.clear();
+		mSize = 0;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "core/fanAssert.hpp"
+#include "core/ecs/fanEcsEntity.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// Maps handles to entities with a single array access
+	// handles index slots stored in fixed size pages, pages are allocated on demand & freed when empty
+	// so memory follows the range of live handles, not the number of handles ever created
+	// handle values are not recycled ( scenes, prefabs & network ids rely on their numeric values ),
+	// the handle of a dead entity stays invalid instead of silently pointing to a new entity
+	//========================================================================================================
+	class EcsHandleTable
+	{
+	public:
+		static constexpr EcsHandle sPageSize = 4096;
+
+		//================================
+		//================================
+		inline EcsEntity* Find( const EcsHandle _handle )
+		{
+			const EcsHandle pageIndex = _handle / sPageSize;
+			if( pageIndex >= mPages.size() || mPages[pageIndex] == nullptr ) { return nullptr; }
+			EcsEntity& entity = mPages[pageIndex]->mEntities[_handle % sPageSize];
+			return entity.mArchetype != nullptr ? &entity : nullptr;
+		}
+
+		inline const EcsEntity* Find( const EcsHandle _handle ) const
+		{
+			return const_cast<EcsHandleTable*>( this )->Find( _handle );
+		}
+
+		inline EcsEntity& At( const EcsHandle _handle )
+		{
+			EcsEntity* entity = Find( _handle );
+			fanAssert( entity != nullptr );
+			return *entity;
+		}
+
+		inline bool Contains( const EcsHandle _handle ) const { return Find( _handle ) != nullptr; }
+		inline int  Size() const { return mSize; }
+
+		void Set( const EcsHandle _handle, const EcsEntity _entity );
+		void Remove( const EcsHandle _handle );
+		void Clear();
+
+		// calls _function( EcsHandle, EcsEntity ) for every handle
+		template < typename _Function >
+		void ForEach( _Function _function ) const
+		{
+			for( EcsHandle pageIndex = 0; pageIndex < mPages.size(); pageIndex++ )
+			{
+				if( mPages[pageIndex] == nullptr ) { continue; }
+				for( EcsHandle slotIndex = 0; slotIndex < sPageSize; slotIndex++ )
+				{
+					const EcsEntity& entity = mPages[pageIndex]->mEntities[slotIndex];
+					if( entity.mArchetype != nullptr )
+					{
+						_function( pageIndex * sPageSize + slotIndex, entity );
+					}
+				}
+			}
+		}
+
+	private:
+		struct Page
+		{
+			EcsEntity mEntities[sPageSize];
+			int       mSize = 0;
+		};
+
+		std::vector< std::unique_ptr< Page > > mPages;
+		int                                    mSize = 0;
+	};
+}
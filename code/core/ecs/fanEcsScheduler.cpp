@@ -0,0 +1,141 @@
+#include "core/ecs/fanEcsScheduler.hpp"
+
+#include <algorithm>
+#include "core/fanThreadPool.hpp"
+#include "core/time/fanProfiler.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	//========================================================================================================
+	EcsScheduler::EcsScheduler( EcsWorld& _world ) : EcsScheduler( _world, ThreadPool::Get() ) {}
+
+	//========================================================================================================
+	//========================================================================================================
+	EcsScheduler::EcsScheduler( EcsWorld& _world, ThreadPool& _threadPool ) :
+			mWorld( _world ),
+			mThreadPool( _threadPool )
+	{
+	}
+
+	//========================================================================================================
+	// waves run one after the other, systems of the same wave run in parallel
+	// the ThreadPool runs a wave on the calling thread when it is already busy ( see ThreadPool::Run )
+	//========================================================================================================
+	void EcsScheduler::Run()
+	{
+		SCOPED_PROFILE( scheduler );
+
+		ComputeWaves();
+		mNumParallelWaves = 0;
+		for( const Wave& wave : mWaves )
+		{
+			if( RunsInParallel( wave ) )
+			{
+				fanAssert( !mWorld.mIsParallel );
+				mNumParallelWaves++;
+				mWorld.mIsParallel = true;
+				mThreadPool.Run( wave.mRuns );
+				mWorld.mIsParallel = false;
+			}
+			else
+			{
+				for( const std::function<void()>& run : wave.mRuns ) { run(); }
+			}
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	bool EcsScheduler::RunsInParallel( const Wave& _wave ) const
+	{
+		if( _wave.mRuns.size() == 1 || mThreadPool.NumWorkers() == 0 ) { return false; }
+		if( mMinParallelEntities <= 0 ) { return true; }
+
+		int numEntities = 0;
+		for( const EcsSignature& signature : _wave.mSignatures )
+		{
+			numEntities += mWorld.Match( signature ).Size();
+			if( numEntities >= mMinParallelEntities ) { return true; }
+		}
+		return false;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	int EcsScheduler::NumWaves()
+	{
+		ComputeWaves();
+		return int( mWaves.size() );
+	}
+
+	//========================================================================================================
+	// conflicts depend on the archetypes matching the systems, waves are computed again when one is added
+	//========================================================================================================
+	void EcsScheduler::ComputeWaves()
+	{
+		const size_t numArchetypes = mWorld.GetArchetypes().size();
+		if( !mDirty && numArchetypes == mNumArchetypes ) { return; }
+		mDirty         = false;
+		mNumArchetypes = numArchetypes;
+
+		std::vector<int> waveIndices( mSystems.size(), 0 );
+		int numWaves = 0;
+		for( int systemIndex = 0; systemIndex < (int)mSystems.size(); systemIndex++ )
+		{
+			for( int previousIndex = 0; previousIndex < systemIndex; previousIndex++ )
+			{
+				if( Conflicts( mSystems[systemIndex], mSystems[previousIndex] ) )
+				{
+					waveIndices[systemIndex] = std::max( waveIndices[systemIndex], waveIndices[previousIndex] + 1 );
+				}
+			}
+			numWaves = std::max( numWaves, waveIndices[systemIndex] + 1 );
+		}
+
+		mWaves.clear();
+		mWaves.resize( numWaves );
+		for( int systemIndex = 0; systemIndex < (int)mSystems.size(); systemIndex++ )
+		{
+			Wave& wave = mWaves[waveIndices[systemIndex]];
+			wave.mRuns.push_back( mSystems[systemIndex].mRun );
+			wave.mSignatures.push_back( mSystems[systemIndex].mSignature );
+		}
+	}
+
+	//========================================================================================================
+	// view accesses only conflict if an archetype matches both systems signatures
+	//========================================================================================================
+	bool EcsScheduler::Conflicts( const ScheduledSystem& _system, const ScheduledSystem& _other ) const
+	{
+		if( !_system.mHasAccess || !_other.mHasAccess )
+		{
+			return true;
+		}
+
+		auto accessConflicts = []( const EcsSignature& _read1, const EcsSignature& _write1,
+		                           const EcsSignature& _read2, const EcsSignature& _write2 )
+		{
+			return ( _write1 & ( _read2 | _write2 ) ).any() || ( _write2 & _read1 ).any();
+		};
+
+		const EcsSystemAccess& access      = _system.mAccess;
+		const EcsSystemAccess& otherAccess = _other.mAccess;
+		if( accessConflicts( access.mRead,
+		                     access.mWrite,
+		                     otherAccess.mRead | otherAccess.mViewRead,
+		                     otherAccess.mWrite | otherAccess.mViewWrite ) )
+		{
+			return true;
+		}
+		if( accessConflicts( access.mViewRead, access.mViewWrite, otherAccess.mRead, otherAccess.mWrite ) )
+		{
+			return true;
+		}
+		if( accessConflicts( access.mViewRead, access.mViewWrite, otherAccess.mViewRead, otherAccess.mViewWrite ) )
+		{
+			return !mWorld.Match( _system.mSignature | _other.mSignature ).Empty();
+		}
+		return false;
+	}
+}
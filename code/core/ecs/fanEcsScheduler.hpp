@@ -0,0 +1,95 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include "core/ecs/fanEcsWorld.hpp"
+#include "core/ecs/fanEcsSystem.hpp"
+
+namespace fan
+{
+	class ThreadPool;
+
+	//========================================================================================================
+	// true if the system declares a static GetAccess( const EcsWorld& ) method
+	//========================================================================================================
+	template< typename _SystemType, typename = void >
+	struct EcsHasAccess : std::false_type {};
+	template< typename _SystemType >
+	struct EcsHasAccess< _SystemType, std::void_t< decltype( _SystemType::GetAccess( std::declval<const EcsWorld&>() ) ) > >
+	        : std::true_type {};
+
+	//========================================================================================================
+	// Runs a group of systems in parallel when their accesses do not conflict
+	// a system runs in the wave following the last wave of the previously added systems it conflicts with,
+	// so conflicting systems keep the order in which they were added
+	// structural changes ( kill, add/remove components etc. ) are still deferred to ApplyTransitions
+	// waves are computed on the first Run() and kept until a system or an archetype is added,
+	// keep the scheduler alive between frames and bind the arguments that change with std::cref
+	// a wave runs serially on the calling thread when the pool has no worker or when its systems match less
+	// entities than SetMinParallelEntities(), dispatching small waves costs more than it saves
+	// ex:	EcsScheduler scheduler( mWorld );
+	//		scheduler.Add<SRechargeBatteries>( std::cref( mDelta ) );
+	//		scheduler.Add<SUpdateExpirationTimes>( std::cref( mDelta ) );
+	//		scheduler.Run();
+	//========================================================================================================
+	class EcsScheduler
+	{
+	public:
+		EcsScheduler( EcsWorld& _world );
+		EcsScheduler( EcsWorld& _world, ThreadPool& _threadPool );
+
+		template< typename _SystemType, typename... _Args > void Add( _Args... _args );
+		void Run();
+		int  NumWaves();
+		int  NumParallelWaves() const { return mNumParallelWaves; }	// waves dispatched by the last Run()
+		void SetMinParallelEntities( const int _minEntities ) { mMinParallelEntities = _minEntities; }
+
+	private:
+		struct ScheduledSystem
+		{
+			EcsSignature          mSignature;
+			EcsSystemAccess       mAccess;
+			bool                  mHasAccess = false;
+			std::function<void()> mRun;
+		};
+
+		struct Wave
+		{
+			std::vector<std::function<void()>> mRuns;
+			std::vector<EcsSignature>          mSignatures;
+		};
+
+		bool Conflicts( const ScheduledSystem& _system, const ScheduledSystem& _other ) const;
+		bool RunsInParallel( const Wave& _wave ) const;
+		void ComputeWaves();
+
+		EcsWorld&                    mWorld;
+		ThreadPool&                  mThreadPool;
+		std::vector<ScheduledSystem> mSystems;
+		std::vector<Wave>            mWaves;
+		size_t                       mNumArchetypes       = 0;	// archetypes count when the waves were computed
+		int                          mMinParallelEntities = 0;
+		int                          mNumParallelWaves    = 0;
+		bool                         mDirty               = true;
+	};
+
+	//========================================================================================================
+	// arguments are copied and passed to the system Run() method when the scheduler runs
+	//========================================================================================================
+	template< typename _SystemType, typename... _Args > void EcsScheduler::Add( _Args... _args )
+	{
+		static_assert( std::is_base_of< EcsSystem, _SystemType >::value );
+
+		ScheduledSystem system;
+		system.mSignature = _SystemType::GetSignature( mWorld );
+		if constexpr( EcsHasAccess<_SystemType>::value )
+		{
+			system.mAccess    = _SystemType::GetAccess( mWorld );
+			system.mHasAccess = true;
+		}
+		EcsWorld& world = mWorld;
+		system.mRun = [&world, _args...]() { world.Run<_SystemType>( _args... ); };
+		mSystems.push_back( system );
+		mDirty = true;
+	}
+}
@@ -10,4 +10,19 @@ namespace fan
 	// implement GetSignature() and  Run(..) methods
 	//==============================================================================================================================================================
 	struct EcsSystem {};
+
+	//==============================================================================================================================================================
+	// Component types a system reads & writes, used by the EcsScheduler to run systems in parallel
+	// systems declare it with a static GetAccess( const EcsWorld& ) method next to GetSignature()
+	// mViewRead/mViewWrite : components accessed on the entities of the system view only
+	// mRead/mWrite         : components accessed on any entity ( through handles, pointers etc. )
+	// systems with an access can read singletons but must not write them, systems without an access run alone
+	//==============================================================================================================================================================
+	struct EcsSystemAccess
+	{
+		EcsSignature mViewRead  = EcsSignature( 0 );
+		EcsSignature mViewWrite = EcsSignature( 0 );
+		EcsSignature mRead      = EcsSignature( 0 );
+		EcsSignature mWrite     = EcsSignature( 0 );
+	};
 }
\ No newline at end of file
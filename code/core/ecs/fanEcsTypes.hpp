@@ -9,6 +9,7 @@ namespace fan
     static constexpr uint32_t ecsSignatureLength = 64;
     using EcsSignature = std::bitset<ecsSignatureLength>;
     using EcsHandle = uint32_t;
+    using EcsTick = uint64_t;	// increases every time a system runs, components writes are stamped with it
 
 	// theses groups are used to set the color of the singleton/components icons
 	enum class EngineGroups
@@ -1,43 +1,55 @@
 #pragma once
 
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
 #include "core/ecs/fanEcsArchetype.hpp"
+#include "core/fanThreadPool.hpp"
 
 namespace fan
 {
 	//================================
+	// Change detection:
+	// accessing a non const component type through the view stamps its chunks with the view change tick
+	// ex: ForEach<const Transform, Bounds> only marks the bounds as changed
+	// Changed<...>() returns a view that skips the entities whose components were not written
+	// since the previous run of the system
 	//================================
 	struct EcsView
 	{
-		EcsView( const std::unordered_map<uint32_t, int >& _typesToIndex, const EcsSignature _signature ) :
+		EcsView( const std::unordered_map<uint32_t, int >& _typesToIndex,
+		         const EcsSignature _signature,
+		         const std::vector<EcsArchetype*>& _archetypes,
+		         const EcsTick _changeTick ) :
                 mTypesToIndex( _typesToIndex )
 			, mSignature( _signature )
+			, mArchetypes( _archetypes )
+			, mChangeTick( _changeTick )
 		{
 		}
 
 		//================================
+		// iterates over one component type of the view
+		// borrows the archetypes list of the view, the view must outlive the iterator
 		//================================
 		template < typename ComponentType >
 		struct iterator
 		{
-			iterator( const EcsView& _view, const int _componentIndex )
+			iterator( const EcsView& _view, const int _componentIndex ) :
+			        mArchetypes( &_view.mArchetypes ),
+			        mChangeTick( _view.mChangeTick )
 			{
 				if( _componentIndex == -1 )
 				{
-                    mArchetypeIndex = uint16_t( _view.mArchetypes.size() ); // end() iterator
+                    mArchetypeIndex = int( mArchetypes->size() ); // end() iterator
 				}
 				else
 				{
                     fanAssert( _view.mSignature[_componentIndex] );
-                    mArchetypesList = _view.mArchetypes;
                     mComponentIndex = _componentIndex;
-                    mChunkIndex     = 0;
-                    mElementIndex   = 0;
                     mArchetypeIndex = 0;
-					if( !mArchetypesList.empty() )
-					{
-                        mCurrentArchetype = mArchetypesList[mArchetypeIndex];
-                        mCurrentChunk     = &mCurrentArchetype->GetChunkVector( _componentIndex ).GetChunk( mChunkIndex );
-					}
+                    NextNonEmptyArchetype();
 				}
 			}
 
@@ -46,49 +58,81 @@ namespace fan
 				return mArchetypeIndex != _other.mArchetypeIndex;
 			}
 
-			void operator++() // prefix ++
+			inline void operator++() // prefix ++
 			{
-				++mElementIndex;
-				if( mElementIndex >= mCurrentChunk->Size() )
+				if( ++mElementIndex >= mChunkSize )
 				{
-                    mElementIndex = 0;
-					++mChunkIndex;
-
-					if( mChunkIndex < mCurrentArchetype->GetChunkVector( mComponentIndex ).NumChunk() )
-					{
-                        mCurrentChunk = &mCurrentArchetype->GetChunkVector( mComponentIndex ).GetChunk( mChunkIndex );
-					}
-					else
-					{
-                        mChunkIndex = 0;
-						++mArchetypeIndex;
-						if( mArchetypeIndex < mArchetypesList.size() )
-						{
-                            mCurrentArchetype = mArchetypesList[mArchetypeIndex];
-                            mCurrentChunk     = &mCurrentArchetype->GetChunkVector( mComponentIndex ).GetChunk( mChunkIndex );
-						}
-					}
+                    NextChunk();
 				}
 			}
 
 			inline ComponentType& operator*()
 			{
-				return *static_cast<ComponentType*>( mCurrentChunk->At( mElementIndex ) );
+				return mChunkData[mElementIndex];
 			}
 
 			EcsEntity GetEntity() const
 			{
-				const uint32_t index = mChunkIndex * mCurrentChunk->Capacity() + mElementIndex;
+				const uint32_t index = mChunkIndex * mChunkCapacity + mElementIndex;
 				return { mCurrentArchetype, index };
 			}
 		private:
-			std::vector< EcsArchetype* > mArchetypesList;
-			int                          mComponentIndex;
-			uint16_t                     mArchetypeIndex;
-			uint16_t                     mChunkIndex;
-			uint16_t                     mElementIndex;
-			EcsArchetype*                mCurrentArchetype;
-			EcsChunk*                    mCurrentChunk;
+		    void NextChunk()
+            {
+                mElementIndex = 0;
+                ++mChunkIndex;
+                if( mChunkIndex < mChunkVector->NumChunk() )
+                {
+                    SetChunk();
+                }
+                else
+                {
+                    ++mArchetypeIndex;
+                    NextNonEmptyArchetype();
+                }
+            }
+
+		    // cached archetypes lists can contain empty archetypes, skip them
+		    void NextNonEmptyArchetype()
+            {
+                const int numArchetypes = int( mArchetypes->size() );
+                while( mArchetypeIndex < numArchetypes && ( *mArchetypes )[mArchetypeIndex]->Empty() )
+                {
+                    ++mArchetypeIndex;
+                }
+                if( mArchetypeIndex < numArchetypes )
+                {
+                    mCurrentArchetype = ( *mArchetypes )[mArchetypeIndex];
+                    mChunkVector      = &mCurrentArchetype->GetChunkVector( mComponentIndex );
+                    mChunkIndex       = 0;
+                    mElementIndex     = 0;
+                    SetChunk();
+                }
+            }
+
+            void SetChunk()
+            {
+                EcsChunk& chunk = mChunkVector->GetChunk( mChunkIndex );
+                mChunkData     = static_cast<ComponentType*>( chunk.Data() );
+                mChunkSize     = chunk.Size();
+                mChunkCapacity = chunk.Capacity();
+                if constexpr( !std::is_const<ComponentType>::value )
+                {
+                    chunk.SetVersion( mChangeTick );
+                }
+            }
+
+			const std::vector< EcsArchetype* >* mArchetypes;
+			EcsTick                             mChangeTick;
+			int                                 mComponentIndex   = -1;
+			int                                 mArchetypeIndex   = 0;
+			int                                 mChunkIndex       = 0;
+			int                                 mElementIndex     = 0;
+			int                                 mChunkSize        = 0;
+			int                                 mChunkCapacity    = 0;
+			ComponentType*                      mChunkData        = nullptr;
+			EcsArchetype*                       mCurrentArchetype = nullptr;
+			EcsChunkVector*                     mChunkVector      = nullptr;
 		};
 
 		template < typename _ComponentType >
@@ -104,6 +148,145 @@ namespace fan
 			return iterator<_ComponentType>( *this, -1 );
 		}
 
+		//================================
+		// returns a copy of the view where ForEach & ParallelForEach only process the entities which
+		// _ComponentTypes were written since the last run of the system ( all entities on the first run )
+		// filtering is done per chunk, unchanged entities sharing a chunk with a changed one are processed too
+		// iterators ( begin/end ) ignore the filter
+		//================================
+		template < typename... _ComponentTypes >
+		EcsView Changed() const
+		{
+			static_assert( sizeof...( _ComponentTypes ) > 0 );
+			EcsView view = *this;
+			for( const int componentIndex : { mTypesToIndex.at( _ComponentTypes::Info::sType )... } )
+			{
+				fanAssert( mSignature[componentIndex] );
+				view.mChangedFilter.set( componentIndex );
+			}
+			return view;
+		}
+
+		//================================
+		// calls _function( _ComponentTypes&... ) on every entity of the view
+		// components of different sizes have different chunk boundaries,
+		// so entities are processed in runs that do not cross any chunk boundary
+		// ex: _view.ForEach<Transform, SceneNode>( [&]( Transform& _transform, SceneNode& _node ){ ... } );
+		//================================
+		template < typename... _ComponentTypes, typename _Function >
+		void ForEach( _Function _function ) const
+		{
+			static_assert( sizeof...( _ComponentTypes ) > 0 );
+			const int componentIndices[] = { mTypesToIndex.at( _ComponentTypes::Info::sType )... };
+			auto forEachInRange = [this, &componentIndices, &_function]( EcsArchetype& _archetype,
+			                                                              const int _begin,
+			                                                              const int _end )
+			{
+				ForEachInRange<_ComponentTypes...>( _archetype,
+				                                    componentIndices,
+				                                    _begin,
+				                                    _end,
+				                                    mChangeTick,
+				                                    [&_function]( const int, _ComponentTypes&... _components )
+				                                    {
+					                                    _function( _components... );
+				                                    },
+				                                    std::index_sequence_for<_ComponentTypes...>{} );
+			};
+
+			if( mChangedFilter.none() )
+			{
+				for( EcsArchetype* archetype : mArchetypes )
+				{
+					if( !archetype->Empty() )
+					{
+						forEachInRange( *archetype, 0, archetype->Size() );
+					}
+				}
+			}
+			else
+			{
+				for( const Batch& batch : GetBatches( componentIndices[0] ) )
+				{
+					forEachInRange( *batch.mArchetype, batch.mBegin, batch.mEnd );
+				}
+			}
+		}
+
+		//================================
+		// same as ForEach but entities are split in batches that are processed in parallel on the ThreadPool
+		// a batch is a run of entities of an archetype stored in the same chunk of the first component type
+		// _function is called concurrently from different threads, it must not make structural changes
+		// ( kill, add/remove components etc. ) or write data shared between entities
+		//================================
+		template < typename... _ComponentTypes, typename _Function >
+		void ParallelForEach( _Function _function ) const
+		{
+			static_assert( sizeof...( _ComponentTypes ) > 0 );
+			const int componentIndices[] = { mTypesToIndex.at( _ComponentTypes::Info::sType )... };
+			const std::vector<Batch> batches = GetBatches( componentIndices[0] );
+
+			std::vector<ThreadPool::Job> jobs;
+			jobs.reserve( batches.size() );
+			for( const Batch& batch : batches )
+			{
+				jobs.push_back( [this, &batch, &componentIndices, &_function]()
+				{
+					ForEachInRange<_ComponentTypes...>( *batch.mArchetype,
+					                                    componentIndices,
+					                                    batch.mBegin,
+					                                    batch.mEnd,
+					                                    mChangeTick,
+					                                    [&_function]( const int, _ComponentTypes&... _components )
+					                                    {
+						                                    _function( _components... );
+					                                    },
+					                                    std::index_sequence_for<_ComponentTypes...>{} );
+				} );
+			}
+			ThreadPool::Get().Run( jobs );
+		}
+
+		//================================
+		// ParallelForEach with one output per batch, calls _function( _Output&, EcsEntity, _ComponentTypes&... )
+		// _outputs is resized to the number of batches and batches are ordered like the entities of the view,
+		// so concatenating the outputs in order gives the same result whatever the number of threads
+		// ex: collect the entities to kill in a std::vector<std::vector<EcsEntity>> and kill them after the call
+		//================================
+		template < typename... _ComponentTypes, typename _Output, typename _Function >
+		void ParallelForEach( std::vector<_Output>& _outputs, _Function _function ) const
+		{
+			static_assert( sizeof...( _ComponentTypes ) > 0 );
+			const int componentIndices[] = { mTypesToIndex.at( _ComponentTypes::Info::sType )... };
+			const std::vector<Batch> batches = GetBatches( componentIndices[0] );
+
+			_outputs.clear();
+			_outputs.resize( batches.size() );
+			std::vector<ThreadPool::Job> jobs;
+			jobs.reserve( batches.size() );
+			for( int batchIndex = 0; batchIndex < (int)batches.size(); batchIndex++ )
+			{
+				const Batch& batch  = batches[batchIndex];
+				_Output&     output = _outputs[batchIndex];
+				jobs.push_back( [this, &batch, &output, &componentIndices, &_function]()
+				{
+					ForEachInRange<_ComponentTypes...>( *batch.mArchetype,
+					                                    componentIndices,
+					                                    batch.mBegin,
+					                                    batch.mEnd,
+					                                    mChangeTick,
+					                                    [&batch, &output, &_function]( const int _index,
+					                                                                   _ComponentTypes&... _components )
+					                                    {
+						                                    const EcsEntity entity = { batch.mArchetype, uint32_t( _index ) };
+						                                    _function( output, entity, _components... );
+					                                    },
+					                                    std::index_sequence_for<_ComponentTypes...>{} );
+				} );
+			}
+			ThreadPool::Get().Run( jobs );
+		}
+
 		int Size() const
 		{
 			int size = 0;
@@ -116,11 +299,141 @@ namespace fan
 
 		bool Empty() const
 		{
-			return Size() == 0;
+			for( const EcsArchetype* archetype : mArchetypes )
+			{
+				if( !archetype->Empty() ) { return false; }
+			}
+			return true;
 		}
 
         const std::unordered_map<uint32_t, int >& mTypesToIndex;
         const EcsSignature                        mSignature;
-        std::vector<EcsArchetype*>                mArchetypes;
+        const std::vector<EcsArchetype*>&         mArchetypes;// cached in the world, may contain empty archetypes
+        EcsTick                                   mChangeTick;		// writes through the view are stamped with it
+        EcsTick                                   mLastRunTick = 0;	// change tick of the previous run of the system
+        EcsSignature                              mChangedFilter;	// components filtered by Changed<...>()
+
+	private:
+		//================================
+		// position in the chunks of one component type of an archetype
+		//================================
+		template < typename _ComponentType >
+		struct ChunkCursor
+		{
+			ChunkCursor( EcsChunkVector& _chunkVector, const int _begin, const EcsTick _changeTick ) :
+			        mChunkVector( _chunkVector ),
+			        mChangeTick( _changeTick )
+			{
+				const int capacity = mChunkVector.GetChunk( 0 ).Capacity();
+				mChunkIndex = _begin / capacity;
+				SetChunk();
+				mData += _begin % capacity;
+				mRemaining -= _begin % capacity;
+			}
+
+			void Advance( const int _count )
+			{
+				mData += _count;
+				mRemaining -= _count;
+				if( mRemaining == 0 && ++mChunkIndex < mChunkVector.NumChunk() )
+				{
+					SetChunk();
+				}
+			}
+
+			void SetChunk()
+			{
+				EcsChunk& chunk = mChunkVector.GetChunk( mChunkIndex );
+				mData      = static_cast<_ComponentType*>( chunk.Data() );
+				mRemaining = chunk.Size();
+				if constexpr( !std::is_const<_ComponentType>::value )
+				{
+					chunk.SetVersion( mChangeTick );
+				}
+			}
+
+			EcsChunkVector& mChunkVector;
+			EcsTick         mChangeTick;
+			_ComponentType* mData       = nullptr;
+			int             mRemaining  = 0;
+			int             mChunkIndex = 0;
+		};
+
+		//================================
+		// entities [_begin, _end[ of an archetype
+		//================================
+		struct Batch
+		{
+			EcsArchetype* mArchetype;
+			int           mBegin;
+			int           mEnd;
+		};
+
+		// splits the view along the chunks boundaries of a component type
+		// batches that did not change are skipped when the view is filtered with Changed<...>()
+		std::vector<Batch> GetBatches( const int _componentIndex ) const
+		{
+			std::vector<Batch> batches;
+			for( EcsArchetype* archetype : mArchetypes )
+			{
+				if( archetype->Empty() ) { continue; }
+				const int size     = archetype->Size();
+				const int capacity = archetype->GetChunkVector( _componentIndex ).ChunkCapacity();
+				for( int begin = 0; begin < size; begin += capacity )
+				{
+					const Batch batch = { archetype, begin, std::min( begin + capacity, size ) };
+					if( mChangedFilter.none() || BatchChanged( batch ) )
+					{
+						batches.push_back( batch );
+					}
+				}
+			}
+			return batches;
+		}
+
+		bool BatchChanged( const Batch& _batch ) const
+		{
+			for( int componentIndex = 0; componentIndex < int( ecsSignatureLength ); componentIndex++ )
+			{
+				if( mChangedFilter[componentIndex] &&
+				    _batch.mArchetype->GetChunkVector( componentIndex ).ChangedSince( _batch.mBegin,
+				                                                                      _batch.mEnd,
+				                                                                      mLastRunTick ) )
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// calls _function( entityIndex, _ComponentTypes&... ) on entities [_begin, _end[ of the archetype
+		template < typename... _ComponentTypes, typename _Function, size_t... _Indices >
+		static void ForEachInRange( EcsArchetype& _archetype,
+		                            const int* _componentIndices,
+		                            const int _begin,
+		                            const int _end,
+		                            const EcsTick _changeTick,
+		                            _Function _function,
+		                            std::index_sequence<_Indices...> )
+		{
+			std::tuple< ChunkCursor<_ComponentTypes>... > cursors(
+			        ChunkCursor<_ComponentTypes>( _archetype.GetChunkVector( _componentIndices[_Indices] ),
+			                                      _begin,
+			                                      _changeTick )... );
+
+			int index = _begin;
+			while( index < _end )
+			{
+				const int count = std::min( { _end - index, std::get<_Indices>( cursors ).mRemaining... } );
+				fanAssert( count > 0 );
+				std::tuple< _ComponentTypes*... > data( std::get<_Indices>( cursors ).mData... );
+				for( int i = 0; i < count; i++ )
+				{
+					_function( index + i, std::get<_Indices>( data )[i]... );
+				}
+				( std::get<_Indices>( cursors ).Advance( count ), ... );
+				index += count;
+			}
+		}
 	};
 }
\ No newline at end of file
@@ -5,18 +5,9 @@
 namespace fan
 {
 	//========================================================================================================
-	//========================================================================================================
-	struct SortedTransition
-	{
-		int transitionIndex;
-		uint32_t entityIndex;
-		bool operator<( const SortedTransition& _other ) const
-		{
-		    return ( entityIndex < _other.entityIndex );
-		}
-	};
-
-	//========================================================================================================
+	// transitions are grouped by source archetype then by target signature
+	// entities of a group are moved together to their target archetype,
+	// then the source archetype is compacted in one pass
 	//========================================================================================================
 	void EcsWorld::ApplyTransitions() 
 	{
@@ -33,157 +24,219 @@ namespace fan
         fanAssert( mTransitionArchetype.Size() == (int)mTransitions.size() );
 		if( mTransitions.size() == 0 ) { return; }
 
-		// Sort transitions by ascending entity index
-		std::vector<SortedTransition> sortedTransitions;
-		sortedTransitions.reserve( mTransitions.size() );
+		// Computes the target signatures, transitions that don't change anything are erased
+		mSortedTransitions.clear();
 		for ( int transitionIndex = 0; transitionIndex < (int)mTransitions.size(); transitionIndex++)
 		{
-			const EcsTransition& transition = mTransitions[transitionIndex];
-			sortedTransitions.push_back( { transitionIndex, transition.mEntity.mIndex } );
-		}
-		std::sort( sortedTransitions.begin(), sortedTransitions.end() );
-
-		// Applies structural transition to entities ( add/remove components/tags, add/remove entities
-		for ( int transitionIdx = int( sortedTransitions.size()) - 1; transitionIdx >= 0 ; transitionIdx--)
-		{
-			const SortedTransition&		sortedTransition = sortedTransitions[transitionIdx];
-			const int					transitionIndex = sortedTransition.transitionIndex;
-			const EcsTransition&		transition = mTransitions[ transitionIndex ];
-			const EcsEntity&			srcEntity = transition.mEntity;
-			const uint32_t				srcIndex = srcEntity.mIndex;
-			EcsArchetype&				srcArchetype = *srcEntity.mArchetype;
-            const bool srcArchetypeIsTransitionArchetype =  ( &srcArchetype == &mTransitionArchetype );
-			const EcsEntityData&		srcEntityData = srcArchetype.GetEntityData(srcIndex);
+			const EcsTransition& transition   = mTransitions[transitionIndex];
+			EcsArchetype&        srcArchetype = *transition.mEntity.mArchetype;
+			EcsEntityData&       srcEntityData = srcArchetype.GetEntityData( transition.mEntity.mIndex );
+            const bool srcArchetypeIsTransitionArchetype = ( &srcArchetype == &mTransitionArchetype );
 			fanAssert( srcEntityData.mTransitionIndex == transitionIndex );
             fanAssert( !( srcArchetypeIsTransitionArchetype &&
                           transition.mSignatureRemove != EcsSignature( 0 ) ) );
 
-			// Create destination signature
 			EcsSignature targetSignature = EcsSignature( 0 );
-			if( &srcArchetype != &mTransitionArchetype )
+			if( !srcArchetypeIsTransitionArchetype )
 			{
 				targetSignature |= srcArchetype.GetSignature();
 			}
 			targetSignature |= transition.mSignatureAdd;
 			targetSignature &= ~transition.mSignatureRemove;
 
-			// if we didn't change anything, continue after erasing the transition
             if( ! transition.mIsDead && targetSignature == srcArchetype.GetSignature() )
             {
-                srcArchetype.GetEntityData(srcIndex).mTransitionIndex = -1;
+                srcEntityData.mTransitionIndex = -1;
                 continue;
             }
 
-            // entity is dead, no need to consider a target archetype
-			if( transition.mIsDead || targetSignature == EcsSignature( 0 ) )
-			{
-                fanAssert( !srcArchetypeIsTransitionArchetype );
+			const bool isDead = transition.mIsDead || targetSignature == EcsSignature( 0 );
+            fanAssert( !( isDead && srcArchetypeIsTransitionArchetype ) );
+			mSortedTransitions.push_back( { &srcArchetype,
+			                                srcArchetype.GetSignature(),
+			                                targetSignature,
+			                                transitionIndex,
+			                                int( transition.mEntity.mIndex ),
+			                                isDead } );
+		}
 
-				// destroy all components from the src archetype
-				if( !srcArchetypeIsTransitionArchetype )
-				{
-					for( int componentIndex = 0; componentIndex < NumComponents(); componentIndex++ )
-					{
-						if( srcArchetype.GetSignature()[componentIndex] )
-						{
-							srcArchetype.GetChunkVector(componentIndex).Remove( srcIndex );
-						}
-					}
-				}
+		// Sorts by source archetype, target signature and ascending entity index
+		// signatures are compared instead of pointers to keep the entities order deterministic
+		// transitions are often already sorted ( spawning entities, killing a whole view etc. )
+		auto compare = []( const SortedTransition& _a, const SortedTransition& _b )
+		{
+		    const unsigned long long aSrc = _a.mSrcSignature.to_ullong();
+		    const unsigned long long bSrc = _b.mSrcSignature.to_ullong();
+		    if( aSrc != bSrc ) { return aSrc < bSrc; }
+		    if( _a.mSrcArchetype != _b.mSrcArchetype )
+		    {
+		        return std::less<EcsArchetype*>()( _a.mSrcArchetype, _b.mSrcArchetype );
+		    }
+		    if( _a.mIsDead != _b.mIsDead ) { return _a.mIsDead; }
+		    const unsigned long long aTarget = _a.mTargetSignature.to_ullong();
+		    const unsigned long long bTarget = _b.mTargetSignature.to_ullong();
+		    if( aTarget != bTarget ) { return aTarget < bTarget; }
+		    return _a.mEntityIndex < _b.mEntityIndex;
+		};
+		if( !std::is_sorted( mSortedTransitions.begin(), mSortedTransitions.end(), compare ) )
+		{
+			std::sort( mSortedTransitions.begin(), mSortedTransitions.end(), compare );
+		}
 
-				// remove handle
-				if( srcEntityData.mHandle != 0 )
-				{
-					mHandles.erase( srcEntityData.mHandle );
-				}
+		// Applies structural transition to entities ( add/remove components/tags, add/remove entities )
+		const int numSorted = int( mSortedTransitions.size() );
+		for( int srcBegin = 0; srcBegin < numSorted; )
+		{
+			EcsArchetype& srcArchetype = *mSortedTransitions[srcBegin].mSrcArchetype;
+			int srcEnd = srcBegin + 1;
+			while( srcEnd < numSorted && mSortedTransitions[srcEnd].mSrcArchetype == &srcArchetype ) { srcEnd++; }
 
-				// if another entity was moved, update its handle	
-				if( !srcArchetypeIsTransitionArchetype )
-				{					
-					if( srcIndex != uint32_t(srcArchetype.Size() - 1) )
-					{						
-						EcsEntityData movedEntity = srcArchetype.GetEntityData( srcArchetype.Size() - 1 );
-						if( movedEntity.mHandle != 0 )
-						{
-                            mHandles[movedEntity.mHandle].mIndex = srcIndex;
-						}
-					}	
-					srcArchetype.RemoveEntity( srcIndex );
-				}
-				
-			}
-			else // entity is alive, we need to copy remaining components to the target archetype
+			// entities leave the source archetype before it is compacted
+			for( int groupBegin = srcBegin; groupBegin < srcEnd; )
 			{
-				// get dst archetype
-				EcsArchetype* dstArchetype = FindArchetype( targetSignature );
-				if( dstArchetype == nullptr )
-				{
-					dstArchetype = &CreateArchetype( targetSignature );
-				}
-
-				// push new entity
-				const uint32_t dstIndex = dstArchetype->Size();
-				dstArchetype->PushBackEntityData( srcArchetype.GetEntityData(srcIndex) );
-				EcsEntityData& dstEntityData = dstArchetype->GetEntityData( dstArchetype->Size() - 1 );
-				dstEntityData = srcEntityData;
-				dstEntityData.mTransitionIndex = -1;
-				if( srcEntityData.mHandle != 0 )
+				const SortedTransition& first = mSortedTransitions[groupBegin];
+				int groupEnd = groupBegin + 1;
+				while( groupEnd < srcEnd &&
+				       mSortedTransitions[groupEnd].mIsDead == first.mIsDead &&
+				       mSortedTransitions[groupEnd].mTargetSignature == first.mTargetSignature )
 				{
-                    mHandles[srcEntityData.mHandle] = { dstArchetype, dstIndex };
+					groupEnd++;
 				}
 
-				// moves components from the source archetype to the target archetype			
-				if( !srcArchetypeIsTransitionArchetype )
+				if( first.mIsDead )
 				{
-					for( int i = 0; i < NumComponents(); i++ )
-					{
-						if( srcArchetype.GetSignature()[i] )
-						{
-							if( ! transition.mSignatureRemove[i] ) // copy component to the target archetype
-							{
-								dstArchetype->GetChunkVector(i).PushBack(
-								        srcArchetype.GetChunkVector(i).At( srcIndex ) );
-							}
-							srcArchetype.GetChunkVector(i).Remove( srcIndex );							
-						}
-					}
-
-					// if another entity was moved, update its handle	
-					if( !srcArchetypeIsTransitionArchetype )
+					for( int i = groupBegin; i < groupEnd; i++ )
 					{
-						if( srcIndex != uint32_t(srcArchetype.Size() - 1) )
+						const EcsHandle handle = srcArchetype.GetEntityData( mSortedTransitions[i].mEntityIndex ).mHandle;
+						if( handle != 0 )
 						{
-							EcsEntityData movedEntity = srcArchetype.GetEntityData( srcArchetype.Size() - 1 );
-							if( movedEntity.mHandle != 0 )
-							{
-                                mHandles[movedEntity.mHandle].mIndex = srcIndex;
-							}
+							mHandles.Remove( handle );
 						}
-						srcArchetype.RemoveEntity( srcIndex );
 					}
 				}
+				else
+				{
+					MoveEntities( groupBegin, groupEnd );
+				}
+				groupBegin = groupEnd;
+			}
 
-				// moves components from the transition archetype to the target archetype
-				for( int i = 0; i < NumComponents(); i++ )
+			if( &srcArchetype != &mTransitionArchetype )
+			{
+				mRemovedIndices.clear();
+				for( int i = srcBegin; i < srcEnd; i++ )
 				{
-					if( transition.mSignatureAdd[i] )
-					{
-						dstArchetype->GetChunkVector(i).PushBack(
-                                mTransitionArchetype.GetChunkVector( i).At( transitionIndex ) );
-					}
+					mRemovedIndices.push_back( mSortedTransitions[i].mEntityIndex );
 				}
+				std::sort( mRemovedIndices.begin(), mRemovedIndices.end() );
+				RemoveEntities( srcArchetype, mRemovedIndices );
 			}
+			srcBegin = srcEnd;
 		}
-        // we must keep the transitions intact during the apply
-        fanAssert( mTransitions.size() == sortedTransitions.size() );
 
         // we must keep the transition archetype intact during the apply
-        fanAssert( mTransitionArchetype.Size() == (int)sortedTransitions.size() );
+        fanAssert( mTransitionArchetype.Size() == (int)mTransitions.size() );
 
 		mTransitions.clear();
 		mTransitionArchetype.Clear();
 	}
 
+	//========================================================================================================
+	// copies the entities of sorted transitions [_begin, _end[ to their target archetype
+	// they all have the same source archetype and target signature
+	// contiguous components are copied chunk by chunk
+	//========================================================================================================
+	void EcsWorld::MoveEntities( const int _begin, const int _end )
+	{
+		const SortedTransition& first        = mSortedTransitions[_begin];
+		EcsArchetype&           srcArchetype = *first.mSrcArchetype;
+        const bool srcArchetypeIsTransitionArchetype = ( &srcArchetype == &mTransitionArchetype );
+
+		EcsArchetype* dstArchetype = &FindOrCreateTargetArchetype( srcArchetype, first.mTargetSignature );
+		const int     dstBegin     = dstArchetype->Size();
+
+		// push new entities
+		for( int i = _begin; i < _end; i++ )
+		{
+			EcsEntityData entityData = srcArchetype.GetEntityData( mSortedTransitions[i].mEntityIndex );
+			entityData.mTransitionIndex = -1;
+			const uint32_t dstIndex = dstArchetype->Size();
+			dstArchetype->PushBackEntityData( entityData );
+			if( entityData.mHandle != 0 )
+			{
+                mHandles.Set( entityData.mHandle, { dstArchetype, dstIndex } );
+			}
+		}
+
+		// components come from the source archetype or from the transition archetype when they are added
+		for( int componentIndex = 0; componentIndex < NumComponents(); componentIndex++ )
+		{
+			if( !first.mTargetSignature[componentIndex] ) { continue; }
+
+			const bool isAdded = srcArchetypeIsTransitionArchetype || !srcArchetype.GetSignature()[componentIndex];
+			EcsChunkVector& srcChunkVector = isAdded
+			        ? mTransitionArchetype.GetChunkVector( componentIndex )
+			        : srcArchetype.GetChunkVector( componentIndex );
+			EcsChunkVector& dstChunkVector = dstArchetype->GetChunkVector( componentIndex );
+
+			auto srcIndex = [this, isAdded]( const int _sortedIndex )
+			{
+				const SortedTransition& transition = mSortedTransitions[_sortedIndex];
+				return isAdded ? transition.mTransitionIndex : transition.mEntityIndex;
+			};
+			for( int runBegin = _begin; runBegin < _end; )
+			{
+				const int runSrcIndex = srcIndex( runBegin );
+				int runEnd = runBegin + 1;
+				while( runEnd < _end && srcIndex( runEnd ) == runSrcIndex + runEnd - runBegin ) { runEnd++; }
+				dstChunkVector.PushBack( srcChunkVector, runSrcIndex, runEnd - runBegin );
+				runBegin = runEnd;
+			}
+			dstChunkVector.SetVersion( dstBegin, dstArchetype->Size(), mChangeTick.load() );
+		}
+	}
+
+	//========================================================================================================
+	// removes entities from an archetype in one pass
+	// holes are filled with the last entities of the archetype, then the archetype is shrunk
+	//========================================================================================================
+	void EcsWorld::RemoveEntities( EcsArchetype& _archetype, const std::vector<int>& _sortedIndices )
+	{
+		const int newSize     = _archetype.Size() - int( _sortedIndices.size() );
+		int       lastIndex   = _archetype.Size() - 1;
+		int       lastRemoved = int( _sortedIndices.size() ) - 1;
+		for( const int hole : _sortedIndices )
+		{
+			if( hole >= newSize ) { break; }
+
+			// skips the removed entities at the end of the archetype
+			while( lastRemoved >= 0 && _sortedIndices[lastRemoved] == lastIndex )
+			{
+				lastRemoved--;
+				lastIndex--;
+			}
+            fanAssert( lastIndex >= newSize );
+
+			for( int componentIndex = 0; componentIndex < NumComponents(); componentIndex++ )
+			{
+				if( _archetype.GetSignature()[componentIndex] )
+				{
+					EcsChunkVector& chunkVector = _archetype.GetChunkVector( componentIndex );
+					chunkVector.Move( hole, lastIndex );
+					chunkVector.SetVersion( hole, hole + 1, mChangeTick.load() );
+				}
+			}
+			const EcsEntityData& movedEntity = _archetype.GetEntityData( lastIndex );
+			_archetype.GetEntityData( hole ) = movedEntity;
+			if( movedEntity.mHandle != 0 )
+			{
+                mHandles.At( movedEntity.mHandle ).mIndex = hole;
+			}
+			lastIndex--;
+		}
+		_archetype.Shrink( newSize );
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	int  EcsWorld::GetIndex( const uint32_t  _type ) const
@@ -203,7 +256,7 @@ namespace fan
 		}
 		mTransitionArchetype.Clear();
 
-		mHandles.clear();
+		mHandles.Clear();
         mNextHandle = 1;
 
 		// clears singleton components
@@ -233,19 +286,37 @@ namespace fan
         }
     }
 
+	//========================================================================================================
+	//========================================================================================================
+	EcsEntity EcsWorld::GetEntity( const EcsHandle _handle )
+	{
+        const ParallelLock lock( *this );
+	    return mHandles.At( _handle );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	bool EcsWorld::HandleExists( const EcsHandle _handle )
+	{
+        const ParallelLock lock( *this );
+	    return mHandles.Contains( _handle );
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	EcsHandle	EcsWorld::AddHandle( const EcsEntity _entity )
 	{
+        const ParallelLock lock( *this );
 		EcsEntityData& entity = _entity.mArchetype->GetEntityData( _entity.mIndex);
         fanAssert( entity.mHandle == 0 );
 		entity.mHandle = mNextHandle++;
-        mHandles[entity.mHandle] = _entity;
+        mHandles.Set( entity.mHandle, _entity );
 		return entity.mHandle;
 	}
 
 	EcsHandle	EcsWorld::GetHandle( const EcsEntity _entity ) const
 	{
+        const ParallelLock lock( *this );
 		EcsEntityData& entity = _entity.mArchetype->GetEntityData( _entity.mIndex);
 		return entity.mHandle;
 	}
@@ -256,6 +327,7 @@ namespace fan
 	//========================================================================================================
 	void EcsWorld::SetHandle( const EcsEntity _entity, EcsHandle _handle )
 	{
+        const ParallelLock lock( *this );
         fanAssert( _handle != 0 );
         fanAssert( _handle >= mNextHandle );
 
@@ -263,18 +335,19 @@ namespace fan
         fanAssert( entity.mHandle == 0 );
 		entity.mHandle = _handle;
 
-        fanAssert( mHandles.find( entity.mHandle) == mHandles.end() );
-        mHandles[entity.mHandle] = _entity;
+        fanAssert( !mHandles.Contains( entity.mHandle ) );
+        mHandles.Set( entity.mHandle, _entity );
 	}
 
 	//========================================================================================================
 	//========================================================================================================
 	void EcsWorld::RemoveHandle( const EcsEntity _entity )
 	{
+        const ParallelLock lock( *this );
 		EcsEntityData& entity = _entity.mArchetype->GetEntityData( _entity.mIndex);
 		if( entity.mHandle != 0 )
 		{
-			mHandles.erase( entity.mHandle );
+			mHandles.Remove( entity.mHandle );
 			entity.mHandle = 0;
 		}
 	}
@@ -303,6 +376,7 @@ namespace fan
 	//========================================================================================================
 	void EcsWorld::AddTag( const EcsEntity _entity, const uint32_t _type )
 	{
+        const ParallelLock lock( *this );
 		const int tagIndex = GetIndex( _type );
         const EcsEntityData& entityData = _entity.mArchetype->GetEntityData( _entity.mIndex );
 		if( entityData.mTransitionIndex != -1 || !_entity.mArchetype->GetSignature()[tagIndex] )
@@ -317,6 +391,7 @@ namespace fan
 	//========================================================================================================
 	void EcsWorld::RemoveTag( const EcsEntity _entity, const uint32_t _type )
 	{
+        const ParallelLock lock( *this );
         const int tagIndex = GetIndex( _type );
         const EcsEntityData& entityData = _entity.mArchetype->GetEntityData( _entity.mIndex );
         if( _entity.mArchetype == &mTransitionArchetype )
@@ -346,6 +421,7 @@ namespace fan
     //========================================================================================================
     bool EcsWorld::IndexedHasTag( const EcsEntity _entity, const int _tagIndex ) const
     {
+        const ParallelLock lock( *this );
 	    fanAssert( _tagIndex < ecsSignatureLength  );
         fanAssert( _tagIndex >= GetFistTagIndex() );
         const EcsEntityData& entityData = _entity.mArchetype->GetEntityData( _entity.mIndex );
@@ -378,6 +454,7 @@ namespace fan
 	//========================================================================================================
 	void EcsWorld::AddTagsFromSignature( const EcsEntity _entity, const EcsSignature& _signature )
 	{
+        const ParallelLock lock( *this );
 		EcsTransition& transition = FindOrCreateTransition( _entity );
 		transition.mSignatureAdd |= _signature & mTagsMask;
 	}
@@ -385,7 +462,8 @@ namespace fan
 	//========================================================================================================
 	//========================================================================================================
 	EcsComponent& EcsWorld::AddComponent( const EcsEntity _entity, const uint32_t _type )
-	{		
+	{
+        const ParallelLock lock( *this );
 		if( HasComponent( _entity, _type ) )
 		{
 			return GetComponent( _entity, _type );
@@ -412,6 +490,7 @@ namespace fan
 	//========================================================================================================
 	void  EcsWorld::RemoveComponent( const EcsEntity _entity, const uint32_t _type )
 	{
+        const ParallelLock lock( *this );
 		const int componentIndex = GetIndex( _type );
 
         fanAssert( _entity.mArchetype != &mTransitionArchetype );
@@ -437,7 +516,7 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	bool EcsWorld::HasComponent( const EcsEntity _entity, const uint32_t _type )
+	bool EcsWorld::HasComponent( const EcsEntity _entity, const uint32_t _type ) const
     {
         const int componentIndex = GetIndex( _type );
         return IndexedHasComponent( _entity, componentIndex );
@@ -445,8 +524,9 @@ namespace fan
 
     //========================================================================================================
     //========================================================================================================
-    bool EcsWorld::IndexedHasComponent( const EcsEntity _entity, const int _componentindex )
+    bool EcsWorld::IndexedHasComponent( const EcsEntity _entity, const int _componentindex ) const
 	{
+        const ParallelLock lock( *this );
 		if( _entity.mArchetype == &mTransitionArchetype )
 		{
 			const EcsEntityData& entityData = _entity.mArchetype->GetEntityData( _entity.mIndex);
@@ -497,28 +577,67 @@ namespace fan
     }
 
 	//========================================================================================================
+	// the component is accessed for writing, it's marked as changed
 	//========================================================================================================
-	EcsComponent& EcsWorld::IndexedGetComponent( const EcsEntity _entity, const int _componentIndex ) {
-        fanAssert( _componentIndex < NumComponents() );
+	EcsComponent& EcsWorld::IndexedGetComponent( const EcsEntity _entity, const int _componentIndex )
+	{
+		const EcsWorld& world = *this;
+		EcsComponent& component = const_cast<EcsComponent&>( world.IndexedGetComponent( _entity, _componentIndex ) );
+		if( _entity.mArchetype != &mTransitionArchetype && _entity.mArchetype->GetSignature()[_componentIndex] )
+		{
+			_entity.mArchetype->GetChunkVector( _componentIndex ).SetVersion( _entity.mIndex,
+																			  _entity.mIndex + 1,
+																			  mChangeTick.load() );
+		}
+		return component;
+	}
+
+	//========================================================================================================
+	// read only access, the version of the component is left unchanged
+	//========================================================================================================
+	const EcsComponent& EcsWorld::GetComponent( const EcsEntity _entity, const uint32_t _type ) const
+	{
+		fanAssert( HasComponent( _entity, _type ) );
+		return IndexedGetComponent( _entity, GetIndex( _type ) );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	const EcsComponent* EcsWorld::SafeGetComponent( const EcsEntity _entity, const uint32_t _type ) const
+	{
+		const int componentIndex = GetIndex( _type );
+		if( IndexedHasComponent( _entity, componentIndex ) )
+		{
+			return &IndexedGetComponent( _entity, componentIndex );
+		}
+		return nullptr;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	const EcsComponent& EcsWorld::IndexedGetComponent( const EcsEntity _entity, const int _componentIndex ) const
+	{
+		const ParallelLock lock( *this );
+		fanAssert( _componentIndex < NumComponents() );
 		if( _entity.mArchetype == &mTransitionArchetype )
 		{
 			const EcsEntityData& entityData = _entity.mArchetype->GetEntityData( _entity.mIndex);
-            fanAssert( entityData.mTransitionIndex != -1 );
-			return *static_cast<EcsComponent*>( mTransitionArchetype.
-			    GetChunkVector( _componentIndex ).At( entityData.mTransitionIndex ) );
+			fanAssert( entityData.mTransitionIndex != -1 );
+			return *static_cast<const EcsComponent*>( mTransitionArchetype.
+				GetChunkVector( _componentIndex ).At( entityData.mTransitionIndex ) );
 		}
 		else
 		{
 			if( _entity.mArchetype->GetSignature()[_componentIndex] )
 			{
-				return *static_cast<EcsComponent*>(
-				        _entity.mArchetype->GetChunkVector( _componentIndex ).At( _entity.mIndex ) );
+				return *static_cast<const EcsComponent*>( _entity.mArchetype->
+					GetChunkVector( _componentIndex ).At( _entity.mIndex ) );
 			}
 			else
 			{
 				const EcsEntityData& entityData = _entity.mArchetype->GetEntityData( _entity.mIndex);
-				return *static_cast<EcsComponent*>( mTransitionArchetype.
-				GetChunkVector( _componentIndex ).At( entityData.mTransitionIndex ) );
+				return *static_cast<const EcsComponent*>( mTransitionArchetype.
+					GetChunkVector( _componentIndex ).At( entityData.mTransitionIndex ) );
 			}
 		}
 	}
@@ -555,6 +674,7 @@ namespace fan
 	//========================================================================================================
 	EcsEntity EcsWorld::CreateEntity()
 	{
+        const ParallelLock lock( *this );
 		EcsEntity entityID;
 		entityID.mArchetype = &mTransitionArchetype;
 		entityID.mIndex     = mTransitionArchetype.Size();
@@ -575,10 +695,64 @@ namespace fan
 		return entityID;
 	}
 
+	//========================================================================================================
+	// creates an entity with all the components of the signature at once, _handle is set before they are
+	// initialized ( 0 for no handle )
+	// outside of systems runs the entity is pushed directly in its archetype if it already exists,
+	// views iterating this archetype must not be used after the call
+	// otherwise it is created in the transition archetype and moved at once by ApplyTransitions
+	//========================================================================================================
+	EcsEntity EcsWorld::CreateEntity( const EcsSignature& _signature, const EcsHandle _handle )
+	{
+        const ParallelLock lock( *this );
+		const bool    isRunning = mIsParallel || mNumSystemRuns.load() > 0;
+		EcsArchetype* archetype = isRunning ? nullptr : FindArchetype( _signature );
+
+		EcsEntity entity;
+		int       componentsIndex;
+		if( archetype != nullptr )
+		{
+			entity.mArchetype = archetype;
+			entity.mIndex     = archetype->Size();
+			archetype->PushBackEntityData( {} );
+			componentsIndex = int( entity.mIndex );
+		}
+		else
+		{
+			entity = CreateEntity();
+			mTransitions.rbegin()->mSignatureAdd = _signature;
+			archetype       = &mTransitionArchetype;
+			componentsIndex = GetEntityData( entity ).mTransitionIndex;
+		}
+
+		if( _handle != 0 )
+		{
+			SetHandle( entity, _handle );
+		}
+
+		for( int componentIndex = 0; componentIndex < NumComponents(); componentIndex++ )
+		{
+			if( !_signature[componentIndex] ) { continue; }
+
+			EcsChunkVector& chunkVector = archetype->GetChunkVector( componentIndex );
+			if( archetype != &mTransitionArchetype )
+			{
+				chunkVector.EmplaceBack();
+				chunkVector.SetVersion( componentsIndex, componentsIndex + 1, mChangeTick.load() );
+			}
+			EcsComponent& component = *static_cast<EcsComponent*>( chunkVector.At( componentsIndex ) );
+			const EcsComponentInfo& info = mComponentsInfo[componentIndex];
+			info.construct( &component );
+			info.init( *this, entity, component );
+		}
+		return entity;
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void EcsWorld::Kill( const EcsEntity _entity )
 	{
+        const ParallelLock lock( *this );
 		EcsTransition& transition = FindOrCreateTransition( _entity );
 
 		// do not delete twice
@@ -601,28 +775,74 @@ namespace fan
 					}
 				}
 			}
+
+			// components added this frame are still stored in the transition archetype
+			const EcsEntityData& entityData = GetEntityData( _entity );
+			for( int i = 0; i < NumComponents(); i++ )
+			{
+				const EcsComponentInfo& info = mComponentsInfo[i];
+				if( transition.mSignatureAdd[i] && info.destroy != nullptr )
+				{
+					EcsComponent& component = *static_cast<EcsComponent*>(
+					        mTransitionArchetype.GetChunkVector( i ).At( entityData.mTransitionIndex ) );
+					mDestroyedComponents.push_back( { _entity, component, info.destroy } );
+				}
+			}
 		}
 	}
 
     //========================================================================================================
+    // Matching archetypes are cached per signature and updated when a new archetype is created,
+    // the archetypes list is only built the first time a signature is matched
+    // the view references the cached list, so it must not outlive the next ApplyTransitions
     //========================================================================================================
     EcsView EcsWorld::Match( const EcsSignature& _signature ) const
     {
-        EcsView view( mTypeToIndex, _signature );
-        for( auto it = mArchetypes.begin(); it != mArchetypes.end(); ++it )
+        const ParallelLock lock( *this );
+        auto it = mQueryCache.find( _signature );
+        if( it == mQueryCache.end() )
         {
-            if( ( it->first & _signature ) == _signature && !it->second->Empty() )
+            std::vector< EcsArchetype* >& archetypes = mQueryCache[_signature];
+            for( auto archetypeIt = mArchetypes.begin(); archetypeIt != mArchetypes.end(); ++archetypeIt )
             {
-                view.mArchetypes.push_back( it->second );
+                if( ( archetypeIt->first & _signature ) == _signature )
+                {
+                    archetypes.push_back( archetypeIt->second );
+                }
             }
+            return EcsView( mTypeToIndex, _signature, archetypes, mChangeTick.load() );
         }
-        return view;
+        return EcsView( mTypeToIndex, _signature, it->second, mChangeTick.load() );
+    }
+
+    //========================================================================================================
+    // each system run gets its own change tick, the tick is incremented again after the run
+    // so that writes made between systems runs are seen as changes by the system that just ran
+    //========================================================================================================
+    void EcsWorld::BeginSystemRun( const void* _systemKey, EcsView& _view )
+    {
+        _view.mChangeTick = ++mChangeTick;
+        mNumSystemRuns++;
+
+        const ParallelLock lock( *this );
+        EcsTick& lastRunTick = mLastRunTicks[_systemKey];
+        _view.mLastRunTick = lastRunTick;
+        lastRunTick        = _view.mChangeTick;
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void EcsWorld::EndSystemRun()
+    {
+        mNumSystemRuns--;
+        ++mChangeTick;
     }
 
 	//========================================================================================================
 	//========================================================================================================
 	bool EcsWorld::IsAlive( const EcsEntity _entity ) const
 	{
+        const ParallelLock lock( *this );
 		const EcsEntityData& entityData = GetEntityData( _entity );
 		return entityData.mTransitionIndex < 0 || !mTransitions[entityData.mTransitionIndex].mIsDead;
 	}
@@ -643,9 +863,59 @@ namespace fan
 		EcsArchetype* newArchetype = new EcsArchetype();
 		newArchetype->Create( mComponentsInfo, _signature );
 		mArchetypes[_signature] = newArchetype;
+
+		// registers the new archetype in the cached queries it matches
+		for( auto it = mQueryCache.begin(); it != mQueryCache.end(); ++it )
+		{
+			if( ( _signature & it->first ) == it->first )
+			{
+				it->second.push_back( newArchetype );
+			}
+		}
 		return *newArchetype;
 	}
 	
+	//========================================================================================================
+	// adding or removing a single component/tag follows the edges of the source archetype
+	// edges are created in both directions the first time the target archetype is found
+	//========================================================================================================
+	EcsArchetype& EcsWorld::FindOrCreateTargetArchetype( EcsArchetype& _srcArchetype,
+	                                                     const EcsSignature _targetSignature )
+	{
+		const EcsSignature difference = _srcArchetype.GetSignature() ^ _targetSignature;
+		if( &_srcArchetype == &mTransitionArchetype || difference.count() != 1 )
+		{
+			EcsArchetype* archetype = FindArchetype( _targetSignature );
+			return archetype != nullptr ? *archetype : CreateArchetype( _targetSignature );
+		}
+
+		int index = 0;
+		while( !difference[index] ) { index++; }
+		const bool isAdd = _targetSignature[index];
+
+		EcsArchetype* archetype = isAdd ? _srcArchetype.GetAddEdge( index ) : _srcArchetype.GetRemoveEdge( index );
+		if( archetype == nullptr )
+		{
+			archetype = FindArchetype( _targetSignature );
+			if( archetype == nullptr )
+			{
+				archetype = &CreateArchetype( _targetSignature );
+			}
+			if( isAdd )
+			{
+				_srcArchetype.SetAddEdge( index, archetype );
+				archetype->SetRemoveEdge( index, &_srcArchetype );
+			}
+			else
+			{
+				_srcArchetype.SetRemoveEdge( index, archetype );
+				archetype->SetAddEdge( index, &_srcArchetype );
+			}
+		}
+        fanAssert( archetype->GetSignature() == _targetSignature );
+		return *archetype;
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	EcsTransition& EcsWorld::FindOrCreateTransition( const EcsEntity _entity )
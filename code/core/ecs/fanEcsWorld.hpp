@@ -1,9 +1,12 @@
 #pragma once
 
+#include <mutex>
+#include <atomic>
 #include <unordered_map>
 #include "core/fanHash.hpp"
 #include "core/fanAssert.hpp"
 #include "core/ecs/fanEcsEntity.hpp"
+#include "core/ecs/fanEcsHandleTable.hpp"
 #include "core/ecs/fanEcsComponent.hpp"
 #include "core/ecs/fanEcsSingleton.hpp"
 #include "core/ecs/fanEcsTag.hpp"
@@ -59,14 +62,14 @@ namespace fan
 		void ReloadInfos();
 
 		// Handles
-		EcsEntity	GetEntity		( const EcsHandle _handle ){ return mHandles.at( _handle ); }
+		EcsEntity	GetEntity		( const EcsHandle _handle );
 		EcsHandle	AddHandle		( const EcsEntity _entity );
 		void		SetHandle		( const EcsEntity _entity, EcsHandle _handle );
 		EcsHandle	GetHandle		( const EcsEntity _entity ) const;
 		void		RemoveHandle	( const EcsEntity _entity );
 		EcsHandle	GetNextHandle() const { return mNextHandle; }
 		void		SetNextHandle( const EcsHandle  _handle ) { mNextHandle = _handle; }
-        bool        HandleExists( const EcsHandle _handle ) { return mHandles.find( _handle ) != mHandles.end(); }
+        bool        HandleExists( const EcsHandle _handle );
 
 		// Singletons
 		template <typename _SingletonType >	void		AddSingletonType();
@@ -96,16 +99,21 @@ namespace fan
 		template <typename _ComponentType >	void			AddComponentType	();
 		template <typename _ComponentType > _ComponentType&    AddComponent		( const EcsEntity _entity );
 		template <typename _ComponentType > void			    RemoveComponent		( const EcsEntity _entity );
-		template <typename _ComponentType > bool			    HasComponent		( const EcsEntity _entity );
+		template <typename _ComponentType > bool			    HasComponent		( const EcsEntity _entity ) const;
 		template< typename _ComponentType >	_ComponentType& GetComponent		( const EcsEntity _entity );
         template< typename _ComponentType >	_ComponentType* SafeGetComponent	( const EcsEntity _entity );
+		template< typename _ComponentType >	const _ComponentType& GetComponent		( const EcsEntity _entity ) const;
+        template< typename _ComponentType >	const _ComponentType* SafeGetComponent	( const EcsEntity _entity ) const;
 		EcsComponent&			AddComponent		( const EcsEntity _entity, const uint32_t _type );
 		void					RemoveComponent		( const EcsEntity _entity, const uint32_t _type );
-		bool					HasComponent		( const EcsEntity _entity, const uint32_t _type );
-        bool					IndexedHasComponent	( const EcsEntity _entity, const int _componentindex );
+		bool					HasComponent		( const EcsEntity _entity, const uint32_t _type ) const;
+        bool					IndexedHasComponent	( const EcsEntity _entity, const int _componentindex ) const;
 		EcsComponent&			GetComponent		( const EcsEntity _entity, const uint32_t _type );
         EcsComponent*			SafeGetComponent	( const EcsEntity _entity, const uint32_t _type );
 		EcsComponent&			IndexedGetComponent ( const EcsEntity _entity, const int _componentIndex );
+		const EcsComponent&		GetComponent		( const EcsEntity _entity, const uint32_t _type ) const;
+        const EcsComponent*		SafeGetComponent	( const EcsEntity _entity, const uint32_t _type ) const;
+		const EcsComponent&		IndexedGetComponent ( const EcsEntity _entity, const int _componentIndex ) const;
 		const EcsComponentInfo&	IndexedGetComponentInfo( const int _componentIndex ) const;
 		const EcsComponentInfo&	GetComponentInfo( const uint32_t _type ) const;
         const EcsComponentInfo*	SafeGetComponentInfo( const uint32_t _type ) const;
@@ -113,6 +121,7 @@ namespace fan
 
 		// Entities
 		EcsEntity	CreateEntity();
+		EcsEntity	CreateEntity( const EcsSignature& _signature, const EcsHandle _handle = 0 );
 		void		Kill	( const EcsEntity _entity );
 		bool		IsAlive	( const EcsEntity _entity ) const;
 
@@ -121,13 +130,33 @@ namespace fan
         template< typename _SystemType, typename... _Args > void ForceRun( _Args&&... _args );
 		template< typename _SystemType > EcsView Match() const;
         EcsView Match( const EcsSignature& _signature ) const;
+        EcsTick GetChangeTick() const { return mChangeTick.load(); }
 
 		// Const accessors
-        const std::unordered_map<EcsHandle, EcsEntity>& GetHandles() const { return mHandles; }
+        const EcsHandleTable& GetHandles() const { return mHandles; }
         const std::unordered_map<EcsSignature, EcsArchetype*>& GetArchetypes() const { return mArchetypes; }
         const EcsArchetype& GetTransitionArchetype() const { return mTransitionArchetype; }
 
     private:
+        friend class EcsScheduler;
+
+        //================================================================
+        // locks structural changes & transitions accesses while systems run in parallel
+        //================================================================
+        struct ParallelLock
+        {
+            ParallelLock( const EcsWorld& _world ) :
+                    mMutex( _world.mIsParallel ? &_world.mParallelMutex : nullptr )
+            {
+                if( mMutex != nullptr ) { mMutex->lock(); }
+            }
+            ~ParallelLock()
+            {
+                if( mMutex != nullptr ) { mMutex->unlock(); }
+            }
+            std::recursive_mutex* mMutex;
+        };
+
         const EcsEntityData&  GetEntityData( const EcsEntity _entity ) const
         {
             return _entity.mArchetype->GetEntityData( _entity.mIndex );
@@ -138,8 +167,30 @@ namespace fan
         }
 		EcsArchetype*		FindArchetype( const EcsSignature _signature );
 		EcsArchetype&		CreateArchetype( const EcsSignature _signature );
+		EcsArchetype&		FindOrCreateTargetArchetype( EcsArchetype& _srcArchetype, const EcsSignature _targetSignature );
 		EcsTransition&		FindOrCreateTransition( const EcsEntity _entity );
-		
+		void				MoveEntities( const int _begin, const int _end );
+		void				RemoveEntities( EcsArchetype& _archetype, const std::vector<int>& _sortedIndices );
+		void				BeginSystemRun( const void* _systemKey, EcsView& _view );
+		void				EndSystemRun();
+
+        // the address of sKey identifies a system type
+        template< typename _SystemType > struct SystemKey { static constexpr char sKey = 0; };
+
+        //================================================================
+        // transitions are sorted by source archetype & target signature to be applied in batches
+        //================================================================
+        struct SortedTransition
+        {
+            EcsArchetype* mSrcArchetype;
+            EcsSignature  mSrcSignature;// signature of the transition archetype is empty
+            EcsSignature  mTargetSignature;
+            int           mTransitionIndex;
+            int           mEntityIndex;
+            bool          mIsDead;
+        };
+
+        using QueryCache = std::unordered_map< EcsSignature, std::vector< EcsArchetype* > >;
 
 		EcsHandle                                         mNextHandle   = 1;	// 0 is a null handle
 		int                                               mNextTagIndex = ecsSignatureLength - 1;
@@ -147,13 +198,21 @@ namespace fan
 		EcsArchetype                                      mTransitionArchetype;
 		std::unordered_map< EcsSignature, EcsArchetype* > mArchetypes;
 		std::unordered_map<uint32_t, int >                mTypeToIndex;
-		std::unordered_map< EcsHandle, EcsEntity >        mHandles;
+		EcsHandleTable                                    mHandles;
 		std::unordered_map< uint32_t, EcsSingleton* >     mSingletons;
 		std::unordered_map< uint32_t, EcsSingletonInfo >  mSingletonInfos;
 		std::vector< EcsComponentInfo >                   mComponentsInfo;
         std::vector< EcsTagInfo >                         mTagsInfo;
 		std::vector< EcsTransition >                      mTransitions;
 		std::vector< DestroyedComponent >                 mDestroyedComponents;
+        std::vector< SortedTransition >                   mSortedTransitions;// reused by ApplyTransitions
+        std::vector< int >                                mRemovedIndices;   // reused by ApplyTransitions
+        mutable QueryCache                                mQueryCache;// archetypes matching a signature
+        mutable std::recursive_mutex                      mParallelMutex;
+        bool                                              mIsParallel = false;// set by the EcsScheduler
+        std::atomic<EcsTick>                              mChangeTick{ 1 };	// incremented before & after each system run
+        std::atomic<int>                                  mNumSystemRuns{ 0 };// systems currently running
+        std::unordered_map< const void*, EcsTick >        mLastRunTicks;	// change tick of the last run of each system
 	};
 
 	//========================================================================================================
@@ -275,18 +334,27 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	template <typename _ComponentType > bool EcsWorld::HasComponent( const EcsEntity _entity )
+	template <typename _ComponentType > bool EcsWorld::HasComponent( const EcsEntity _entity ) const
 	{
 		static_assert( std::is_base_of< EcsComponent, _ComponentType>::value );
 		return HasComponent( _entity, _ComponentType::Info::sType );
 	}
 
 	//========================================================================================================
+	// non const access marks the component as changed, use GetComponent<const T> for read only access
 	//========================================================================================================
 	template< typename _ComponentType >	_ComponentType& EcsWorld::GetComponent( const EcsEntity _entity )
 	{
 		static_assert( std::is_base_of< EcsComponent, _ComponentType>::value );
-		return static_cast<_ComponentType&> ( GetComponent( _entity, _ComponentType::Info::sType ) );
+		if constexpr( std::is_const<_ComponentType>::value )
+		{
+			const EcsWorld& world = *this;
+			return world.GetComponent<std::remove_const_t<_ComponentType>>( _entity );
+		}
+		else
+		{
+			return static_cast<_ComponentType&> ( GetComponent( _entity, _ComponentType::Info::sType ) );
+		}
 	}
 
     //========================================================================================================
@@ -294,7 +362,33 @@ namespace fan
     template< typename _ComponentType >	_ComponentType* EcsWorld::SafeGetComponent( const EcsEntity _entity )
     {
         static_assert( std::is_base_of< EcsComponent, _ComponentType>::value );
-        return static_cast<_ComponentType*> ( SafeGetComponent( _entity, _ComponentType::Info::sType ) );
+        if constexpr( std::is_const<_ComponentType>::value )
+        {
+            const EcsWorld& world = *this;
+            return world.SafeGetComponent<std::remove_const_t<_ComponentType>>( _entity );
+        }
+        else
+        {
+            return static_cast<_ComponentType*> ( SafeGetComponent( _entity, _ComponentType::Info::sType ) );
+        }
+    }
+
+	//========================================================================================================
+	//========================================================================================================
+	template< typename _ComponentType >
+	const _ComponentType& EcsWorld::GetComponent( const EcsEntity _entity ) const
+	{
+		static_assert( std::is_base_of< EcsComponent, _ComponentType>::value );
+		return static_cast<const _ComponentType&> ( GetComponent( _entity, _ComponentType::Info::sType ) );
+	}
+
+    //========================================================================================================
+    //========================================================================================================
+    template< typename _ComponentType >
+    const _ComponentType* EcsWorld::SafeGetComponent( const EcsEntity _entity ) const
+    {
+        static_assert( std::is_base_of< EcsComponent, _ComponentType>::value );
+        return static_cast<const _ComponentType*> ( SafeGetComponent( _entity, _ComponentType::Info::sType ) );
     }
 
 	//========================================================================================================
@@ -305,7 +399,9 @@ namespace fan
 		EcsView view = Match<_SystemType>();
 		if( ! view.Empty() )
 		{
+		    BeginSystemRun( &SystemKey<_SystemType>::sKey, view );
 		    _SystemType::Run( *this, view, _args... );
+		    EndSystemRun();
 		}
 	}
 
@@ -316,7 +412,9 @@ namespace fan
     {
         static_assert( std::is_base_of< EcsSystem, _SystemType >::value );
         EcsView view = Match<_SystemType>();
+        BeginSystemRun( &SystemKey<_SystemType>::sKey, view );
         _SystemType::Run( *this, view, _args... );
+        EndSystemRun();
     }
 
 	//========================================================================================================
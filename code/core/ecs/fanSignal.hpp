@@ -3,6 +3,9 @@
 #include <vector>
 #include <iostream>
 #include <functional>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 #include "core/fanAssert.hpp"
 #include "core/ecs/fanEcsWorld.hpp"
 #include "core/ecs/fanSlot.hpp"
@@ -13,19 +16,45 @@ namespace fan
     class EcsWorld;
 
     //========================================================================================================
-    // A signal is used for communication between objects ( ~similar to qt Signals & Slots )
+    // Type erased call to a method of an object, a component or a slot
+    // the target ( method pointer + object pointer or world + handle ) is stored inline
+    // delegates are trivially copyable, copying or calling one never allocates
     //========================================================================================================
-    template< typename ...Args > struct Signal
+    template< typename ...Args > struct Delegate
     {
-        //================================================================
-        //================================================================
-        struct Connection
+        static constexpr size_t sStorageSize = 4 * sizeof( void* );
+        using Invoke = void ( * )( const Delegate&, Args... );
+
+        template< typename _Target >
+        void Store( const _Target& _target )
         {
-            using Lambda = std::function<void( Args... )>;
+            static_assert( sizeof( _Target ) <= sStorageSize, "delegate target too big" );
+            static_assert( std::is_trivially_copyable<_Target>::value );
+            std::memcpy( mStorage, &_target, sizeof( _Target ) );
+        }
+        template< typename _Target >
+        _Target Load() const
+        {
+            _Target target;
+            std::memcpy( &target, mStorage, sizeof( _Target ) );
+            return target;
+        }
+        void operator()( Args... _args ) const { ( *mInvoke )( *this, _args... ); }
 
-            Lambda mLambda;
-            size_t mID;
-        };
+        alignas( void* ) uint8_t mStorage[sStorageSize];
+        Invoke                   mInvoke = nullptr;
+        size_t                   mID     = 0;
+    };
+
+    //========================================================================================================
+    // A signal is used for communication between objects ( ~similar to qt Signals & Slots )
+    // the first sInlineConnections connections are stored inline, signals are copied with the packets
+    // & components that own them and most have one or two connections
+    //========================================================================================================
+    template< typename ...Args > struct Signal
+    {
+        using Connection = Delegate<Args...>;
+        static constexpr int sInlineConnections = 2;
 
         template< typename _Object >
         void Connect( void( _Object::* _method )( Args... ), _Object* _object );
@@ -39,12 +68,22 @@ namespace fan
 
         void Emmit( Args... _args );
         void Clear();
-        int ConnectionsCount() const { return (int)mConnections.size(); }
+        int ConnectionsCount() const { return mNumConnections; }
         void Disconnect( const size_t _ID );
         int GetType() const{ return TemplateType::Type<Args...>(); }
 
     private:
-        std::vector<Connection> mConnections;
+        Connection& GetConnection( const int _index )
+        {
+            return _index < sInlineConnections ? mInlineConnections[_index]
+                                               : mOverflowConnections[_index - sInlineConnections];
+        }
+        void AddConnection( const Connection& _connection );
+        void Resize( const int _numConnections );
+
+        Connection              mInlineConnections[sInlineConnections];
+        std::vector<Connection> mOverflowConnections;
+        int                     mNumConnections = 0;
     };
 
     //========================================================================================================
@@ -55,13 +94,21 @@ namespace fan
     {
         static_assert( !std::is_base_of<EcsComponent, _Object>::value );
 
+        struct Target
+        {
+            void ( _Object::* mMethod )( Args... );
+            _Object* mObject;
+        };
+
         Connection connection;
         connection.mID     = size_t( _object );
-        connection.mLambda = [_method, _object]( Args... _args )
+        connection.Store( Target{ _method, _object } );
+        connection.mInvoke = []( const Connection& _connection, Args... _args )
         {
-            ( ( *_object ).*( _method ) )( _args... );
+            const Target target = _connection.template Load<Target>();
+            ( ( *target.mObject ).*( target.mMethod ) )( _args... );
         };
-        mConnections.push_back( connection );
+        AddConnection( connection );
     }
 
     //========================================================================================================
@@ -75,14 +122,24 @@ namespace fan
         static_assert( std::is_base_of<EcsComponent, _ComponentType>::value );
         fanAssert( _handle != 0 );
 
+        struct Target
+        {
+            void ( _ComponentType::* mMethod )( Args... );
+            EcsWorld* mWorld;
+            EcsHandle mHandle;
+        };
+
         Connection connection;
         connection.mID     = _handle;
-        connection.mLambda = [_method, &_world, _handle]( Args... _args )
+        connection.Store( Target{ _method, &_world, _handle } );
+        connection.mInvoke = []( const Connection& _connection, Args... _args )
         {
-            _ComponentType& component = _world.GetComponent<_ComponentType>( _world.GetEntity( _handle ) );
-            ( ( component ).*( _method ) )( _args... );
+            const Target target = _connection.template Load<Target>();
+            EcsWorld& world = *target.mWorld;
+            _ComponentType& component = world.GetComponent<_ComponentType>( world.GetEntity( target.mHandle ) );
+            ( ( component ).*( target.mMethod ) )( _args... );
         };
-        mConnections.push_back( connection );
+        AddConnection( connection );
     }
     //========================================================================================================
     //========================================================================================================
@@ -91,12 +148,22 @@ namespace fan
     {
         if( _slotPtr.GetArgsType() != GetType()) { return false; }
 
+        struct Target
+        {
+            EcsWorld*                   mWorld;
+            const SlotPtr::SlotCallData* mCallData;
+        };
+
         const SlotPtr::SlotCallData * _callData = &_slotPtr.Data();
 
         Connection connection;
         connection.mID      = (size_t)_callData;
-        connection.mLambda  = [ &_world, _callData ]( Args... _args )
+        connection.Store( Target{ &_world, _callData } );
+        connection.mInvoke  = []( const Connection& _connection, Args... _args )
         {
+            const Target target = _connection.template Load<Target>();
+            const SlotPtr::SlotCallData* _callData = target.mCallData;
+            EcsWorld& _world = *target.mWorld;
             if( _callData->mSlot == nullptr ){ return; }
 
             Slot<Args...>* slot = static_cast< Slot<Args...>* >(_callData->mSlot);
@@ -120,18 +187,21 @@ namespace fan
             }
         };
 
-        mConnections.push_back( connection );
+        AddConnection( connection );
         return true;
     }
 
     //========================================================================================================
+    // connections are copied before being called, they can connect or disconnect the signal
+    // a connection disconnected during the emission shifts the next ones, one of them is skipped until the next
     //========================================================================================================
     template< typename... Args >
     void Signal<Args...>::Emmit( Args... _args )
     {
-        for( Connection connection : mConnections )
+        for( int i = 0; i < mNumConnections; i++ )
         {
-            connection.mLambda( _args... );
+            const Connection connection = GetConnection( i );
+            connection( _args... );
         }
     }
 
@@ -140,7 +210,7 @@ namespace fan
     template< typename... Args >
     void Signal<Args...>::Clear()
     {
-        mConnections.clear();
+        Resize( 0 );
     }
 
     //========================================================================================================
@@ -148,12 +218,42 @@ namespace fan
     template< typename... Args >
     void Signal<Args...>::Disconnect( const size_t _ID )
     {
-        for( int i = (int)mConnections.size() - 1; i >= 0; i-- )
+        int numKept = 0;
+        for( int i = 0; i < mNumConnections; i++ )
         {
-            if( mConnections[i].mID == _ID )
+            const Connection connection = GetConnection( i );
+            if( connection.mID != _ID )
             {
-                mConnections.erase( mConnections.begin() + i );
+                GetConnection( numKept++ ) = connection;
             }
         }
+        Resize( numKept );
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    template< typename... Args >
+    void Signal<Args...>::AddConnection( const Connection& _connection )
+    {
+        if( mNumConnections < sInlineConnections )
+        {
+            mInlineConnections[mNumConnections] = _connection;
+        }
+        else
+        {
+            mOverflowConnections.push_back( _connection );
+        }
+        mNumConnections++;
+    }
+
+    //========================================================================================================
+    // the overflow capacity is kept
+    //========================================================================================================
+    template< typename... Args >
+    void Signal<Args...>::Resize( const int _numConnections )
+    {
+        fanAssert( _numConnections <= mNumConnections );
+        mNumConnections = _numConnections;
+        mOverflowConnections.resize( std::max( 0, _numConnections - sInlineConnections ) );
     }
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "core/fanDebug.hpp"
 
 #include <iostream>
-#include "glfw/glfw3.h"
+#include "core/time/fanClock.hpp"
 
 namespace fan
 {
@@ -22,7 +22,7 @@ namespace fan
 		item.message = mStringstream.str();
 		item.severity = mCurrentSeverity;
 		item.type = mCurrentType;
-		item.time = glfwGetTime();
+		item.time = Clock::SecondsSinceStartup();
 		mLogBuffer.push_back( item );
 
 		// stdio
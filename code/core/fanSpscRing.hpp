@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+namespace fan
+{
+	//========================================================================================================
+	// Lock-free ring buffer with a single producer thread & a single consumer thread
+	// items are written & read in place : BeginPush/EndPush on the producer side, Front/Pop on the consumer side
+	// the capacity must be a power of two, the items are allocated once at construction
+	//========================================================================================================
+	template< typename T, size_t _capacity >
+	class SpscRing
+	{
+	public:
+		static_assert( _capacity > 0 && ( _capacity & ( _capacity - 1 ) ) == 0, "capacity must be a power of two" );
+		static constexpr size_t sCapacity = _capacity;
+
+		SpscRing() : mItems( _capacity ), mHead( 0 ), mTail( 0 ) {}
+		SpscRing( SpscRing const& ) = delete;
+		SpscRing& operator=( SpscRing const& ) = delete;
+
+		//================================================================
+		// producer, returns nullptr when the ring is full
+		// _offset reserves the slot of the next items to push them in a batch
+		//================================================================
+		T* BeginPush( const size_t _offset = 0 )
+		{
+			const size_t tail = mTail.load( std::memory_order_relaxed ) + _offset;
+			if( tail - mHead.load( std::memory_order_acquire ) >= _capacity ) { return nullptr; }
+			return &mItems[tail & ( _capacity - 1 )];
+		}
+		void EndPush( const size_t _count = 1 )
+		{
+			mTail.store( mTail.load( std::memory_order_relaxed ) + _count, std::memory_order_release );
+		}
+		bool Push( const T& _item )
+		{
+			T* item = BeginPush();
+			if( item == nullptr ) { return false; }
+			*item = _item;
+			EndPush();
+			return true;
+		}
+
+		//================================================================
+		// consumer, returns nullptr when the ring is empty
+		// _offset peeks the next items to pop them in a batch
+		//================================================================
+		T* Front( const size_t _offset = 0 )
+		{
+			const size_t head = mHead.load( std::memory_order_relaxed ) + _offset;
+			if( head >= mTail.load( std::memory_order_acquire ) ) { return nullptr; }
+			return &mItems[head & ( _capacity - 1 )];
+		}
+		void Pop( const size_t _count = 1 )
+		{
+			mHead.store( mHead.load( std::memory_order_relaxed ) + _count, std::memory_order_release );
+		}
+
+		size_t Size() const  { return mTail.load( std::memory_order_acquire ) - mHead.load( std::memory_order_acquire ); }
+		bool   Empty() const { return Size() == 0; }
+
+	private:
+		std::vector<T>                  mItems;
+		alignas( 64 ) std::atomic<size_t> mHead;	// next item to read, written by the consumer
+		alignas( 64 ) std::atomic<size_t> mTail;	// next item to write, written by the producer
+	};
+}
@@ -0,0 +1,120 @@
+#include "core/fanThreadPool.hpp"
+#include <algorithm>
+
+namespace fan
+{
+	//========================================================================================================
+	//========================================================================================================
+	ThreadPool::ThreadPool( const int _numWorkers ) : mNextJob( 0 ), mNumJobsDone( 0 )
+	{
+		int numWorkers = _numWorkers;
+		if( numWorkers < 0 )
+		{
+			numWorkers = std::max( 0, int( std::thread::hardware_concurrency() ) - 1 );
+		}
+
+		mWorkers.reserve( numWorkers );
+		for( int i = 0; i < numWorkers; i++ )
+		{
+			mWorkers.emplace_back( &ThreadPool::WorkerLoop, this );
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock( mMutex );
+			mExit = true;
+		}
+		mWakeCondition.notify_all();
+		for( std::thread& worker : mWorkers )
+		{
+			worker.join();
+		}
+	}
+
+	//========================================================================================================
+	// returns when all jobs are done and no worker references _jobs anymore
+	// when the pool is busy ( ex: a ParallelForEach inside a scheduled system, or a Run() from another thread )
+	// jobs run serially on the calling thread, this is counted in mNumInlineRuns
+	//========================================================================================================
+	void ThreadPool::Run( const std::vector<Job>& _jobs )
+	{
+		if( _jobs.empty() ) { return; }
+
+		if( mWorkers.empty() || _jobs.size() == 1 )
+		{
+			for( const Job& job : _jobs ) { job(); }
+			return;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock( mMutex );
+			if( mJobs != nullptr )
+			{
+				lock.unlock();
+				mNumInlineRuns.fetch_add( 1, std::memory_order_relaxed );
+				for( const Job& job : _jobs ) { job(); }
+				return;
+			}
+			mJobs = &_jobs;
+			mNextJob.store( 0 );
+			mNumJobsDone.store( 0 );
+			mGeneration++;
+		}
+		mWakeCondition.notify_all();
+
+		ExecuteJobs( _jobs );
+
+		std::unique_lock<std::mutex> lock( mMutex );
+		mDoneCondition.wait( lock, [this, &_jobs]()
+		{
+			return mNumJobsDone.load() == int( _jobs.size() ) && mActiveWorkers == 0;
+		} );
+		mJobs = nullptr;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void ThreadPool::ExecuteJobs( const std::vector<Job>& _jobs )
+	{
+		const int numJobs = int( _jobs.size() );
+		for( int jobIndex = mNextJob++; jobIndex < numJobs; jobIndex = mNextJob++ )
+		{
+			_jobs[jobIndex]();
+			mNumJobsDone++;
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void ThreadPool::WorkerLoop()
+	{
+		uint64_t lastGeneration = 0;
+		for( ;; )
+		{
+			const std::vector<Job>* jobs = nullptr;
+			{
+				std::unique_lock<std::mutex> lock( mMutex );
+				mWakeCondition.wait( lock, [this, lastGeneration]()
+				{
+					return mExit || ( mJobs != nullptr && mGeneration != lastGeneration );
+				} );
+				if( mExit ) { return; }
+				lastGeneration = mGeneration;
+				jobs = mJobs;
+				mActiveWorkers++;
+			}
+
+			ExecuteJobs( *jobs );
+
+			{
+				std::lock_guard<std::mutex> lock( mMutex );
+				mActiveWorkers--;
+			}
+			mDoneCondition.notify_one();
+		}
+	}
+}
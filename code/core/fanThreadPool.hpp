@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include "core/fanSingleton.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// Pool of worker threads sleeping until jobs are submitted
+	// Run() blocks until all jobs are done, the calling thread executes jobs too
+	// ThreadPool::Get() is shared by all the worlds of the process
+	// the pool runs one batch at a time : a Run() called while another one is active ( from a job or from
+	// another thread ) executes its jobs serially on the calling thread, NumInlineRuns() counts these fallbacks
+	//========================================================================================================
+	class ThreadPool : public Singleton<ThreadPool>
+	{
+	public:
+		using Job = std::function<void()>;
+
+		ThreadPool( const int _numWorkers = -1 );// -1 uses one worker per hardware thread minus the caller
+		~ThreadPool();
+		ThreadPool( ThreadPool const& ) = delete;
+		ThreadPool& operator=( ThreadPool const& ) = delete;
+
+		void Run( const std::vector<Job>& _jobs );
+		int  NumWorkers() const { return int( mWorkers.size() ); }
+		int  NumThreads() const { return NumWorkers() + 1; }
+		uint64_t NumInlineRuns() const { return mNumInlineRuns.load( std::memory_order_relaxed ); }
+
+	private:
+		void WorkerLoop();
+		void ExecuteJobs( const std::vector<Job>& _jobs );
+
+		std::vector<std::thread> mWorkers;
+		std::mutex               mMutex;
+		std::condition_variable  mWakeCondition;
+		std::condition_variable  mDoneCondition;
+		const std::vector<Job>*  mJobs          = nullptr;
+		uint64_t                 mGeneration    = 0;	// incremented for each Run()
+		int                      mActiveWorkers = 0;	// workers currently executing jobs of the generation
+		bool                     mExit          = false;
+		std::atomic<int>         mNextJob;
+		std::atomic<int>         mNumJobsDone;
+		std::atomic<uint64_t>    mNumInlineRuns { 0 };	// Run() serialized because the pool was busy
+	};
+}
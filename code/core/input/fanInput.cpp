@@ -1,6 +1,7 @@
 #include "core/input/fanInput.hpp"
 #include "core/input/fanKeyboard.hpp"
 #include "core/input/fanInputManager.hpp"
+#include "core/memory/fanSerializedValues.hpp"
 
 namespace fan
 {
@@ -33,4 +34,19 @@ namespace fan
 		++Get().mCount;
 		glfwPollEvents();
 	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void Input::LoadKeyBindings()
+	{
+		mInputManager->Load( SerializedValues::Get().GetKeyBindings() );
+	}
+
+	//========================================================================================================
+	// key bindings are written to disk with the other values by SerializedValues::SaveValuesToDisk
+	//========================================================================================================
+	void Input::SaveKeyBindings()
+	{
+		mInputManager->Save( SerializedValues::Get().GetKeyBindings() );
+	}
 }
\ No newline at end of file
@@ -21,6 +21,8 @@ namespace fan
 	public:
 		void			Setup( GLFWwindow* _window );
 		void			NewFrame();
+		void			LoadKeyBindings();
+		void			SaveKeyBindings();
 		GLFWwindow*		Window()		{ return mWindow; }
 		uint64_t		FrameCount()	{ return mCount; }
         InputManager&	Manager()		{ return *mInputManager; }
@@ -0,0 +1,43 @@
+#include "core/math/fanSpatialGrid.hpp"
+
+#include <cmath>
+#include "core/fanAssert.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	//========================================================================================================
+	void SpatialGrid::Clear( const float _cellSize )
+	{
+		fanAssert( _cellSize > 0.f );
+		mCellSize = _cellSize;
+		mEntries.clear();
+	}
+
+	//========================================================================================================
+	// Build() must be called after the last insertion & before querying
+	//========================================================================================================
+	void SpatialGrid::Insert( const int _index, const float _x, const float _z )
+	{
+		Entry entry;
+		entry.mCell  = CellKey( ToCell( _x ), ToCell( _z ) );
+		entry.mIndex = _index;
+		entry.mX     = _x;
+		entry.mZ     = _z;
+		mEntries.push_back( entry );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void SpatialGrid::Build()
+	{
+		std::sort( mEntries.begin(), mEntries.end() );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	int32_t SpatialGrid::ToCell( const float _position ) const
+	{
+		return int32_t( std::floor( _position / mCellSize ) );
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace fan
+{
+	//========================================================================================================
+	// Uniform grid on the XZ plane for radius queries
+	// entries are sorted by cell, a query only visits the cells overlapping its radius
+	// rebuilt every frame, the storage is kept between builds so rebuilding does not allocate
+	//========================================================================================================
+	class SpatialGrid
+	{
+	public:
+		void Clear( const float _cellSize );
+		void Insert( const int _index, const float _x, const float _z );
+		void Build();
+		int  Size() const { return (int)mEntries.size(); }
+
+		// calls _function( int _index, float _sqrDistance ) for every entry closer than _radius
+		template < typename _Function >
+		void Query( const float _x, const float _z, const float _radius, _Function _function ) const;
+
+	private:
+		struct Entry
+		{
+			uint64_t mCell;
+			int      mIndex;
+			float    mX;
+			float    mZ;
+			bool operator<( const Entry& _other ) const { return mCell < _other.mCell; }
+		};
+
+		int32_t  ToCell( const float _position ) const;
+		uint64_t CellKey( const int32_t _cellX, const int32_t _cellZ ) const
+		{
+			return ( uint64_t( uint32_t( _cellX ) ) << 32 ) | uint64_t( uint32_t( _cellZ ) );
+		}
+
+		float              mCellSize = 1.f;
+		std::vector<Entry> mEntries;
+	};
+
+	//========================================================================================================
+	//========================================================================================================
+	template < typename _Function >
+	void SpatialGrid::Query( const float _x, const float _z, const float _radius, _Function _function ) const
+	{
+		const float   sqrRadius = _radius * _radius;
+		const int32_t minX      = ToCell( _x - _radius );
+		const int32_t maxX      = ToCell( _x + _radius );
+		const int32_t minZ      = ToCell( _z - _radius );
+		const int32_t maxZ      = ToCell( _z + _radius );
+		for( int32_t cellX = minX; cellX <= maxX; cellX++ )
+		{
+			for( int32_t cellZ = minZ; cellZ <= maxZ; cellZ++ )
+			{
+				Entry key;
+				key.mCell = CellKey( cellX, cellZ );
+				auto it = std::lower_bound( mEntries.begin(), mEntries.end(), key );
+				for( ; it != mEntries.end() && it->mCell == key.mCell; ++it )
+				{
+					const float dx          = it->mX - _x;
+					const float dz          = it->mZ - _z;
+					const float sqrDistance = dx * dx + dz * dz;
+					if( sqrDistance <= sqrRadius )
+					{
+						_function( it->mIndex, sqrDistance );
+					}
+				}
+			}
+		}
+	}
+}
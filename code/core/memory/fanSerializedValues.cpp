@@ -3,8 +3,6 @@
 #include <fstream>
 #include "bullet/LinearMath/btQuaternion.h"
 #include "core/memory/fanSerializable.hpp"
-#include "core/input/fanInputManager.hpp"
-#include "core/input/fanInput.hpp"
 #include "core/fanDebug.hpp"
 #include "core/fanColor.hpp"
 
@@ -32,7 +30,6 @@ namespace fan
 	{
 
 		Debug::Log( "Saving value to disk" );
-		Input::Get().Manager().Save( mJson[ mKeysBindingsName ] );
 		std::ofstream outFile( mJsonPath );
         fanAssert( outFile.is_open() );
 		outFile << mJson;
@@ -41,9 +38,9 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	void SerializedValues::LoadKeyBindings()
+	Json& SerializedValues::GetKeyBindings()
 	{
-		Input::Get().Manager().Load( mJson[ mKeysBindingsName ] );
+		return mJson[ mKeysBindingsName ];
 	}
 
 
@@ -25,7 +25,7 @@ namespace fan
 	public:
 		friend class Singleton<SerializedValues>;
 		void SaveValuesToDisk();
-		void LoadKeyBindings();
+		Json& GetKeyBindings();
 
 		void SetVec2	( const char * _name, const btVector2&		_vec2 );
 		void SetVec3	( const char * _name, const btVector3&		_vec3 );
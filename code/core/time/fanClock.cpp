@@ -30,4 +30,13 @@ namespace fan
 	{
 		return SecondsBetween( mStartPoint, Now() );
 	}
+
+	//========================================================================================================
+	// steady_clock is monotonic, the start point is set on the first call
+	//========================================================================================================
+	double Clock::SecondsSinceStartup()
+	{
+		static const std::chrono::steady_clock::time_point sStartupTime = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>( std::chrono::steady_clock::now() - sStartupTime ).count();
+	}
 }
\ No newline at end of file
@@ -7,6 +7,7 @@ namespace fan
 	//========================================================================================================
 	// Clock for counting time
 	// starts when constructed
+	// SecondsSinceStartup uses a monotonic clock, it doesn't depend on the window library
 	//========================================================================================================
 	class Clock
 	{
@@ -24,6 +25,7 @@ namespace fan
             mStartPoint += _seconds;
 		}
 
+		static double SecondsSinceStartup();
 		static float SecondsBetween( const TimePoint& _t1, const TimePoint& _t2 )
 		{
 			return std::chrono::duration<float>( _t2 - _t1 ).count();
@@ -0,0 +1,98 @@
+#include "core/time/fanPreciseSleep.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include "core/time/fanClock.hpp"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+	#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+		#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+	#endif
+#endif
+
+namespace fan
+{
+	//========================================================================================================
+	// windows sleeps have a 15ms granularity by default, a high resolution timer is used when available
+	//========================================================================================================
+	PreciseSleep::PreciseSleep() :
+			mOvershootMean( 0.001 ),
+			mOvershootVariance( 0. ),
+			mOvershootEstimate( 0.001 ),
+			mTimer( nullptr )
+	{
+#ifdef _WIN32
+		mTimer = CreateWaitableTimerExW( nullptr,
+										 nullptr,
+										 CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+										 TIMER_ALL_ACCESS );
+#endif
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	PreciseSleep::~PreciseSleep()
+	{
+#ifdef _WIN32
+		if( mTimer != nullptr ) { CloseHandle( mTimer ); }
+#endif
+	}
+
+	//========================================================================================================
+	// returns immediately if _wakeTime is in the past
+	//========================================================================================================
+	void PreciseSleep::SleepUntil( const double _wakeTime )
+	{
+		double       now       = Clock::SecondsSinceStartup();
+		const double sleepTime = _wakeTime - now - mOvershootEstimate;
+		if( sleepTime > 0. )
+		{
+			OsSleep( sleepTime );
+			const double wakeTime = Clock::SecondsSinceStartup();
+			UpdateEstimate( wakeTime - now - sleepTime );
+			now = wakeTime;
+		}
+
+		while( now < _wakeTime )
+		{
+			std::this_thread::yield();
+			now = Clock::SecondsSinceStartup();
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void PreciseSleep::OsSleep( const double _seconds )
+	{
+#ifdef _WIN32
+		if( mTimer != nullptr )
+		{
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -LONGLONG( _seconds * 1e7 ); // relative time in 100ns units
+			if( SetWaitableTimerEx( mTimer, &dueTime, 0, nullptr, nullptr, nullptr, 0 ) )
+			{
+				WaitForSingleObject( mTimer, INFINITE );
+				return;
+			}
+		}
+#endif
+		std::this_thread::sleep_for( std::chrono::duration<double>( _seconds ) );
+	}
+
+	//========================================================================================================
+	// exponential moving average & variance, adapts to the load of the machine
+	//========================================================================================================
+	void PreciseSleep::UpdateEstimate( const double _overshoot )
+	{
+		const double alpha = 1. / 16.;
+		const double delta = std::max( _overshoot, 0. ) - mOvershootMean;
+		mOvershootMean += alpha * delta;
+		mOvershootVariance = ( 1. - alpha ) * ( mOvershootVariance + alpha * delta * delta );
+		mOvershootEstimate = std::min( mOvershootMean + std::sqrt( mOvershootVariance ), sMaxSpinTime );
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace fan
+{
+	//========================================================================================================
+	// Sleeps until a precise time ( seconds since startup, see Clock::SecondsSinceStartup )
+	// the thread is put to sleep once for the bulk of the wait, the OS wakes it up late by an overshoot
+	// that is estimated from the previous sleeps, the remaining time is spent yielding
+	//========================================================================================================
+	class PreciseSleep
+	{
+	public:
+		PreciseSleep();
+		~PreciseSleep();
+		PreciseSleep( PreciseSleep const& ) = delete;
+		PreciseSleep& operator=( PreciseSleep const& ) = delete;
+
+		void SleepUntil( const double _wakeTime );
+		double OvershootEstimate() const { return mOvershootEstimate; }
+
+		static constexpr double sMaxSpinTime = 0.002; // (seconds) bounds the yielding time if the OS timer is coarse
+
+	private:
+		void OsSleep( const double _seconds );
+		void UpdateEstimate( const double _overshoot );
+
+		double mOvershootMean;		// running mean of the OS sleep overshoot
+		double mOvershootVariance;	// running variance of the OS sleep overshoot
+		double mOvershootEstimate;	// mean + standard deviation
+		void*  mTimer;				// windows high resolution waitable timer
+	};
+}
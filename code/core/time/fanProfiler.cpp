@@ -1,4 +1,5 @@
 #include "core/time/fanProfiler.hpp"
+#include <cstring>
 
 namespace fan
 {
@@ -7,6 +8,8 @@ namespace fan
 	//================================================================================================================================
 	size_t Profiler::OpenTimeInterval( const char _name[ sNameSize ] )
 	{
+		if( std::this_thread::get_id() != mThreadID ) { return sInvalidID; }
+
 		Interval interval;
 		interval.mTime = mClock.Now();
 		interval.mID   = mIndex++;
@@ -22,6 +25,8 @@ namespace fan
 	//================================================================================================================================
 	void Profiler::CloseTimeInterval( const size_t _index )
 	{
+		if( _index == sInvalidID ) { return; }
+
 		Interval interval;
 		interval.mTime = mClock.Now();
 		interval.mID   = _index;
@@ -29,11 +34,34 @@ namespace fan
 		mIntervals.push_back( interval );
 	}
 
+	//================================================================================================================================
+	// Sets the value of a counter, creates it if it doesn't exist
+	//================================================================================================================================
+	void Profiler::SetCounter( const char _name[ sNameSize ], const int _value )
+	{
+		if( std::this_thread::get_id() != mThreadID ) { return; }
+
+		for( Counter& counter : mCounters )
+		{
+			if( strcmp( counter.mName, _name ) == 0 )
+			{
+				counter.mValue = _value;
+				return;
+			}
+		}
+
+		Counter counter;
+		strcpy_s( counter.mName, _name );
+		counter.mValue = _value;
+		mCounters.push_back( counter );
+	}
+
 	//================================================================================================================================
 	// Clears the profiler
 	//================================================================================================================================
 	void Profiler::Begin()
 	{
+		mThreadID = std::this_thread::get_id();
 		mIntervals.clear();
         mIndex = 0;
 		mClock.Reset();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <thread>
 #include "core/fanSingleton.hpp"
 #include "core/ecs/fanSignal.hpp"
 #include "core/time/fanClock.hpp"
@@ -9,12 +10,14 @@ namespace fan
 	//========================================================================================================
 	// Measures time intervals in scoped segments of code
 	// data is displayed in the profiler window of the editor
+	// only intervals of the thread that called Begin() are recorded
 	//========================================================================================================
 	class Profiler : public Singleton<Profiler>
 	{
 	public:
 
 		static const size_t sNameSize          = 32;
+		static const size_t sInvalidID         = size_t( -1 );
 		Signal<>            mOnProfilingEnd;
 
 		//================================================================
@@ -29,17 +32,30 @@ namespace fan
 			bool IsClosing() const { return mName[ 0 ] == '\0'; }
 		};
 
+		//================================================================
+		// named value displayed alongside the intervals, keeps its value until it is set again
+		//================================================================
+		struct Counter
+		{
+			char mName[ sNameSize ];
+			int  mValue;
+		};
+
 		size_t	OpenTimeInterval( const char _name[ sNameSize ] );
 		void	CloseTimeInterval( const size_t _index );
+		void	SetCounter( const char _name[ sNameSize ], const int _value );
 
 		void Begin();
 		void End();
 		inline const std::vector<Interval>& GetIntervals() { return mIntervals; }
+		inline const std::vector<Counter>&  GetCounters() { return mCounters; }
 
 	private:
 		Clock                           mClock;
 		size_t                          mIndex = 0;
 		std::vector<Profiler::Interval> mIntervals;
+		std::vector<Profiler::Counter>  mCounters;
+		std::thread::id                 mThreadID = std::this_thread::get_id();
 	};
 
 	//================================================================================================================================
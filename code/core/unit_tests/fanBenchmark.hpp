@@ -0,0 +1,99 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "core/time/fanClock.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    struct BenchmarkResult
+    {
+        struct Measure
+        {
+            std::string mName         = "";
+            int         mIterations   = 0;
+            float       mTotalSeconds = 0.f;
+            float       mNanosecondsPerIteration = 0.f;
+        };
+        std::vector<Measure> mMeasures;
+    };
+
+    //========================================================================================================
+    // A benchmark class is instanciated for every BenchmarkMethod returned by GetBenchmarks()
+    // each method can record any number of measures using Measure()
+    // Benchmark minimal example :
+    /*
+    class BenchmarkSomething : public Benchmark<BenchmarkSomething>
+    {
+    public:
+        static std::vector<BenchmarkMethod> GetBenchmarks()
+        {
+            return { { &BenchmarkSomething::BenchmarkSomethingFast, "something fast" } };
+        }
+        void Create() override {}
+        void Destroy() override {}
+        void BenchmarkSomethingFast() { Measure( "sum", 1000, [&](){ mSum += 1; } ); }
+        int mSum = 0;
+    };
+    */
+    //========================================================================================================
+    template< typename BenchmarkType> class Benchmark
+    {
+    public:
+        virtual void Create() = 0;
+        virtual void Destroy() = 0;
+
+        struct BenchmarkMethod
+        {
+            using Method = void ( BenchmarkType::* )();
+            Method      mMethod;
+            std::string mName;
+        };
+
+        static BenchmarkResult RunBenchmarks()
+        {
+            std::vector<BenchmarkMethod> benchmarks = BenchmarkType::GetBenchmarks();
+            BenchmarkResult              result;
+            for( const BenchmarkMethod& benchmarkMethod : benchmarks )
+            {
+                BenchmarkType benchmark;
+                benchmark.mPrefix = benchmarkMethod.mName;
+                benchmark.Create();
+                ( ( benchmark ).*( benchmarkMethod.mMethod ) )();
+                benchmark.Destroy();
+                result.mMeasures.insert( result.mMeasures.end(),
+                                         benchmark.mMeasures.begin(),
+                                         benchmark.mMeasures.end() );
+            }
+            return result;
+        }
+
+    protected:
+        //====================================================================================================
+        // runs _function _iterations times and records the elapsed time
+        //====================================================================================================
+        template< typename _Function >
+        void Measure( const std::string& _name, const int _iterations, _Function _function )
+        {
+            Clock clock;
+            for( int i = 0; i < _iterations; i++ )
+            {
+                _function();
+            }
+            const float elapsed = clock.ElapsedSeconds();
+
+            BenchmarkResult::Measure measure;
+            measure.mName                    = mPrefix + " " + _name;
+            measure.mIterations              = _iterations;
+            measure.mTotalSeconds            = elapsed;
+            measure.mNanosecondsPerIteration = _iterations > 0 ? 1e9f * elapsed / _iterations : 0.f;
+            mMeasures.push_back( measure );
+        }
+
+    private:
+        std::string                           mPrefix;
+        std::vector<BenchmarkResult::Measure> mMeasures;
+    };
+}
@@ -0,0 +1,372 @@
+#pragma once
+
+#include "core/unit_tests/fanBenchmark.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "core/ecs/fanEcsComponent.hpp"
+#include "core/ecs/fanEcsTag.hpp"
+#include "core/ecs/fanEcsSystem.hpp"
+#include "core/ecs/fanEcsScheduler.hpp"
+#include "core/fanThreadPool.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    struct BenchmarkEcsComponent : public EcsComponent
+    {
+        ECS_COMPONENT( BenchmarkEcsComponent )
+        static void SetInfo( EcsComponentInfo& /*_info*/ ) {}
+        static void Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
+        {
+            BenchmarkEcsComponent& benchmarkComponent = static_cast<BenchmarkEcsComponent&>( _component );
+            benchmarkComponent.mValue = 0;
+        }
+        int mValue = 0;
+    };
+
+    //========================================================================================================
+    //========================================================================================================
+    struct BenchmarkEcsComponent2 : public EcsComponent
+    {
+        ECS_COMPONENT( BenchmarkEcsComponent2 )
+        static void SetInfo( EcsComponentInfo& /*_info*/ ) {}
+        static void Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
+        {
+            BenchmarkEcsComponent2& benchmarkComponent = static_cast<BenchmarkEcsComponent2&>( _component );
+            benchmarkComponent.mPosition[0] = benchmarkComponent.mPosition[1] = benchmarkComponent.mPosition[2] = 0.f;
+            benchmarkComponent.mVelocity[0] = benchmarkComponent.mVelocity[1] = benchmarkComponent.mVelocity[2] = 1.f;
+        }
+        float mPosition[3];
+        float mVelocity[3];
+    };
+
+    struct TagBenchmark0 : EcsTag { ECS_TAG( TagBenchmark0 ) };
+    struct TagBenchmark1 : EcsTag { ECS_TAG( TagBenchmark1 ) };
+    struct TagBenchmark2 : EcsTag { ECS_TAG( TagBenchmark2 ) };
+    struct TagBenchmark3 : EcsTag { ECS_TAG( TagBenchmark3 ) };
+    struct TagBenchmark4 : EcsTag { ECS_TAG( TagBenchmark4 ) };
+    struct TagBenchmark5 : EcsTag { ECS_TAG( TagBenchmark5 ) };
+    struct TagBenchmark6 : EcsTag { ECS_TAG( TagBenchmark6 ) };
+    struct TagBenchmark7 : EcsTag { ECS_TAG( TagBenchmark7 ) };
+
+    //========================================================================================================
+    // two systems writing different components of the same entities, they can run in parallel
+    //========================================================================================================
+    struct SBenchmarkIncrement : EcsSystem
+    {
+        static EcsSignature GetSignature( const EcsWorld& _world )
+        {
+            return _world.GetSignature<BenchmarkEcsComponent>();
+        }
+        static EcsSystemAccess GetAccess( const EcsWorld& _world )
+        {
+            EcsSystemAccess access;
+            access.mViewWrite = _world.GetSignature<BenchmarkEcsComponent>();
+            return access;
+        }
+        static void Run( EcsWorld&, const EcsView& _view, const float _delta )
+        {
+            _view.ForEach<BenchmarkEcsComponent>( [_delta]( BenchmarkEcsComponent& _component )
+            {
+                _component.mValue += int( _delta );
+            } );
+        }
+    };
+
+    struct SBenchmarkMove : EcsSystem
+    {
+        static EcsSignature GetSignature( const EcsWorld& _world )
+        {
+            return _world.GetSignature<BenchmarkEcsComponent2>();
+        }
+        static EcsSystemAccess GetAccess( const EcsWorld& _world )
+        {
+            EcsSystemAccess access;
+            access.mViewWrite = _world.GetSignature<BenchmarkEcsComponent2>();
+            return access;
+        }
+        static void Run( EcsWorld&, const EcsView& _view, const float _delta )
+        {
+            _view.ForEach<BenchmarkEcsComponent2>( [_delta]( BenchmarkEcsComponent2& _component )
+            {
+                for( int i = 0; i < 3; i++ ) { _component.mPosition[i] += _delta * _component.mVelocity[i]; }
+            } );
+        }
+    };
+
+    //========================================================================================================
+    //========================================================================================================
+    class BenchmarkEcs : public Benchmark<BenchmarkEcs>
+    {
+    public:
+        static std::vector<BenchmarkMethod> GetBenchmarks()
+        {
+            return { { &BenchmarkEcs::BenchmarkMatch, "match" },
+                     { &BenchmarkEcs::BenchmarkView,  "view" },
+                     { &BenchmarkEcs::BenchmarkTransitions, "transitions" },
+                     { &BenchmarkEcs::BenchmarkHandles, "handles" },
+                     { &BenchmarkEcs::BenchmarkScheduler, "scheduler" },
+            };
+        }
+        void Create() override {}
+        void Destroy() override {}
+
+        static constexpr int sNumTags = 8;
+
+        //====================================================================================================
+        //====================================================================================================
+        static void AddBenchmarkTypes( EcsWorld& _world )
+        {
+            _world.AddComponentType<BenchmarkEcsComponent>();
+            _world.AddComponentType<BenchmarkEcsComponent2>();
+            _world.AddTagType<TagBenchmark0>();
+            _world.AddTagType<TagBenchmark1>();
+            _world.AddTagType<TagBenchmark2>();
+            _world.AddTagType<TagBenchmark3>();
+            _world.AddTagType<TagBenchmark4>();
+            _world.AddTagType<TagBenchmark5>();
+            _world.AddTagType<TagBenchmark6>();
+            _world.AddTagType<TagBenchmark7>();
+        }
+
+        //====================================================================================================
+        // creates _numArchetypes archetypes ( power of two ) with _entitiesPerArchetype entities each
+        // by combining the benchmark tags
+        //====================================================================================================
+        static void CreateArchetypes( EcsWorld& _world, const int _numArchetypes, const int _entitiesPerArchetype )
+        {
+            const uint32_t tagTypes[sNumTags] = { TagBenchmark0::Info::sType, TagBenchmark1::Info::sType,
+                                                  TagBenchmark2::Info::sType, TagBenchmark3::Info::sType,
+                                                  TagBenchmark4::Info::sType, TagBenchmark5::Info::sType,
+                                                  TagBenchmark6::Info::sType, TagBenchmark7::Info::sType };
+            for( int archetypeIndex = 0; archetypeIndex < _numArchetypes; archetypeIndex++ )
+            {
+                for( int i = 0; i < _entitiesPerArchetype; i++ )
+                {
+                    EcsEntity entity = _world.CreateEntity();
+                    _world.AddComponent<BenchmarkEcsComponent>( entity );
+                    _world.AddComponent<BenchmarkEcsComponent2>( entity );
+                    for( int tagIndex = 0; tagIndex < sNumTags; tagIndex++ )
+                    {
+                        if( archetypeIndex & ( 1 << tagIndex ) )
+                        {
+                            _world.AddTag( entity, tagTypes[tagIndex] );
+                        }
+                    }
+                }
+            }
+            _world.ApplyTransitions();
+        }
+
+        //====================================================================================================
+        //====================================================================================================
+        void BenchmarkMatch()
+        {
+            for( int numArchetypes : { 4, 16, 64, 256 } )
+            {
+                EcsWorld world;
+                AddBenchmarkTypes( world );
+                CreateArchetypes( world, numArchetypes, 1 );
+                const EcsSignature signature = world.GetSignature<BenchmarkEcsComponent>();
+                const std::string  suffix    = std::to_string( numArchetypes ) + " archetypes";
+
+                Measure( "first " + suffix, 1, [&]() { mMatched += (int)world.Match( signature ).mArchetypes.size(); } );
+                Measure( "cached " + suffix, 10000, [&]() { mMatched += world.Match( signature ).Size(); } );
+            }
+        }
+
+        //====================================================================================================
+        // iterates over two components with lockstep iterators and with ForEach
+        //====================================================================================================
+        void BenchmarkView()
+        {
+            EcsWorld world;
+            AddBenchmarkTypes( world );
+            CreateArchetypes( world, 16, 10000 );
+            const EcsView view = world.Match( world.GetSignature<BenchmarkEcsComponent>() |
+                                              world.GetSignature<BenchmarkEcsComponent2>() );
+            const std::string suffix = std::to_string( view.Size() ) + " entities";
+
+            Measure( "iterators " + suffix, 100, [&]()
+            {
+                auto it2 = view.begin<BenchmarkEcsComponent2>();
+                for( auto it = view.begin<BenchmarkEcsComponent>(); it != view.end<BenchmarkEcsComponent>(); ++it, ++it2 )
+                {
+                    BenchmarkEcsComponent2& component2 = *it2;
+                    component2.mPosition[0] += component2.mVelocity[0];
+                    ( *it ).mValue++;
+                }
+            } );
+            Measure( "for each " + suffix, 100, [&]()
+            {
+                view.ForEach<BenchmarkEcsComponent, BenchmarkEcsComponent2>(
+                        []( BenchmarkEcsComponent& _component, BenchmarkEcsComponent2& _component2 )
+                {
+                    _component2.mPosition[0] += _component2.mVelocity[0];
+                    _component.mValue++;
+                } );
+            } );
+            Measure( "parallel for each " + suffix, 100, [&]()
+            {
+                view.ParallelForEach<BenchmarkEcsComponent, BenchmarkEcsComponent2>(
+                        []( BenchmarkEcsComponent& _component, BenchmarkEcsComponent2& _component2 )
+                {
+                    _component2.mPosition[0] += _component2.mVelocity[0];
+                    _component.mValue++;
+                } );
+            } );
+        }
+
+        //====================================================================================================
+        // spawns, moves and kills entities the way particles are created and destroyed during an eruption
+        //====================================================================================================
+        void BenchmarkTransitions()
+        {
+            const int numEntities = 100000;
+            EcsWorld world;
+            AddBenchmarkTypes( world );
+            const std::string suffix = std::to_string( numEntities ) + " entities";
+
+            Measure( "spawn & kill " + suffix, 10, [&]()
+            {
+                for( int i = 0; i < numEntities; i++ )
+                {
+                    EcsEntity entity = world.CreateEntity();
+                    world.AddComponent<BenchmarkEcsComponent>( entity );
+                    world.AddComponent<BenchmarkEcsComponent2>( entity );
+                }
+                world.ApplyTransitions();
+
+                const EcsView view = world.Match( world.GetSignature<BenchmarkEcsComponent>() );
+                for( auto it = view.begin<BenchmarkEcsComponent>(); it != view.end<BenchmarkEcsComponent>(); ++it )
+                {
+                    world.Kill( it.GetEntity() );
+                }
+                world.ApplyTransitions();
+            } );
+
+            for( int i = 0; i < numEntities; i++ )
+            {
+                EcsEntity entity = world.CreateEntity();
+                world.AddComponent<BenchmarkEcsComponent>( entity );
+                world.AddComponent<BenchmarkEcsComponent2>( entity );
+            }
+            world.ApplyTransitions();
+            Measure( "add & remove tag " + suffix, 10, [&]()
+            {
+                const EcsView view = world.Match( world.GetSignature<BenchmarkEcsComponent>() );
+                for( auto it = view.begin<BenchmarkEcsComponent>(); it != view.end<BenchmarkEcsComponent>(); ++it )
+                {
+                    world.AddTag<TagBenchmark0>( it.GetEntity() );
+                }
+                world.ApplyTransitions();
+                for( auto it = view.begin<BenchmarkEcsComponent>(); it != view.end<BenchmarkEcsComponent>(); ++it )
+                {
+                    world.RemoveTag<TagBenchmark0>( it.GetEntity() );
+                }
+                world.ApplyTransitions();
+            } );
+
+            // kills one entity out of two, the archetype is compacted
+            Measure( "kill half " + suffix, 1, [&]()
+            {
+                const EcsView view = world.Match( world.GetSignature<BenchmarkEcsComponent>() );
+                int index = 0;
+                for( auto it = view.begin<BenchmarkEcsComponent>(); it != view.end<BenchmarkEcsComponent>(); ++it )
+                {
+                    if( index++ % 2 == 0 ) { world.Kill( it.GetEntity() ); }
+                }
+                world.ApplyTransitions();
+            } );
+        }
+
+        //====================================================================================================
+        // handles lookups while entities with handles are continuously spawned & killed like bullets
+        //====================================================================================================
+        void BenchmarkHandles()
+        {
+            const int numEntities = 10000;
+            const int numChurned  = 1000;
+            EcsWorld world;
+            AddBenchmarkTypes( world );
+            std::vector<EcsHandle> handles;
+            for( int i = 0; i < numEntities; i++ )
+            {
+                EcsEntity entity = world.CreateEntity();
+                world.AddComponent<BenchmarkEcsComponent>( entity );
+                handles.push_back( world.AddHandle( entity ) );
+            }
+            world.ApplyTransitions();
+
+            int churnIndex = 0;
+            auto churn = [&]()
+            {
+                for( int i = 0; i < numChurned; i++ )
+                {
+                    EcsHandle& handle = handles[( churnIndex++ * 7919 ) % numEntities];
+                    world.Kill( world.GetEntity( handle ) );
+                    EcsEntity entity = world.CreateEntity();
+                    world.AddComponent<BenchmarkEcsComponent>( entity );
+                    handle = world.AddHandle( entity );
+                }
+                world.ApplyTransitions();
+            };
+
+            const std::string suffix = std::to_string( numEntities ) + " handles";
+            Measure( "churn " + std::to_string( numChurned ) + " entities", 100, churn );
+            Measure( "get entity " + suffix, 100, [&]()
+            {
+                for( const EcsHandle handle : handles )
+                {
+                    mMatched += world.GetEntity( handle ).mIndex;
+                }
+            } );
+            Measure( "churn & get entity " + suffix, 100, [&]()
+            {
+                churn();
+                for( const EcsHandle handle : handles )
+                {
+                    mMatched += world.GetComponent<BenchmarkEcsComponent>( world.GetEntity( handle ) ).mValue;
+                }
+            } );
+        }
+
+        //====================================================================================================
+        // two conflict-free systems run one after the other, with a scheduler built every frame
+        // and with a scheduler kept between frames
+        // 32 entities is the size of the game worlds ( planets & spaceships )
+        //====================================================================================================
+        void BenchmarkScheduler()
+        {
+            for( int numEntities : { 32, 1000, 100000 } )
+            {
+                EcsWorld world;
+                AddBenchmarkTypes( world );
+                CreateArchetypes( world, 1, numEntities );
+                const std::string suffix     = std::to_string( numEntities ) + " entities";
+                const int         iterations = numEntities > 1000 ? 100 : 10000;
+                float             delta      = 1.f;
+
+                Measure( "serial " + suffix, iterations, [&]()
+                {
+                    world.Run<SBenchmarkIncrement>( delta );
+                    world.Run<SBenchmarkMove>( delta );
+                } );
+                Measure( "scheduler per frame " + suffix, iterations, [&]()
+                {
+                    EcsScheduler scheduler( world );
+                    scheduler.Add<SBenchmarkIncrement>( delta );
+                    scheduler.Add<SBenchmarkMove>( delta );
+                    scheduler.Run();
+                } );
+
+                EcsScheduler scheduler( world );
+                scheduler.Add<SBenchmarkIncrement>( std::cref( delta ) );
+                scheduler.Add<SBenchmarkMove>( std::cref( delta ) );
+                Measure( "persistent scheduler " + suffix, iterations, [&]() { scheduler.Run(); } );
+            }
+        }
+
+        int mMatched = 0;
+    };
+}
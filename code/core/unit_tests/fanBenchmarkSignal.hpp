@@ -0,0 +1,138 @@
+#pragma once
+
+#include <functional>
+#include "core/unit_tests/fanBenchmark.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "core/ecs/fanEcsComponent.hpp"
+#include "core/ecs/fanSignal.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // reference implementation : each connection is a std::function stored in a std::vector
+    //========================================================================================================
+    template< typename ...Args > struct BenchmarkFunctionSignal
+    {
+        struct Connection
+        {
+            std::function<void( Args... )> mLambda;
+            size_t                         mID;
+        };
+
+        template< typename _Object >
+        void Connect( void( _Object::* _method )( Args... ), _Object* _object )
+        {
+            mConnections.push_back( { [_method, _object]( Args... _args ) { ( ( *_object ).*( _method ) )( _args... ); },
+                                      size_t( _object ) } );
+        }
+
+        template< typename _ComponentType >
+        void Connect( void( _ComponentType::* _method )( Args... ), EcsWorld& _world, const EcsHandle _handle )
+        {
+            mConnections.push_back( { [_method, &_world, _handle]( Args... _args )
+                                      {
+                                          _ComponentType& component = _world.GetComponent<_ComponentType>(
+                                                  _world.GetEntity( _handle ) );
+                                          ( ( component ).*( _method ) )( _args... );
+                                      }, _handle } );
+        }
+
+        void Emmit( Args... _args )
+        {
+            for( Connection connection : mConnections ) { connection.mLambda( _args... ); }
+        }
+        int ConnectionsCount() const { return (int)mConnections.size(); }
+
+        std::vector<Connection> mConnections;
+    };
+
+    //========================================================================================================
+    //========================================================================================================
+    struct BenchmarkSignalComponent : public EcsComponent
+    {
+        ECS_COMPONENT( BenchmarkSignalComponent )
+        static void SetInfo( EcsComponentInfo& /*_info*/ ) {}
+        static void Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
+        {
+            static_cast<BenchmarkSignalComponent&>( _component ).mSum = 0;
+        }
+        void Add( int _value ) { mSum += _value; }
+        int mSum = 0;
+    };
+
+    //========================================================================================================
+    // compares Signal to the std::function signal it replaced
+    // connections target an object or a component, signals are copied the way packets & components copy them
+    //========================================================================================================
+    class BenchmarkSignal : public Benchmark<BenchmarkSignal>
+    {
+    public:
+        static std::vector<BenchmarkMethod> GetBenchmarks()
+        {
+            return { { &BenchmarkSignal::BenchmarkObject,    "object" },
+                     { &BenchmarkSignal::BenchmarkComponent, "component" },
+            };
+        }
+        void Create() override
+        {
+            mWorld.AddComponentType<BenchmarkSignalComponent>();
+            const EcsEntity entity = mWorld.CreateEntity();
+            mWorld.AddComponent<BenchmarkSignalComponent>( entity );
+            mHandle = mWorld.AddHandle( entity );
+            mWorld.ApplyTransitions();
+        }
+        void Destroy() override {}
+
+        static constexpr int sIterations = 100000;
+        static constexpr int sRingSize   = 64;
+
+        struct Receiver
+        {
+            void Add( int _value ) { mSum += _value; }
+            int mSum = 0;
+        };
+
+        EcsWorld  mWorld;
+        EcsHandle mHandle;
+        Receiver  mReceiver;
+
+        //====================================================================================================
+        //====================================================================================================
+        template< typename _SignalType, typename _ConnectFunction >
+        void MeasureSignal( const std::string& _name, _ConnectFunction _connect )
+        {
+            // signals are kept alive in a ring so that their construction can't be optimized away
+            // each measure includes the destruction of the signal previously stored in the ring
+            std::vector<_SignalType> signals( sRingSize );
+            int index = 0;
+            Measure( _name + " connect", sIterations, [&]()
+            {
+                _SignalType& signal = signals[index++ % sRingSize];
+                signal = _SignalType();
+                _connect( signal );
+            } );
+
+            const _SignalType source = signals.front();
+            Measure( _name + " copy", sIterations, [&]() { signals[index++ % sRingSize] = _SignalType( source ); } );
+
+            Measure( _name + " emit", sIterations, [&]() { signals.front().Emmit( 1 ); } );
+        }
+
+        void BenchmarkObject()
+        {
+            auto connect = [this]( auto& _signal ) { _signal.Connect( &Receiver::Add, &mReceiver ); };
+            MeasureSignal<BenchmarkFunctionSignal<int>>( "std::function", connect );
+            MeasureSignal<Signal<int>>( "inline", connect );
+        }
+
+        void BenchmarkComponent()
+        {
+            auto connect = [this]( auto& _signal )
+            {
+                _signal.Connect( &BenchmarkSignalComponent::Add, mWorld, mHandle );
+            };
+            MeasureSignal<BenchmarkFunctionSignal<int>>( "std::function", connect );
+            MeasureSignal<Signal<int>>( "inline", connect );
+        }
+    };
+}
@@ -5,6 +5,9 @@
 #include "core/ecs/fanEcsWorld.hpp"
 #include "core/ecs/fanEcsComponent.hpp"
 #include "core/ecs/fanEcsSingleton.hpp"
+#include "core/ecs/fanEcsSystem.hpp"
+#include "core/ecs/fanEcsScheduler.hpp"
+#include "core/fanThreadPool.hpp"
 
 namespace fan
 {
@@ -45,6 +48,150 @@ namespace fan
         int     mValueInt = 0;
     };
 
+    //========================================================================================================
+    // bigger than TestEcsComponent so that their chunks boundaries differ
+    //========================================================================================================
+    struct TestEcsComponent2 : public EcsComponent
+    {
+        ECS_COMPONENT( TestEcsComponent2 )
+        static void SetInfo( EcsComponentInfo& /*_info*/ )
+        {
+        }
+        static void	Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
+        {
+            TestEcsComponent2& testComponent = static_cast<TestEcsComponent2&>(_component);
+            testComponent.mValueInt = 0;
+        }
+        int     mValueInt = 0;
+        float   mPadding[15];
+    };
+
+    //========================================================================================================
+    // counts its destructions
+    //========================================================================================================
+    struct TestEcsComponentDestroy : public EcsComponent
+    {
+        ECS_COMPONENT( TestEcsComponentDestroy )
+        static void SetInfo( EcsComponentInfo& _info )
+        {
+            _info.destroy = &TestEcsComponentDestroy::Destroy;
+        }
+        static void	Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& /*_component*/ ) {}
+        static void Destroy( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& /*_component*/ )
+        {
+            sNumDestroyed++;
+        }
+        static int sNumDestroyed;
+    };
+    inline int TestEcsComponentDestroy::sNumDestroyed = 0;
+
+    //========================================================================================================
+    //========================================================================================================
+    struct STestIncrement : EcsSystem
+    {
+        static EcsSignature GetSignature( const EcsWorld& _world ) { return _world.GetSignature<TestEcsComponent>(); }
+        static EcsSystemAccess GetAccess( const EcsWorld& _world )
+        {
+            EcsSystemAccess access;
+            access.mViewWrite = _world.GetSignature<TestEcsComponent>();
+            return access;
+        }
+        static void Run( EcsWorld& /*_world*/, const EcsView& _view, const int _value )
+        {
+            _view.ForEach<TestEcsComponent>( [_value]( TestEcsComponent& _component ){ _component.mValueInt += _value; } );
+        }
+    };
+
+    //========================================================================================================
+    //========================================================================================================
+    struct STestIncrement2 : EcsSystem
+    {
+        static EcsSignature GetSignature( const EcsWorld& _world ) { return _world.GetSignature<TestEcsComponent2>(); }
+        static EcsSystemAccess GetAccess( const EcsWorld& _world )
+        {
+            EcsSystemAccess access;
+            access.mViewWrite = _world.GetSignature<TestEcsComponent2>();
+            return access;
+        }
+        static void Run( EcsWorld& /*_world*/, const EcsView& _view, const int _value )
+        {
+            _view.ForEach<TestEcsComponent2>( [_value]( TestEcsComponent2& _component ){ _component.mValueInt += _value; } );
+        }
+    };
+
+    //========================================================================================================
+    //========================================================================================================
+    struct STestCopy : EcsSystem
+    {
+        static EcsSignature GetSignature( const EcsWorld& _world )
+        {
+            return _world.GetSignature<TestEcsComponent>() | _world.GetSignature<TestEcsComponent2>();
+        }
+        static EcsSystemAccess GetAccess( const EcsWorld& _world )
+        {
+            EcsSystemAccess access;
+            access.mViewRead  = _world.GetSignature<TestEcsComponent>();
+            access.mViewWrite = _world.GetSignature<TestEcsComponent2>();
+            return access;
+        }
+        static void Run( EcsWorld& /*_world*/, const EcsView& _view )
+        {
+            _view.ForEach<TestEcsComponent, TestEcsComponent2>( []( TestEcsComponent& _component,
+                                                                    TestEcsComponent2& _component2 )
+            {
+                _component2.mValueInt = _component.mValueInt;
+            } );
+        }
+    };
+
+    //========================================================================================================
+    // copies TestEcsComponent2 to TestEcsComponent only when it changed
+    //========================================================================================================
+    struct STestCopyChanged : EcsSystem
+    {
+        static EcsSignature GetSignature( const EcsWorld& _world )
+        {
+            return _world.GetSignature<TestEcsComponent>() | _world.GetSignature<TestEcsComponent2>();
+        }
+        static void Run( EcsWorld& /*_world*/, const EcsView& _view, int& _numCopies )
+        {
+            _numCopies = 0;
+            _view.Changed<TestEcsComponent2>().ForEach<const TestEcsComponent2, TestEcsComponent>(
+                    [&_numCopies]( const TestEcsComponent2& _component2, TestEcsComponent& _component )
+                    {
+                        _component.mValueInt = _component2.mValueInt;
+                        _numCopies++;
+                    } );
+        }
+    };
+
+    //========================================================================================================
+    // no access declared, runs alone
+    //========================================================================================================
+    struct STestKillAll : EcsSystem
+    {
+        static EcsSignature GetSignature( const EcsWorld& _world ) { return _world.GetSignature<TestEcsComponent>(); }
+        static void Run( EcsWorld& _world, const EcsView& _view )
+        {
+            for( auto it = _view.begin<TestEcsComponent>(); it != _view.end<TestEcsComponent>(); ++it )
+            {
+                _world.Kill( it.GetEntity() );
+            }
+        }
+    };
+
+    //========================================================================================================
+    // creates an entity while the system runs
+    //========================================================================================================
+    struct STestCreateEntity : EcsSystem
+    {
+        static EcsSignature GetSignature( const EcsWorld& _world ) { return _world.GetSignature<TestEcsComponent>(); }
+        static void Run( EcsWorld& _world, const EcsView&, const EcsSignature _signature, EcsEntity& _outEntity )
+        {
+            _outEntity = _world.CreateEntity( _signature );
+        }
+    };
+
     struct TagTest  : EcsTag  { ECS_TAG( TagTest )  };
     struct TagTest2  : EcsTag  { ECS_TAG( TagTest2 )  };
 
@@ -58,11 +205,24 @@ namespace fan
             return { { &UnitTestEcs::TestAddTagType,             "tag add types " },
                      { &UnitTestEcs::TestAddRemoveTags,          "tag add/remove " },
                      { &UnitTestEcs::TestFaultyAddRemoveTags,    "tag multiple add/remove" },
+                     { &UnitTestEcs::TestMatchCache,             "match cache" },
+                     { &UnitTestEcs::TestBatchedTransitions,     "batched transitions" },
+                     { &UnitTestEcs::TestArchetypeEdges,         "archetype edges" },
+                     { &UnitTestEcs::TestHandleTable,            "handle table" },
+                     { &UnitTestEcs::TestKillDestroy,            "kill destroy" },
+                     { &UnitTestEcs::TestCreateFromSignature,    "create from signature" },
+                     { &UnitTestEcs::TestChangeDetection,        "change detection" },
+                     { &UnitTestEcs::TestChunkAllocator,         "chunk allocator" },
+                     { &UnitTestEcs::TestViewForEach,            "view for each" },
+                     { &UnitTestEcs::TestParallelForEach,        "view parallel for each" },
+                     { &UnitTestEcs::TestScheduler,              "scheduler" },
             };
         }
         void Create() override
         {
             mWorld.AddComponentType<TestEcsComponent>();
+            mWorld.AddComponentType<TestEcsComponent2>();
+            mWorld.AddComponentType<TestEcsComponentDestroy>();
             mWorld.AddSingletonType<TestEcsSingleton>();
             mWorld.AddTagType<TagTest>();
 
@@ -158,5 +318,515 @@ namespace fan
 
             TEST_ASSERT( mWorld.HasTag<TagTest>( entity ) );
         }
+
+        void TestMatchCache()
+        {
+            const EcsSignature signature = mWorld.GetSignature<TestEcsComponent>();
+            TEST_ASSERT( mWorld.Match( signature ).Empty() );
+
+            EcsEntity entity = mWorld.CreateEntity();
+            EcsHandle handle = mWorld.AddHandle( entity );
+            mWorld.AddComponent<TestEcsComponent>( entity );
+            mWorld.ApplyTransitions();
+            TEST_ASSERT( mWorld.Match( signature ).Size() == 1 );
+            TEST_ASSERT( mWorld.Match( signature ).mArchetypes.size() == 1 );
+
+            // the new archetype is added to the cached query, the old one stays in it empty
+            entity = mWorld.GetEntity( handle );
+            mWorld.AddTag<TagTest>( entity );
+            mWorld.ApplyTransitions();
+            const EcsView view = mWorld.Match( signature );
+            TEST_ASSERT( view.Size() == 1 );
+            TEST_ASSERT( view.mArchetypes.size() == 2 );
+
+            int count = 0;
+            for( auto it = view.begin<TestEcsComponent>(); it != view.end<TestEcsComponent>(); ++it ){ count++; }
+            TEST_ASSERT( count == 1 );
+        }
+
+        void TestBatchedTransitions()
+        {
+            // crosses the chunks boundaries of TestEcsComponent2
+            const int numEntities = 10000;
+            std::vector<EcsHandle> handles;
+            for( int i = 0; i < numEntities; i++ )
+            {
+                EcsEntity entity = mWorld.CreateEntity();
+                mWorld.AddComponent<TestEcsComponent>( entity ).mValueInt = i;
+                handles.push_back( mWorld.AddHandle( entity ) );
+            }
+            mWorld.ApplyTransitions();
+
+            // kills, moves to two different archetypes & leaves some entities in place
+            for( int i = 0; i < numEntities; i++ )
+            {
+                const EcsEntity entity = mWorld.GetEntity( handles[i] );
+                switch( i % 4 )
+                {
+                    case 0: mWorld.Kill( entity ); break;
+                    case 1: mWorld.AddComponent<TestEcsComponent2>( entity ).mValueInt = 2 * i; break;
+                    case 2: mWorld.AddTag<TagTest>( entity ); break;
+                    default: break;
+                }
+            }
+            mWorld.ApplyTransitions();
+
+            const EcsView view = mWorld.Match( mWorld.GetSignature<TestEcsComponent>() );
+            TEST_ASSERT( view.Size() == numEntities - numEntities / 4 );
+            for( int i = 0; i < numEntities; i++ )
+            {
+                if( i % 4 == 0 )
+                {
+                    TEST_ASSERT( !mWorld.HandleExists( handles[i] ) );
+                    continue;
+                }
+                const EcsEntity entity = mWorld.GetEntity( handles[i] );
+                TEST_ASSERT( mWorld.GetHandle( entity ) == handles[i] );
+                TEST_ASSERT( mWorld.GetComponent<TestEcsComponent>( entity ).mValueInt == i );
+                TEST_ASSERT( mWorld.HasComponent<TestEcsComponent2>( entity ) == ( i % 4 == 1 ) );
+                TEST_ASSERT( mWorld.HasTag<TagTest>( entity ) == ( i % 4 == 2 ) );
+                if( i % 4 == 1 )
+                {
+                    TEST_ASSERT( mWorld.GetComponent<TestEcsComponent2>( entity ).mValueInt == 2 * i );
+                }
+            }
+
+            // removes the component & kill the rest
+            for( int i = 1; i < numEntities; i += 4 )
+            {
+                mWorld.RemoveComponent<TestEcsComponent2>( mWorld.GetEntity( handles[i] ) );
+            }
+            for( int i = 2; i < numEntities; i += 4 )
+            {
+                mWorld.Kill( mWorld.GetEntity( handles[i] ) );
+            }
+            mWorld.ApplyTransitions();
+            TEST_ASSERT( view.Size() == numEntities / 2 );
+            TEST_ASSERT( mWorld.GetHandles().Size() == numEntities / 2 );
+            for( int i = 0; i < numEntities; i++ )
+            {
+                if( i % 4 == 1 || i % 4 == 3 )
+                {
+                    const EcsEntity entity = mWorld.GetEntity( handles[i] );
+                    TEST_ASSERT( mWorld.GetComponent<TestEcsComponent>( entity ).mValueInt == i );
+                    TEST_ASSERT( !mWorld.HasComponent<TestEcsComponent2>( entity ) );
+                }
+            }
+        }
+
+        void TestArchetypeEdges()
+        {
+            EcsEntity entity = mWorld.CreateEntity();
+            mWorld.AddComponent<TestEcsComponent>( entity );
+            const EcsHandle handle = mWorld.AddHandle( entity );
+            mWorld.ApplyTransitions();
+            EcsArchetype* archetype = mWorld.GetEntity( handle ).mArchetype;
+
+            const int tagIndex = mWorld.GetIndex( TagTest::Info::sType );
+            TEST_ASSERT( archetype->GetAddEdge( tagIndex ) == nullptr );
+            mWorld.AddTag<TagTest>( mWorld.GetEntity( handle ) );
+            mWorld.ApplyTransitions();
+            EcsArchetype* taggedArchetype = mWorld.GetEntity( handle ).mArchetype;
+            TEST_ASSERT( archetype->GetAddEdge( tagIndex ) == taggedArchetype );
+            TEST_ASSERT( taggedArchetype->GetRemoveEdge( tagIndex ) == archetype );
+
+            mWorld.RemoveTag<TagTest>( mWorld.GetEntity( handle ) );
+            mWorld.ApplyTransitions();
+            TEST_ASSERT( mWorld.GetEntity( handle ).mArchetype == archetype );
+            TEST_ASSERT( !mWorld.HasTag<TagTest>( mWorld.GetEntity( handle ) ) );
+        }
+
+        void TestHandleTable()
+        {
+            EcsHandleTable table;
+            EcsArchetype&  archetype = const_cast<EcsArchetype&>( mWorld.GetTransitionArchetype() );
+            table.Set( 1, { &archetype, 0 } );
+            table.Set( 3 * EcsHandleTable::sPageSize + 2, { &archetype, 1 } );
+            TEST_ASSERT( table.Size() == 2 );
+            TEST_ASSERT( table.Contains( 1 ) );
+            TEST_ASSERT( !table.Contains( 2 ) );
+            TEST_ASSERT( !table.Contains( 100 * EcsHandleTable::sPageSize ) );
+            TEST_ASSERT( table.At( 3 * EcsHandleTable::sPageSize + 2 ).mIndex == 1 );
+
+            int numHandles = 0;
+            table.ForEach( [&numHandles]( const EcsHandle, const EcsEntity& ) { numHandles++; } );
+            TEST_ASSERT( numHandles == 2 );
+
+            table.Remove( 3 * EcsHandleTable::sPageSize + 2 );
+            TEST_ASSERT( table.Size() == 1 );
+            TEST_ASSERT( !table.Contains( 3 * EcsHandleTable::sPageSize + 2 ) );
+
+            // handles of killed entities are not reused
+            EcsEntity entity = mWorld.CreateEntity();
+            mWorld.AddComponent<TestEcsComponent>( entity );
+            const EcsHandle handle = mWorld.AddHandle( entity );
+            mWorld.ApplyTransitions();
+            mWorld.Kill( mWorld.GetEntity( handle ) );
+            mWorld.ApplyTransitions();
+            TEST_ASSERT( !mWorld.HandleExists( handle ) );
+            entity = mWorld.CreateEntity();
+            mWorld.AddComponent<TestEcsComponent>( entity );
+            TEST_ASSERT( mWorld.AddHandle( entity ) != handle );
+            TEST_ASSERT( !mWorld.HandleExists( handle ) );
+
+            // specific handles can be assigned far from the others
+            entity = mWorld.CreateEntity();
+            mWorld.AddComponent<TestEcsComponent>( entity );
+            const EcsHandle farHandle = mWorld.GetNextHandle() + 10 * EcsHandleTable::sPageSize;
+            mWorld.SetHandle( entity, farHandle );
+            mWorld.ApplyTransitions();
+            TEST_ASSERT( mWorld.HandleExists( farHandle ) );
+            TEST_ASSERT( mWorld.GetHandle( mWorld.GetEntity( farHandle ) ) == farHandle );
+        }
+
+        void TestKillDestroy()
+        {
+            TestEcsComponentDestroy::sNumDestroyed = 0;
+
+            // killed after the transitions were applied
+            EcsEntity entity = mWorld.CreateEntity();
+            mWorld.AddComponent<TestEcsComponentDestroy>( entity );
+            const EcsHandle handle = mWorld.AddHandle( entity );
+            mWorld.ApplyTransitions();
+            mWorld.Kill( mWorld.GetEntity( handle ) );
+            mWorld.ApplyTransitions();
+            TEST_ASSERT( TestEcsComponentDestroy::sNumDestroyed == 1 );
+
+            // component added then killed on the same frame, destroy is called once
+            entity = mWorld.CreateEntity();
+            mWorld.AddComponent<TestEcsComponent>( entity );
+            const EcsHandle handle2 = mWorld.AddHandle( entity );
+            mWorld.ApplyTransitions();
+            entity = mWorld.GetEntity( handle2 );
+            mWorld.AddComponent<TestEcsComponentDestroy>( entity );
+            mWorld.Kill( entity );
+            mWorld.Kill( entity );
+            mWorld.ApplyTransitions();
+            TEST_ASSERT( TestEcsComponentDestroy::sNumDestroyed == 2 );
+        }
+
+        void TestCreateFromSignature()
+        {
+            EcsWorld world;
+            world.AddComponentType<TestEcsComponent>();
+            world.AddComponentType<TestEcsComponent2>();
+            world.AddTagType<TagTest>();
+            const EcsSignature signature = world.GetSignature<TestEcsComponent>() |
+                                           world.GetSignature<TestEcsComponent2>() |
+                                           world.GetSignature<TagTest>();
+
+            // no archetype yet, the entity is created in the transition archetype
+            EcsEntity entity = world.CreateEntity( signature, 1 );
+            TEST_ASSERT( entity.mArchetype == &world.GetTransitionArchetype() );
+            TEST_ASSERT( world.HasComponent<TestEcsComponent2>( entity ) );
+            TEST_ASSERT( world.HasTag<TagTest>( entity ) );
+            world.GetComponent<TestEcsComponent>( entity ).mValueInt = 1;
+            world.ApplyTransitions();
+            TEST_ASSERT( world.Match( signature ).Size() == 1 );
+
+            // the archetype exists, the entity is pushed directly in it
+            entity = world.CreateEntity( signature, 2 );
+            TEST_ASSERT( entity.mArchetype->GetSignature() == signature );
+            TEST_ASSERT( world.GetTransitionArchetype().Empty() );
+            TEST_ASSERT( world.Match( signature ).Size() == 2 );
+            TEST_ASSERT( world.GetEntity( 2 ).mIndex == entity.mIndex );
+            world.GetComponent<TestEcsComponent2>( entity ).mValueInt = 2;
+            world.ApplyTransitions();
+            TEST_ASSERT( world.GetComponent<TestEcsComponent>( world.GetEntity( 1 ) ).mValueInt == 1 );
+            TEST_ASSERT( world.GetComponent<TestEcsComponent2>( world.GetEntity( 2 ) ).mValueInt == 2 );
+
+            // can be killed on the frame it is created
+            world.Kill( world.CreateEntity( signature ) );
+            world.ApplyTransitions();
+            TEST_ASSERT( world.Match( signature ).Size() == 2 );
+
+            // systems views must stay valid, entities created while they run wait for ApplyTransitions
+            world.Run<STestCreateEntity>( signature, entity );
+            TEST_ASSERT( entity.mArchetype == &world.GetTransitionArchetype() );
+            TEST_ASSERT( world.Match( signature ).Size() == 2 );
+            world.ApplyTransitions();
+            TEST_ASSERT( world.Match( signature ).Size() == 3 );
+        }
+
+        void TestChangeDetection()
+        {
+            const int numEntities = 3000;
+            for( int i = 0; i < numEntities; i++ )
+            {
+                EcsEntity entity = mWorld.CreateEntity();
+                mWorld.AddComponent<TestEcsComponent>( entity );
+                mWorld.AddComponent<TestEcsComponent2>( entity );
+            }
+            mWorld.ApplyTransitions();
+            const EcsView view      = mWorld.Match( mWorld.GetSignature<TestEcsComponent2>() );
+            EcsArchetype* archetype = nullptr;
+            for( EcsArchetype* viewArchetype : view.mArchetypes )
+            {
+                if( viewArchetype->Size() == numEntities ) { archetype = viewArchetype; }
+            }
+            TEST_ASSERT( archetype != nullptr );
+            const int componentIndex = mWorld.GetIndex( TestEcsComponent2::Info::sType );
+            const int capacity       = archetype->GetChunkVector( componentIndex ).ChunkCapacity();
+            TEST_ASSERT( capacity < numEntities / 2 );
+
+            // everything changed on the first run, then nothing changed
+            int numCopies = 0;
+            mWorld.Run<STestCopyChanged>( numCopies );
+            TEST_ASSERT( numCopies == numEntities );
+            mWorld.Run<STestCopyChanged>( numCopies );
+            TEST_ASSERT( numCopies == 0 );
+
+            // const accesses do not change anything
+            view.ForEach<const TestEcsComponent2>( []( const TestEcsComponent2& ) {} );
+            mWorld.Run<STestCopyChanged>( numCopies );
+            TEST_ASSERT( numCopies == 0 );
+
+            // neither do read only lookups
+            const EcsEntity readEntity = { archetype, 0 };
+            const EcsWorld& constWorld = mWorld;
+            const TestEcsComponent2& readComponent = mWorld.GetComponent<const TestEcsComponent2>( readEntity );
+            TEST_ASSERT( mWorld.SafeGetComponent<const TestEcsComponent2>( readEntity ) == &readComponent );
+            TEST_ASSERT( &constWorld.GetComponent( readEntity, TestEcsComponent2::Info::sType ) == &readComponent );
+            mWorld.Run<STestCopyChanged>( numCopies );
+            TEST_ASSERT( numCopies == 0 );
+
+            // only the chunk of the modified component changed
+            const EcsEntity entity = { archetype, uint32_t( capacity + 1 ) };
+            mWorld.GetComponent<TestEcsComponent2>( entity ).mValueInt = 42;
+            mWorld.Run<STestCopyChanged>( numCopies );
+            TEST_ASSERT( numCopies == capacity );
+            TEST_ASSERT( mWorld.GetComponent<TestEcsComponent>( entity ).mValueInt == 42 );
+
+            // writes from other systems
+            mWorld.Run<STestIncrement2>( 1 );
+            mWorld.Run<STestCopyChanged>( numCopies );
+            TEST_ASSERT( numCopies == numEntities );
+
+            // structural changes, the hole left by the killed entity is filled with the last entity
+            mWorld.Kill( { archetype, 0 } );
+            mWorld.ApplyTransitions();
+            mWorld.Run<STestCopyChanged>( numCopies );
+            TEST_ASSERT( numCopies == capacity );
+        }
+
+        void TestChunkAllocator()
+        {
+            EcsChunkAllocator allocator( 8 );
+            std::vector<void*> chunks;
+            for( int i = 0; i < 100; i++ )
+            {
+                uint8_t* chunk = static_cast<uint8_t*>( allocator.Alloc() );
+                TEST_ASSERT( reinterpret_cast<uintptr_t>( chunk ) % 4096 == 0 );
+                chunk[0] = chunk[EcsChunkAllocator::sChunkSize - 1] = uint8_t( i );
+                chunks.push_back( chunk );
+            }
+            EcsChunkAllocator::Stats stats = allocator.GetStats();
+            TEST_ASSERT( stats.mLiveChunks == 100 );
+            TEST_ASSERT( stats.mPeakLiveChunks == 100 );
+            for( void* chunk : chunks ) { allocator.Free( chunk ); }
+
+            // chunks freed past the retention cap are returned to the OS
+            stats = allocator.GetStats();
+            TEST_ASSERT( stats.mLiveChunks == 0 );
+            TEST_ASSERT( stats.mReleasedChunks > 0 );
+            TEST_ASSERT( stats.mFreeChunks + stats.mReleasedChunks == stats.mCommittedChunks );
+
+            // released chunks are usable again
+            uint8_t* chunk = nullptr;
+            for( int i = 0; i < 100; i++ )
+            {
+                chunk = static_cast<uint8_t*>( allocator.Alloc() );
+                chunk[0] = 42;
+            }
+            TEST_ASSERT( allocator.GetStats().mLiveChunks == 100 );
+            TEST_ASSERT( allocator.GetStats().mReleasedChunks == 0 );
+
+            // allocates & frees from several threads
+            std::vector<std::thread> threads;
+            for( int threadIndex = 0; threadIndex < 4; threadIndex++ )
+            {
+                threads.emplace_back( [&allocator]()
+                {
+                    std::vector<void*> threadChunks;
+                    for( int i = 0; i < 1000; i++ )
+                    {
+                        threadChunks.push_back( allocator.Alloc() );
+                        if( i % 3 == 0 )
+                        {
+                            allocator.Free( threadChunks.back() );
+                            threadChunks.pop_back();
+                        }
+                    }
+                    for( void* threadChunk : threadChunks ) { allocator.Free( threadChunk ); }
+                } );
+            }
+            for( std::thread& thread : threads ) { thread.join(); }
+            TEST_ASSERT( allocator.GetStats().mLiveChunks == 100 );
+        }
+
+        void TestViewForEach()
+        {
+            // crosses the chunks boundaries of both components
+            const int numEntities = 20000;
+            for( int i = 0; i < numEntities; i++ )
+            {
+                EcsEntity entity = mWorld.CreateEntity();
+                mWorld.AddComponent<TestEcsComponent>( entity ).mValueInt = i;
+                mWorld.AddComponent<TestEcsComponent2>( entity ).mValueInt = i;
+            }
+            mWorld.ApplyTransitions();
+
+            const EcsView view = mWorld.Match( mWorld.GetSignature<TestEcsComponent>() |
+                                               mWorld.GetSignature<TestEcsComponent2>() );
+            int count = 0;
+            bool matching = true;
+            view.ForEach<TestEcsComponent, TestEcsComponent2>( [&]( TestEcsComponent& _component,
+                                                                    TestEcsComponent2& _component2 )
+            {
+                matching &= ( _component.mValueInt == _component2.mValueInt );
+                count++;
+            } );
+            TEST_ASSERT( count == numEntities );
+            TEST_ASSERT( matching );
+
+            // iterators must visit the same elements
+            count = 0;
+            auto it2 = view.begin<TestEcsComponent2>();
+            for( auto it = view.begin<TestEcsComponent>(); it != view.end<TestEcsComponent>(); ++it, ++it2 )
+            {
+                TEST_ASSERT( ( *it ).mValueInt == ( *it2 ).mValueInt );
+                TEST_ASSERT( it.GetEntity().mIndex == it2.GetEntity().mIndex );
+                count++;
+            }
+            TEST_ASSERT( count == numEntities );
+        }
+
+        void TestParallelForEach()
+        {
+            const int numEntities = 20000;
+            for( int i = 0; i < numEntities; i++ )
+            {
+                EcsEntity entity = mWorld.CreateEntity();
+                mWorld.AddComponent<TestEcsComponent>( entity ).mValueInt = i;
+                mWorld.AddComponent<TestEcsComponent2>( entity ).mValueInt = i;
+            }
+            mWorld.ApplyTransitions();
+
+            const EcsView view = mWorld.Match( mWorld.GetSignature<TestEcsComponent>() |
+                                               mWorld.GetSignature<TestEcsComponent2>() );
+            view.ParallelForEach<TestEcsComponent2, TestEcsComponent>( []( TestEcsComponent2& _component2,
+                                                                           TestEcsComponent& _component )
+            {
+                _component2.mValueInt += _component.mValueInt;
+            } );
+
+            // outputs are ordered like the entities of the view
+            std::vector<std::vector<EcsEntity>> outputs;
+            view.ParallelForEach<TestEcsComponent>( outputs, []( std::vector<EcsEntity>& _output,
+                                                                 const EcsEntity _entity,
+                                                                 TestEcsComponent& /*_component*/ )
+            {
+                _output.push_back( _entity );
+            } );
+            TEST_ASSERT( outputs.size() > 1 );
+
+            int count = 0;
+            auto it = view.begin<TestEcsComponent>();
+            auto it2 = view.begin<TestEcsComponent2>();
+            for( const std::vector<EcsEntity>& output : outputs )
+            {
+                for( const EcsEntity entity : output )
+                {
+                    TEST_ASSERT( it2.GetEntity().mIndex == entity.mIndex );
+                    TEST_ASSERT( ( *it2 ).mValueInt == 2 * ( *it ).mValueInt );
+                    ++it;
+                    ++it2;
+                    count++;
+                }
+            }
+            TEST_ASSERT( count == numEntities );
+        }
+
+        void TestScheduler()
+        {
+            for( int i = 0; i < 100; i++ )
+            {
+                EcsEntity entity = mWorld.CreateEntity();
+                mWorld.AddComponent<TestEcsComponent>( entity );
+                mWorld.AddComponent<TestEcsComponent2>( entity );
+            }
+            mWorld.ApplyTransitions();
+
+            ThreadPool threadPool( 2 );
+            {
+                EcsScheduler scheduler( mWorld, threadPool );
+                scheduler.Add<STestIncrement>( 1 );
+                scheduler.Add<STestIncrement2>( 10 );
+                TEST_ASSERT( scheduler.NumWaves() == 1 );
+                scheduler.Add<STestCopy>();
+                TEST_ASSERT( scheduler.NumWaves() == 2 );
+                scheduler.Add<STestIncrement>( 2 );// after the copy
+                TEST_ASSERT( scheduler.NumWaves() == 3 );
+                scheduler.Run();
+            }
+
+            const EcsView view = mWorld.Match<STestCopy>();
+            bool valid = true;
+            view.ForEach<TestEcsComponent, TestEcsComponent2>( [&]( TestEcsComponent& _component,
+                                                                    TestEcsComponent2& _component2 )
+            {
+                valid &= _component.mValueInt == 3 && _component2.mValueInt == 1;
+            } );
+            TEST_ASSERT( valid );
+
+            // a scheduler kept between runs uses the current value of the arguments bound with std::cref
+            {
+                EcsScheduler scheduler( mWorld, threadPool );
+                int value = 1;
+                scheduler.Add<STestIncrement>( std::cref( value ) );
+                scheduler.Add<STestIncrement2>( std::cref( value ) );
+                scheduler.Run();
+                value = 2;
+                scheduler.Run();
+                TEST_ASSERT( scheduler.NumWaves() == 1 );
+            }
+            view.ForEach<TestEcsComponent, TestEcsComponent2>( [&]( TestEcsComponent& _component,
+                                                                    TestEcsComponent2& _component2 )
+            {
+                valid &= _component.mValueInt == 6 && _component2.mValueInt == 4;
+            } );
+            TEST_ASSERT( valid );
+
+            // waves matching less entities than the threshold run serially
+            {
+                EcsScheduler scheduler( mWorld, threadPool );
+                scheduler.Add<STestIncrement>( 1 );
+                scheduler.Add<STestIncrement2>( 1 );
+                scheduler.SetMinParallelEntities( 1000 );
+                scheduler.Run();
+                TEST_ASSERT( scheduler.NumParallelWaves() == 0 );
+                scheduler.SetMinParallelEntities( 100 );
+                scheduler.Run();
+                TEST_ASSERT( scheduler.NumParallelWaves() == 1 );
+            }
+            view.ForEach<TestEcsComponent, TestEcsComponent2>( [&]( TestEcsComponent& _component,
+                                                                    TestEcsComponent2& _component2 )
+            {
+                valid &= _component.mValueInt == 8 && _component2.mValueInt == 6;
+            } );
+            TEST_ASSERT( valid );
+
+            // systems without access run alone
+            {
+                EcsScheduler scheduler( mWorld, threadPool );
+                scheduler.Add<STestIncrement2>( 1 );
+                scheduler.Add<STestKillAll>();
+                scheduler.Add<STestIncrement>( 1 );
+                TEST_ASSERT( scheduler.NumWaves() == 3 );
+                scheduler.Run();
+            }
+            mWorld.ApplyTransitions();
+            TEST_ASSERT( mWorld.Match<STestKillAll>().Empty() );
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "core/time/fanClock.hpp"
+#include "core/time/fanPreciseSleep.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    class UnitTestPreciseSleep : public UnitTest<UnitTestPreciseSleep>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestPreciseSleep::TestMonotonicClock, "Monotonic clock" },
+                     { &UnitTestPreciseSleep::TestSleepUntil,     "Sleep until" },
+                     { &UnitTestPreciseSleep::TestPastTime,       "Past time" },
+            };
+        }
+        void Create() override {}
+        void Destroy() override {}
+
+        void TestMonotonicClock()
+        {
+            double previous = Clock::SecondsSinceStartup();
+            for( int i = 0; i < 1000; i++ )
+            {
+                const double now = Clock::SecondsSinceStartup();
+                TEST_ASSERT( now >= previous );
+                previous = now;
+            }
+        }
+
+        void TestSleepUntil()
+        {
+            PreciseSleep preciseSleep;
+            for( int i = 0; i < 10; i++ )
+            {
+                const double wakeTime = Clock::SecondsSinceStartup() + 0.002;
+                preciseSleep.SleepUntil( wakeTime );
+                TEST_ASSERT( Clock::SecondsSinceStartup() >= wakeTime );
+            }
+            TEST_ASSERT( preciseSleep.OvershootEstimate() >= 0. );
+            TEST_ASSERT( preciseSleep.OvershootEstimate() <= PreciseSleep::sMaxSpinTime );
+        }
+
+        void TestPastTime()
+        {
+            PreciseSleep preciseSleep;
+            const double start = Clock::SecondsSinceStartup();
+            preciseSleep.SleepUntil( start - 1. );
+            TEST_ASSERT( Clock::SecondsSinceStartup() - start < 0.05 ); // doesn't sleep
+        }
+    };
+}
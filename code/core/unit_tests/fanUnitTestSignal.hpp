@@ -56,6 +56,7 @@ namespace fan
             TestComponent& testComponent = static_cast<TestComponent&>(_component);
             testComponent.mValueFloat = _value;
         }
+        void SetValueIntMethod( int _value ) { mValueInt = _value; }
         static void DoNothing( EcsComponent& _component )
         {
             (void)_component;
@@ -79,6 +80,9 @@ namespace fan
                      { &UnitTestSignal::TestSlotPtrSingleton,   "Slot ptr singleton" },
                      { &UnitTestSignal::TestSignalSlotComponent,"Signal slot component" },
                      { &UnitTestSignal::TestSignalSlotSingleton,"Signal slot singleton" },
+                     { &UnitTestSignal::TestOverflow,           "Overflow" },
+                     { &UnitTestSignal::TestConnectComponent,   "Connect component" },
+                     { &UnitTestSignal::TestReentrance,         "Reentrance" },
             };
         }
         void Create() override
@@ -220,5 +224,77 @@ namespace fan
             signalInt.Emmit(64);
             TEST_ASSERT( testSingleton.mValueInt == 42 );
         }
+
+        struct TestAccumulator
+        {
+            void Add( int _value ) { mSum += _value; }
+            int mSum = 0;
+        };
+
+        // connections beyond the inline ones are stored in the overflow & copied with the signal
+        void TestOverflow()
+        {
+            static constexpr int sNumAccumulators = Signal<int>::sInlineConnections + 3;
+            TestAccumulator accumulators[sNumAccumulators];
+            Signal<int> signal;
+            for( TestAccumulator& accumulator : accumulators ) { signal.Connect( &TestAccumulator::Add, &accumulator ); }
+            TEST_ASSERT( signal.ConnectionsCount() == sNumAccumulators );
+            signal.Emmit( 1 );
+            for( TestAccumulator& accumulator : accumulators ) { TEST_ASSERT( accumulator.mSum == 1 ); }
+
+            // removes an inline & an overflow connection, the order is kept
+            signal.Disconnect( (size_t)&accumulators[0] );
+            signal.Disconnect( (size_t)&accumulators[sNumAccumulators - 2] );
+            TEST_ASSERT( signal.ConnectionsCount() == sNumAccumulators - 2 );
+            Signal<int> copy = signal;
+            signal.Clear();
+            signal.Emmit( 10 );
+            copy.Emmit( 2 );
+            TEST_ASSERT( accumulators[0].mSum == 1 );
+            TEST_ASSERT( accumulators[1].mSum == 3 );
+            TEST_ASSERT( accumulators[sNumAccumulators - 2].mSum == 1 );
+            TEST_ASSERT( accumulators[sNumAccumulators - 1].mSum == 3 );
+
+            copy.Connect( &TestAccumulator::Add, &accumulators[0] );
+            copy.Emmit( 1 );
+            TEST_ASSERT( accumulators[0].mSum == 2 );
+        }
+
+        void TestConnectComponent()
+        {
+            EcsEntity entity = mWorld.CreateEntity();
+            EcsHandle handle = mWorld.AddHandle( entity );
+            mWorld.AddComponent<TestComponent>( entity );
+            mWorld.ApplyTransitions();
+
+            Signal<int> signal;
+            signal.Connect( &TestComponent::SetValueIntMethod, mWorld, handle );
+            signal.Emmit( 7 );
+            TEST_ASSERT( mWorld.GetComponent<TestComponent>( mWorld.GetEntity( handle ) ).mValueInt == 7 );
+            signal.Disconnect( handle );
+            TEST_ASSERT( signal.ConnectionsCount() == 0 );
+        }
+
+        // connections can disconnect the signal while it is emitted
+        struct TestDisconnecter
+        {
+            void OnEmmit() { mCount++; mSignal->Disconnect( (size_t)this ); }
+            Signal<>* mSignal;
+            int       mCount = 0;
+        };
+        void TestReentrance()
+        {
+            Signal<> signal;
+            TestDisconnecter disconnecters[Signal<>::sInlineConnections + 1];
+            for( TestDisconnecter& disconnecter : disconnecters )
+            {
+                disconnecter.mSignal = &signal;
+                signal.Connect( &TestDisconnecter::OnEmmit, &disconnecter );
+            }
+            signal.Emmit();
+            signal.Emmit();
+            TEST_ASSERT( signal.ConnectionsCount() == 0 );
+            for( TestDisconnecter& disconnecter : disconnecters ) { TEST_ASSERT( disconnecter.mCount == 1 ); }
+        }
     };
 }
\ No newline at end of file
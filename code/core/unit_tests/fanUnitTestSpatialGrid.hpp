@@ -0,0 +1,95 @@
+#pragma once
+
+#include <set>
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "core/math/fanSpatialGrid.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    class UnitTestSpatialGrid : public UnitTest<UnitTestSpatialGrid>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestSpatialGrid::TestEmpty,         "Empty" },
+                     { &UnitTestSpatialGrid::TestQuery,         "Query" },
+                     { &UnitTestSpatialGrid::TestNegativeCells, "Negative cells" },
+                     { &UnitTestSpatialGrid::TestBruteForce,    "Brute force" },
+            };
+        }
+        void Create() override {}
+        void Destroy() override {}
+
+        SpatialGrid mGrid;
+
+        std::set<int> Query( const float _x, const float _z, const float _radius ) const
+        {
+            std::set<int> result;
+            mGrid.Query( _x, _z, _radius, [&result]( const int _index, const float ) { result.insert( _index ); } );
+            return result;
+        }
+
+        void TestEmpty()
+        {
+            mGrid.Clear( 10.f );
+            mGrid.Build();
+            TEST_ASSERT( mGrid.Size() == 0 );
+            TEST_ASSERT( Query( 0.f, 0.f, 100.f ).empty() );
+        }
+
+        void TestQuery()
+        {
+            mGrid.Clear( 10.f );
+            mGrid.Insert( 0, 0.f, 0.f );
+            mGrid.Insert( 1, 5.f, 5.f );
+            mGrid.Insert( 2, 25.f, 0.f );
+            mGrid.Insert( 3, 100.f, 100.f );
+            mGrid.Build();
+            TEST_ASSERT( mGrid.Size() == 4 );
+            TEST_ASSERT( Query( 0.f, 0.f, 1.f ) == std::set<int>( { 0 } ) );
+            TEST_ASSERT( Query( 0.f, 0.f, 10.f ) == std::set<int>( { 0, 1 } ) );
+            TEST_ASSERT( Query( 0.f, 0.f, 25.f ) == std::set<int>( { 0, 1, 2 } ) );
+            TEST_ASSERT( Query( 100.f, 100.f, 0.5f ) == std::set<int>( { 3 } ) );
+            TEST_ASSERT( Query( 50.f, 50.f, 10.f ).empty() );
+        }
+
+        void TestNegativeCells()
+        {
+            mGrid.Clear( 10.f );
+            mGrid.Insert( 0, -1.f, -1.f );
+            mGrid.Insert( 1, 1.f, 1.f );
+            mGrid.Insert( 2, -15.f, 3.f );
+            mGrid.Build();
+            TEST_ASSERT( Query( 0.f, 0.f, 2.f ) == std::set<int>( { 0, 1 } ) );
+            TEST_ASSERT( Query( -14.f, 3.f, 2.f ) == std::set<int>( { 2 } ) );
+        }
+
+        void TestBruteForce()
+        {
+            const int numEntries = 500;
+            float positions[numEntries][2];
+            mGrid.Clear( 7.f );
+            for( int i = 0; i < numEntries; i++ )
+            {
+                positions[i][0] = float( ( i * 7919 ) % 200 ) - 100.f;
+                positions[i][1] = float( ( i * 104729 ) % 200 ) - 100.f;
+                mGrid.Insert( i, positions[i][0], positions[i][1] );
+            }
+            mGrid.Build();
+
+            for( float radius : { 3.f, 7.f, 20.f } )
+            {
+                std::set<int> expected;
+                for( int i = 0; i < numEntries; i++ )
+                {
+                    const float dx = positions[i][0] - 10.f;
+                    const float dz = positions[i][1] + 20.f;
+                    if( dx * dx + dz * dz <= radius * radius ) { expected.insert( i ); }
+                }
+                TEST_ASSERT( Query( 10.f, -20.f, radius ) == expected );
+            }
+        }
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <thread>
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "core/fanSpscRing.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    class UnitTestSpscRing : public UnitTest<UnitTestSpscRing>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestSpscRing::TestEmpty,     "Empty" },
+                     { &UnitTestSpscRing::TestFull,      "Full" },
+                     { &UnitTestSpscRing::TestWrap,      "Wrap" },
+                     { &UnitTestSpscRing::TestBatch,     "Batch" },
+                     { &UnitTestSpscRing::TestTwoThreads, "Two threads" },
+            };
+        }
+        void Create() override {}
+        void Destroy() override {}
+
+        using Ring = SpscRing<int, 8>;
+
+        void TestEmpty()
+        {
+            Ring ring;
+            TEST_ASSERT( ring.Empty() );
+            TEST_ASSERT( ring.Front() == nullptr );
+            TEST_ASSERT( ring.Push( 42 ) );
+            TEST_ASSERT( ring.Size() == 1 );
+            TEST_ASSERT( ring.Front() != nullptr && *ring.Front() == 42 );
+            ring.Pop();
+            TEST_ASSERT( ring.Empty() );
+        }
+
+        void TestFull()
+        {
+            Ring ring;
+            for( int i = 0; i < int( Ring::sCapacity ); i++ ) { TEST_ASSERT( ring.Push( i ) ); }
+            TEST_ASSERT( ring.Size() == Ring::sCapacity );
+            TEST_ASSERT( ring.BeginPush() == nullptr );
+            TEST_ASSERT( !ring.Push( 99 ) );
+            ring.Pop();
+            TEST_ASSERT( ring.Push( 99 ) );
+        }
+
+        void TestWrap()
+        {
+            Ring ring;
+            int nextPushed = 0;
+            int nextPopped = 0;
+            for( int i = 0; i < 100; i++ )
+            {
+                for( int j = 0; j < 5; j++ ) { TEST_ASSERT( ring.Push( nextPushed++ ) ); }
+                for( int j = 0; j < 5; j++ )
+                {
+                    TEST_ASSERT( *ring.Front() == nextPopped++ );
+                    ring.Pop();
+                }
+            }
+            TEST_ASSERT( ring.Empty() );
+        }
+
+        void TestBatch()
+        {
+            Ring ring;
+            ring.Push( -1 );
+            for( int i = 0; i < int( Ring::sCapacity ) - 1; i++ ) { *ring.BeginPush( i ) = i; }
+            TEST_ASSERT( ring.BeginPush( Ring::sCapacity - 1 ) == nullptr );
+            TEST_ASSERT( ring.Size() == 1 );
+            ring.EndPush( Ring::sCapacity - 1 );
+            TEST_ASSERT( ring.Size() == Ring::sCapacity );
+
+            ring.Pop();
+            TEST_ASSERT( *ring.Front( 3 ) == 3 );
+            TEST_ASSERT( ring.Front( Ring::sCapacity - 1 ) == nullptr );
+            ring.Pop( 4 );
+            TEST_ASSERT( *ring.Front() == 4 );
+            TEST_ASSERT( ring.Size() == Ring::sCapacity - 5 );
+        }
+
+        void TestTwoThreads()
+        {
+            constexpr int count = 100000;
+            Ring ring;
+            std::thread producer( [&ring]()
+            {
+                for( int i = 0; i < count; i++ )
+                {
+                    while( !ring.Push( i ) ) { std::this_thread::yield(); }
+                }
+            } );
+
+            bool isOrdered = true;
+            for( int expected = 0; expected < count; )
+            {
+                const int* item = ring.Front();
+                if( item == nullptr )
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                isOrdered &= *item == expected++;
+                ring.Pop();
+            }
+            producer.join();
+            TEST_ASSERT( isOrdered );
+            TEST_ASSERT( ring.Empty() );
+        }
+    };
+}
@@ -4,6 +4,7 @@
 #include "network/singletons/fanTime.hpp"
 #include "editor/windows/fanPreferencesWindow.hpp"
 #include "editor/windows/fanUnitsTestsWindow.hpp"
+#include "editor/windows/fanBenchmarksWindow.hpp"
 #include "editor/windows/fanSingletonsWindow.hpp"
 #include "editor/windows/fanInspectorWindow.hpp"
 #include "editor/windows/fanProfilerWindow.hpp"
@@ -78,7 +79,8 @@ namespace fan
             new ProfilerWindow(),
             new PreferencesWindow( mRenderer, mFullScreen ),
             new SingletonsWindow(),
-            new UnitTestsWindow()
+            new UnitTestsWindow(),
+            new BenchmarksWindow()
         } );
 
         // Instance messages
@@ -130,6 +132,15 @@ namespace fan
             RenderWorld& renderWorld = world.GetSingleton<RenderWorld>();
             renderWorld.mIsHeadless = ( &game != &GetCurrentGame() );
 
+            if( _settings.mTickRate > 0 )
+            {
+                world.GetSingleton<Time>().SetTickRate( float( _settings.mTickRate ) );
+            }
+            if( _settings.mSnapshotRate > 0 )
+            {
+                world.GetSingleton<Time>().mSnapshotRate = float( _settings.mSnapshotRate );
+            }
+
             Scene          & scene     = world.GetSingleton<Scene>();
             EditorSelection& selection = world.GetSingleton<EditorSelection>();
 
@@ -178,6 +189,7 @@ namespace fan
             SerializedValues::SaveWindowPosition( mWindow.GetPosition() );
             SerializedValues::SaveWindowSize( mWindow.GetSize() );
         }
+        Input::Get().SaveKeyBindings();
         SerializedValues::Get().SaveValuesToDisk();
     }
 
@@ -338,6 +350,7 @@ namespace fan
             UpdateRenderWorld( mRenderer, GetCurrentGame(), ToGLM( mGameViewWindow->GetSize() ) );
 
             mRenderer.DrawFrame();
+            EcsChunk::sAllocator.ReportToProfiler();
             Profiler::Get().End();
             Profiler::Get().Begin();
         }
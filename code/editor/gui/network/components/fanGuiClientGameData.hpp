@@ -27,7 +27,7 @@ namespace fan
             ImGui::PushItemWidth( 0.6f * ImGui::GetWindowWidth() - 16 );
             {
                 ImGui::Text( "player ID           : %u", gameData.mPlayerId );
-                ImGui::DragInt( "max input sent", &gameData.mMaxInputSent, 1.f, 0, 200 );
+                ImGui::DragInt( "max input sent", &gameData.mMaxInputSent, 1.f, 0, PacketInput::sMaxInputs );
                 ImGui::Text( "size previous states:  %d", gameData.mPreviousLocalStates.size() );
                 ImGui::Text( "%s", gameData.mFrameSynced ? "frame synced" : "frame not synced" );
                 ImGui::Text( "size pending inputs:  %d", gameData.mPreviousInputs.size() );
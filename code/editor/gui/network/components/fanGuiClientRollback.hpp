@@ -27,14 +27,14 @@ namespace fan
             {
                 ClientRollback& clientRollback = static_cast<ClientRollback&>( _component );
 
-                const FrameIndex newestFrameIndex = clientRollback.mRollbackDatas.empty()
+                const FrameIndex newestFrameIndex = clientRollback.Empty()
                         ? 0
-                        : clientRollback.mRollbackDatas.back().mFrameIndex;
-                const FrameIndex oldestFrameIndex = clientRollback.mRollbackDatas.empty()
+                        : clientRollback.NewestFrameIndex();
+                const FrameIndex oldestFrameIndex = clientRollback.Empty()
                         ? 0
-                        : clientRollback.mRollbackDatas.front().mFrameIndex;
+                        : clientRollback.OldestFrameIndex();
 
-                ImGui::Text( "Num saved states: %d", clientRollback.mRollbackDatas.size() );
+                ImGui::Text( "Num saved frames: %d / %d", clientRollback.NumFrames(), ClientRollback::sMaxFrames );
                 ImGui::Text( "Range [%d,%d]", oldestFrameIndex, newestFrameIndex );
             }
             ImGui::Unindent();
@@ -0,0 +1,44 @@
+#include "network/components/fanEntityInterpolation.hpp"
+#include "editor/singletons/fanEditorGuiInfo.hpp"
+
+namespace fan
+{
+    struct GuiEntityInterpolation
+    {
+        //====================================================================================================
+        //====================================================================================================
+        static GuiComponentInfo GetInfo()
+        {
+            GuiComponentInfo info;
+            info.mIcon       = ImGui::Network16;
+            info.mGroup      = EngineGroups::Network;
+            info.onGui       = &GuiEntityInterpolation::OnGui;
+            info.mEditorName = "interpolation";
+            info.mEditorPath = "network/";
+            return info;
+        }
+
+        //====================================================================================================
+        //====================================================================================================
+        static void OnGui( EcsWorld& /*_world*/, EcsEntity /*_entityID*/, EcsComponent& _component )
+        {
+            ImGui::Indent();
+            ImGui::Indent();
+            {
+                EntityInterpolation& interpolation = static_cast<EntityInterpolation&>( _component );
+                const FrameIndex newestFrameIndex = interpolation.Empty()
+                        ? 0
+                        : interpolation.GetNewest().mFrameIndex;
+                ImGui::Text( "snapshots:       %d / %d",
+                             interpolation.mNumSnapshots,
+                             EntityInterpolation::sMaxSnapshots );
+                ImGui::Text( "newest frame:    %d", newestFrameIndex );
+                ImGui::Text( "frame offset:    %.1f", interpolation.mFrameOffset );
+                ImGui::Text( "snapshot period: %.1f", interpolation.mSnapshotPeriod );
+                ImGui::Text( "render delay:    %.1f frames", interpolation.GetRenderDelay() );
+            }
+            ImGui::Unindent();
+            ImGui::Unindent();
+        }
+    };
+}
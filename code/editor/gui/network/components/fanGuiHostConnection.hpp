@@ -88,6 +88,7 @@ namespace fan
                                     "rtt:                %.1f",
                                     1000.f * hostConnection.mRtt );
                 ImGui::Text( "bandwidth :         %.1f Ko/s", hostConnection.mBandwidth );
+                ImGui::Text( "available bytes:    %.0f", hostConnection.mAvailableBytes );
                 ImGui::Text( "last response:      %.1f", currentTime - hostConnection.mLastResponseTime );
                 ImGui::Text( "adress:             %s::%u",
                              hostConnection.mIp.toString().c_str(),
@@ -97,6 +98,7 @@ namespace fan
                              hostConnection.mFramesDelta[0],
                              hostConnection.mFramesDelta[1],
                              hostConnection.mFramesDelta[2] );
+                ImGui::DragFloat( "bandwidth budget", &hostConnection.mBandwidthBudget, 1.f, 1.f, 1000.f, "%.0f Ko/s" );
                 ImGui::DragFloat( "ping delay", &hostConnection.mPingDelay, 0.1f, 0.f, 10.f );
                 ImGui::DragFloat( "timeout time", &hostConnection.mTimeoutDelay, 0.1f, 0.f, 10.f );
             }
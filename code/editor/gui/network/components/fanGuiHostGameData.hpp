@@ -28,15 +28,14 @@ namespace fan
             {
                 ImGui::Text( "spaceshipID :      %u", hostGameData.mSpaceshipID );
                 ImGui::Text( "spaceship handle : %u", hostGameData.mSpaceshipHandle );
-                ImGui::Text( "inputs size :      %u", hostGameData.mInputs.size() );
-
                 if( ImGui::CollapsingHeader( "inputs" ) )
                 {
-                    std::queue<PacketInput::InputData> inputsCpy = hostGameData.mInputs;
-                    while( !inputsCpy.empty() )
+                    for( const PacketInput::InputData& inputData : hostGameData.mInputs )
                     {
-                        ImGui::Text( "%d", inputsCpy.front().mFrameIndex );
-                        inputsCpy.pop();
+                        if( inputData.mFrameIndex != std::numeric_limits<FrameIndex>::max() )
+                        {
+                            ImGui::Text( "%d", inputData.mFrameIndex );
+                        }
                     }
                 }
             }
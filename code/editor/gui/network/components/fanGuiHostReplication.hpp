@@ -1,6 +1,7 @@
 #pragma once
 
 #include "network/components/fanHostReplication.hpp"
+#include "core/fanColor.hpp"
 #include "editor/singletons/fanEditorGuiInfo.hpp"
 
 namespace fan
@@ -28,6 +29,13 @@ namespace fan
             {
                 ImGui::Text( "next replication:    %d", hostReplication.mNextReplication.size() );
                 ImGui::Text( "pending replication: %d", hostReplication.mPendingReplication.size() );
+                ImGui::Text( "baselines:           %d", hostReplication.mBaselines.size() );
+                ImGui::Text( "pending deltas:      %d", hostReplication.mPendingDeltas.size() );
+                ImGui::Text( "relevant entities:   %d", hostReplication.mRelevantEntities.size() );
+                ImGui::TextColored( hostReplication.mNumStarvedEntities > 0 ? Color::sOrange.ToImGui()
+                                                                            : Color::sWhite.ToImGui(),
+                                    "starved entities:    %d", hostReplication.mNumStarvedEntities );
+                ImGui::Text( "max priority:        %.0f", hostReplication.mMaxPriority );
             }
             ImGui::PopItemWidth();
         }
@@ -28,8 +28,9 @@ namespace fan
             {
                 ImGui::Text( "next packet tag:       %d", deliveryNotification.mNextPacketTag );
                 ImGui::Text( "expected packet tag:   %d", deliveryNotification.mExpectedPacketTag );
-                ImGui::Text( "num pending ack:       %d", deliveryNotification.mPendingAck.size() );
-                ImGui::Text( "num in flight packets: %d", deliveryNotification.mInFlightPackets.size() );
+                ImGui::Text( "latest acked tag:      %d", deliveryNotification.mAck.mLatestTag );
+                ImGui::Text( "ack bits:              %08x", deliveryNotification.mAck.mAckBits );
+                ImGui::Text( "num in flight packets: %d", deliveryNotification.mNumInFlightPackets );
             }
             ImGui::PopItemWidth();
         }
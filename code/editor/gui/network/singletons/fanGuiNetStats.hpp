@@ -0,0 +1,140 @@
+#pragma once
+
+#include "network/singletons/fanNetStats.hpp"
+#include "network/singletons/fanLinkingContext.hpp"
+#include "network/singletons/fanTime.hpp"
+#include "editor/singletons/fanEditorGuiInfo.hpp"
+
+namespace fan
+{
+    struct GuiNetStats
+    {
+        //====================================================================================================
+        //====================================================================================================
+        static GuiSingletonInfo GetInfo()
+        {
+            GuiSingletonInfo info;
+            info.mIcon  = ImGui::Network16;
+            info.mGroup = EngineGroups::Network;
+            info.onGui  = &GuiNetStats::OnGui;
+            info.mEditorName  = "net stats";
+            return info;
+        }
+
+        //====================================================================================================
+        //====================================================================================================
+        static void OnGui( EcsWorld& _world, EcsSingleton& _component )
+        {
+            NetStats& stats = static_cast<NetStats&>( _component );
+            const float duration = std::max( 0.001f, float( Time::ElapsedSinceStartup() - stats.mResetTime.load() ) );
+
+            if( ImGui::Button( "reset" ) ) { stats.Reset(); }
+            ImGui::SameLine();
+            ImGui::Text( "over %.1fs", duration );
+            ImGui::Text( "sent:     %6llu datagrams %.1f Ko/s",
+                         (unsigned long long)stats.mSent.GetCount(),
+                         float( stats.mSent.GetBytes() ) / duration / 1000.f );
+            ImGui::Text( "received: %6llu datagrams %.1f Ko/s",
+                         (unsigned long long)stats.mReceived.GetCount(),
+                         float( stats.mReceived.GetBytes() ) / duration / 1000.f );
+            ImGui::Text( "retransmissions: %llu", (unsigned long long)stats.mRetransmissions.load() );
+
+            if( ImGui::CollapsingHeader( "packet types" ) )
+            {
+                ImGui::Columns( 4 );
+                ImGui::Text( "type" );                 ImGui::NextColumn();
+                ImGui::Text( "sent messages" );        ImGui::NextColumn();
+                ImGui::Text( "sent Ko/s" );            ImGui::NextColumn();
+                ImGui::Text( "received messages" );    ImGui::NextColumn();
+                for( int i = 0; i < NetStats::sNumTypes; i++ )
+                {
+                    const NetCounter& sent = stats.mSentTypes[i];
+                    ImGui::Text( "%s", NetStats::GetPacketTypeName( PacketType( i ) ) ); ImGui::NextColumn();
+                    ImGui::Text( "%llu", (unsigned long long)sent.GetCount() );         ImGui::NextColumn();
+                    ImGui::Text( "%.2f", float( sent.GetBytes() ) / duration / 1000.f ); ImGui::NextColumn();
+                    ImGui::Text( "%llu", (unsigned long long)stats.mReceivedTypes[i].load() ); ImGui::NextColumn();
+                }
+                ImGui::Columns( 1 );
+            }
+
+            if( ImGui::CollapsingHeader( "replication" ) )
+            {
+                ImGui::Columns( 3 );
+                ImGui::Text( "type" );          ImGui::NextColumn();
+                ImGui::Text( "sent messages" ); ImGui::NextColumn();
+                ImGui::Text( "sent Ko/s" );     ImGui::NextColumn();
+                for( int i = 0; i < NetStats::sNumReplicationTypes; i++ )
+                {
+                    const NetCounter& sent = stats.mSentReplication[i];
+                    ImGui::Text( "%s", NetStats::GetReplicationTypeName( PacketReplication::ReplicationType( i ) ) );
+                    ImGui::NextColumn();
+                    ImGui::Text( "%llu", (unsigned long long)sent.GetCount() );         ImGui::NextColumn();
+                    ImGui::Text( "%.2f", float( sent.GetBytes() ) / duration / 1000.f ); ImGui::NextColumn();
+                }
+
+                // components inside the entities replication
+                LinkingContext& linkingContext = _world.GetSingleton<LinkingContext>();
+                for( int i = 0; i < NetStats::sMaxComponents; i++ )
+                {
+                    const NetCounter& sent = stats.mSentComponents[i];
+                    uint32_t type;
+                    if( sent.GetCount() == 0 || !linkingContext.GetNetComponentType( _world, i, type ) ) { continue; }
+                    ImGui::Text( "  %s", _world.GetComponentInfo( type ).mName.c_str() ); ImGui::NextColumn();
+                    ImGui::Text( "%llu", (unsigned long long)sent.GetCount() );         ImGui::NextColumn();
+                    ImGui::Text( "%.2f", float( sent.GetBytes() ) / duration / 1000.f ); ImGui::NextColumn();
+                }
+                ImGui::Columns( 1 );
+            }
+
+            if( ImGui::CollapsingHeader( "latency" ) )
+            {
+                DrawHistogram( "rtt", stats.mRtt );
+                DrawHistogram( "jitter", stats.mJitter );
+                DrawHistogram( "ack latency", stats.mAckLatency );
+            }
+
+            if( ImGui::CollapsingHeader( "hosts" ) )
+            {
+                ImGui::Columns( 6 );
+                ImGui::Text( "host" );            ImGui::NextColumn();
+                ImGui::Text( "sent Ko/s" );       ImGui::NextColumn();
+                ImGui::Text( "received Ko/s" );   ImGui::NextColumn();
+                ImGui::Text( "rtt" );             ImGui::NextColumn();
+                ImGui::Text( "jitter" );          ImGui::NextColumn();
+                ImGui::Text( "retransmissions" ); ImGui::NextColumn();
+                for( const NetHostStats& host : stats.mHosts )
+                {
+                    const EcsHandle handle = host.mHandle.load();
+                    if( handle == 0 ) { continue; }
+                    ImGui::Text( "%d", handle );                                                   ImGui::NextColumn();
+                    ImGui::Text( "%.2f", float( host.mSent.GetBytes() ) / duration / 1000.f );     ImGui::NextColumn();
+                    ImGui::Text( "%.2f", float( host.mReceived.GetBytes() ) / duration / 1000.f ); ImGui::NextColumn();
+                    ImGui::Text( "%.0fms", 1000.f * host.mRtt.load() );                            ImGui::NextColumn();
+                    ImGui::Text( "%.1fms", 1000.f * host.mJitter.load() );                         ImGui::NextColumn();
+                    ImGui::Text( "%llu", (unsigned long long)host.mRetransmissions.load() );       ImGui::NextColumn();
+                }
+                ImGui::Columns( 1 );
+            }
+        }
+
+        //====================================================================================================
+        //====================================================================================================
+        static void DrawHistogram( const char* _name, const NetHistogram& _histogram )
+        {
+            float buckets[NetHistogram::sNumBuckets];
+            for( int i = 0; i < NetHistogram::sNumBuckets; i++ )
+            {
+                buckets[i] = float( _histogram.mBuckets[i].load() );
+            }
+            ImGui::Text( "%s: mean %.1fms p50 %.0fms p95 %.0fms p99 %.0fms",
+                         _name,
+                         _histogram.GetMean(),
+                         _histogram.GetPercentile( .5f ),
+                         _histogram.GetPercentile( .95f ),
+                         _histogram.GetPercentile( .99f ) );
+            ImGui::PushID( _name );
+            ImGui::PlotHistogram( "", buckets, NetHistogram::sNumBuckets, 0, nullptr, 0.f, FLT_MAX, ImVec2( 0.f, 40.f ) );
+            ImGui::PopID();
+        }
+    };
+}
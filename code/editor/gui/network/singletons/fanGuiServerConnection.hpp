@@ -27,6 +27,12 @@ namespace fan
             ImGui::Text( "Server" );
             ImGui::Spacing();
             ImGui::Text( "port: %u", connection.mServerPort );
+            ImGui::Spacing();
+            const NetworkThread& networkThread = connection.mNetworkThread;
+            ImGui::Text( "network thread: %s", networkThread.IsRunning() ? "running" : "off" );
+            ImGui::Text( "datagrams received: %d", networkThread.mNumReceived.load() );
+            ImGui::Text( "datagrams sent:     %d", networkThread.mNumSent.load() );
+            ImGui::Text( "datagrams dropped:  %d", networkThread.mNumDropped.load() );
         }
     };
 }
\ No newline at end of file
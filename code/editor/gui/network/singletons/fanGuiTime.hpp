@@ -29,6 +29,8 @@ namespace fan
             ImGui::Text( "logic delta:          %.3f", gameTime.mLogicDelta );
             ImGui::Text( "time scale increment: %.3f", gameTime.mTimeScaleIncrement );
             ImGui::DragFloat( "timescale", &gameTime.mTimeScaleDelta, 0.1f );
+            ImGui::DragFloat( "snapshot rate", &gameTime.mSnapshotRate, 1.f, 0.f, 1000.f );
+            ImGui::Text( "snapshot period:      %d frames", gameTime.GetSnapshotPeriod() );
         }
     };
 }
\ No newline at end of file
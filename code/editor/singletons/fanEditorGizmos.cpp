@@ -41,8 +41,8 @@ namespace fan
 		// Get main camera data
 		EcsWorld& world = *scene.mWorld;
 		const EcsEntity id = world.GetEntity( scene.mMainCameraHandle );
-		const Transform & cameraTransform = world.GetComponent<Transform>( id );
-		const Camera& camera = world.GetComponent<Camera>( id );
+		const Transform & cameraTransform = world.GetComponent<const Transform>( id );
+		const Camera& camera = world.GetComponent<const Camera>( id );
 
 		GizmoCacheData& cacheData = mGizmoCacheData[ _uniqueID ];
 		const btVector3 origin = _transform.getOrigin();
@@ -12,6 +12,7 @@
 // NETWORK
 #include "editor/gui/network/singletons/fanGuiHostManager.hpp"
 #include "editor/gui/network/singletons/fanGuiLinkingContext.hpp"
+#include "editor/gui/network/singletons/fanGuiNetStats.hpp"
 #include "editor/gui/network/singletons/fanGuiServerConnection.hpp"
 #include "editor/gui/network/singletons/fanGuiSpawnManager.hpp"
 #include "editor/gui/network/singletons/fanGuiTime.hpp"
@@ -22,6 +23,7 @@
 #include "editor/gui/network/components/fanGuiClientRollback.hpp"
 #include "editor/gui/network/components/fanGuiClientRPC.hpp"
 #include "editor/gui/network/components/fanGuiEntityReplication.hpp"
+#include "editor/gui/network/components/fanGuiEntityInterpolation.hpp"
 #include "editor/gui/network/components/fanGuiHostConnection.hpp"
 #include "editor/gui/network/components/fanGuiHostGameData.hpp"
 #include "editor/gui/network/components/fanGuiHostPersistentHandle.hpp"
@@ -113,6 +115,7 @@ namespace fan
         //network
         editorGui.mSingletonInfos[ HostManager::Info::sType ]       = GuiHostManager::GetInfo();
         editorGui.mSingletonInfos[ LinkingContext::Info::sType ]    = GuiLinkingContext::GetInfo();
+        editorGui.mSingletonInfos[ NetStats::Info::sType ]          = GuiNetStats::GetInfo();
         editorGui.mSingletonInfos[ ServerConnection::Info::sType ]  = GuiServerConnection::GetInfo();
         editorGui.mSingletonInfos[ SpawnManager::Info::sType ]      = GuiSpawnManager::GetInfo();
         editorGui.mSingletonInfos[ Time::Info::sType ]              = GuiTime::GetInfo();
@@ -123,6 +126,7 @@ namespace fan
         editorGui.mComponentInfos[ ClientRollback::Info::sType ]            = GuiClientRollback::GetInfo();
         editorGui.mComponentInfos[ ClientRPC::Info::sType ]                 = GuiClientRPC::GetInfo();
         editorGui.mComponentInfos[ EntityReplication::Info::sType ]         = GuiEntityReplication::GetInfo();
+        editorGui.mComponentInfos[ EntityInterpolation::Info::sType ]       = GuiEntityInterpolation::GetInfo();
         editorGui.mComponentInfos[ HostConnection::Info::sType ]            = GuiHostConnection::GetInfo();
         editorGui.mComponentInfos[ HostGameData::Info::sType ]              = GuiHostGameData::GetInfo();
         editorGui.mComponentInfos[ HostPersistentHandle::Info::sType ]      = GuiHostPersistentHandle::GetInfo();
@@ -112,8 +112,8 @@ namespace fan
         if( !mouseCaptured && _gameWindowHovered && mouse.mPressed[ Mouse::buttonLeft ] )
  		{
 			EcsEntity cameraID = world.GetEntity( mCurrentScene->mMainCameraHandle );
-			const Transform& cameraTransform = world.GetComponent<Transform>( cameraID );
-			const Camera& camera = world.GetComponent<Camera>( cameraID );
+			const Transform& cameraTransform = world.GetComponent<const Transform>( cameraID );
+			const Camera& camera = world.GetComponent<const Camera>( cameraID );
 
             const Ray ray = camera.ScreenPosToRay( cameraTransform,
                                                    ToBullet( mouse.LocalScreenSpacePosition() ) );
@@ -148,10 +148,10 @@ namespace fan
 			if( world.HasComponent<Transform>( selectedEntity ) ) 
 			{
 				RenderDebug& renderDebug = world.GetSingleton<RenderDebug>();
-				const Transform& transform = world.GetComponent<Transform>( selectedEntity );
+				const Transform& transform = world.GetComponent<const Transform>( selectedEntity );
 				if( world.HasComponent<DirectionalLight>( selectedEntity ) )
                 {
-                    const DirectionalLight& directionalLight = world.GetComponent<DirectionalLight>(
+                    const DirectionalLight& directionalLight = world.GetComponent<const DirectionalLight>(
                             selectedEntity );
                     SDrawDebugDirectionalLights::DrawDirectionalLight( renderDebug,
                                                                        transform,
@@ -159,7 +159,7 @@ namespace fan
 				} 
 				if( world.HasComponent<PointLight>( selectedEntity ) )
 				{
-					const PointLight& pointLight = world.GetComponent<PointLight>( selectedEntity );
+					const PointLight& pointLight = world.GetComponent<const PointLight>( selectedEntity );
 					SDrawDebugPointLights::DrawPointLight( renderDebug, transform, pointLight );
 				}
 			}
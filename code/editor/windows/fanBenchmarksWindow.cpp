@@ -0,0 +1,75 @@
+#include "editor/windows/fanBenchmarksWindow.hpp"
+
+#include "core/time/fanProfiler.hpp"
+#include "core/unit_tests/fanBenchmarkEcs.hpp"
+#include "core/unit_tests/fanBenchmarkSignal.hpp"
+#include "engine/unit_tests/fanBenchmarkPrefab.hpp"
+#include "network/unit_tests/fanBenchmarkReplication.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    BenchmarksWindow::BenchmarksWindow() : EditorWindow( "benchmarks", ImGui::IconType::None16 ) {}
+
+    //========================================================================================================
+    //========================================================================================================
+    std::vector<BenchmarksWindow::BenchmarkArgument> BenchmarksWindow::GetBenchmarks()
+    {
+        return {
+                { "Ecs", &BenchmarkEcs::RunBenchmarks, mEcsResult },
+                { "Signal", &BenchmarkSignal::RunBenchmarks, mSignalResult },
+                { "Prefab", &BenchmarkPrefab::RunBenchmarks, mPrefabResult },
+                { "Replication", &BenchmarkReplication::RunBenchmarks, mReplicationResult },
+        };
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void BenchmarksWindow::OnGui( EcsWorld& /*_world*/ )
+    {
+        SCOPED_PROFILE( benchmarks_window );
+
+        const std::vector<BenchmarkArgument> benchmarks = GetBenchmarks();
+
+        if( ImGui::Button( "Run all" ) )
+        {
+            for( const BenchmarkArgument& argument : benchmarks ){ argument.mResult = ( *argument.mRunMethod )(); }
+        }
+        ImGui::SameLine();
+        if( ImGui::Button( "Clear all" ) )
+        {
+            for( const BenchmarkArgument& argument : benchmarks ){ argument.mResult = {}; }
+        }
+        ImGui::Spacing();
+        for( const BenchmarkArgument& argument : benchmarks ){ DrawBenchmark( argument ); }
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void BenchmarksWindow::DrawBenchmark( const BenchmarkArgument& _benchmarkArgument )
+    {
+        if( ImGui::CollapsingHeader( _benchmarkArgument.mName ) )
+        {
+            ImGui::Indent();
+            std::string runButtonName = "Run##" + std::string( _benchmarkArgument.mName );
+            if( ImGui::Button( runButtonName.c_str() ) )
+            {
+                _benchmarkArgument.mResult = ( *_benchmarkArgument.mRunMethod )();
+            }
+
+            ImGui::Columns( 3 );
+            ImGui::Text( "name" );          ImGui::NextColumn();
+            ImGui::Text( "iterations" );    ImGui::NextColumn();
+            ImGui::Text( "ns/iteration" );  ImGui::NextColumn();
+            for( const BenchmarkResult::Measure& measure : _benchmarkArgument.mResult.mMeasures )
+            {
+                ImGui::Text( "%s", measure.mName.c_str() );                 ImGui::NextColumn();
+                ImGui::Text( "%d", measure.mIterations );                   ImGui::NextColumn();
+                ImGui::Text( "%.1f", measure.mNanosecondsPerIteration );    ImGui::NextColumn();
+            }
+            ImGui::Columns( 1 );
+            ImGui::Unindent();
+        }
+    }
+}
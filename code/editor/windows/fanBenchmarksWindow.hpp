@@ -0,0 +1,35 @@
+#pragma once
+
+#include "editor/windows/fanEditorWindow.hpp"
+#include "core/unit_tests/fanBenchmark.hpp"
+
+namespace fan
+{
+    class EcsWorld;
+    //========================================================================================================
+    // runs the engine benchmarks & displays their timings
+    //========================================================================================================
+    class BenchmarksWindow : public EditorWindow
+    {
+    public:
+        BenchmarksWindow();
+
+    protected:
+        struct BenchmarkArgument
+        {
+            using RunMethod = BenchmarkResult ( * )();
+            const char*      mName;
+            RunMethod        mRunMethod;
+            BenchmarkResult& mResult;
+        };
+
+        void OnGui( EcsWorld& _world ) override;
+        std::vector<BenchmarkArgument> GetBenchmarks();
+        static void DrawBenchmark( const BenchmarkArgument& _benchmarkArgument );
+
+        BenchmarkResult mEcsResult;
+        BenchmarkResult mSignalResult;
+        BenchmarkResult mPrefabResult;
+        BenchmarkResult mReplicationResult;
+    };
+}
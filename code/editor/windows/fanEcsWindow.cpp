@@ -38,9 +38,13 @@ namespace fan
 		// Global
 		if( ImGui::CollapsingHeader( "Global" ) )
 		{
-			ImGui::Text( "num chunks     : %d", EcsChunk::sAllocator.Size() );
+            const EcsChunkAllocator::Stats stats = EcsChunk::sAllocator.GetStats();
+			ImGui::Text( "live chunks    : %d", stats.mLiveChunks );
+			ImGui::Text( "free chunks    : %d", stats.mFreeChunks );
+			ImGui::Text( "released chunks: %d", stats.mReleasedChunks );
+			ImGui::Text( "peak chunks    : %d", stats.mPeakLiveChunks );
             ImGui::Text( "total size (Mo): %.1f",
-                         float( EcsChunk::sAllocator.Size() * EcsChunk::sAllocator.sChunkSize ) * 0.000001f );
+                         float( EcsChunk::sAllocator.Size() * EcsChunkAllocator::sChunkSize ) * 0.000001f );
         }
 
 		// Archetypes
@@ -133,18 +137,15 @@ namespace fan
 			ImGui::Separator();
 
 			int i = 0;
-			for( const auto& pair : _world.GetHandles() )
+			_world.GetHandles().ForEach( [&i]( const EcsHandle handle, const EcsEntity& entity )
 			{
-				const EcsHandle handle = pair.first;
-				EcsEntity entity = pair.second;
-
 				ImGui::Text( "%d", i++ );		ImGui::NextColumn();
 				ImGui::Text( "%d", handle );	ImGui::NextColumn();
 				std::stringstream ss;
 				ss << entity.mArchetype->GetSignature();
 				ImGui::Text( "%s", ss.str().c_str() );	ImGui::NextColumn();
 				ImGui::Text( "%d", entity.mIndex );	ImGui::NextColumn();
-			}
+			} );
 			ImGui::Columns( 1 );
 		}
 	}
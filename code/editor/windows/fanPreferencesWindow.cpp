@@ -155,11 +155,15 @@ namespace fan
 
 				// Reset
 				ImGui::SameLine();
-				if ( ImGui::Button( "Save" ) ) { SerializedValues::Get().SaveValuesToDisk(); }
+				if ( ImGui::Button( "Save" ) )
+				{
+					Input::Get().SaveKeyBindings();
+					SerializedValues::Get().SaveValuesToDisk();
+				}
 
 				// Reset
 				ImGui::SameLine();
-				if ( ImGui::Button( "Reset" ) ) { SerializedValues::Get().LoadKeyBindings(); }
+				if ( ImGui::Button( "Reset" ) ) { Input::Get().LoadKeyBindings(); }
 
 				ImGui::SameLine();
 				ImGui::FanShowHelpMarker(" for a reset to engine default, delete the file editor_data.json" );
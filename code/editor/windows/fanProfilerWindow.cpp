@@ -29,6 +29,7 @@ namespace fan
 		if ( !mFreezeCapture )
 		{
             mIntervalsCopy = Profiler::Get().GetIntervals();
+            mCountersCopy  = Profiler::Get().GetCounters();
 		}
 	}
 
@@ -45,6 +46,12 @@ namespace fan
 			ImGui::SameLine();	ImGui::DragFloat( "speed", &mSpeed, 0.01f, 0.f, 10.f );
 		}
 
+		// Counters
+		for( const Profiler::Counter& counter : mCountersCopy )
+		{
+			ImGui::Text( "%s: %d", counter.mName, counter.mValue );
+		}
+
 		// Returns if no data 
 		if ( mIntervalsCopy.size() == 0 )
 		{
@@ -19,6 +19,7 @@ namespace fan
 		void OnProfilerEnd();
 	private:
 		std::vector<Profiler::Interval> mIntervalsCopy;
+		std::vector<Profiler::Counter>  mCountersCopy;
 		bool                            mFreezeCapture      = false;
 		float                           mLastScrollPosition = 0.f;
 		float                           mScale              = 1.f;
@@ -9,8 +9,20 @@
 #include "render/unit_tests/fanUnitTestFontManager.hpp"
 #include "engine/unit_tests/fanUnitTestPrefabManager.hpp"
 #include "engine/unit_tests/fanUnitTestMouse.hpp"
+#include "engine/unit_tests/fanUnitTestPhysicsWorld.hpp"
 #include "core/unit_tests/fanUnitTestSignal.hpp"
 #include "core/unit_tests/fanUnitTestEcs.hpp"
+#include "core/unit_tests/fanUnitTestSpatialGrid.hpp"
+#include "core/unit_tests/fanUnitTestSpscRing.hpp"
+#include "core/unit_tests/fanUnitTestPreciseSleep.hpp"
+#include "network/unit_tests/fanUnitTestBitStream.hpp"
+#include "network/unit_tests/fanUnitTestReliabilityLayer.hpp"
+#include "network/unit_tests/fanUnitTestClientRollback.hpp"
+#include "network/unit_tests/fanUnitTestLoopback.hpp"
+#include "network/unit_tests/fanUnitTestPacketInput.hpp"
+#include "network/unit_tests/fanUnitTestInterpolation.hpp"
+#include "network/unit_tests/fanUnitTestNetStats.hpp"
+#include "network/unit_tests/fanUnitTestDeltaReplication.hpp"
 
 
 namespace fan
@@ -32,8 +44,20 @@ namespace fan
                  { "fanAssert",          &UnitTestFanAssert::RunTests,       mFanAssertResult },
 #endif
                 { "Mouse",      &UnitTestMouse::RunTests, mGlfwMouseResult },
+                { "Physics world", &UnitTestPhysicsWorld::RunTests, mPhysicsWorldResult },
                 { "Signal",     &UnitTestSignal::RunTests, mSignalResult },
                 { "Ecs",     &UnitTestEcs::RunTests, mEcsResult },
+                { "Spatial grid", &UnitTestSpatialGrid::RunTests, mSpatialGridResult },
+                { "Spsc ring", &UnitTestSpscRing::RunTests, mSpscRingResult },
+                { "Precise sleep", &UnitTestPreciseSleep::RunTests, mPreciseSleepResult },
+                { "Bit stream", &UnitTestBitStream::RunTests, mBitStreamResult },
+                { "Reliability layer", &UnitTestReliabilityLayer::RunTests, mReliabilityLayerResult },
+                { "Client rollback", &UnitTestClientRollback::RunTests, mClientRollbackResult },
+                { "Loopback transport", &UnitTestLoopback::RunTests, mLoopbackResult },
+                { "Packet input", &UnitTestPacketInput::RunTests, mPacketInputResult },
+                { "Interpolation", &UnitTestInterpolation::RunTests, mInterpolationResult },
+                { "Net stats", &UnitTestNetStats::RunTests, mNetStatsResult },
+                { "Delta replication", &UnitTestDeltaReplication::RunTests, mDeltaReplicationResult },
 
         };
     }
@@ -38,7 +38,19 @@ namespace fan
         UnitTestResult mFontManagerResult;
         UnitTestResult mFanAssertResult;
         UnitTestResult mGlfwMouseResult;
+        UnitTestResult mPhysicsWorldResult;
         UnitTestResult mSignalResult;
         UnitTestResult mEcsResult;
+        UnitTestResult mSpatialGridResult;
+        UnitTestResult mSpscRingResult;
+        UnitTestResult mPreciseSleepResult;
+        UnitTestResult mBitStreamResult;
+        UnitTestResult mReliabilityLayerResult;
+        UnitTestResult mClientRollbackResult;
+        UnitTestResult mLoopbackResult;
+        UnitTestResult mPacketInputResult;
+        UnitTestResult mInterpolationResult;
+        UnitTestResult mNetStatsResult;
+        UnitTestResult mDeltaReplicationResult;
     };
 }
\ No newline at end of file
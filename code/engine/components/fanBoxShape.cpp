@@ -10,6 +10,10 @@ namespace fan
 		_info.destroy     = &BoxShape::Destroy;
 		_info.load        = &BoxShape::Load;
 		_info.save        = &BoxShape::Save;
+		_info.prefabSave  = &BoxShape::PrefabSave;
+		_info.prefabLoad  = &BoxShape::PrefabLoad;
+		_info.mPrefabSize = sizeof( btVector3 );// scaling
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//========================================================================================================
@@ -52,6 +56,22 @@ namespace fan
 		boxShape.SetScaling( scaling );
 	}
 
+	//========================================================================================================
+	//========================================================================================================
+	void BoxShape::PrefabSave( const EcsComponent& _component, void* _params )
+	{
+		const BoxShape& boxShape = static_cast<const BoxShape&>( _component );
+		*static_cast<btVector3*>( _params ) = boxShape.GetScaling();
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void BoxShape::PrefabLoad( EcsComponent& _component, const void* _params )
+	{
+		BoxShape& boxShape = static_cast<BoxShape&>( _component );
+		boxShape.SetScaling( *static_cast<const btVector3*>( _params ) );
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void BoxShape::SetScaling( const btVector3 _scaling )
@@ -19,6 +19,8 @@ namespace fan
 		static void Destroy( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component );
 		static void Save( const EcsComponent& _component, Json& _json );
 		static void Load( EcsComponent& _component, const Json& _json );
+		static void PrefabSave( const EcsComponent& _component, void* _params );
+		static void PrefabLoad( EcsComponent& _component, const void* _params );
 		
 		void	  SetScaling( const btVector3 _scaling );
 		btVector3 GetScaling() const;
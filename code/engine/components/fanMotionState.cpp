@@ -11,6 +11,9 @@ namespace fan
 		_info.destroy     = &MotionState::Destroy;
 		_info.save        = &MotionState::Save;
 		_info.load        = &MotionState::Load;
+		_info.prefabSave  = &MotionState::PrefabSave;// no parameters, the motion state is created by Init
+		_info.prefabLoad  = &MotionState::PrefabLoad;
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//========================================================================================================
@@ -2,9 +2,13 @@
 #include "render/fanRenderSerializable.hpp"
 #include "engine/singletons/fanPhysicsWorld.hpp"
 #include "network/fanPacket.hpp"
+#include "network/fanQuantization.hpp"
 
 namespace fan
 {
+	static constexpr QuantizedFloat sNetVelocity        = { -64.f, 64.f, 12 };	// ~0.03 precision
+	static constexpr QuantizedFloat sNetAngularVelocity = { -32.f, 32.f, 12 };	// ~0.016 precision
+
 	//========================================================================================================
 	//========================================================================================================
 	void Rigidbody::SetInfo( EcsComponentInfo& _info )
@@ -16,6 +20,11 @@ namespace fan
 		_info.netLoad      = &Rigidbody::NetLoad;
 		_info.rollbackLoad = &Rigidbody::RollbackLoad;
 		_info.rollbackSave = &Rigidbody::RollbackSave;
+		_info.mRollbackSize = sizeof( RollbackState );
+		_info.prefabSave   = &Rigidbody::PrefabSave;
+		_info.prefabLoad   = &Rigidbody::PrefabLoad;
+		_info.mPrefabSize  = sizeof( PrefabParams );
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 	   
 	//========================================================================================================
@@ -45,50 +54,52 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	void Rigidbody::NetSave( const EcsComponent& _component, sf::Packet& _packet )
+	void Rigidbody::NetSave( const EcsComponent& _component, BitWriter& _writer )
 	{
 		const Rigidbody& rb = static_cast<const Rigidbody&>( _component );
 		const btVector3 velocity = rb.GetVelocity();
 		const btVector3 angularVelocity = rb.GetAngularVelocity();
 
-		_packet << velocity[0] << velocity[2];
-		_packet << angularVelocity[1];
+		sNetVelocity.Write( _writer, velocity[0] );
+		sNetVelocity.Write( _writer, velocity[2] );
+		sNetAngularVelocity.Write( _writer, angularVelocity[1] );
 	}
 
 	//========================================================================================================
 	//========================================================================================================
-	void Rigidbody::NetLoad( EcsComponent& _component, sf::Packet& _packet )
+	void Rigidbody::NetLoad( EcsComponent& _component, BitReader& _reader )
 	{
 		Rigidbody& rb = static_cast<Rigidbody&>( _component );
 		btVector3 velocity( 0.f, 0.f, 0.f );
 		btVector3 angularVelocity( 0.f, 0.f, 0.f );
-		_packet >> velocity[0] >> velocity[2];
-		_packet >> angularVelocity[1] ;
+		velocity[0] = sNetVelocity.Read( _reader );
+		velocity[2] = sNetVelocity.Read( _reader );
+		angularVelocity[1] = sNetAngularVelocity.Read( _reader );
 		rb.SetVelocity( velocity );
 		rb.SetAngularVelocity( angularVelocity );
 	}
 
 	//========================================================================================================
 	//========================================================================================================
-	void Rigidbody::RollbackSave( const EcsComponent& _component, sf::Packet& _packet )
+	void Rigidbody::RollbackSave( const EcsComponent& _component, void* _state )
 	{
 		const Rigidbody&	rb = static_cast<const Rigidbody&>( _component );
 
 		const btVector3&	velocity = rb.GetVelocity();
 		const btVector3&	angularVelocity = rb.GetAngularVelocity();
-		_packet << velocity[0] << velocity[2];
-		_packet << angularVelocity[1];
+		RollbackState& state = *static_cast<RollbackState*>( _state );
+		state.mVelocity[0]     = velocity[0];
+		state.mVelocity[1]     = velocity[2];
+		state.mAngularVelocity = angularVelocity[1];
 	}
 
 	//========================================================================================================
 	//========================================================================================================
-	void Rigidbody::RollbackLoad( EcsComponent& _component, sf::Packet& _packet )
+	void Rigidbody::RollbackLoad( EcsComponent& _component, const void* _state )
 	{
-		btVector3		velocity( 0, 0, 0 );
-		btVector3		angularVelocity( 0, 0, 0 );
-
-		_packet >> velocity[0] >> velocity[2];
-		_packet >> angularVelocity[1];
+		const RollbackState& state = *static_cast<const RollbackState*>( _state );
+		const btVector3 velocity( state.mVelocity[0], 0, state.mVelocity[1] );
+		const btVector3 angularVelocity( 0, state.mAngularVelocity, 0 );
 
 		Rigidbody& rb = static_cast<Rigidbody&>( _component );
 		rb.ClearForces();
@@ -96,6 +107,29 @@ namespace fan
 		rb.SetAngularVelocity( angularVelocity );
 	}
 
+	//========================================================================================================
+	//========================================================================================================
+	void Rigidbody::PrefabSave( const EcsComponent& _component, void* _params )
+	{
+		const Rigidbody& rb = static_cast<const Rigidbody&>( _component );
+		PrefabParams& params = *static_cast<PrefabParams*>( _params );
+		params.mMass               = rb.GetMass();
+		params.mEnableDeactivation = rb.IsDeactivationEnabled();
+		params.mIsKinematic        = rb.IsKinematic();
+	}
+
+	//========================================================================================================
+	// same as Load
+	//========================================================================================================
+	void Rigidbody::PrefabLoad( EcsComponent& _component, const void* _params )
+	{
+		const PrefabParams& params = *static_cast<const PrefabParams*>( _params );
+		Rigidbody& rb = static_cast<Rigidbody&>( _component );
+		rb.SetMass( params.mMass );
+		rb.EnableDeactivation( params.mEnableDeactivation );
+		if( params.mIsKinematic ) { rb.SetKinematic(); }
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	float  Rigidbody::GetMass() const
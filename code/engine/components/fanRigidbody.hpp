@@ -26,10 +26,25 @@ namespace fan
 		static void Destroy( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component );
 		static void Save( const EcsComponent& _component, Json& _json );
 		static void Load( EcsComponent& _component, const Json& _json );
-		static void NetSave( const EcsComponent& _component, sf::Packet& _packet );
-		static void NetLoad( EcsComponent& _component, sf::Packet& _packet );
-		static void RollbackSave( const EcsComponent& _component, sf::Packet& _packet );
-		static void RollbackLoad( EcsComponent& _component, sf::Packet& _packet );
+		static void NetSave( const EcsComponent& _component, BitWriter& _writer );
+		static void NetLoad( EcsComponent& _component, BitReader& _reader );
+		static void RollbackSave( const EcsComponent& _component, void* _state );
+		static void RollbackLoad( EcsComponent& _component, const void* _state );
+		static void PrefabSave( const EcsComponent& _component, void* _params );
+		static void PrefabLoad( EcsComponent& _component, const void* _params );
+
+		struct RollbackState
+		{
+			btScalar mVelocity[2];	// x, z
+			btScalar mAngularVelocity;	// y
+		};
+
+		struct PrefabParams
+		{
+			btScalar mMass;
+			bool     mEnableDeactivation;
+			bool     mIsKinematic;
+		};
 
 		EcsHandle	GetHandle(){ return static_cast<EcsHandle>( mRigidbody->getUserIndex() ); }
 		EcsWorld&	GetWorld() { return *static_cast<EcsWorld*>( mRigidbody->getUserPointer() ); }
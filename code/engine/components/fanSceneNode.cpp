@@ -81,7 +81,11 @@ namespace fan
         mName   = _name;
 		if( _parent != nullptr )
 		{
-			_parent->AddChild( *this );
+			// a new node has no childs & no parent, skips the checks of AddChild that are linear with the
+			// number of childs of the parent ( the scene root when spawning prefabs )
+			fanAssert( mParentHandle == 0 && mChilds.empty() );
+			_parent->mChilds.push_back( mHandle );
+			mParentHandle = _parent->mHandle;
 		}
 	}
 
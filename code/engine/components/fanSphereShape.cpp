@@ -10,6 +10,10 @@ namespace fan
 		_info.destroy     = &SphereShape::Destroy;
 		_info.load        = &SphereShape::Load;
 		_info.save        = &SphereShape::Save;
+		_info.prefabSave  = &SphereShape::PrefabSave;
+		_info.prefabLoad  = &SphereShape::PrefabLoad;
+		_info.mPrefabSize = sizeof( float );// radius
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//========================================================================================================
@@ -50,6 +54,22 @@ namespace fan
 		sphereShape.SetRadius( radius );
 	}
 
+	//========================================================================================================
+	//========================================================================================================
+	void SphereShape::PrefabSave( const EcsComponent& _component, void* _params )
+	{
+		const SphereShape& sphereShape = static_cast<const SphereShape&>( _component );
+		*static_cast<float*>( _params ) = sphereShape.GetRadius();
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void SphereShape::PrefabLoad( EcsComponent& _component, const void* _params )
+	{
+		SphereShape& sphereShape = static_cast<SphereShape&>( _component );
+		sphereShape.SetRadius( *static_cast<const float*>( _params ) );
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void  SphereShape::SetRadius( const float _radius )
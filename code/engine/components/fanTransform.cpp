@@ -3,9 +3,13 @@
 #include "core/memory/fanSerializable.hpp"
 #include "core/math/fanMathUtils.hpp"
 #include "network/fanPacket.hpp"
+#include "network/fanQuantization.hpp"
 
 namespace fan
 {	
+	static constexpr QuantizedFloat sNetPosition = { -1024.f, 1024.f, 18 };	// ~0.008 precision
+	static constexpr QuantizedFloat sNetRotation = { -180.f, 180.f, 10 };		// degrees, ~0.35 precision
+
 	//========================================================================================================
 	//========================================================================================================
 	void Transform::SetInfo( EcsComponentInfo& _info )
@@ -16,6 +20,7 @@ namespace fan
 		_info.netLoad      = &Transform::NetLoad;
 		_info.rollbackLoad = &Transform::RollbackLoad;
 		_info.rollbackSave = &Transform::RollbackSave;
+		_info.mRollbackSize = sizeof( RollbackState );
 	}
 
 	//========================================================================================================
@@ -57,27 +62,28 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	void Transform::RollbackSave( const EcsComponent& _component, sf::Packet& _packet )
+	void Transform::RollbackSave( const EcsComponent& _component, void* _state )
 	{
 		const Transform& transform = static_cast<const Transform&>( _component );
 		const btVector3& position = transform.GetPosition();
 		const btVector3  rotation = transform.GetRotationEuler();
 
-		_packet << position[0] << position[2];
-		_packet << rotation[0] << rotation[1] << rotation[2];
+		RollbackState& state = *static_cast<RollbackState*>( _state );
+		state.mPosition[0] = position[0];
+		state.mPosition[1] = position[2];
+		state.mRotation[0] = rotation[0];
+		state.mRotation[1] = rotation[1];
+		state.mRotation[2] = rotation[2];
 	}
 
 	//========================================================================================================
 	//========================================================================================================
-	void Transform::RollbackLoad( EcsComponent& _component, sf::Packet& _packet )
+	void Transform::RollbackLoad( EcsComponent& _component, const void* _state )
 	{
 		Transform& transform = static_cast<Transform&>( _component );
-		btVector3 position( 0, 0, 0 );
-		btVector3 rotation( 0, 0, 0 );
-		_packet >> position[0] >> position[2];
-		_packet >> rotation[0] >> rotation[1] >> rotation[2];
-		transform.SetPosition( position );
-		transform.SetRotationEuler( rotation );
+		const RollbackState& state = *static_cast<const RollbackState*>( _state );
+		transform.SetPosition( btVector3( state.mPosition[0], 0, state.mPosition[1] ) );
+		transform.SetRotationEuler( btVector3( state.mRotation[0], state.mRotation[1], state.mRotation[2] ) );
 	}
 
 	//========================================================================================================
@@ -218,7 +224,7 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	void Transform::NetSave( const EcsComponent& _component, sf::Packet& _packet )
+	void Transform::NetSave( const EcsComponent& _component, BitWriter& _writer )
 	{
 		const Transform& transform = static_cast<const Transform&>( _component );
 		const btVector3 position = transform.GetPosition();
@@ -228,20 +234,23 @@ namespace fan
 		{
 			rotation = -rotation;
 		}
+		if( rotation > 180.f ) { rotation -= 360.f; }
+		if( rotation < -180.f ) { rotation += 360.f; }
 
-		_packet << position[0] << position[2];
-		_packet << rotation;
+		sNetPosition.Write( _writer, position[0] );
+		sNetPosition.Write( _writer, position[2] );
+		sNetRotation.Write( _writer, rotation );
 	}
 
 	//========================================================================================================
 	//========================================================================================================
-	void Transform::NetLoad( EcsComponent& _component, sf::Packet& _packet )
+	void Transform::NetLoad( EcsComponent& _component, BitReader& _reader )
 	{
 		Transform& transform = static_cast<Transform&>( _component );
 		btVector3 position( 0.f, 0.f, 0.f );
-		float rotation;
-		_packet >> position[0] >> position[2];
-		_packet >> rotation;
+		position[0] = sNetPosition.Read( _reader );
+		position[2] = sNetPosition.Read( _reader );
+		const float rotation = sNetRotation.Read( _reader );
 
 		transform.SetRotationEuler( btVector3( 0.f, rotation, 0.f ) );
 		transform.SetPosition( position );
@@ -21,10 +21,16 @@ namespace fan
 		static void	Init( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component );
 		static void Save( const EcsComponent& _component, Json& _json );
 		static void Load( EcsComponent& _component, const Json& _json );
-		static void NetSave( const EcsComponent& _component, sf::Packet& _packet );
-		static void NetLoad( EcsComponent& _component, sf::Packet& _packet );
-		static void RollbackSave( const EcsComponent& _component, sf::Packet& _packet );
-		static void RollbackLoad( EcsComponent& _component, sf::Packet& _packet );
+		static void NetSave( const EcsComponent& _component, BitWriter& _writer );
+		static void NetLoad( EcsComponent& _component, BitReader& _reader );
+		static void RollbackSave( const EcsComponent& _component, void* _state );
+		static void RollbackLoad( EcsComponent& _component, const void* _state );
+
+		struct RollbackState
+		{
+			btScalar mPosition[2];	// x, z
+			btScalar mRotation[3];	// euler angles
+		};
 
 		void SetPosition( btVector3 _newPosition );
 		void SetScale( btVector3 _newScale );
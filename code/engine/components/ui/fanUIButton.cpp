@@ -11,6 +11,7 @@ namespace fan
 	{
 		_info.load        = &UIButton::Load;
 		_info.save        = &UIButton::Save;
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//========================================================================================================
@@ -8,6 +8,7 @@ namespace fan
 	{
 		_info.load        = &UIProgressBar::Load;
 		_info.save        = &UIProgressBar::Save;
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//========================================================================================================
@@ -16,6 +16,7 @@ namespace fan
 	{
 		_info.load        = &UIText::Load;
 		_info.save        = &UIText::Save;
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//========================================================================================================
@@ -22,7 +22,7 @@ namespace fan
     {
         _game.Init();
 
-		SerializedValues::Get().LoadKeyBindings();
+		Input::Get().LoadKeyBindings();
 		GameClient::CreateGameAxes();
 
 		InitWorld( _game.mWorld );
@@ -30,6 +30,15 @@ namespace fan
         Application& app = _game.mWorld.GetSingleton<Application>();
         app.mOnQuit.Connect( &IHolder::Exit, (IHolder*)this );
 
+        if( _settings.mTickRate > 0 )
+        {
+            mGame.mWorld.GetSingleton<Time>().SetTickRate( float( _settings.mTickRate ) );
+        }
+        if( _settings.mSnapshotRate > 0 )
+        {
+            mGame.mWorld.GetSingleton<Time>().mSnapshotRate = float( _settings.mSnapshotRate );
+        }
+
 		// load scene
 		Scene& scene = mGame.mWorld.GetSingleton<Scene>();
 		scene.New();
@@ -165,23 +174,16 @@ namespace fan
                                mGame,
                                { mWindow.GetExtent().width, mWindow.GetExtent().height } );
 			mRenderer.DrawFrame();
+			EcsChunk::sAllocator.ReportToProfiler();
 			Profiler::Get().End();
 			Profiler::Get().Begin();
 		}
 
 		// sleep for the rest of the frame
+		// rendering only happens on logic frames, the next logic step is the next thing to do
 		if( mLaunchSettings.mainLoopSleep )
 		{
-			// @todo repair this to work with multiple worlds running 
-// 				const double minSleepTime = 1;
-// 				const double endFrameTime = Time::ElapsedSinceStartup();
-// 				const double timeBeforeNextLogic = lastLogicTime + time.logicDelta - endFrameTime;
-// 				const double timeBeforeNextRender = lastRenderTime + Time::s_renderDelta - endFrameTime;
-// 				const double sleepTimeMiliseconds = 1000. * std::min( timeBeforeNextLogic, timeBeforeNextRender );
-// 				if( sleepTimeMiliseconds > minSleepTime )
-// 				{
-// 					std::this_thread::sleep_for( std::chrono::milliseconds( int( sleepTimeMiliseconds / 2 ) ) );
-// 				}
+			mPreciseSleep.SleepUntil( time.mLastLogicTime + time.mLogicDelta );
 		}
 	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "core/memory/fanSerializedValues.hpp"
 #include "core/ecs/fanEcsWorld.hpp"
+#include "core/time/fanPreciseSleep.hpp"
 #include "engine/fanIHolder.hpp"
 #include "game/fanGameClient.hpp"
 #include "game/fanGameServer.hpp"
@@ -26,7 +27,8 @@ namespace fan
 		void Step();
 
 	private:
-        IGame& mGame;
+        IGame&       mGame;
+        PreciseSleep mPreciseSleep;
 
         LaunchSettings& AdaptSettings( LaunchSettings& _settings );
 	};
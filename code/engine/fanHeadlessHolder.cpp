@@ -0,0 +1,212 @@
+#include "engine/fanHeadlessHolder.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include "core/fanDebug.hpp"
+#include "core/time/fanProfiler.hpp"
+#include "render/resources/fanMeshManager.hpp"
+#include "render/resources/fanMesh2DManager.hpp"
+#include "render/resources/fanTextureManager.hpp"
+#include "render/resources/fanFontManager.hpp"
+#include "network/singletons/fanTime.hpp"
+#include "network/singletons/fanNetStats.hpp"
+#include "engine/fanIGame.hpp"
+#include "engine/singletons/fanRenderWorld.hpp"
+#include "engine/singletons/fanRenderDebug.hpp"
+#include "engine/singletons/fanRenderResources.hpp"
+#include "engine/singletons/fanSceneResources.hpp"
+#include "engine/singletons/fanScene.hpp"
+#include "engine/singletons/fanApplication.hpp"
+
+namespace fan
+{
+    volatile std::sig_atomic_t HeadlessHolder::sInterrupted = 0;
+
+    //========================================================================================================
+    //========================================================================================================
+    HeadlessHolder::HeadlessHolder( LaunchSettings& _settings, const std::vector<IGame*>& _games ) :
+            mLaunchSettings( _settings ),
+            mGames( _games ),
+            mApplicationShouldExit( false ),
+            mLastNetStatsTime( 0. ),
+            mMeshManager( new MeshManager() ),
+            mMesh2DManager( new Mesh2DManager() ),
+            mTextureManager( new TextureManager() ),
+            mFontManager( new FontManager() )
+    {
+        std::signal( SIGINT, &HeadlessHolder::OnInterrupt );
+        std::signal( SIGTERM, &HeadlessHolder::OnInterrupt );
+
+        SceneResources::SetupResources( mPrefabManager );
+        RenderResources::SetupResources( *mMeshManager, *mMesh2DManager, *mTextureManager, *mFontManager );
+
+        for( IGame* game : mGames )
+        {
+            game->Init();
+
+            EcsWorld& world = game->mWorld;
+            world.GetSingleton<RenderResources>().SetPointers( mMeshManager.get(),
+                                                               mMesh2DManager.get(),
+                                                               mTextureManager.get(),
+                                                               mFontManager.get() );
+            world.GetSingleton<SceneResources>().SetPointers( &mPrefabManager );
+            world.GetSingleton<RenderWorld>().mIsHeadless = true;
+
+            Application& app = world.GetSingleton<Application>();
+            app.mOnQuit.Connect( &HeadlessHolder::Exit, this );
+
+            if( _settings.mTickRate > 0 )
+            {
+                world.GetSingleton<Time>().SetTickRate( float( _settings.mTickRate ) );
+            }
+            if( _settings.mSnapshotRate > 0 )
+            {
+                world.GetSingleton<Time>().mSnapshotRate = float( _settings.mSnapshotRate );
+            }
+
+            // load scene
+            Scene& scene = world.GetSingleton<Scene>();
+            scene.New();
+            if( !_settings.loadScene.empty() )
+            {
+                scene.LoadFrom( _settings.loadScene );
+                game->Start();
+            }
+        }
+    }
+
+    //========================================================================================================
+    // resources were never uploaded to a device, only their cpu side is released
+    //========================================================================================================
+    HeadlessHolder::~HeadlessHolder()
+    {
+        mMeshManager->Clear();
+        mMesh2DManager->Clear();
+        mTextureManager->Clear();
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void HeadlessHolder::Exit()
+    {
+        mApplicationShouldExit = true;
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void HeadlessHolder::OnInterrupt( int /*_signal*/ )
+    {
+        sInterrupted = 1;
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void HeadlessHolder::Run()
+    {
+        const double startTime = Time::ElapsedSinceStartup();
+        for( IGame* game : mGames )
+        {
+            Time& time = game->mWorld.GetSingleton<Time>();
+            time.mLastLogicTime = startTime;
+            Debug::Log() << "Headless " << game->mName << " running at "
+                         << int( 1.f / time.mLogicDelta + 0.5f ) << " ticks per second" << Debug::Endl();
+        }
+
+        Profiler::Get().Begin();
+        mLastNetStatsTime = startTime;
+
+        while( mApplicationShouldExit == false && sInterrupted == 0 )
+        {
+            Step();
+        }
+
+        Debug::Log( "Exit application" );
+    }
+
+    //========================================================================================================
+    // runs the late logic frames of all games then sleeps until the next one
+    //========================================================================================================
+    void HeadlessHolder::Step()
+    {
+        const double currentTime = Time::ElapsedSinceStartup();
+        double nextTickTime = std::numeric_limits<double>::max();
+        for( IGame* game : mGames )
+        {
+            StepGame( *game, currentTime );
+            const Time& time = game->mWorld.GetSingleton<Time>();
+            nextTickTime = std::min( nextTickTime, time.mLastLogicTime + time.mLogicDelta );
+        }
+
+        // there is no frame to render, the profiler intervals are flushed every step
+        Profiler::Get().End();
+        Profiler::Get().Begin();
+
+        // the renderer usually releases the removed resources
+        mMeshManager->DestroyRemovedMeshes();
+        mMesh2DManager->DestroyRemovedMeshes();
+        mTextureManager->DestroyRemovedTextures();
+
+        if( mLaunchSettings.mNetStatsPeriod > 0 &&
+            currentTime - mLastNetStatsTime >= double( mLaunchSettings.mNetStatsPeriod ) )
+        {
+            mLastNetStatsTime = currentTime;
+            LogNetStats();
+        }
+
+        mPreciseSleep.SleepUntil( nextTickTime );
+    }
+
+    //========================================================================================================
+    // each report covers the period since the previous one
+    //========================================================================================================
+    void HeadlessHolder::LogNetStats()
+    {
+        for( IGame* game : mGames )
+        {
+            EcsWorld& world = game->mWorld;
+            if( world.SafeGetSingletonInfo( NetStats::Info::sType ) == nullptr ) { continue; }
+
+            NetStats& stats = world.GetSingleton<NetStats>();
+            std::stringstream report;
+            stats.Dump( world, report );
+            stats.Reset();
+            Debug::Log() << game->mName << " " << report.str() << Debug::Endl();
+        }
+    }
+
+    //========================================================================================================
+    // each game has its own time & can be late or shifted ( clients resynchronizing with the server )
+    //========================================================================================================
+    void HeadlessHolder::StepGame( IGame& _game, const double _currentTime )
+    {
+        Time& time = _game.mWorld.GetSingleton<Time>();
+        while( _currentTime > time.mLastLogicTime + time.mLogicDelta )
+        {
+            _game.mWorld.GetSingleton<RenderDebug>().Clear();
+
+            // if we are really really late, resets the timer
+            const double loopDelayMilliseconds = 1000. * ( _currentTime
+                                                           - ( time.mLastLogicTime + time.mLogicDelta ) );
+            if( loopDelayMilliseconds > 100 )
+            {
+                time.mLastLogicTime = _currentTime - time.mLogicDelta;
+            }
+
+            // increase the logic time of a timeScaleDelta with n timeScaleIncrements
+            if( std::abs( time.mTimeScaleDelta ) >= time.mTimeScaleIncrement )
+            {
+                const float increment = time.mTimeScaleDelta > 0.f
+                        ? time.mTimeScaleIncrement
+                        : -time.mTimeScaleIncrement;
+                time.mLastLogicTime -= increment;
+                time.mTimeScaleDelta -= increment;
+            }
+
+            time.mLastLogicTime += time.mLogicDelta;
+
+            _game.Step( time.mLogicDelta );
+            _game.mWorld.ApplyTransitions();
+        }
+    }
+}
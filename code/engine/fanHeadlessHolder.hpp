@@ -0,0 +1,56 @@
+#pragma once
+
+#include <csignal>
+#include <memory>
+#include <vector>
+#include "core/time/fanPreciseSleep.hpp"
+#include "engine/fanPrefabManager.hpp"
+#include "game/fanLaunchSettings.hpp"
+
+namespace fan
+{
+    class IGame;
+    class MeshManager;
+    class Mesh2DManager;
+    class TextureManager;
+    class FontManager;
+
+    //========================================================================================================
+    // This holder runs games without window, renderer or input ( dedicated server, soak benchmark )
+    // Auto load a scene & starts it, steps the logic at a fixed tick rate & sleeps between the ticks
+    // there can be multiple IGame for client and server to run in the same process
+    // resources are only loaded on the cpu, no graphics device is created
+    // render managers are forward declared, users of the holder do not include the render module
+    //========================================================================================================
+    class HeadlessHolder
+    {
+    public:
+        HeadlessHolder( LaunchSettings& _settings, const std::vector<IGame*>& _games );
+        ~HeadlessHolder();
+        HeadlessHolder( HeadlessHolder const& ) = delete;
+        HeadlessHolder& operator=( HeadlessHolder const& ) = delete;
+
+        void Run();
+        void Step();
+        void Exit();
+
+    private:
+        const LaunchSettings mLaunchSettings;
+        std::vector<IGame*>  mGames;
+        bool                 mApplicationShouldExit;
+        PreciseSleep         mPreciseSleep;
+        double               mLastNetStatsTime;	// see LaunchSettings::mNetStatsPeriod
+
+        PrefabManager                   mPrefabManager;
+        std::unique_ptr<MeshManager>    mMeshManager;
+        std::unique_ptr<Mesh2DManager>  mMesh2DManager;
+        std::unique_ptr<TextureManager> mTextureManager;
+        std::unique_ptr<FontManager>    mFontManager;
+
+        static void StepGame( IGame& _game, const double _currentTime );
+        void        LogNetStats();
+
+        static volatile std::sig_atomic_t sInterrupted; // set by ctrl+c or a termination request
+        static void OnInterrupt( int _signal );
+    };
+}
@@ -51,6 +51,7 @@
 #include "network/components/fanClientGameData.hpp"
 #include "network/components/fanClientRollback.hpp"
 #include "network/singletons/fanLinkingContext.hpp"
+#include "network/singletons/fanNetStats.hpp"
 
 // network server
 #include "network/components/fanHostGameData.hpp"
@@ -58,6 +59,7 @@
 #include "network/components/fanHostReplication.hpp"
 #include "network/components/fanHostPersistentHandle.hpp"
 #include "network/components/fanEntityReplication.hpp"
+#include "network/components/fanEntityInterpolation.hpp"
 #include "network/singletons/fanServerConnection.hpp"
 #include "network/singletons/fanHostManager.hpp"
 #include "network/singletons/fanSpawnManager.hpp"
@@ -139,8 +141,10 @@ namespace fan
         _world.AddComponentType<ClientRPC>();
         _world.AddComponentType<ClientGameData>();
         _world.AddComponentType<ClientRollback>();
+        _world.AddComponentType<EntityInterpolation>();
 
         _world.AddSingletonType<LinkingContext>();
+        _world.AddSingletonType<NetStats>();
     }
 
     //========================================================================================================
@@ -159,5 +163,6 @@ namespace fan
         _world.AddSingletonType<LinkingContext>();
         _world.AddSingletonType<HostManager>();
         _world.AddSingletonType<SpawnManager>();
+        _world.AddSingletonType<NetStats>();
     }
 }
\ No newline at end of file
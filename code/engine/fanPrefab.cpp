@@ -1,6 +1,9 @@
 #include "engine/fanPrefab.hpp"
 
+#include <cstddef>
 #include <fstream>
+#include <algorithm>
+#include <memory>
 #include "core/fanDebug.hpp"
 #include "engine/components/fanSceneNode.hpp"
 #include "engine/singletons/fanScene.hpp"
@@ -8,6 +11,99 @@
 
 namespace fan
 {
+	//========================================================================================================
+	//========================================================================================================
+	void PrefabTemplate::Compile( const Json& _jPrefab )
+	{
+		Clear();
+		RCompileNode( _jPrefab, -1 );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void PrefabTemplate::Clear()
+	{
+		mNodes.clear();
+		mComponents.clear();
+		mMaxHandle = 0;
+		mPrototypes.clear();
+		mPrototypesBase     = nullptr;
+		mPrototypesCompiled = false;
+	}
+
+	//========================================================================================================
+	// same traversal as Scene::RLoadFromJson
+	//========================================================================================================
+	void PrefabTemplate::RCompileNode( const Json& _jNode, const int _parentIndex )
+	{
+		Node node;
+		node.mParentIndex = _parentIndex;
+		node.mHandle      = 0;
+		Serializable::LoadUInt( _jNode, "handle", node.mHandle );
+		Serializable::LoadString( _jNode, "name", node.mName );
+		mMaxHandle = std::max( mMaxHandle, node.mHandle );
+
+		node.mComponentsBegin = (int)mComponents.size();
+		const Json& jComponents = _jNode["components"];
+		for( int componentIndex = 0; componentIndex < (int)jComponents.size(); componentIndex++ )
+		{
+			const Json& jComponent_i = jComponents[componentIndex];
+			Component component;
+			component.mType = 0;
+			Serializable::LoadUInt( jComponent_i, "component_type", component.mType );
+			component.mJson = jComponent_i;
+			component.mPrototypeOffset = -1;
+			mComponents.push_back( component );
+		}
+		node.mComponentsEnd = (int)mComponents.size();
+
+		const int nodeIndex = (int)mNodes.size();
+		mNodes.push_back( node );
+
+		const Json& jchilds = _jNode["childs"];
+		for( int childIndex = 0; childIndex < (int)jchilds.size(); childIndex++ )
+		{
+			RCompileNode( jchilds[childIndex], nodeIndex );
+		}
+	}
+
+	//========================================================================================================
+	// component sizes are only known by the world, so the layout is made by the first instance
+	//========================================================================================================
+	void PrefabTemplate::LayoutPrototypes( const EcsWorld& _world ) const
+	{
+		size_t size = 0;
+		size_t maxAlignment = 1;
+		for( const Component& component : mComponents )
+		{
+			component.mPrototypeOffset = -1;
+			const EcsComponentInfo* info = _world.SafeGetComponentInfo( component.mType );
+			if( info == nullptr ) { continue; }
+
+			size_t prototypeSize      = info->mSize;
+			size_t prototypeAlignment = info->mAlignment;
+			if( info->mFlags & EcsComponentInfo::PrefabPerInstance )
+			{
+				if( info->prefabLoad == nullptr ) { continue; }
+				prototypeSize      = info->mPrefabSize;
+				prototypeAlignment = alignof( std::max_align_t );
+			}
+
+			size = ( size + prototypeAlignment - 1 ) / prototypeAlignment * prototypeAlignment;
+			component.mPrototypeOffset = int( size );
+			size += prototypeSize;
+			maxAlignment = std::max( maxAlignment, prototypeAlignment );
+		}
+
+		mPrototypes.resize( size + maxAlignment );
+		void* base = mPrototypes.data();
+		size_t space = mPrototypes.size();
+		void* result = std::align( maxAlignment, size, base, space );
+		fanAssert( result != nullptr );
+		(void)result;
+		mPrototypesBase = static_cast<uint8_t*>( base );
+	}
+
     //========================================================================================================
 	//========================================================================================================
 	bool Prefab::CreateFromJson( const Json& _json )
@@ -17,6 +113,7 @@ namespace fan
 		if ( _json.contains( "prefab" ) )
 		{
             mJson = _json;
+			mTemplate.Compile( mJson["prefab"] );
 			return true;
 		}
 		else
@@ -41,6 +138,7 @@ namespace fan
 			if ( mJson.contains( "prefab" ) )
 			{
                 mPath = _path;
+				mTemplate.Compile( mJson["prefab"] );
 				return true;
 			}
 			else
@@ -68,6 +166,7 @@ namespace fan
         Scene::RemapTable remapTable;
         Scene::GenerateRemapTable( prefabJson, remapTable );
         Scene::RemapHandlesRecursively( prefabJson, remapTable );
+		mTemplate.Compile( prefabJson );
 	}
 
 	//========================================================================================================
@@ -84,11 +183,74 @@ namespace fan
 			EcsWorld& world = *_parent.mScene->mWorld;
 			Scene& scene = world.GetSingleton<Scene>();
 			const EcsHandle handleOffset = world.GetNextHandle() - 1;
-			SceneNode& newNode = Scene::RLoadFromJson( mJson["prefab"], scene, &_parent, handleOffset );
-			const EcsHandle maxHandle = Scene::RFindMaximumHandle( _parent );
-			world.SetNextHandle( maxHandle + 1);
+			const bool compilePrototypes = !mTemplate.mPrototypesCompiled;
+			if( compilePrototypes ) { mTemplate.LayoutPrototypes( world ); }
+
+			// nodes are stored parents first, so the parent of a node is always created before it
+			std::vector<SceneNode*> nodes( mTemplate.mNodes.size(), nullptr );
+			for( int nodeIndex = 0; nodeIndex < (int)mTemplate.mNodes.size(); nodeIndex++ )
+			{
+				const PrefabTemplate::Node& templateNode = mTemplate.mNodes[nodeIndex];
+
+				// the entity is created with all its components
+				EcsSignature signature( 0 );
+				for( int i = templateNode.mComponentsBegin; i < templateNode.mComponentsEnd; i++ )
+				{
+					const EcsComponentInfo* info = world.SafeGetComponentInfo( mTemplate.mComponents[i].mType );
+					if( info != nullptr ) { signature[info->mIndex] = 1; }
+				}
+
+				SceneNode* parent = templateNode.mParentIndex < 0 ? &_parent : nodes[templateNode.mParentIndex];
+				SceneNode& node = scene.CreateSceneNode( templateNode.mName,
+														 parent,
+														 templateNode.mHandle + handleOffset,
+														 signature );
+				nodes[nodeIndex] = &node;
+
+				const EcsEntity entity = world.GetEntity( node.mHandle );
+				for( int i = templateNode.mComponentsBegin; i < templateNode.mComponentsEnd; i++ )
+				{
+					const PrefabTemplate::Component& templateComponent = mTemplate.mComponents[i];
+					const EcsComponentInfo* info = world.SafeGetComponentInfo( templateComponent.mType );
+					if( info == nullptr ) { continue; }
+
+					EcsComponent& component = world.IndexedGetComponent( entity, info->mIndex );
+					if( templateComponent.mPrototypeOffset < 0 )
+					{
+						info->load( component, templateComponent.mJson );
+						continue;
+					}
+
+					void* prototype = mTemplate.GetPrototype( templateComponent );
+					if( info->mFlags & EcsComponentInfo::PrefabPerInstance )
+					{
+						if( compilePrototypes )
+						{
+							info->load( component, templateComponent.mJson );
+							info->prefabSave( component, prototype );
+						}
+						else
+						{
+							info->prefabLoad( component, prototype );
+						}
+					}
+					else if( compilePrototypes )
+					{
+						info->load( component, templateComponent.mJson );
+						info->copy( prototype, &component, info->mSize );
+					}
+					else
+					{
+						info->copy( &component, prototype, info->mSize );
+					}
+				}
+			}
+			mTemplate.mPrototypesCompiled = true;
+
+			// handles of the prefab are known at compile time, no need to walk the scene tree
+			world.SetNextHandle( std::max( world.GetNextHandle(), handleOffset + mTemplate.mMaxHandle + 1 ) );
 			ScenePointers::ResolveComponentPointers( world, handleOffset );
-			return &newNode;
+			return nodes[0];
 		}		
 	}
 }
\ No newline at end of file
@@ -1,11 +1,56 @@
 #pragma once
 
+#include <vector>
+#include "core/ecs/fanEcsTypes.hpp"
 #include "core/resources/fanResource.hpp"
 #include "engine/fanSceneSerializable.hpp"
 
 namespace fan
 {
 	struct SceneNode;
+	class EcsWorld;
+
+	//========================================================================================================
+	// flattened version of the prefab json, compiled once when the prefab is created
+	// nodes are stored depth first ( parents before their childs ) with handles relative to the prefab
+	// the first instance compiles the components to prototypes, next instances copy construct them
+	// components flagged PrefabPerInstance own per instance data ( bullet objects, scene pointers ),
+	// their prototype only holds the parameters applied with prefabLoad ( mass, radius etc. )
+	// per instance components without prefabLoad are loaded from their json for every instance
+	//========================================================================================================
+	struct PrefabTemplate
+	{
+		struct Component
+		{
+			uint32_t    mType;
+			Json        mJson;
+			mutable int mPrototypeOffset;	// in the prototypes buffer, -1 if loaded from json for every instance
+		};
+
+		struct Node
+		{
+			std::string mName;
+			EcsHandle   mHandle;			// relative to the prefab
+			int         mParentIndex;		// -1 for the prefab root
+			int         mComponentsBegin;
+			int         mComponentsEnd;
+		};
+
+		void Compile( const Json& _jPrefab );
+		void Clear();
+		void RCompileNode( const Json& _jNode, const int _parentIndex );
+		void LayoutPrototypes( const EcsWorld& _world ) const;
+		void* GetPrototype( const Component& _component ) const { return mPrototypesBase + _component.mPrototypeOffset; }
+
+		std::vector<Node>      mNodes;
+		std::vector<Component> mComponents;
+		EcsHandle              mMaxHandle = 0;
+
+		// prototypes are compiled lazily by the first instance, the buffer is never resized after its layout
+		mutable std::vector<uint8_t> mPrototypes;
+		mutable uint8_t*             mPrototypesBase     = nullptr;
+		mutable bool                 mPrototypesCompiled = false;
+	};
 
 	//========================================================================================================
 	// represents a gameobjects tree
@@ -21,9 +66,13 @@ namespace fan
 		SceneNode* Instantiate( SceneNode& _parent ) const;
 
 		bool IsEmpty() const { return !mJson.contains( "prefab" ); }
-		void Clear() { mJson = Json(); }
+		void Clear() { mJson = Json(); mTemplate.Clear(); }
+		const PrefabTemplate& GetTemplate() const { return mTemplate; }
 
 		Json        mJson;
 		std::string mPath;
+
+	private:
+		PrefabTemplate mTemplate;
 	};
 }
\ No newline at end of file
@@ -1,15 +1,10 @@
 #include "engine/singletons/fanMouse.hpp"
+#include <algorithm>
 #include "core/fanAssert.hpp"
 #include "core/fanDebug.hpp"
-#include "render/fanWindow.hpp"
-#include "editor/fanModals.hpp"
 
 namespace fan
 {
-
-    static_assert( Mouse::count == GLFW_MOUSE_BUTTON_LAST + 1 );
-    static_assert( Mouse::button1 == GLFW_MOUSE_BUTTON_1 );
-
     bool Mouse::sLocked = false;
 
     //========================================================================================================
@@ -46,14 +41,6 @@ namespace fan
         }
     }
 
-    //========================================================================================================
-    //========================================================================================================
-    void Mouse::UpdateData( GLFWwindow* _window )
-    {
-        Mouse& mouse = Window::GetInputData( _window ).mMouse;
-        std::memcpy( this, &mouse, sizeof( Mouse ) );
-    }
-
     //========================================================================================================
     // Coordinate between -1.f and 1.f
     //========================================================================================================
@@ -67,93 +54,6 @@ namespace fan
         return ratio;
     }
 
-    //========================================================================================================
-    //========================================================================================================
-    void Mouse::NextFrame( GLFWwindow* _window, const glm::vec2 _position, const glm::vec2 _size  )
-    {
-        Window::InputData& inputData = Window::GetInputData( _window );
-        Mouse            & mouse     = inputData.mMouse;
-        mouse.mScreenPosition = _position;
-        mouse.mScreenSize = _size;
-        mouse.mScrollDelta = glm::vec2( 0.f, 0.f );
-        mouse.mPositionDelta = glm::vec2( 0.f, 0.f );
-        for( int i=0 ; i < Mouse::count; i++ )
-        {
-            mouse.mPressed[i] = false;
-            mouse.mReleased[i] = false;
-        }
-        mouse.mLocalPosition =  mouse.mPosition - mouse.mScreenPosition;
-        mouse.mWindowHovered = mouse.IsWindowHovered();
-        if( mouse.sLocked ){ glfwSetCursorPos( inputData.mWindow, mouse.mPosition.x, mouse.mPosition.y );}
-    }
-
-    //========================================================================================================
-    //========================================================================================================
-    void Mouse::SetCallbacks( GLFWwindow* _window )
-    {
-        glfwSetCursorPosCallback( _window, Mouse::MouseCallback );
-        glfwSetMouseButtonCallback( _window, Mouse::MouseButtonCallback );
-        glfwSetScrollCallback( _window, Mouse::ScrollCallback );
-    }
-
-    //========================================================================================================
-    //========================================================================================================
-    void Mouse::MouseCallback( GLFWwindow* _window, double _x, double _y )
-    {
-        Window::InputData& inputData =  Window::GetInputData( _window );
-        Mouse            & mouse     = inputData.mMouse;
-        mouse.mPositionDelta = glm::vec2( _x, _y ) - mouse.mPosition;
-        if( !mouse.sLocked )
-        {
-            mouse.mPosition = glm::vec2( (float)_x, (float)_y );
-            mouse.mLocalPosition =  mouse.mPosition - mouse.mScreenPosition;
-            mouse.mWindowHovered = mouse.IsWindowHovered();
-        }
-
-        ImGuiIO& io = ImGui::GetIO();
-        io.MousePos = ImVec2( static_cast< float >( _x ), static_cast< float >( _y ) );
-    }
-
-    //========================================================================================================
-    //========================================================================================================
-    void Mouse::MouseButtonCallback( GLFWwindow* _window, int _button, int _action, int /*_mods*/ )
-    {
-        Mouse& mouse = Window::GetInputData( _window ).mMouse;
-
-        fanAssert( _button < Mouse::Button::count );
-        ImGuiIO& io = ImGui::GetIO();
-        switch(  _action )
-        {
-            case GLFW_PRESS:
-                mouse.mPressed[ _button ] = true;
-                mouse.mDown[ _button ] = true;
-                if ( _button < 5 ) { io.MouseDown[ _button ] = true; }
-                break;
-            case GLFW_RELEASE:
-                mouse.mReleased[ _button ] = true;
-                mouse.mDown[ _button ] = false;
-                if ( _button < 5 ) { io.MouseDown[ _button ] = false; }
-                break;
-            case GLFW_REPEAT:
-
-                break;
-            default:
-                break;
-        }
-    }
-
-    //========================================================================================================
-    //========================================================================================================
-    void Mouse::ScrollCallback( GLFWwindow* _window, double _xoffset, double _yoffset )
-    {
-        Mouse& mouse = Window::GetInputData( _window ).mMouse;
-        mouse.mScrollDelta += glm::vec2 ( (float)_xoffset, (float)_yoffset );
-
-        ImGuiIO& io = ImGui::GetIO();
-        io.MouseWheelH += ( float ) _xoffset;
-        io.MouseWheel += ( float ) _yoffset;
-    }
-
     //========================================================================================================
     //========================================================================================================
     bool Mouse::IsWindowHovered() const
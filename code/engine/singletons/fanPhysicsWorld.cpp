@@ -4,6 +4,9 @@
 #include "engine/components/fanRigidbody.hpp"
 #include "core/memory/fanSerializable.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace fan
 {
 	//========================================================================================================
@@ -27,6 +30,14 @@ namespace fan
 			physicsWorld.mDynamicsWorld->removeCollisionObject( obj );
 		}
 		physicsWorld.mDynamicsWorld->setGravity( btVector3::Zero() );
+
+		physicsWorld.mSnapshots.clear();
+		physicsWorld.mSnapshots.resize( sMaxSnapshots );
+		for( Snapshot& snapshot : physicsWorld.mSnapshots )
+		{
+			snapshot.mFrameIndex = std::numeric_limits<FrameIndex>::max();
+		}
+		physicsWorld.mReplayedRigidbodies.clear();
 	}
 
 	//========================================================================================================
@@ -118,6 +129,143 @@ namespace fan
 		mDynamicsWorld->getConstraintSolver()->reset();
 	}
 
+	//========================================================================================================
+	// saves the state of all dynamic rigidbodies, the buffers of the snapshots are reused
+	//========================================================================================================
+	void PhysicsWorld::SaveSnapshot( const FrameIndex _frameIndex )
+	{
+		fanAssert( mSnapshots.size() == sMaxSnapshots );
+		Snapshot& snapshot = mSnapshots[_frameIndex % sMaxSnapshots];
+		snapshot.mFrameIndex = _frameIndex;
+		snapshot.mStates.clear();
+
+		const btCollisionObjectArray& collisionObjects = mDynamicsWorld->getCollisionObjectArray();
+		for( int i = 0; i < collisionObjects.size(); i++ )
+		{
+			const btRigidBody* rigidbodyPtr = btRigidBody::upcast( collisionObjects[i] );
+			if( rigidbodyPtr == nullptr || rigidbodyPtr->isStaticOrKinematicObject() ) { continue; }
+
+			const btRigidBody& rigidbody = *rigidbodyPtr;
+			RigidbodyState state;
+			state.mHandle          = static_cast<EcsHandle>( rigidbody.getUserIndex() );
+			state.mTransform       = rigidbody.getWorldTransform();
+			state.mVelocity        = rigidbody.getLinearVelocity();
+			state.mAngularVelocity = rigidbody.getAngularVelocity();
+			snapshot.mStates.push_back( state );
+		}
+		std::sort( snapshot.mStates.begin(), snapshot.mStates.end(),
+				   []( const RigidbodyState& _a, const RigidbodyState& _b ) { return _a.mHandle < _b.mHandle; } );
+	}
+
+	//========================================================================================================
+	// returns nullptr if the frame is not saved
+	//========================================================================================================
+	const PhysicsWorld::Snapshot* PhysicsWorld::GetSnapshot( const FrameIndex _frameIndex ) const
+	{
+		if( mSnapshots.empty() ) { return nullptr; }
+		const Snapshot& snapshot = mSnapshots[_frameIndex % sMaxSnapshots];
+		return snapshot.mFrameIndex == _frameIndex ? &snapshot : nullptr;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	const PhysicsWorld::RigidbodyState* PhysicsWorld::Snapshot::Find( const EcsHandle _handle ) const
+	{
+		auto it = std::lower_bound( mStates.begin(), mStates.end(), _handle,
+									[]( const RigidbodyState& _state, const EcsHandle _value ) { return _state.mHandle < _value; } );
+		return ( it != mStates.end() && it->mHandle == _handle ) ? &( *it ) : nullptr;
+	}
+
+	//========================================================================================================
+	// dynamic rigidbodies that are not simulated are replayed from the snapshots and put to sleep,
+	// bullet only integrates, solves and updates the aabb of active bodies
+	// so the cost of a resimulated frame depends on the simulated bodies only
+	// a replayed rigidbody woken up by a contact with a simulated one is simulated for the current frame
+	//========================================================================================================
+	void PhysicsWorld::BeginResimulation( const std::vector<EcsHandle>& _simulatedHandles )
+	{
+		fanAssert( mReplayedRigidbodies.empty() );
+		btCollisionObjectArray& collisionObjects = mDynamicsWorld->getCollisionObjectArray();
+		for( int i = 0; i < collisionObjects.size(); i++ )
+		{
+			btRigidBody* rigidbody = btRigidBody::upcast( collisionObjects[i] );
+			if( rigidbody == nullptr ) { continue; }
+
+			const EcsHandle handle = static_cast<EcsHandle>( rigidbody->getUserIndex() );
+			if( rigidbody->isStaticOrKinematicObject() ||
+				std::find( _simulatedHandles.begin(), _simulatedHandles.end(), handle ) != _simulatedHandles.end() )
+			{
+				continue;
+			}
+			mReplayedRigidbodies.push_back( { rigidbody, rigidbody->getActivationState() } );
+		}
+		mDynamicsWorld->setForceUpdateAllAabbs( false );
+	}
+
+	//========================================================================================================
+	// must be called before stepping the resimulated frame, after the motion states were synchronized
+	// replayed rigidbodies missing from the snapshot are left in place
+	//========================================================================================================
+	void PhysicsWorld::ReplaySnapshot( const FrameIndex _frameIndex )
+	{
+		const Snapshot* snapshot = GetSnapshot( _frameIndex );
+		for( ReplayedRigidbody& replayed : mReplayedRigidbodies )
+		{
+			btRigidBody& rigidbody = *replayed.mRigidbody;
+			const RigidbodyState* state = snapshot != nullptr
+				? snapshot->Find( static_cast<EcsHandle>( rigidbody.getUserIndex() ) )
+				: nullptr;
+			if( state != nullptr )
+			{
+				RestoreState( rigidbody, *state );
+				mDynamicsWorld->updateSingleAabb( &rigidbody );
+			}
+			rigidbody.forceActivationState( ISLAND_SLEEPING );
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void PhysicsWorld::EndResimulation()
+	{
+		for( ReplayedRigidbody& replayed : mReplayedRigidbodies )
+		{
+			replayed.mRigidbody->forceActivationState( replayed.mActivationState );
+			replayed.mRigidbody->setDeactivationTime( 0.f );
+		}
+		mReplayedRigidbodies.clear();
+		mDynamicsWorld->setForceUpdateAllAabbs( true );
+	}
+
+	//========================================================================================================
+	// removes the overlapping pairs & contact manifolds of a rigidbody that was moved manually
+	// cheaper than Reset() that clears the cached data of the whole world
+	//========================================================================================================
+	void PhysicsWorld::ClearCachedContacts( btRigidBody& _rigidbody )
+	{
+		if( _rigidbody.getBroadphaseHandle() == nullptr ) { return; }
+
+		btOverlappingPairCache* pairCache = mDynamicsWorld->getBroadphase()->getOverlappingPairCache();
+		pairCache->cleanProxyFromPairs( _rigidbody.getBroadphaseHandle(), mDynamicsWorld->getDispatcher() );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void PhysicsWorld::RestoreState( btRigidBody& _rigidbody, const RigidbodyState& _state )
+	{
+		_rigidbody.setWorldTransform( _state.mTransform );
+		_rigidbody.setInterpolationWorldTransform( _state.mTransform );
+		_rigidbody.setLinearVelocity( _state.mVelocity );
+		_rigidbody.setAngularVelocity( _state.mAngularVelocity );
+		_rigidbody.setInterpolationLinearVelocity( _state.mVelocity );
+		_rigidbody.setInterpolationAngularVelocity( _state.mAngularVelocity );
+		_rigidbody.clearForces();
+		if( _rigidbody.getMotionState() != nullptr )
+		{
+			_rigidbody.getMotionState()->setWorldTransform( _state.mTransform );
+		}
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	PhysicsWorld::~PhysicsWorld()
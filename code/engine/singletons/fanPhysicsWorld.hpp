@@ -1,6 +1,8 @@
 #pragma once
 
+#include <vector>
 #include "core/ecs/fanEcsSingleton.hpp"
+#include "network/fanNetConfig.hpp"
 #include "fanDisableWarnings.hpp"
 WARNINGS_BULLET_PUSH()
 #include "bullet/btBulletDynamicsCommon.h"
@@ -14,6 +16,7 @@ namespace fan
 	// Contains all Bullet physics components
 	// allows registering of rigidbodies and quick rigidbodies access through handles
 	// triggers collision callbacks
+	// keeps a ring of snapshots of the dynamic rigidbodies for rolling back the simulation
 	//========================================================================================================
 	struct PhysicsWorld : public EcsSingleton
 	{
@@ -32,7 +35,50 @@ namespace fan
 		btSequentialImpulseConstraintSolver* mSolver;
 		btDiscreteDynamicsWorld*			 mDynamicsWorld;
 
+		//================================================================
+		// dynamic state of a rigidbody at a specific frame
+		//================================================================
+		struct RigidbodyState
+		{
+			EcsHandle   mHandle;
+			btTransform mTransform;
+			btVector3   mVelocity;
+			btVector3   mAngularVelocity;
+		};
+
+		//================================================================
+		// states of all dynamic rigidbodies, sorted by handle
+		//================================================================
+		struct Snapshot
+		{
+			FrameIndex                  mFrameIndex;
+			std::vector<RigidbodyState> mStates;
+
+			const RigidbodyState* Find( const EcsHandle _handle ) const;
+		};
+
+		//================================================================
+		// rigidbody replayed from the snapshots during a resimulation
+		//================================================================
+		struct ReplayedRigidbody
+		{
+			btRigidBody* mRigidbody;
+			int          mActivationState;
+		};
+
+		static const int sMaxSnapshots = 64;
+
+		std::vector<Snapshot>          mSnapshots;			// ring indexed by frame index
+		std::vector<ReplayedRigidbody> mReplayedRigidbodies;
+
 		void Reset();
+		void SaveSnapshot( const FrameIndex _frameIndex );
+		const Snapshot* GetSnapshot( const FrameIndex _frameIndex ) const;
+		void BeginResimulation( const std::vector<EcsHandle>& _simulatedHandles );
+		void ReplaySnapshot( const FrameIndex _frameIndex );
+		void EndResimulation();
+		void ClearCachedContacts( btRigidBody& _rigidbody );
+		static void RestoreState( btRigidBody& _rigidbody, const RigidbodyState& _state );
 		static void ContactStartedCallback( btPersistentManifold* const& _manifold );
 		static void ContactEndedCallback( btPersistentManifold* const& _manifold );
 	};
@@ -45,29 +45,28 @@ namespace fan
 	//========================================================================================================
 	// _handle can be used to force the handle of scene node entity,
 	// if _handle=0 (by default), generate a new handle
+	// components of _signature are created with the node in a single step ( see EcsWorld::CreateEntity )
 	//========================================================================================================
-	SceneNode& Scene::CreateSceneNode( const std::string _name, SceneNode* const _parentNode, EcsHandle _handle )
+	SceneNode& Scene::CreateSceneNode( const std::string _name,
+	                                   SceneNode* const _parentNode,
+	                                   EcsHandle _handle,
+	                                   const EcsSignature& _signature )
 	{
         fanAssert( _parentNode != nullptr || mRootNodeHandle == 0 ); // we can have only one root node
 
-		EcsEntity entity = mWorld->CreateEntity();
-
-		// set entity handle
-		EcsHandle handle = 0;
+		const EcsHandle handle = _handle != 0 ? _handle : mWorld->GetNextHandle();
+		const EcsSignature signature = _signature |
+		                               mWorld->GetSignature<SceneNode>() |
+		                               mWorld->GetSignature<Bounds>();
+		const EcsEntity entity = mWorld->CreateEntity( signature, handle );
 		if( _handle == 0 )
 		{
-			handle = mWorld->AddHandle( entity );
-		}
-		else
-		{
-			mWorld->SetHandle( entity, _handle );
-			handle = _handle;
+			mWorld->SetNextHandle( handle + 1 );
 		}
         fanAssert( mNodes.find( handle ) == mNodes.end() );
 		mNodes.insert( handle );
 
-		SceneNode& sceneNode = mWorld->AddComponent<SceneNode>( entity );
-		mWorld->AddComponent<Bounds>( entity );
+		SceneNode& sceneNode = mWorld->GetComponent<SceneNode>( entity );
 		sceneNode.AddFlag( SceneNode::BoundsOutdated );
 		if( _parentNode == nullptr ) // root node
 		{
@@ -188,6 +187,7 @@ namespace fan
 		// save components
 		Json& jComponents = _json["components"];
 		{
+			const EcsWorld& constWorld = world;	// read only access, components versions are left unchanged
 			EcsEntity entity = world.GetEntity( _node.mHandle );
 			unsigned nextIndex = 0;
 			for( const EcsComponentInfo& info : world.GetComponentInfos() )
@@ -195,7 +195,7 @@ namespace fan
 				if( ! world.HasComponent( entity, info.mType ) ) { continue; }
 
 				// if a save method is provided, saves the component
-				EcsComponent& component = world.GetComponent( entity, info.mType );
+				const EcsComponent& component = constWorld.GetComponent( entity, info.mType );
 				if( info.save != nullptr )
 				{
 					Json& jComponent_i = jComponents[nextIndex++];
@@ -23,7 +23,8 @@ namespace fan
 
         SceneNode& CreateSceneNode( const std::string _name,
                                     SceneNode* const _parentNode,
-                                    EcsHandle _handle = 0 );
+                                    EcsHandle _handle = 0,
+                                    const EcsSignature& _signature = EcsSignature( 0 ) );
 
 		void New();
 		void Save() const;
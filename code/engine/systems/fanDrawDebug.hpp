@@ -48,9 +48,9 @@ namespace fan
 		}
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
-			auto meshRendererIt = _view.begin<MeshRenderer>();
-			auto transformIt = _view.begin<Transform>();
-			for( ; meshRendererIt != _view.end<MeshRenderer>(); ++meshRendererIt, ++transformIt )
+			auto meshRendererIt = _view.begin<const MeshRenderer>();
+			auto transformIt = _view.begin<const Transform>();
+			for( ; meshRendererIt != _view.end<const MeshRenderer>(); ++meshRendererIt, ++transformIt )
 			{
 				const MeshRenderer& meshRenderer = *meshRendererIt;
 				const Transform& transform = *transformIt;
@@ -86,9 +86,9 @@ namespace fan
 		}
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
-			auto meshRendererIt = _view.begin<MeshRenderer>();
-			auto transformIt = _view.begin<Transform>();
-			for( ; meshRendererIt != _view.end<MeshRenderer>(); ++meshRendererIt, ++transformIt )
+			auto meshRendererIt = _view.begin<const MeshRenderer>();
+			auto transformIt = _view.begin<const Transform>();
+			for( ; meshRendererIt != _view.end<const MeshRenderer>(); ++meshRendererIt, ++transformIt )
 			{
 				const MeshRenderer& meshRenderer = *meshRendererIt;
 				const Transform& transform = *transformIt;
@@ -124,9 +124,9 @@ namespace fan
 
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
-			auto meshRendererIt = _view.begin<MeshRenderer>();
-			auto transformIt = _view.begin<Transform>();
-			for( ; meshRendererIt != _view.end<MeshRenderer>(); ++meshRendererIt, ++transformIt )
+			auto meshRendererIt = _view.begin<const MeshRenderer>();
+			auto transformIt = _view.begin<const Transform>();
+			for( ; meshRendererIt != _view.end<const MeshRenderer>(); ++meshRendererIt, ++transformIt )
 			{
 				const MeshRenderer& meshRenderer = *meshRendererIt;
 				const Transform& transform = *transformIt;
@@ -171,7 +171,7 @@ namespace fan
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
 			auto lightIt = _view.begin<PointLight>();
-			auto transformIt = _view.begin<Transform>();
+			auto transformIt = _view.begin<const Transform>();
 			RenderDebug& renderDebug = _world.GetSingleton<RenderDebug>();
 			for( ; lightIt != _view.end<PointLight>(); ++lightIt, ++transformIt )
 			{
@@ -206,7 +206,7 @@ namespace fan
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
 			auto lightIt = _view.begin<DirectionalLight>();
-			auto transformIt = _view.begin<Transform>();
+			auto transformIt = _view.begin<const Transform>();
 			RenderDebug& renderDebug = _world.GetSingleton<RenderDebug>();
 			for( ; lightIt != _view.end<DirectionalLight>(); ++lightIt, ++transformIt )
 			{
@@ -254,8 +254,8 @@ namespace fan
 
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
-			auto transformIt = _view.begin<Transform>();
-			for( ; transformIt != _view.end<Transform>(); ++transformIt )
+			auto transformIt = _view.begin<const Transform>();
+			for( ; transformIt != _view.end<const Transform>(); ++transformIt )
 			{
 				const EcsEntity entity = transformIt.GetEntity();
 				DrawCollisionShape( _world, entity );
@@ -266,12 +266,12 @@ namespace fan
 		{
 			if( !_world.HasComponent<Transform>( _entity ) ) { return; }
 
-			const Transform& transform = _world.GetComponent<Transform>( _entity );
+			const Transform& transform = _world.GetComponent<const Transform>( _entity );
 
 			// box shape
 			if( _world.HasComponent<BoxShape>( _entity ) )
 			{
-				const BoxShape& shape = _world.GetComponent<BoxShape>( _entity );
+				const BoxShape& shape = _world.GetComponent<const BoxShape>( _entity );
                 _world.GetSingleton<RenderDebug>().DebugCube( transform.mTransform,
                                                               0.5f * shape.GetScaling(),
                                                               Color::sGreen, false );
@@ -280,7 +280,7 @@ namespace fan
 			// sphere shape
 			if( _world.HasComponent<SphereShape>( _entity ) )
 			{
-				const SphereShape& shape = _world.GetComponent<SphereShape>( _entity );
+				const SphereShape& shape = _world.GetComponent<const SphereShape>( _entity );
                 _world.GetSingleton<RenderDebug>().DebugSphere( transform.mTransform,
                                                                 shape.GetRadius(),
                                                                 Color::sGreen, false );
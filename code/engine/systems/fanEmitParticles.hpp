@@ -23,9 +23,9 @@ namespace fan
 
 			if( _delta == 0.f ) { return; }
 
-			auto transformIt = _view.begin<Transform>();
+			auto transformIt = _view.begin<const Transform>();
 			auto particleEmitterIt = _view.begin<ParticleEmitter>();
-			for( ; transformIt != _view.end<Transform>(); ++transformIt, ++particleEmitterIt )
+			for( ; transformIt != _view.end<const Transform>(); ++transformIt, ++particleEmitterIt )
 			{
 				const Transform& emitterTransform = *transformIt;
 				ParticleEmitter& emitter = *particleEmitterIt;
@@ -22,28 +22,35 @@ namespace fan
 			if( _delta == 0.f ) { return; }
 
 			RenderWorld& renderWorld = _world.GetSingleton<RenderWorld>();
-			std::vector<Vertex> vertices;
-			vertices.resize( _view.Size() * 3 );
 			const float size = 0.05f;
 
-			for( auto particleIt = _view.begin<Particle>(); particleIt != _view.end<Particle>(); ++particleIt )
+			// each batch generates the vertices of its particles, batches are merged in order
+			std::vector<std::vector<Vertex>> batchesVertices;
+			_view.ParallelForEach<Particle>( batchesVertices, [size]( std::vector<Vertex>& _vertices,
+			                                                          const EcsEntity /*_entity*/,
+			                                                          const Particle& _particle )
 			{
-				Particle& particle = *particleIt;
-
-				glm::vec3 color = particle.mColor.ToGLM3();
+				glm::vec3 color = _particle.mColor.ToGLM3();
 				// pos, normal, color, uv;
-                vertices.push_back( { particle.mPosition + glm::vec3( -size, 0.0f, -size ),
-                                      glm::vec3( 0.f, 1.f, 0.f ),
-                                      color,
-                                      glm::vec2( -0.5f, -0.5f ) } );
-                vertices.push_back( { particle.mPosition + glm::vec3( 0, 0.0f, size ),
-                                      glm::vec3( 0.f, 1.f, 0.f ),
-                                      color,
-                                      glm::vec2( -0.5f, -0.5f ) } );
-                vertices.push_back( { particle.mPosition + glm::vec3( size, 0.0f, -size ),
-                                      glm::vec3( 0.f, 1.f, 0.f ),
-                                      color,
-                                      glm::vec2( -0.5f, -0.5f ) } );
+                _vertices.push_back( { _particle.mPosition + glm::vec3( -size, 0.0f, -size ),
+                                       glm::vec3( 0.f, 1.f, 0.f ),
+                                       color,
+                                       glm::vec2( -0.5f, -0.5f ) } );
+                _vertices.push_back( { _particle.mPosition + glm::vec3( 0, 0.0f, size ),
+                                       glm::vec3( 0.f, 1.f, 0.f ),
+                                       color,
+                                       glm::vec2( -0.5f, -0.5f ) } );
+                _vertices.push_back( { _particle.mPosition + glm::vec3( size, 0.0f, -size ),
+                                       glm::vec3( 0.f, 1.f, 0.f ),
+                                       color,
+                                       glm::vec2( -0.5f, -0.5f ) } );
+			} );
+
+			std::vector<Vertex> vertices;
+			vertices.reserve( _view.Size() * 3 );
+			for( const std::vector<Vertex>& batchVertices : batchesVertices )
+			{
+				vertices.insert( vertices.end(), batchVertices.begin(), batchVertices.end() );
 			}
 			renderWorld.mParticlesMesh->LoadFromVertices( vertices );
 		}
@@ -67,7 +67,7 @@ namespace fan
                     // raycast on mesh renderer
                     if( _world.HasComponent<MeshRenderer>( entity ) )
                     {
-                        const MeshRenderer& meshRenderer = _world.GetComponent<MeshRenderer>( entity );
+                        const MeshRenderer& meshRenderer = _world.GetComponent<const MeshRenderer>( entity );
                         const Ray transformedRay( transform.InverseTransformPoint( _ray.origin ),
                                                   transform.InverseTransformDirection( _ray.direction ) );
                         if( meshRenderer.mMesh != nullptr &&
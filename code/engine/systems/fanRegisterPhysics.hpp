@@ -34,18 +34,18 @@ namespace fan
 				btCollisionShape* shape = nullptr;
 				if( _world.HasComponent<SphereShape>( entity ) )
 				{
-					shape = _world.GetComponent<SphereShape>( entity ).mSphereShape;
+					shape = _world.GetComponent<const SphereShape>( entity ).mSphereShape;
 				}
 				else if( _world.HasComponent<BoxShape>( entity ) )
 				{
-					shape = _world.GetComponent<BoxShape>( entity ).mBoxShape;
+					shape = _world.GetComponent<const BoxShape>( entity ).mBoxShape;
 				}
 
 				// find a motion state
 				btDefaultMotionState* motionState = nullptr;
 				if( _world.HasComponent<MotionState>( entity ) )
 				{
-					motionState = _world.GetComponent<MotionState>( entity ).mMotionState;
+					motionState = _world.GetComponent<const MotionState>( entity ).mMotionState;
 				}
 
 				// reset the rigidbody				
@@ -56,6 +56,7 @@ namespace fan
 
 	//========================================================================================================
 	// Uses the convex hull in the mesh renderer mesh to generate new bounds
+	// chunks where the scene node, mesh renderer & transform were not written since the last run are skipped
 	//========================================================================================================
 	struct SUpdateBoundsFromModel : EcsSystem
 	{
@@ -70,39 +71,29 @@ namespace fan
 
 		static void Run( EcsWorld& /*_world*/, const EcsView& _view )
 		{
-			auto meshRendererIt = _view.begin<MeshRenderer>();
-			auto transformIt = _view.begin<Transform>();
-			auto boundsIt = _view.begin<Bounds>();
-			auto sceneNodeIt = _view.begin<SceneNode>();
-            for( ; meshRendererIt != _view.end<MeshRenderer>();
-                   ++meshRendererIt, ++transformIt, ++boundsIt, ++sceneNodeIt )
-			{
-				SceneNode& sceneNode = *sceneNodeIt;
-				if( !sceneNode.HasFlag( SceneNode::BoundsOutdated ) )
-				{
-					continue;
-				}
-				const MeshRenderer& renderer = *meshRendererIt;
-				const Transform& transform = *transformIt;
-				Bounds& bounds = *boundsIt;
-
-				if( *renderer.mMesh != nullptr )
-				{
-					// Calculates model matrix
-					const glm::vec3 position = ToGLM( transform.GetPosition() );
-					const glm::vec3 scale = ToGLM( transform.mScale );
-					const glm::quat rotation = ToGLM( transform.GetRotationQuat() );
-					glm::mat4 modelMatrix =
-					        glm::translate( glm::mat4( 1.f ), position ) *
-					        glm::mat4_cast( rotation ) *
-					        glm::scale( glm::mat4( 1.f ), scale );
-
-					// Set the bounds
-					bounds.mAabb = AABB( renderer.mMesh->mConvexHull.mVertices, modelMatrix );
-
-					sceneNode.RemoveFlag( SceneNode::BoundsOutdated );
-				}
-			}
+            const EcsView changedView = _view.Changed<SceneNode, MeshRenderer, Transform>();
+            changedView.ParallelForEach<SceneNode, const MeshRenderer, const Transform, Bounds>(
+                    []( SceneNode& _sceneNode, const MeshRenderer& _renderer, const Transform& _transform, Bounds& _bounds )
+            {
+                if( !_sceneNode.HasFlag( SceneNode::BoundsOutdated ) || *_renderer.mMesh == nullptr )
+                {
+                    return;
+                }
+
+                // Calculates model matrix
+                const glm::vec3 position = ToGLM( _transform.GetPosition() );
+                const glm::vec3 scale = ToGLM( _transform.mScale );
+                const glm::quat rotation = ToGLM( _transform.GetRotationQuat() );
+                glm::mat4 modelMatrix =
+                        glm::translate( glm::mat4( 1.f ), position ) *
+                        glm::mat4_cast( rotation ) *
+                        glm::scale( glm::mat4( 1.f ), scale );
+
+                // Set the bounds
+                _bounds.mAabb = AABB( _renderer.mMesh->mConvexHull.mVertices, modelMatrix );
+
+                _sceneNode.RemoveFlag( SceneNode::BoundsOutdated );
+            } );
 		}
 	};
 
@@ -18,17 +18,22 @@ namespace fan
 			if( _delta == 0.f ) { return; }
 			SCOPED_PROFILE( UpdateParticles );
 
-			for( auto particleIt = _view.begin<Particle>(); particleIt != _view.end<Particle>(); ++particleIt )
+			std::vector<std::vector<EcsEntity>> deadParticles;
+			_view.ParallelForEach<Particle>( deadParticles, [_delta]( std::vector<EcsEntity>& _dead,
+			                                                          const EcsEntity _entity,
+			                                                          Particle& _particle )
 			{
-				const EcsEntity entity = particleIt.GetEntity();
-				Particle& particle = *particleIt;
-
-				particle.mDurationLeft -= _delta;
-				if( particle.mDurationLeft < 0.f )
+				_particle.mDurationLeft -= _delta;
+				if( _particle.mDurationLeft < 0.f )
 				{
-					_world.Kill( entity );
+					_dead.push_back( _entity );
 				}
-				particle.mPosition += _delta * particle.mSpeed;
+				_particle.mPosition += _delta * _particle.mSpeed;
+			} );
+
+			for( const std::vector<EcsEntity>& dead : deadParticles )
+			{
+				for( const EcsEntity entity : dead ) { _world.Kill( entity ); }
 			}
 		}
 	};
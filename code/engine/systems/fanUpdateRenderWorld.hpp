@@ -31,16 +31,16 @@ namespace fan
 			RenderWorld& renderWorld = _world.GetSingleton<RenderWorld>();
 			renderWorld.drawData.clear();
 
-			auto meshRendererIt = _view.begin<MeshRenderer>();
-			auto transformIt = _view.begin<Transform>();
-			auto materialIt = _view.begin<Material>();
+			auto meshRendererIt = _view.begin<const MeshRenderer>();
+			auto transformIt = _view.begin<const Transform>();
+			auto materialIt = _view.begin<const Material>();
 			// get all mesh and adds them to the render world
-            for( ; meshRendererIt != _view.end<MeshRenderer>();
+            for( ; meshRendererIt != _view.end<const MeshRenderer>();
                    ++meshRendererIt, ++transformIt, ++materialIt )
 			{
-				MeshRenderer& meshRenderer = *meshRendererIt;
-				Transform& transform = *transformIt;
-				Material& material = *materialIt;
+				const MeshRenderer& meshRenderer = *meshRendererIt;
+				const Transform& transform = *transformIt;
+				const Material& material = *materialIt;
 
 				if( meshRenderer.mMesh.IsValid() )
 				{
@@ -125,9 +125,9 @@ namespace fan
 			RenderWorld& renderWorld = _world.GetSingleton<RenderWorld>();
 			renderWorld.pointLights.clear();
 
-			auto transformIt = _view.begin<Transform>();
+			auto transformIt = _view.begin<const Transform>();
 			auto lightIt = _view.begin<PointLight>();
-			for( ; transformIt != _view.end<Transform>(); ++transformIt, ++lightIt )
+			for( ; transformIt != _view.end<const Transform>(); ++transformIt, ++lightIt )
 			{
 				const Transform& transform = *transformIt;
 				PointLight& light = *lightIt;
@@ -162,9 +162,9 @@ namespace fan
 			RenderWorld& renderWorld = _world.GetSingleton<RenderWorld>();
 			renderWorld.directionalLights.clear();
 
-			auto transformIt = _view.begin<Transform>();
+			auto transformIt = _view.begin<const Transform>();
 			auto lightIt = _view.begin<DirectionalLight>();
-			for( ; transformIt != _view.end<Transform>(); ++transformIt, ++lightIt )
+			for( ; transformIt != _view.end<const Transform>(); ++transformIt, ++lightIt )
 			{
 				const Transform& transform = *transformIt;
 				DirectionalLight& directionalLight = *lightIt;
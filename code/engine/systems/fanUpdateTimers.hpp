@@ -13,6 +13,13 @@ namespace fan
 			return	_world.GetSignature<ExpirationTime>();
 		}
 
+		static EcsSystemAccess GetAccess( const EcsWorld& _world )
+		{
+			EcsSystemAccess access;
+			access.mViewWrite = _world.GetSignature<ExpirationTime>();
+			return access;
+		}
+
 		static void Run( EcsWorld& _world, const EcsView& _view, const float _delta )
 		{
 			if( _delta == 0.f ) { return; }
@@ -32,7 +32,7 @@ namespace fan
 
                 fanAssert( sceneNode.mParentHandle != 0 );
                 EcsEntity parentEntity = _world.GetEntity( sceneNode.mParentHandle );
-                Transform * parentTransform = _world.SafeGetComponent<Transform>( parentEntity );
+                const Transform * parentTransform = _world.SafeGetComponent<const Transform>( parentEntity );
 				if( parentTransform != nullptr )
                 {
                     followTransform.mLocalTransform = SInitFollowTransforms::GetLocalTransform(
@@ -62,23 +62,18 @@ namespace fan
 
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
-            auto sceneNodeIt = _view.begin<SceneNode>();
-			auto transformIt = _view.begin<Transform>();
-			auto followTransformIt = _view.begin<FollowTransform>();
-			for( ; transformIt != _view.end<Transform>(); ++transformIt, ++followTransformIt, ++sceneNodeIt )
-			{
-				Transform& follow = *transformIt;
-				const FollowTransform& followTransform = *followTransformIt;
-                SceneNode& sceneNode = *sceneNodeIt;
-
-                fanAssert( sceneNode.mParentHandle != 0 );
-                EcsEntity parentEntity = _world.GetEntity( sceneNode.mParentHandle );
-                Transform * parentTransform = _world.SafeGetComponent<Transform>( parentEntity );
-				if( followTransform.mLocked && parentTransform != nullptr )
-				{
-					follow.mTransform = parentTransform->mTransform * followTransform.mLocalTransform;
-				}
-			}
+            _view.ForEach<Transform, FollowTransform, SceneNode>( [&_world]( Transform& _follow,
+                                                                             const FollowTransform& _followTransform,
+                                                                             const SceneNode& _sceneNode )
+            {
+                fanAssert( _sceneNode.mParentHandle != 0 );
+                EcsEntity parentEntity = _world.GetEntity( _sceneNode.mParentHandle );
+                const Transform * parentTransform = _world.SafeGetComponent<const Transform>( parentEntity );
+                if( _followTransform.mLocked && parentTransform != nullptr )
+                {
+                    _follow.mTransform = parentTransform->mTransform * _followTransform.mLocalTransform;
+                }
+            } );
 		}
 	};
 }
\ No newline at end of file
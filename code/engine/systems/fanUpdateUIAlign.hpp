@@ -31,7 +31,7 @@ namespace fan
 
                 fanAssert( sceneNode.mParentHandle != 0 );
                 EcsEntity parentEntity = _world.GetEntity(sceneNode.mParentHandle);
-                UITransform* parentTransform = _world.SafeGetComponent<UITransform>( parentEntity );
+                const UITransform* parentTransform = _world.SafeGetComponent<const UITransform>( parentEntity );
 
                 glm::ivec2 pPos;
                 glm::ivec2 pSize;
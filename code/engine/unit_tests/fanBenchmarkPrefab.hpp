@@ -0,0 +1,95 @@
+#pragma once
+
+#include "core/unit_tests/fanBenchmark.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "engine/fanIGame.hpp"
+#include "engine/fanPrefab.hpp"
+#include "engine/singletons/fanScene.hpp"
+#include "engine/singletons/fanScenePointers.hpp"
+#include "engine/components/fanSceneNode.hpp"
+#include "engine/components/fanTransform.hpp"
+#include "engine/components/fanRigidbody.hpp"
+#include "engine/components/fanMotionState.hpp"
+#include "engine/components/fanSphereShape.hpp"
+#include "engine/components/fanExpirationTime.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // spawns bullets in a scene, like SpawnBullet does in game
+    //========================================================================================================
+    class BenchmarkPrefab : public Benchmark<BenchmarkPrefab>
+    {
+    public:
+        static std::vector<BenchmarkMethod> GetBenchmarks()
+        {
+            return { { &BenchmarkPrefab::BenchmarkInstantiate, "prefab" },
+                     { &BenchmarkPrefab::BenchmarkInstantiateJson, "prefab json" },
+            };
+        }
+
+        static constexpr int sNumBullets = 10000;
+        static constexpr int sApplyTransitionsInterval = 100; // roughly the number of bullets spawned per frame
+
+        EcsWorld mWorld;
+        Prefab   mPrefab;
+
+        void Create() override
+        {
+            IGame::EcsIncludeBase( mWorld );
+            IGame::EcsIncludePhysics( mWorld );
+            IGame::EcsIncludeRender3D( mWorld );
+
+            Scene& scene = mWorld.GetSingleton<Scene>();
+            scene.New();
+
+            // builds a bullet with the engine components of content/prefab/bullet.prefab
+            SceneNode& bulletNode = scene.CreateSceneNode( "bullet", &scene.GetRootNode() );
+            const EcsEntity entity = mWorld.GetEntity( bulletNode.mHandle );
+            mWorld.AddComponent<Transform>( entity ).SetPosition( btVector3( 2.f, 0.f, -1.f ) );
+            mWorld.AddComponent<Rigidbody>( entity );
+            mWorld.AddComponent<MotionState>( entity );
+            mWorld.AddComponent<SphereShape>( entity ).SetRadius( 0.05f );
+            mWorld.AddComponent<ExpirationTime>( entity );
+            mWorld.ApplyTransitions();
+
+            mPrefab.CreateFromSceneNode( bulletNode );
+        }
+
+        void Destroy() override
+        {
+            mWorld.GetSingleton<Scene>().Clear();
+        }
+
+        void BenchmarkInstantiate()
+        {
+            SceneNode& root = mWorld.GetSingleton<Scene>().GetRootNode();
+            int spawnCount = 0;
+            Measure( "spawn " + std::to_string( sNumBullets ) + " bullets", sNumBullets, [&]()
+            {
+                mPrefab.Instantiate( root );
+                if( ++spawnCount % sApplyTransitionsInterval == 0 ){ mWorld.ApplyTransitions(); }
+            } );
+            mWorld.ApplyTransitions();
+        }
+
+        //====================================================================================================
+        // previous instantiation path, rebuilds the nodes from the json & walks the scene tree for handles
+        //====================================================================================================
+        void BenchmarkInstantiateJson()
+        {
+            Scene& scene = mWorld.GetSingleton<Scene>();
+            SceneNode& root = scene.GetRootNode();
+            int spawnCount = 0;
+            Measure( "spawn " + std::to_string( sNumBullets ) + " bullets", sNumBullets, [&]()
+            {
+                const EcsHandle handleOffset = mWorld.GetNextHandle() - 1;
+                Scene::RLoadFromJson( mPrefab.mJson["prefab"], scene, &root, handleOffset );
+                mWorld.SetNextHandle( Scene::RFindMaximumHandle( root ) + 1 );
+                ScenePointers::ResolveComponentPointers( mWorld, handleOffset );
+                if( ++spawnCount % sApplyTransitionsInterval == 0 ){ mWorld.ApplyTransitions(); }
+            } );
+            mWorld.ApplyTransitions();
+        }
+    };
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "engine/singletons/fanPhysicsWorld.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // rigidbodies are far apart, no contact callback is triggered
+    //========================================================================================================
+    class UnitTestPhysicsWorld : public UnitTest<UnitTestPhysicsWorld>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestPhysicsWorld::TestSnapshot,    "Snapshot" },
+                     { &UnitTestPhysicsWorld::TestSnapshotRing, "Snapshot ring" },
+                     { &UnitTestPhysicsWorld::TestResimulation, "Resimulation" },
+            };
+        }
+        void Create() override
+        {
+            mWorld = new EcsWorld();
+            mWorld->AddSingletonType<PhysicsWorld>();
+            mShape = new btSphereShape( 1.f );
+            mSimulated = CreateRigidbody( 1, btVector3( 0, 0, 0 ), 1.f );
+            mReplayed  = CreateRigidbody( 2, btVector3( 100, 0, 0 ), 1.f );
+            mStatic    = CreateRigidbody( 3, btVector3( -100, 0, 0 ), 0.f );
+            mSimulated->setLinearVelocity( btVector3( 1, 0, 0 ) );
+            mReplayed->setLinearVelocity( btVector3( 0, 0, 1 ) );
+        }
+        void Destroy() override
+        {
+            PhysicsWorld& physicsWorld = mWorld->GetSingleton<PhysicsWorld>();
+            for( btRigidBody* rigidbody : { mSimulated, mReplayed, mStatic } )
+            {
+                physicsWorld.mDynamicsWorld->removeRigidBody( rigidbody );
+                delete rigidbody;
+            }
+            delete mShape;
+            delete mWorld;
+        }
+
+        EcsWorld*         mWorld;
+        btCollisionShape* mShape;
+        btRigidBody*      mSimulated;
+        btRigidBody*      mReplayed;
+        btRigidBody*      mStatic;
+
+        btRigidBody* CreateRigidbody( const EcsHandle _handle, const btVector3& _position, const float _mass )
+        {
+            btVector3 inertia( 0, 0, 0 );
+            if( _mass > 0.f ) { mShape->calculateLocalInertia( _mass, inertia ); }
+            btRigidBody* rigidbody = new btRigidBody( _mass, nullptr, mShape, inertia );
+            rigidbody->setUserIndex( _handle );
+            rigidbody->setWorldTransform( btTransform( btQuaternion::getIdentity(), _position ) );
+            rigidbody->setActivationState( DISABLE_DEACTIVATION );
+            mWorld->GetSingleton<PhysicsWorld>().mDynamicsWorld->addRigidBody( rigidbody );
+            return rigidbody;
+        }
+
+        void Step( const FrameIndex _frameIndex )
+        {
+            PhysicsWorld& physicsWorld = mWorld->GetSingleton<PhysicsWorld>();
+            physicsWorld.mDynamicsWorld->stepSimulation( 0.1f, 10, 0.1f );
+            physicsWorld.SaveSnapshot( _frameIndex );
+        }
+
+        void TestSnapshot()
+        {
+            PhysicsWorld& physicsWorld = mWorld->GetSingleton<PhysicsWorld>();
+            TEST_ASSERT( physicsWorld.GetSnapshot( 0 ) == nullptr );
+            Step( 0 );
+
+            const PhysicsWorld::Snapshot* snapshot = physicsWorld.GetSnapshot( 0 );
+            TEST_ASSERT( snapshot != nullptr );
+            TEST_ASSERT( snapshot->mStates.size() == 2 ); // static rigidbodies are not saved
+            TEST_ASSERT( snapshot->Find( 3 ) == nullptr );
+            const PhysicsWorld::RigidbodyState* state = snapshot->Find( 1 );
+            TEST_ASSERT( state != nullptr );
+            TEST_ASSERT( state->mTransform.getOrigin() == mSimulated->getWorldTransform().getOrigin() );
+            TEST_ASSERT( state->mVelocity == btVector3( 1, 0, 0 ) );
+        }
+
+        void TestSnapshotRing()
+        {
+            PhysicsWorld& physicsWorld = mWorld->GetSingleton<PhysicsWorld>();
+            for( FrameIndex i = 0; i < PhysicsWorld::sMaxSnapshots + 3; i++ ) { Step( i ); }
+            TEST_ASSERT( physicsWorld.GetSnapshot( 2 ) == nullptr );
+            TEST_ASSERT( physicsWorld.GetSnapshot( 3 ) != nullptr );
+            TEST_ASSERT( physicsWorld.GetSnapshot( PhysicsWorld::sMaxSnapshots + 2 ) != nullptr );
+        }
+
+        void TestResimulation()
+        {
+            PhysicsWorld& physicsWorld = mWorld->GetSingleton<PhysicsWorld>();
+            for( FrameIndex i = 0; i < 4; i++ ) { Step( i ); }
+            const btVector3 simulatedPosition = mSimulated->getWorldTransform().getOrigin();
+            const btVector3 replayedPosition  = mReplayed->getWorldTransform().getOrigin();
+
+            // rollback the simulated rigidbody to frame 1 & resimulate frames 2 and 3
+            PhysicsWorld::RestoreState( *mSimulated, *physicsWorld.GetSnapshot( 1 )->Find( 1 ) );
+            physicsWorld.ClearCachedContacts( *mSimulated );
+            physicsWorld.BeginResimulation( { 1 } );
+            TEST_ASSERT( physicsWorld.mReplayedRigidbodies.size() == 1 );
+            for( FrameIndex i = 2; i < 4; i++ )
+            {
+                const btVector3 replayedFramePosition = physicsWorld.GetSnapshot( i )->Find( 2 )->mTransform.getOrigin();
+                physicsWorld.ReplaySnapshot( i );
+                TEST_ASSERT( !mReplayed->isActive() );
+                TEST_ASSERT( mReplayed->getWorldTransform().getOrigin() == replayedFramePosition );
+                Step( i );
+                TEST_ASSERT( mReplayed->getWorldTransform().getOrigin() == replayedFramePosition );
+            }
+            physicsWorld.EndResimulation();
+
+            TEST_ASSERT( physicsWorld.mReplayedRigidbodies.empty() );
+            TEST_ASSERT( mReplayed->getActivationState() == DISABLE_DEACTIVATION );
+            TEST_ASSERT( mReplayed->getWorldTransform().getOrigin() == replayedPosition );
+            TEST_ASSERT( mSimulated->getWorldTransform().getOrigin().distance( simulatedPosition ) < 1e-4f );
+        }
+    };
+}
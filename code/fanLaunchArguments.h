@@ -39,6 +39,9 @@ namespace fan
 		static bool CMD_RunGameClient( const std::vector < std::string >& _args, LaunchSettings& _settings );
 		static bool CMD_RunGameServer( const std::vector < std::string >& _args, LaunchSettings& _settings );
 		static bool CMD_MainLoopSleep( const std::vector < std::string >& _args, LaunchSettings& _settings );
+		static bool CMD_TickRate( const std::vector < std::string >& _args, LaunchSettings& _settings );
+		static bool CMD_SnapshotRate( const std::vector < std::string >& _args, LaunchSettings& _settings );
+		static bool CMD_NetStats( const std::vector < std::string >& _args, LaunchSettings& _settings );
 	};
 
 	//========================================================================================================
@@ -95,6 +98,21 @@ namespace fan
                                 "-main_loop_sleep",
                                 "usage: -main_loop_sleep <0-1>"
                         },
+                        {
+                                &LaunchArguments::CMD_TickRate,
+                                "-tick_rate",
+                                "usage: -tick_rate <frames per second>"
+                        },
+                        {
+                                &LaunchArguments::CMD_SnapshotRate,
+                                "-snapshot_rate",
+                                "usage: -snapshot_rate <snapshots per second>"
+                        },
+                        {
+                                &LaunchArguments::CMD_NetStats,
+                                "-net_stats",
+                                "usage: -net_stats <seconds>"
+                        },
                       } ) {}
 
 	//========================================================================================================
@@ -333,4 +351,57 @@ namespace fan
 		std::cout << "cmd : main loop sleep " << ( value == 1 ? "enabled" : "disabled" ) << std::endl;
 		return true;
 	}
+
+	//========================================================================================================
+	// command: -tick_rate <frames per second>"
+	// sets the logic frame rate, clients and server must use the same tick rate
+	//========================================================================================================
+    bool LaunchArguments::CMD_TickRate( const std::vector<std::string>& _args,
+                                        LaunchSettings& _settings )
+	{
+		if( _args.size() != 1 ) { return false; }
+
+		const int value = std::atoi( _args[0].c_str() );
+		if( value <= 0 ) { return false; }
+
+		_settings.mTickRate = value;
+
+		std::cout << "cmd : tick rate " << value << std::endl;
+		return true;
+	}
+
+	//========================================================================================================
+	// command: -snapshot_rate <snapshots per second>"
+	// sets the rate at which the server replicates the entities, the game state is still sent every frame
+	//========================================================================================================
+    bool LaunchArguments::CMD_SnapshotRate( const std::vector<std::string>& _args,
+                                            LaunchSettings& _settings )
+	{
+		if( _args.size() != 1 ) { return false; }
+
+		const int value = std::atoi( _args[0].c_str() );
+		if( value <= 0 ) { return false; }
+
+		_settings.mSnapshotRate = value;
+
+		std::cout << "cmd : snapshot rate " << value << std::endl;
+		return true;
+	}
+
+	//========================================================================================================
+	// command: -net_stats <seconds>"
+	// the headless holder logs the network stats of its games every <seconds>
+	//========================================================================================================
+    bool LaunchArguments::CMD_NetStats( const std::vector<std::string>& _args, LaunchSettings& _settings )
+	{
+		if( _args.size() != 1 ) { return false; }
+
+		const int value = std::atoi( _args[0].c_str() );
+		if( value <= 0 ) { return false; }
+
+		_settings.mNetStatsPeriod = value;
+
+		std::cout << "cmd : net stats every " << value << "s" << std::endl;
+		return true;
+	}
 }
\ No newline at end of file
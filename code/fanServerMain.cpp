@@ -0,0 +1,29 @@
+#include "fanLaunchArguments.h"
+#include "game/fanGameServer.hpp"
+#include "engine/fanHeadlessHolder.hpp"
+
+//============================================================================================================
+// Dedicated server, runs a game server without window or renderer
+//============================================================================================================
+int main( int _argc, char* _argv[] )
+{
+	std::vector< std::string > args; // command line arguments
+	for( int i = 0; i < _argc; i++ ){	args.push_back( _argv[i] );	}
+
+	// Parse the arguments & run the server
+	fan::LaunchArguments launchArguments;
+	fan::LaunchSettings settings = launchArguments.Parse( args );
+	if( settings.loadScene.empty() )
+	{
+		settings.loadScene = "content/scenes/game00.scene";
+	}
+	settings.launchMode   = fan::LaunchSettings::Mode::Server;
+	settings.launchEditor = false;
+	settings.enableLivepp = false;
+
+	fan::GameServer server;
+	fan::HeadlessHolder holder( settings, { &server } );
+	holder.Run();
+
+	return 0;
+}
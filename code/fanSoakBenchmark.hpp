@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include "fanLaunchArguments.h"
+#include "core/fanDebug.hpp"
+#include "network/fanLoopbackTransport.hpp"
+#include "network/fanUDPSocket.hpp"
+#include "network/singletons/fanTime.hpp"
+#include "network/singletons/fanServerConnection.hpp"
+#include "network/singletons/fanNetStats.hpp"
+#include "network/components/fanClientConnection.hpp"
+#include "network/components/fanClientGameData.hpp"
+#include "network/components/fanClientRPC.hpp"
+#include "engine/singletons/fanApplication.hpp"
+#include "engine/fanHeadlessHolder.hpp"
+#include "game/fanGameClient.hpp"
+#include "game/fanGameServer.hpp"
+#include "game/components/fanPlayerInput.hpp"
+#include "game/components/fanPlayerController.hpp"
+#include "game/singletons/fanClientNetworkManager.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// command line of the soak benchmark, times are in seconds, rates in [0-1]
+	// -bots <count> -duration <s> -warmup <s> -latency <ms> -jitter <ms> -loss <%> -duplicate <%> -reorder <%>
+	//========================================================================================================
+	struct SoakSettings
+	{
+		int                         mNumBots  = 8;
+		float                       mDuration = 30.f;
+		float                       mWarmup   = 5.f;	// the beginning of the run is not measured ( login, spawn )
+		LoopbackNetwork::Conditions mConditions;
+
+		// reads & removes the soak arguments, the other ones are left for the LaunchArguments
+		void Parse( std::vector<std::string>& _args )
+		{
+			std::vector<std::string> remaining;
+			for( int i = 0; i < (int)_args.size(); i++ )
+			{
+				const std::string& arg = _args[i];
+				const bool hasValue = i + 1 < (int)_args.size();
+				const float value   = hasValue ? float( std::atof( _args[i + 1].c_str() ) ) : 0.f;
+				if( hasValue && arg == "-bots" )				{ mNumBots = int( value ); }
+				else if( hasValue && arg == "-duration" )	{ mDuration = value; }
+				else if( hasValue && arg == "-warmup" )		{ mWarmup = value; }
+				else if( hasValue && arg == "-latency" )		{ mConditions.mLatency = value / 1000.f; }
+				else if( hasValue && arg == "-jitter" )		{ mConditions.mJitter = value / 1000.f; }
+				else if( hasValue && arg == "-loss" )		{ mConditions.mLossRate = value / 100.f; }
+				else if( hasValue && arg == "-duplicate" )	{ mConditions.mDuplicateRate = value / 100.f; }
+				else if( hasValue && arg == "-reorder" )		{ mConditions.mReorderRate = value / 100.f; }
+				else
+				{
+					remaining.push_back( arg );
+					continue;
+				}
+				i++;
+			}
+			_args = remaining;
+		}
+	};
+
+	//========================================================================================================
+	// mean, standard deviation & extremes of a series of samples
+	//========================================================================================================
+	struct SoakStats
+	{
+		std::vector<double> mSamples;
+
+		void Add( const double _value ) { mSamples.push_back( _value ); }
+		double Mean() const
+		{
+			double sum = 0.;
+			for( double sample : mSamples ) { sum += sample; }
+			return mSamples.empty() ? 0. : sum / mSamples.size();
+		}
+		double StdDev() const
+		{
+			const double mean = Mean();
+			double sum = 0.;
+			for( double sample : mSamples ) { sum += ( sample - mean ) * ( sample - mean ); }
+			return mSamples.empty() ? 0. : std::sqrt( sum / mSamples.size() );
+		}
+		double Min() const { return mSamples.empty() ? 0. : *std::min_element( mSamples.begin(), mSamples.end() ); }
+		double Max() const { return mSamples.empty() ? 0. : *std::max_element( mSamples.begin(), mSamples.end() ); }
+		double Percentile( const double _percentile ) const
+		{
+			if( mSamples.empty() ) { return 0.; }
+			std::vector<double> sorted = mSamples;
+			const size_t index = std::min( sorted.size() - 1, size_t( _percentile * sorted.size() ) );
+			std::nth_element( sorted.begin(), sorted.begin() + index, sorted.end() );
+			return sorted[index];
+		}
+	};
+
+	//========================================================================================================
+	// measures the duration of the server steps & quits the application at the end of the run
+	//========================================================================================================
+	class SoakServer : public GameServer
+	{
+	public:
+		SoakServer( const SoakSettings& _settings ) : mSettings( _settings ) {}
+
+		void Step( const float _delta ) override
+		{
+			const double stepStart = Time::ElapsedSinceStartup();
+			GameServer::Step( _delta );
+			const double stepEnd = Time::ElapsedSinceStartup();
+
+			if( mStartTime < 0. ) { mStartTime = stepStart; }
+			if( !IsMeasuring() )
+			{
+				if( stepStart - mStartTime < mSettings.mWarmup ) { return; }
+				mMeasureStartTime = stepStart;
+				mOnBeginMeasure.Emmit();
+			}
+			mStepDurations.Add( stepEnd - stepStart );
+			if( stepEnd - mMeasureStartTime > mSettings.mDuration )
+			{
+				mWorld.GetSingleton<Application>().mOnQuit.Emmit();
+			}
+		}
+
+		bool IsMeasuring() const { return mMeasureStartTime >= 0.; }
+
+		const SoakSettings& mSettings;
+		Signal<>            mOnBeginMeasure;
+		SoakStats           mStepDurations;			// (seconds)
+		double              mStartTime        = -1.;
+		double              mMeasureStartTime = -1.;
+	};
+
+	//========================================================================================================
+	// a client without player, its spaceship is driven by a synthetic input
+	// counts its rollbacks & frame shifts and samples its frame delta with the server
+	//========================================================================================================
+	class BotClient : public GameClient
+	{
+	public:
+		BotClient( SoakServer& _server, const int _index ) : mServer( _server ), mIndex( _index ) {}
+
+		void Init() override
+		{
+			GameClient::Init();
+			mName = "client_" + std::to_string( mIndex );
+		}
+
+		void Start() override
+		{
+			GameClient::Start();
+			const EcsEntity persistentID = mWorld.GetEntity( GetNetManager().mPersistentHandle );
+			mWorld.GetComponent<ClientRPC>( persistentID ).mOnShiftFrameIndex.Connect( &BotClient::OnShiftFrameIndex,
+																					   this );
+		}
+
+		// the input of a rollback frame is restored after it is written, it is late by one frame in this case
+		void Step( const float _delta ) override
+		{
+			Time& time = mWorld.GetSingleton<Time>();
+			const EcsEntity persistentID = mWorld.GetEntity( GetNetManager().mPersistentHandle );
+			ClientGameData& gameData = mWorld.GetComponent<ClientGameData>( persistentID );
+			if( gameData.sSpaceshipHandle != 0 )
+			{
+				const EcsEntity spaceshipID = mWorld.GetEntity( gameData.sSpaceshipHandle );
+				if( mWorld.HasComponent<PlayerController>( spaceshipID ) )
+				{
+					mWorld.RemoveComponent<PlayerController>( spaceshipID );
+				}
+				WriteInput( mWorld.GetComponent<PlayerInput>( spaceshipID ), time.mFrameIndex + 1 );
+			}
+
+			GameClient::Step( _delta );
+
+			if( mServer.IsMeasuring() && gameData.mFrameSynced )
+			{
+				const FrameIndex serverFrameIndex = mServer.mWorld.GetSingleton<Time>().mFrameIndex;
+				mFrameDeltas.Add( double( time.mFrameIndex ) - double( serverFrameIndex ) );
+			}
+		}
+
+		// the desync is received & resolved during the same step
+		void RollbackResimulate( const float _delta ) override
+		{
+			const EcsEntity persistentID = mWorld.GetEntity( GetNetManager().mPersistentHandle );
+			const ClientGameData& gameData = mWorld.GetComponent<ClientGameData>( persistentID );
+			if( mServer.IsMeasuring() && _delta != 0.f && !gameData.mSpaceshipSynced ) { mNumRollbacks++; }
+			GameClient::RollbackResimulate( _delta );
+		}
+
+		// turns slowly, strafes & fires in bursts, every bot has its own phase
+		void WriteInput( PlayerInput& _input, const FrameIndex _frameIndex ) const
+		{
+			const float angle = 0.7f * mIndex + 0.02f * _frameIndex;
+			_input.mOrientation = btVector3( std::cos( angle ), 0.f, std::sin( angle ) );
+			_input.mForward     = ( _frameIndex / 120 + mIndex ) % 4 == 0 ? 0.f : 1.f;
+			_input.mLeft        = ( _frameIndex / 90 + mIndex ) % 3 == 0 ? 1.f : 0.f;
+			_input.mBoost       = ( _frameIndex / 200 + mIndex ) % 5 == 0 ? 1.f : 0.f;
+			_input.mFire        = ( _frameIndex / 30 + mIndex ) % 2 == 0 ? 1.f : 0.f;
+		}
+
+		void OnShiftFrameIndex( const int /*_framesDelta*/ )
+		{
+			if( mServer.IsMeasuring() ) { mNumFrameShifts++; }
+		}
+
+		ClientNetworkManager& GetNetManager() { return mWorld.GetSingleton<ClientNetworkManager>(); }
+		Port GetPort()
+		{
+			const EcsEntity persistentID = mWorld.GetEntity( GetNetManager().mPersistentHandle );
+			return mWorld.GetComponent<ClientConnection>( persistentID ).mClientPort;
+		}
+
+		SoakServer& mServer;
+		const int   mIndex;
+		int         mNumRollbacks   = 0;
+		int         mNumFrameShifts = 0;
+		SoakStats   mFrameDeltas;
+	};
+
+	//========================================================================================================
+	// Runs a server & N bot clients in the same process on a simulated network
+	// reports the server step duration, the bandwidth per host and the synchronization of the clients
+	//========================================================================================================
+	class SoakBenchmark
+	{
+	public:
+		SoakBenchmark( LaunchSettings& _settings, const SoakSettings& _soakSettings ) :
+				mSoakSettings( _soakSettings ),
+				mServer( mSoakSettings )
+		{
+			mNetwork.mConditions = _soakSettings.mConditions;
+
+			// sockets created from now on use the simulated network
+			UdpSocket::sOnCreate.Connect( &LoopbackNetwork::OnCreateSocket, &mNetwork );
+			std::vector<IGame*> games = { &mServer };
+			for( int i = 0; i < _soakSettings.mNumBots; i++ )
+			{
+				mBots.push_back( std::make_unique<BotClient>( mServer, i ) );
+				games.push_back( mBots.back().get() );
+			}
+			mServer.mOnBeginMeasure.Connect( &SoakBenchmark::OnBeginMeasure, this );
+			mHolder = std::make_unique<HeadlessHolder>( _settings, games );
+		}
+
+		~SoakBenchmark()
+		{
+			mHolder.reset();
+			mBots.clear();
+			UdpSocket::sOnCreate.Disconnect( size_t( &mNetwork ) );
+		}
+
+		void Run()
+		{
+			Debug::Log() << "soak: " << mSoakSettings.mNumBots << " bots for " << mSoakSettings.mDuration
+						 << "s, latency " << 1000.f * mSoakSettings.mConditions.mLatency << "ms, jitter "
+						 << 1000.f * mSoakSettings.mConditions.mJitter << "ms, loss "
+						 << 100.f * mSoakSettings.mConditions.mLossRate << "%" << Debug::Endl();
+			mHolder->Run();
+			Report();
+		}
+
+	private:
+		struct Traffic
+		{
+			uint64_t mServerSent     = 0;
+			uint64_t mServerReceived = 0;
+			uint64_t mBotsSent       = 0;
+			uint64_t mBotsReceived   = 0;
+		};
+
+		Traffic GetTraffic()
+		{
+			Traffic traffic;
+			const ServerConnection& connection = mServer.mWorld.GetSingleton<ServerConnection>();
+			if( const LoopbackTransport* server = mNetwork.Find( connection.mServerPort ) )
+			{
+				traffic.mServerSent     = server->mNumBytesSent;
+				traffic.mServerReceived = server->mNumBytesReceived;
+			}
+			for( const std::unique_ptr<BotClient>& bot : mBots )
+			{
+				if( const LoopbackTransport* transport = mNetwork.Find( bot->GetPort() ) )
+				{
+					traffic.mBotsSent += transport->mNumBytesSent;
+					traffic.mBotsReceived += transport->mNumBytesReceived;
+				}
+			}
+			return traffic;
+		}
+
+		void OnBeginMeasure()
+		{
+			mMeasureStartTraffic = GetTraffic();
+			mServer.mWorld.GetSingleton<NetStats>().Reset();
+		}
+
+		void Report()
+		{
+			const double duration = Time::ElapsedSinceStartup() - mServer.mMeasureStartTime;
+			if( !mServer.IsMeasuring() || duration <= 0. || mBots.empty() )
+			{
+				Debug::Warning() << "soak: nothing measured" << Debug::Endl();
+				return;
+			}
+
+			const Traffic traffic    = GetTraffic();
+			const double  numBots    = double( mBots.size() );
+			const double  toKoPerSec = 1. / ( 1000. * duration * numBots );
+			SoakStats frameDeltas;
+			int numRollbacks = 0;
+			int numFrameShifts = 0;
+			for( const std::unique_ptr<BotClient>& bot : mBots )
+			{
+				numRollbacks += bot->mNumRollbacks;
+				numFrameShifts += bot->mNumFrameShifts;
+				for( double sample : bot->mFrameDeltas.mSamples ) { frameDeltas.Add( sample ); }
+			}
+
+			const SoakStats& steps = mServer.mStepDurations;
+			Debug::Log() << "soak: measured " << duration << "s, " << steps.mSamples.size() << " server steps"
+						 << Debug::Endl();
+			Debug::Log() << "server step (ms): avg " << 1000. * steps.Mean() << " p99 " << 1000. * steps.Percentile( 0.99 )
+						 << " max " << 1000. * steps.Max() << Debug::Endl();
+			Debug::Log() << "per host (Ko/s): server up " << ( traffic.mServerSent - mMeasureStartTraffic.mServerSent ) * toKoPerSec
+						 << " down " << ( traffic.mServerReceived - mMeasureStartTraffic.mServerReceived ) * toKoPerSec
+						 << ", client up " << ( traffic.mBotsSent - mMeasureStartTraffic.mBotsSent ) * toKoPerSec
+						 << " down " << ( traffic.mBotsReceived - mMeasureStartTraffic.mBotsReceived ) * toKoPerSec
+						 << Debug::Endl();
+			Debug::Log() << "rollbacks " << numRollbacks << " (" << numRollbacks / ( numBots * duration ) << "/s per client)"
+						 << ", frame shifts " << numFrameShifts << Debug::Endl();
+			Debug::Log() << "client frame delta: mean " << frameDeltas.Mean() << " stddev " << frameDeltas.StdDev()
+						 << " min " << frameDeltas.Min() << " max " << frameDeltas.Max() << Debug::Endl();
+			Debug::Log() << "network: dropped " << mNetwork.mNumDropped << ", duplicated " << mNetwork.mNumDuplicated
+						 << ", reordered " << mNetwork.mNumReordered << Debug::Endl();
+
+			std::stringstream netStats;
+			mServer.mWorld.GetSingleton<NetStats>().Dump( mServer.mWorld, netStats );
+			Debug::Log() << "server " << netStats.str() << Debug::Endl();
+		}
+
+		const SoakSettings                      mSoakSettings;
+		LoopbackNetwork                         mNetwork;	// must outlive the sockets of the games
+		SoakServer                              mServer;
+		std::vector<std::unique_ptr<BotClient>> mBots;
+		std::unique_ptr<HeadlessHolder>         mHolder;
+		Traffic                                 mMeasureStartTraffic;
+	};
+}
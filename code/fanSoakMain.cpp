@@ -0,0 +1,27 @@
+#include "fanSoakBenchmark.hpp"
+
+//============================================================================================================
+// Soak benchmark, runs a server & bot clients on a simulated network & reports the network statistics
+//============================================================================================================
+int main( int _argc, char* _argv[] )
+{
+	std::vector< std::string > args; // command line arguments
+	for( int i = 0; i < _argc; i++ ){	args.push_back( _argv[i] );	}
+
+	// Parse the soak arguments first, the launch arguments parse the remaining ones
+	fan::SoakSettings soakSettings;
+	soakSettings.Parse( args );
+	fan::LaunchArguments launchArguments;
+	fan::LaunchSettings settings = launchArguments.Parse( args );
+	if( settings.loadScene.empty() )
+	{
+		settings.loadScene = "content/scenes/game00.scene";
+	}
+	settings.launchEditor = false;
+	settings.enableLivepp = false;
+
+	fan::SoakBenchmark benchmark( settings, soakSettings );
+	benchmark.Run();
+
+	return 0;
+}
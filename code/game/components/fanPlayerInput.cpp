@@ -2,7 +2,6 @@
 
 #include "core/input/fanJoystick.hpp"
 #include "editor/fanModals.hpp"	
-#include "network/fanPacket.hpp"
 
 namespace fan
 {
@@ -14,6 +13,7 @@ namespace fan
 		_info.load         = &PlayerInput::Load;
 		_info.rollbackLoad = &PlayerInput::RollbackLoad;
 		_info.rollbackSave = &PlayerInput::RollbackSave;
+		_info.mRollbackSize = sizeof( RollbackState );
 		_info.mFlags |= EcsComponentInfo::RollbackNoOverwrite;
 	}
 
@@ -31,28 +31,32 @@ namespace fan
 
 	//========================================================================================================
 	//========================================================================================================
-	void PlayerInput::RollbackSave( const EcsComponent& _component, sf::Packet& _packet )
+	void PlayerInput::RollbackSave( const EcsComponent& _component, void* _state )
 	{
 		const PlayerInput& playerInput = static_cast<const PlayerInput&>( _component );
 
-		_packet << playerInput.mOrientation[0] << playerInput.mOrientation[2];
-		_packet << playerInput.mLeft;
-		_packet << playerInput.mForward;
-		_packet << playerInput.mBoost;
-		_packet << playerInput.mFire;
+		RollbackState& state = *static_cast<RollbackState*>( _state );
+		state.mOrientation[0] = playerInput.mOrientation[0];
+		state.mOrientation[1] = playerInput.mOrientation[2];
+		state.mLeft           = playerInput.mLeft;
+		state.mForward        = playerInput.mForward;
+		state.mBoost          = playerInput.mBoost;
+		state.mFire           = playerInput.mFire;
 	}
 
 	//========================================================================================================
 	//========================================================================================================
-	void PlayerInput::RollbackLoad( EcsComponent& _component, sf::Packet& _packet )
+	void PlayerInput::RollbackLoad( EcsComponent& _component, const void* _state )
 	{
 		PlayerInput& playerInput = static_cast<PlayerInput&>( _component );
 
-		_packet >> playerInput.mOrientation[0] >> playerInput.mOrientation[2];
-		_packet >> playerInput.mLeft;
-		_packet >> playerInput.mForward;
-		_packet >> playerInput.mBoost;
-		_packet >> playerInput.mFire;
+		const RollbackState& state = *static_cast<const RollbackState*>( _state );
+		playerInput.mOrientation[0] = state.mOrientation[0];
+		playerInput.mOrientation[2] = state.mOrientation[1];
+		playerInput.mLeft           = state.mLeft;
+		playerInput.mForward        = state.mForward;
+		playerInput.mBoost          = state.mBoost;
+		playerInput.mFire           = state.mFire;
 	}
 
 	//========================================================================================================
@@ -18,8 +18,17 @@ namespace fan
 		static void Init( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component );
 		static void Save( const EcsComponent& _component, Json& _json );
 		static void Load( EcsComponent& _component, const Json& _json );
-		static void RollbackSave( const EcsComponent& _component, sf::Packet& _packet );
-		static void RollbackLoad( EcsComponent& _component, sf::Packet& _packet );
+		static void RollbackSave( const EcsComponent& _component, void* _state );
+		static void RollbackLoad( EcsComponent& _component, const void* _state );
+
+		struct RollbackState
+		{
+			btScalar mOrientation[2];	// x, z
+			float    mLeft;
+			float    mForward;
+			float    mBoost;
+			float    mFire;
+		};
 
 		btVector3 mOrientation; // orientation of the ship
 		float     mLeft;		 // left/right key pressed ( strafing )
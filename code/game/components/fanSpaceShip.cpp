@@ -10,6 +10,7 @@ namespace fan
 	{
 		_info.load        = &SpaceShip::Load;
 		_info.save        = &SpaceShip::Save;
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//================================================================================================================================
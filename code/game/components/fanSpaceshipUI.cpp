@@ -8,6 +8,7 @@ namespace fan
 	{
 		_info.load        = &SpaceshipUI::Load;
 		_info.save        = &SpaceshipUI::Save;
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//========================================================================================================
@@ -90,6 +90,15 @@ namespace fan
         mWorld.GetSingleton<Scene>().mOnLoad.Connect( &GameClient::OnLoadScene, this );
 
         RegisterGameSpawnMethods( mWorld.GetSingleton<SpawnManager>() );
+
+        mMoveScheduler.Add<SMovePlanets>( std::cref( mStepDelta ) );
+        mMoveScheduler.Add<SMoveSpaceships>( std::cref( mStepDelta ) );
+        mMoveScheduler.SetMinParallelEntities( sMinParallelEntities );
+        mEnergyScheduler.Add<SUpdateSolarPanels>( std::cref( mStepDelta ) );
+        mEnergyScheduler.Add<SRechargeBatteries>( std::cref( mStepDelta ) );
+        mEnergyScheduler.Add<SUpdateExpirationTimes>( std::cref( mStepDelta ) );
+        mEnergyScheduler.Add<SEruptionDamage>( std::cref( mStepDelta ) );
+        mEnergyScheduler.SetMinParallelEntities( sMinParallelEntities );
 	}
 
 	//========================================================================================================
@@ -157,14 +166,12 @@ namespace fan
 			// Rollback at the frame we took the snapshot of the player game state
 			time.mFrameIndex = firstFrame;
 
-			// reset world to first frame		
+			// reset the spaceship to first frame
 			PhysicsWorld& physicsWorld = mWorld.GetSingleton<PhysicsWorld>();
-			physicsWorld.Reset();
             mWorld.Run<SRollbackRestoreState>( firstFrame );
 			const EcsEntity spaceshipID = mWorld.GetEntity( gameData.sSpaceshipHandle );
 			Rigidbody& rigidbody = mWorld.GetComponent<Rigidbody>( spaceshipID );
-			physicsWorld.mDynamicsWorld->removeRigidBody( rigidbody.mRigidbody );
-			physicsWorld.mDynamicsWorld->addRigidBody( rigidbody.mRigidbody );
+			physicsWorld.ClearCachedContacts( *rigidbody.mRigidbody );
 			rigidbody.ClearForces();
 			Transform& transform = mWorld.GetComponent<Transform>( spaceshipID );
 			rigidbody.SetVelocity( gameData.mLastServerState.mVelocity );
@@ -177,6 +184,8 @@ namespace fan
 			gameData.mPreviousLocalStates.push( gameData.mLastServerState );
 
 			// resimulate the last frames of input of the player
+			// only the spaceship is simulated, other dynamic rigidbodies are replayed from the physics snapshots
+			physicsWorld.BeginResimulation( { gameData.sSpaceshipHandle } );
 			const float delta = time.mLogicDelta;
 			while( time.mFrameIndex < lastFrame )
 			{
@@ -188,12 +197,15 @@ namespace fan
                 mWorld.Run<SMoveSpaceships>( delta );
 
                 mWorld.Run<SSynchronizeMotionStateFromTransform>();
+				physicsWorld.ReplaySnapshot( time.mFrameIndex );
 				physicsWorld.mDynamicsWorld->stepSimulation( time.mLogicDelta, 10, Time::sPhysicsDelta );
                 mWorld.Run<SSynchronizeTransformFromMotionState>();
+				physicsWorld.SaveSnapshot( time.mFrameIndex );
 
                 mWorld.Run<SClientSaveState>( delta );
                 mWorld.Run<SRollbackStateSave>( delta );
 			}
+			physicsWorld.EndResimulation();
 
 			gameData.mSpaceshipSynced = true;
             fanAssert( time.mFrameIndex == lastFrame );
@@ -226,14 +238,19 @@ namespace fan
 			// update
             mWorld.Run<SRefreshPlayerInput>( _delta );
             mWorld.Run<SClientSaveInput>( _delta );
-            mWorld.Run<SMovePlanets>( _delta );
-            mWorld.Run<SMoveSpaceships>( _delta );
+            mStepDelta = _delta;
+            mMoveScheduler.Run();
 
 			// physics & transforms
 			PhysicsWorld& physicsWorld = mWorld.GetSingleton<PhysicsWorld>();
             mWorld.Run<SSynchronizeMotionStateFromTransform>();
 			physicsWorld.mDynamicsWorld->stepSimulation( _delta, 10, Time::sPhysicsDelta );
             mWorld.Run<SSynchronizeTransformFromMotionState>();
+            mWorld.Run<SInterpolateReplicatedEntities>( _delta );
+			if( _delta > 0.f )
+			{
+				physicsWorld.SaveSnapshot( time.mFrameIndex );
+			}
             mWorld.Run<SMoveFollowTransforms>();
 
             mWorld.Run<SUpdateUIText>();
@@ -244,10 +261,7 @@ namespace fan
 
 			mWorld.Run<SFireWeapons>( _delta );
 			mWorld.Run<SGenerateLightMesh>( _delta );
-			mWorld.Run<SUpdateSolarPanels>( _delta );
-			mWorld.Run<SRechargeBatteries>( _delta );
-			mWorld.Run<SUpdateExpirationTimes>( _delta );
-			mWorld.Run<SEruptionDamage>( _delta );
+			mEnergyScheduler.Run();
 			mWorld.Run<SUpdateGameUiValues>( _delta );
 			mWorld.Run<SUpdateGameUiPosition>( _delta );
 			SolarEruption::Step( mWorld,			 _delta );
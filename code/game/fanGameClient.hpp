@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/fanIGame.hpp"
+#include "core/ecs/fanEcsScheduler.hpp"
 
 namespace fan
 {
@@ -19,9 +20,17 @@ namespace fan
 
 		static void CreateGameAxes();
 
+	protected:
+		virtual void RollbackResimulate( const float _delta );
+
 	private:
-		void RollbackResimulate( const float _delta );
         void UseGameCamera();
         void OnLoadScene( Scene& _scene );
+
+        static constexpr int sMinParallelEntities = 1024;// same threshold as the server
+
+        float        mStepDelta = 0.f;	// bound to the scheduled systems
+        EcsScheduler mMoveScheduler { mWorld };
+        EcsScheduler mEnergyScheduler { mWorld };
 	};
 }
@@ -18,6 +18,7 @@
 #include "network/singletons/fanLinkingContext.hpp"
 #include "network/components/fanHostReplication.hpp"
 #include "network/systems/fanServerUpdates.hpp"
+#include "network/systems/fanHostRelevance.hpp"
 #include "network/systems/fanServerSendReceive.hpp"
 #include "network/systems/fanTimeout.hpp"
 #include "game/fanGameTags.hpp"
@@ -74,6 +75,15 @@ namespace fan
         mWorld.GetSingleton<Scene>().mOnEditorUseGameCamera.Connect( &GameServer::UseGameCamera, this );
 
         RegisterGameSpawnMethods( mWorld.GetSingleton<SpawnManager>() );
+
+        mMoveScheduler.Add<SMovePlanets>( std::cref( mStepDelta ) );
+        mMoveScheduler.Add<SMoveSpaceships>( std::cref( mStepDelta ) );
+        mMoveScheduler.SetMinParallelEntities( sMinParallelEntities );
+        mEnergyScheduler.Add<SUpdateSolarPanels>( std::cref( mStepDelta ) );
+        mEnergyScheduler.Add<SRechargeBatteries>( std::cref( mStepDelta ) );
+        mEnergyScheduler.Add<SUpdateExpirationTimes>( std::cref( mStepDelta ) );
+        mEnergyScheduler.Add<SEruptionDamage>( std::cref( mStepDelta ) );
+        mEnergyScheduler.SetMinParallelEntities( sMinParallelEntities );
 	}
 
 	//========================================================================================================
@@ -142,8 +152,8 @@ namespace fan
 
 			// update	
 			mWorld.Run<SHostUpdateInput>( _delta );
-			mWorld.Run<SMovePlanets>	( _delta );
-			mWorld.Run<SMoveSpaceships> ( _delta );
+			mStepDelta = _delta;
+			mMoveScheduler.Run();
 
 			// physics & transforms
 			PhysicsWorld& physicsWorld = mWorld.GetSingleton<PhysicsWorld>();
@@ -154,10 +164,7 @@ namespace fan
 
 			mWorld.Run<SFireWeapons>( _delta );
 			mWorld.Run<SGenerateLightMesh>( _delta );
-			mWorld.Run<SUpdateSolarPanels>( _delta );
-			mWorld.Run<SRechargeBatteries>( _delta );
-			mWorld.Run<SUpdateExpirationTimes>( _delta );
-			mWorld.Run<SEruptionDamage>( _delta );
+			mEnergyScheduler.Run();
 			SolarEruption::Step( mWorld, _delta );
             mWorld.Run<SPlayerDeath>( _delta );
 
@@ -173,7 +180,11 @@ namespace fan
 			}
 
 			mWorld.Run<SHostSaveState>( _delta );
-			mWorld.Run<SUpdateReplication>();
+			if( time.IsSnapshotFrame() ) // game state, acks & rpc are still sent every frame
+			{
+				mWorld.Run<SUpdateRelevance>();
+				mWorld.Run<SUpdateReplication>();
+			}
 			mWorld.Run<SServerSend>( _delta );
 		}
 	}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/fanIGame.hpp"
+#include "core/ecs/fanEcsScheduler.hpp"
 
 namespace fan
 {
@@ -17,5 +18,12 @@ namespace fan
 
 	private:
         void UseGameCamera();
+
+        // below this many entities a wave costs more to dispatch than to run serially
+        static constexpr int sMinParallelEntities = 1024;
+
+        float        mStepDelta = 0.f;	// bound to the scheduled systems
+        EcsScheduler mMoveScheduler { mWorld };
+        EcsScheduler mEnergyScheduler { mWorld };
 	};					  
 }
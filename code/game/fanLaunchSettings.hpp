@@ -23,6 +23,9 @@ namespace fan
 		bool        mainLoopSleep          = false;	    // enables sleeping instead of busy waiting
 		bool        launchEditor           = true;      // launch in an editor holder
         bool        mForceWindowDimensions = false;     // window position/size were set from the command line
+        int         mTickRate              = 0;         // logic frames per second, 0 keeps the default rate
+        int         mSnapshotRate          = 0;         // entities snapshots per second, 0 keeps the default rate
+        int         mNetStatsPeriod        = 0;         // seconds between two network stats reports, 0 disables them
 		Mode        launchMode             = Mode::EditorClientServer; // launch server/client & game/editor
 		glm::ivec2  window_position        = { -1,-1 };
 		glm::ivec2  window_size            = { -1,-1 };
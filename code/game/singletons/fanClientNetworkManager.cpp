@@ -69,6 +69,14 @@ namespace fan
 				connection.mClientPort++;
 			}
 		}
+
+		// let the system choose a free port ( many clients in the same process )
+		if( socketStatus != sf::Socket::Done )
+		{
+			socketStatus = connection.mSocket->Bind( sf::Socket::AnyPort );
+			connection.mClientPort = connection.mSocket->GetPort();
+			Debug::Log() << "bind on port " << connection.mClientPort << Debug::Endl();
+		}
 	}
 
 	//========================================================================================================
@@ -35,12 +35,12 @@ namespace fan
 		EcsWorld& world =  _bulletBody.GetWorld();
 		const EcsHandle bulletHandle = _bulletBody.GetHandle();
 		const EcsEntity bulletID = world.GetEntity( bulletHandle );
-		const Bullet& bullet = world.GetComponent< Bullet >( bulletID );
+		const Bullet& bullet = world.GetComponent< const Bullet >( bulletID );
 		
 		world.Kill( bulletID );
 		
 		// create explosion
-		const Transform& bulletTransform = world.GetComponent< Transform >( bulletID );
+		const Transform& bulletTransform = world.GetComponent< const Transform >( bulletID );
 		const Scene& scene = world.GetSingleton<Scene>();
 		const SceneNode& explosionNode = *bullet.mExplosionPrefab->Instantiate( scene.GetRootNode() );
 		const EcsEntity explosionID = world.GetEntity( explosionNode.mHandle );
@@ -62,8 +62,8 @@ namespace fan
 		const EcsEntity otherID = world.GetEntity( otherHandle );
 
 		// bump
-		const Transform& spaceshipTransform = world.GetComponent<Transform>( spaceshipID );
-		const Transform& otherTransform = world.GetComponent<Transform>( otherID );
+		const Transform& spaceshipTransform = world.GetComponent<const Transform>( spaceshipID );
+		const Transform& otherTransform = world.GetComponent<const Transform>( otherID );
 		const btVector3 dir = spaceshipTransform.GetPosition() - otherTransform.GetPosition();
 		if( !dir.fuzzyZero() )
 		{
@@ -43,6 +43,7 @@ namespace fan
 		{
 			Debug::Log() << "bind on port " << connection.mServerPort << Debug::Endl();
 		}
+		connection.mNetworkThread.Start( connection.mSocket );
 	}
 
 	//========================================================================================================
@@ -50,6 +51,7 @@ namespace fan
 	void ServerNetworkManager::Stop( EcsWorld& _world )
 	{
 		ServerConnection& connection = _world.GetSingleton<ServerConnection>();
+		connection.mNetworkThread.Stop();
 		Debug::Log() << "unbind from port " << connection.mSocket.GetPort() << Debug::Endl();
 		connection.mSocket.Unbind();
 	}
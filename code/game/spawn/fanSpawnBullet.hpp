@@ -71,11 +71,19 @@ namespace fan
 				CollisionManager& collisionManager = _world.GetSingleton<CollisionManager>();
 				const LinkingContext& linkingContext = _world.GetSingleton<LinkingContext>();
 
+				// the owner can be already destroyed
+				auto ownerIt = linkingContext.mNetIDToEcsHandle.find( _owner );
+				if( ownerIt == linkingContext.mNetIDToEcsHandle.end() )
+				{
+					Debug::Warning() << "spawn bullet failed, unknown owner net ID " << _owner << Debug::Endl();
+					return;
+				}
+
 				// spawn the bullet now
-				const EcsHandle ownerHandle = linkingContext.mNetIDToEcsHandle.at( _owner );
+				const EcsHandle ownerHandle = ownerIt->second;
 				const EcsEntity ownerEntity = _world.GetEntity( ownerHandle );
-				const Weapon& ownerWeapon = _world.GetComponent<Weapon>( ownerEntity );
-				const Rigidbody& ownerRigidbody = _world.GetComponent<Rigidbody>( ownerEntity );
+				const Weapon& ownerWeapon = _world.GetComponent<const Weapon>( ownerEntity );
+				const Rigidbody& ownerRigidbody = _world.GetComponent<const Rigidbody>( ownerEntity );
 
 				// creates the bullet
 				if( *ownerWeapon.mBulletPrefab != nullptr )
@@ -91,8 +99,8 @@ namespace fan
                                                                &collisionManager );
 					bulletRigidbody.SetIgnoreCollisionCheck( ownerRigidbody, true );
 					bulletRigidbody.SetVelocity( _velocity );
-					bulletRigidbody.SetMotionState( _world.GetComponent<MotionState>( bulletID ).mMotionState );
-					bulletRigidbody.SetCollisionShape( _world.GetComponent<SphereShape>( bulletID ).mSphereShape );
+					bulletRigidbody.SetMotionState( _world.GetComponent<const MotionState>( bulletID ).mMotionState );
+					bulletRigidbody.SetCollisionShape( _world.GetComponent<const SphereShape>( bulletID ).mSphereShape );
 					bulletRigidbody.SetTransform( bulletTransform.mTransform );
 					physicsWorld.mDynamicsWorld->addRigidBody( bulletRigidbody.mRigidbody );
 				}
@@ -6,6 +6,7 @@
 #include "network/components/fanClientRollback.hpp"
 #include "network/components/fanHostPersistentHandle.hpp"
 #include "network/components/fanEntityReplication.hpp"
+#include "network/components/fanEntityInterpolation.hpp"
 #include "network/components/fanLinkingContextUnregisterer.hpp"
 #include "engine/components/fanTransform.hpp"
 #include "engine/components/fanRigidbody.hpp"
@@ -26,6 +27,7 @@ namespace fan
 		struct SpawnShip
 		{
 			static const SpawnID sID = SSID( "SpawnShip" );
+			static constexpr float sRelevanceDistance = 60.f; // ships are replicated on hosts closer than this
 
 			//================================================================
 			//================================================================
@@ -73,6 +75,14 @@ namespace fan
 						hostData.mSpaceshipHandle = SpawnShip::SpawnSpaceship( _world, true, false, playerID );
 						linkingContext.AddEntity( hostData.mSpaceshipHandle, spaceshipID );
 
+						// other hosts spawn the ship when it enters their relevance distance
+						if( hostData.mSpaceshipHandle != 0 )
+						{
+							const EcsEntity spaceshipEntity = _world.GetEntity( hostData.mSpaceshipHandle );
+							EntityReplication& entityReplication = _world.GetComponent<EntityReplication>( spaceshipEntity );
+							entityReplication.mRelevanceDistance = sRelevanceDistance;
+							entityReplication.mSpawnInfo = GenerateInfo( playerID, 0, spaceshipID, position );
+						}
 					}
 					else
 					{
@@ -94,9 +104,13 @@ namespace fan
 						}
 						else
 						{
-							// spawn remote player ship
+							// spawn remote player ship, displayed between its replicated snapshots
 							const EcsHandle handle = SpawnShip::SpawnSpaceship( _world, false, false );
 							linkingContext.AddEntity( handle, spaceshipID );
+							if( handle != 0 )
+							{
+								_world.AddComponent<EntityInterpolation>( _world.GetEntity( handle ) );
+							}
 						}
 					}
 				}
@@ -21,16 +21,14 @@ namespace fan
 		{
 			if( _delta == 0.f ) { return; }
 
-			SunLight& sunlight = _world.GetSingleton<SunLight>();
+			const SunLight& sunlight = _world.GetSingleton<SunLight>();
 
-            for( auto particleIt = _view.begin<Particle>();
-                 particleIt != _view.end<Particle>();
-                 ++particleIt )
-            {
-				const EcsEntity entity = particleIt.GetEntity();
-				const Particle& particle = *particleIt;
-
-				const btVector3& position = ToBullet( particle.mPosition );
+			std::vector<std::vector<EcsEntity>> occludedParticles;
+			_view.ParallelForEach<Particle>( occludedParticles, [&sunlight]( std::vector<EcsEntity>& _occluded,
+			                                                                 const EcsEntity _entity,
+			                                                                 const Particle& _particle )
+			{
+				const btVector3& position = ToBullet( _particle.mPosition );
 
 				// raycast on the light mesh
 				const btVector3 rayOrigin = btVector3( position[0], 1.f, position[2] );
@@ -40,8 +38,13 @@ namespace fan
                                                                  outIntersection );
 				if( !isInsideSunlight )
 				{
-					_world.Kill( entity );
+					_occluded.push_back( _entity );
 				}
+			} );
+
+			for( const std::vector<EcsEntity>& occluded : occludedParticles )
+			{
+				for( const EcsEntity entity : occluded ) { _world.Kill( entity ); }
 			}
 		}
 	};
@@ -17,6 +17,15 @@ namespace fan
 				_world.GetSignature<Transform>() |
 				_world.GetSignature<SolarPanel>();
 		}
+
+		static EcsSystemAccess GetAccess( const EcsWorld& _world )
+		{
+			EcsSystemAccess access;
+			access.mViewRead  = _world.GetSignature<Transform>();
+			access.mViewWrite = _world.GetSignature<SolarPanel>();
+			return access;
+		}
+
 		static void Run( EcsWorld& _world, const EcsView& _view, const float _delta )
 		{
 			if( _delta == 0.f ) { return; }
@@ -70,6 +79,14 @@ namespace fan
 				_world.GetSignature<SolarPanel>();
 		}
 
+		static EcsSystemAccess GetAccess( const EcsWorld& _world )
+		{
+			EcsSystemAccess access;
+			access.mViewRead  = _world.GetSignature<SolarPanel>();
+			access.mViewWrite = _world.GetSignature<Battery>();
+			return access;
+		}
+
 		static void Run( EcsWorld& /*_world*/, const EcsView& _view, const float _delta )
 		{
 			if( _delta == 0.f ) { return; }
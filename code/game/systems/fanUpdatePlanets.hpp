@@ -17,6 +17,14 @@ namespace fan
 				_world.GetSignature<Planet>();
 		}
 
+		static EcsSystemAccess GetAccess( const EcsWorld& _world )
+		{
+			EcsSystemAccess access;
+			access.mViewRead  = _world.GetSignature<Planet>();
+			access.mViewWrite = _world.GetSignature<SceneNode>() | _world.GetSignature<Transform>();
+			return access;
+		}
+
 		static void Run( EcsWorld& _world, const EcsView& _view, const float _delta )
 		{
 			if( _delta == 0.f ) { return; }
@@ -29,8 +29,8 @@ namespace fan
 			const Scene& scene = _world.GetSingleton<Scene>();
             const Mouse& mouse = _world.GetSingleton<Mouse>();
 			const EcsEntity cameraID = _world.GetEntity( scene.mMainCameraHandle );
-			const Transform& cameraTransform = _world.GetComponent<Transform>( cameraID );
-			const Camera& camera = _world.GetComponent<Camera>( cameraID );
+			const Transform& cameraTransform = _world.GetComponent<const Transform>( cameraID );
+			const Camera& camera = _world.GetComponent<const Camera>( cameraID );
 
 			auto transformIt = _view.begin<Transform>();
 			auto inputIt = _view.begin<PlayerInput>();
@@ -28,6 +28,18 @@ namespace fan
 				_world.GetSignature<SpaceShip>();
 		}
 
+		static EcsSystemAccess GetAccess( const EcsWorld& _world )
+		{
+			EcsSystemAccess access;
+			access.mViewRead  = _world.GetSignature<SpaceShip>() | _world.GetSignature<PlayerInput>();
+			access.mViewWrite = _world.GetSignature<SceneNode>() |
+			                    _world.GetSignature<Transform>() |
+			                    _world.GetSignature<Rigidbody>() |
+			                    _world.GetSignature<Battery>();
+			access.mWrite     = _world.GetSignature<ParticleEmitter>();// spaceship particles
+			return access;
+		}
+
 		static void Run( EcsWorld& /*_world*/, const EcsView& _view, const float _delta )
 		{
 			if( _delta == 0.f ) { return; }
@@ -167,6 +179,14 @@ namespace fan
 				_world.GetSignature<SpaceShip>();
 		}
 
+		static EcsSystemAccess GetAccess( const EcsWorld& _world )
+		{
+			EcsSystemAccess access;
+			access.mViewRead  = _world.GetSignature<SolarPanel>();
+			access.mViewWrite = _world.GetSignature<Health>();
+			return access;
+		}
+
 		static void Run( EcsWorld& _world, const EcsView& _view, const float _delta )
 		{
 			if( _delta == 0.f ) { return; }
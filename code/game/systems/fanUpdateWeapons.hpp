@@ -71,7 +71,7 @@ namespace fan
 					if( game.mIsServer )
 					{
 						// spawn on all hosts
-						const EcsHandle hostHandle = _world.GetComponent<HostPersistentHandle>( spaceshipEntity ).mHandle;
+						const EcsHandle hostHandle = _world.GetComponent<const HostPersistentHandle>( spaceshipEntity ).mHandle;
                         const SpawnInfo info = spawn::SpawnBullet::GenerateInfo( time.mFrameIndex,
                                                                                  ownerID,
                                                                                  bulletPosition,
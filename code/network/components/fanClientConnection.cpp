@@ -51,7 +51,7 @@ namespace fan
 			PacketHello hello;
 			hello.mName = "toto";
 			hello.Write( _packet );
-			_packet.mOnFail.Connect( &ClientConnection::OnLoginFail, _world, _world.GetHandle( _entity ) );
+			_packet.mOnFail.Connect( &ClientConnection::OnLoginFail, _world.GetHandle( _entity ) );
             mState = ClientState::PendingConnection;
 			Debug::Log() << "logging in..." << Debug::Endl();
 		}
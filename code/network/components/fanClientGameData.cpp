@@ -31,6 +31,12 @@ namespace fan
 	{
         mLastServerState = _packet; // @todo store multiple server states to allow deeper rollback
 
+		// the server simulated this frame, older inputs are useless even if their packet was not acked yet
+		while( !mPreviousInputs.empty() && mPreviousInputs.back().mFrameIndex <= _packet.mFrameIndex )
+		{
+			mPreviousInputs.pop_back();
+		}
+
 		// get the corresponding game state for the client
 		while( !mPreviousLocalStates.empty() && mPreviousLocalStates.front().mFrameIndex < _packet.mFrameIndex )
 		{
@@ -92,16 +98,20 @@ namespace fan
 		{
 			numInputs = mMaxInputSent;
 		}
+		if( numInputs > PacketInput::sMaxInputs )
+		{
+			numInputs = PacketInput::sMaxInputs;
+		}
 
 		if( numInputs > 0 )
 		{
 			// registers packet success
-			_packet.mOnSuccess.Connect( &ClientGameData::OnInputReceived, _world, _world.GetHandle( _entity) );
+			_packet.mOnSuccess.Connect( &ClientGameData::OnInputReceived, _world.GetHandle( _entity) );
 			mInputsSent.push_front( { _packet.mTag, mPreviousInputs.front().mFrameIndex } );
 
 			// generate & send inputs
 			PacketInput packetInput;
-			packetInput.mInputs.resize( numInputs );
+			packetInput.mNumInputs = numInputs;
 			for( int i = 0; i < numInputs; i++ )
 			{
 				packetInput.mInputs[numInputs - i - 1] = * ( mPreviousInputs.begin() + i) ;
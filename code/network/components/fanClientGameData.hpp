@@ -29,7 +29,7 @@ namespace fan
 		EcsHandle                            sSpaceshipHandle;	// handle of the player spaceship
 		std::deque< PacketInput::InputData > mPreviousInputs;   // inputs that need to be sent/acknowledged by the server
 		std::deque< InputSent>               mInputsSent;		// inputs sent to server waiting ack
-		int                                  mMaxInputSent;		// the maximum number of inputs to send in one packet
+		int                                  mMaxInputSent;		// the maximum number of inputs to send in one packet ( PacketInput::sMaxInputs at most )
 		std::queue< PacketPlayerGameState >  mPreviousLocalStates; // local state of the client to compare with server state
 		PacketPlayerGameState                mLastServerState;	    // the last know game state received from server ( useful for rollback )
 		bool                                 mFrameSynced;		    // false if frame index is not synchronized with the server
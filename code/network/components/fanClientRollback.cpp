@@ -1,5 +1,8 @@
 #include "network/components/fanClientRollback.hpp"
 
+#include <cstddef>
+#include "core/fanAssert.hpp"
+
 namespace fan
 {
 	//========================================================================================================
@@ -8,6 +11,7 @@ namespace fan
 	{
 		_info.save        = &ClientRollback::Save;
 		_info.load        = &ClientRollback::Load;
+		_info.mFlags |= EcsComponentInfo::PrefabPerInstance;
 	}
 
 	//========================================================================================================
@@ -15,11 +19,86 @@ namespace fan
 	void ClientRollback::Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
 	{
 		ClientRollback& clientRollback = static_cast<ClientRollback&>( _component );
-		clientRollback.mRollbackDatas.clear();
+		clientRollback.mFrames.resize( sMaxFrames );
+		clientRollback.mOldestFrameIndex = 0;
+		clientRollback.mNumFrames        = 0;
 	}
 
 	//========================================================================================================
 	//========================================================================================================
 	void ClientRollback::Save( const EcsComponent& /*_component*/, Json& /*_json*/ ) {}
 	void ClientRollback::Load( EcsComponent& /*_component*/, const Json& /*_json*/ ) {}
-}
\ No newline at end of file
+
+	//========================================================================================================
+	// the buffers keep their capacity, saving a frame doesn't allocate once the ring is warm
+	//========================================================================================================
+	void ClientRollback::FrameStates::Clear( const FrameIndex _frameIndex )
+	{
+		mFrameIndex = _frameIndex;
+		mStates.clear();
+		mData.clear();
+	}
+
+	//========================================================================================================
+	// returns _size bytes for the rollback state of a component, offsets are aligned for any state type
+	//========================================================================================================
+	void* ClientRollback::FrameStates::Allocate( const int _componentIndex, const uint32_t _size )
+	{
+		const uint32_t alignment = alignof( std::max_align_t );
+		const uint32_t offset    = ( uint32_t( mData.size() ) + alignment - 1 ) & ~( alignment - 1 );
+		mData.resize( offset + _size );
+		mStates.push_back( { _componentIndex, offset } );
+		return &mData[offset];
+	}
+
+	//========================================================================================================
+	// returns nullptr if the frame is not saved
+	//========================================================================================================
+	ClientRollback::FrameStates* ClientRollback::GetFrameStates( const FrameIndex _frameIndex )
+	{
+		if( mNumFrames == 0 || _frameIndex < mOldestFrameIndex || _frameIndex > NewestFrameIndex() )
+		{
+			return nullptr;
+		}
+		FrameStates& frameStates = mFrames[_frameIndex % sMaxFrames];
+		fanAssert( frameStates.mFrameIndex == _frameIndex );
+		return &frameStates;
+	}
+
+	//========================================================================================================
+	// returns the cleared states of a frame, ready to be written
+	// a saved frame is overwritten ( resimulation ), a new frame is pushed after the newest one
+	// and the oldest frame is dropped when the ring is full
+	// the ring restarts from _frameIndex when frames were skipped
+	//========================================================================================================
+	ClientRollback::FrameStates& ClientRollback::BeginFrameStates( const FrameIndex _frameIndex )
+	{
+		fanAssert( mFrames.size() == sMaxFrames );
+		if( mNumFrames == 0 || _frameIndex < mOldestFrameIndex || _frameIndex > NewestFrameIndex() + 1 )
+		{
+			mOldestFrameIndex = _frameIndex;
+			mNumFrames        = 1;
+		}
+		else if( _frameIndex == NewestFrameIndex() + 1 )
+		{
+			if( mNumFrames == sMaxFrames )
+			{
+				RemoveOldestFrameStates();
+			}
+			mNumFrames++;
+		}
+
+		FrameStates& frameStates = mFrames[_frameIndex % sMaxFrames];
+		frameStates.Clear( _frameIndex );
+		return frameStates;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void ClientRollback::RemoveOldestFrameStates()
+	{
+		fanAssert( mNumFrames > 0 );
+		mOldestFrameIndex++;
+		mNumFrames--;
+	}
+}
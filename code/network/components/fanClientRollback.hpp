@@ -2,8 +2,8 @@
 
 #include "core/ecs/fanEcsComponent.hpp"
 
-#include <deque>
-#include "network/fanPacket.hpp"
+#include <vector>
+#include "network/fanNetConfig.hpp"
 
 namespace fan
 {
@@ -11,6 +11,8 @@ namespace fan
 
 	//========================================================================================================
 	// Save states of the entity for rolling back the simulation
+	// states are stored in a ring of frames indexed by frame index,
+	// each frame writes its component states contiguously in a reused buffer
 	//========================================================================================================
 	struct ClientRollback : public EcsComponent
 	{
@@ -21,15 +23,40 @@ namespace fan
 		static void Load( EcsComponent& _component, const Json& _json );
 
 		//================================================================
-		// Holds the rollback data of one component at a secific frame
+		// Offset of the rollback state of one component in the frame data
 		//================================================================
-		struct RollbackData
+		struct RollbackState
 		{
-			FrameIndex mFrameIndex;
-			int        mComponentIndex;
-			sf::Packet mData;
+			int      mComponentIndex;
+			uint32_t mOffset;
 		};
-		std::deque<RollbackData> mRollbackDatas;
-		static const int         sRollbackDatasMaxSize = 100;
+
+		//================================================================
+		// Rollback states of all components at a specific frame
+		//================================================================
+		struct FrameStates
+		{
+			FrameIndex                 mFrameIndex;
+			std::vector<RollbackState> mStates;
+			std::vector<uint8_t>       mData;
+
+			void  Clear( const FrameIndex _frameIndex );
+			void* Allocate( const int _componentIndex, const uint32_t _size );
+			const void* GetData( const RollbackState& _state ) const { return &mData[_state.mOffset]; }
+		};
+
+		static const int sMaxFrames = 64;
+
+		FrameStates* GetFrameStates( const FrameIndex _frameIndex );
+		FrameStates& BeginFrameStates( const FrameIndex _frameIndex );
+		void         RemoveOldestFrameStates();
+		bool         Empty() const { return mNumFrames == 0; }
+		FrameIndex   OldestFrameIndex() const { return mOldestFrameIndex; }
+		FrameIndex   NewestFrameIndex() const { return mOldestFrameIndex + mNumFrames - 1; }
+		int          NumFrames() const { return mNumFrames; }
+
+		std::vector<FrameStates> mFrames; // ring of sMaxFrames frames
+		FrameIndex               mOldestFrameIndex;
+		int                      mNumFrames;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,120 @@
+#include "network/components/fanEntityInterpolation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "core/fanAssert.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	//========================================================================================================
+	void EntityInterpolation::SetInfo( EcsComponentInfo& /*_info*/ )
+	{
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void EntityInterpolation::Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
+	{
+		EntityInterpolation& interpolation = static_cast<EntityInterpolation&>( _component );
+		interpolation.mNumSnapshots   = 0;
+		interpolation.mFrameOffset    = 0.f;
+		interpolation.mSnapshotPeriod = 0.f;
+	}
+
+	//========================================================================================================
+	// inserts the snapshot in frame order, a snapshot older than a full buffer is dropped
+	// only the newest snapshots update the delay, reordered ones are late by definition
+	//========================================================================================================
+	void EntityInterpolation::PushSnapshot( const Snapshot& _snapshot, const FrameIndex _receptionFrame )
+	{
+		int index = mNumSnapshots;
+		while( index > 0 && mSnapshots[index - 1].mFrameIndex > _snapshot.mFrameIndex ) { index--; }
+		if( index > 0 && mSnapshots[index - 1].mFrameIndex == _snapshot.mFrameIndex )
+		{
+			mSnapshots[index - 1] = _snapshot;
+			return;
+		}
+
+		if( mNumSnapshots == sMaxSnapshots )
+		{
+			if( index == 0 ) { return; }
+			std::move( mSnapshots + 1, mSnapshots + index, mSnapshots );
+			index--;
+			mNumSnapshots--;
+		}
+		std::move_backward( mSnapshots + index, mSnapshots + mNumSnapshots, mSnapshots + mNumSnapshots + 1 );
+		mSnapshots[index] = _snapshot;
+		mNumSnapshots++;
+
+		if( index != mNumSnapshots - 1 ) { return; }
+
+		const float frameOffset = float( int( _receptionFrame - _snapshot.mFrameIndex ) );
+		if( mNumSnapshots == 1 || std::abs( frameOffset - mFrameOffset ) > sMaxFrameOffsetError )
+		{
+			mFrameOffset = frameOffset;
+		}
+		else
+		{
+			mFrameOffset += sSmoothing * ( frameOffset - mFrameOffset );
+		}
+
+		// entities that don't change are not replicated, the smallest gap is the snapshot period
+		if( mNumSnapshots >= 2 )
+		{
+			FrameIndex period = mSnapshots[1].mFrameIndex - mSnapshots[0].mFrameIndex;
+			for( int i = 2; i < mNumSnapshots; i++ )
+			{
+				period = std::min( period, mSnapshots[i].mFrameIndex - mSnapshots[i - 1].mFrameIndex );
+			}
+			mSnapshotPeriod = mSnapshotPeriod == 0.f
+				? float( period )
+				: mSnapshotPeriod + sSmoothing * ( float( period ) - mSnapshotPeriod );
+		}
+	}
+
+	//========================================================================================================
+	// returns the state of the entity GetRenderDelay() frames before the current frame
+	// frames are compared relative to the current frame to keep the float precision
+	//========================================================================================================
+	EntityInterpolation::Snapshot EntityInterpolation::Interpolate( const FrameIndex _currentFrame,
+																	const float _logicDelta ) const
+	{
+		fanAssert( !Empty() );
+
+		// the render frame is older than all the snapshots
+		const float renderDelay = GetRenderDelay();
+		if( float( int( _currentFrame - mSnapshots[0].mFrameIndex ) ) <= renderDelay )
+		{
+			return mSnapshots[0];
+		}
+
+		for( int i = 1; i < mNumSnapshots; i++ )
+		{
+			const Snapshot& to = mSnapshots[i];
+			const float toDelay = float( int( _currentFrame - to.mFrameIndex ) );
+			if( toDelay <= renderDelay )
+			{
+				const Snapshot& from = mSnapshots[i - 1];
+				const float fromDelay = float( int( _currentFrame - from.mFrameIndex ) );
+				const float alpha = ( fromDelay - renderDelay ) / ( fromDelay - toDelay );
+
+				Snapshot snapshot;
+				snapshot.mFrameIndex      = from.mFrameIndex;
+				snapshot.mPosition        = from.mPosition.lerp( to.mPosition, alpha );
+				snapshot.mRotation        = from.mRotation.slerp( to.mRotation, alpha );
+				snapshot.mVelocity        = from.mVelocity.lerp( to.mVelocity, alpha );
+				snapshot.mAngularVelocity = from.mAngularVelocity.lerp( to.mAngularVelocity, alpha );
+				return snapshot;
+			}
+		}
+
+		// the next snapshot is late
+		const Snapshot& newest = GetNewest();
+		const float extrapolation = std::min( float( int( _currentFrame - newest.mFrameIndex ) ) - renderDelay,
+											  sMaxExtrapolationFrames );
+		Snapshot snapshot = newest;
+		snapshot.mPosition += newest.mVelocity * ( extrapolation * _logicDelta );
+		return snapshot;
+	}
+}
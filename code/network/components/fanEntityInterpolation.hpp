@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/ecs/fanEcsComponent.hpp"
+#include "bullet/LinearMath/btVector3.h"
+#include "bullet/LinearMath/btQuaternion.h"
+#include "network/fanNetConfig.hpp"
+
+namespace fan
+{
+	class EcsWorld;
+
+	//========================================================================================================
+	// [CLIENT] Buffers the replicated snapshots of a remote entity
+	// the entity is displayed slightly in the past, blended between the two snapshots around the render frame
+	// the delay follows the snapshots frames measured on reception & the rate at which the server sends them
+	//========================================================================================================
+	struct EntityInterpolation : public EcsComponent
+	{
+		ECS_COMPONENT( EntityInterpolation )
+		static void SetInfo( EcsComponentInfo& _info );
+		static void Init( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component );
+
+		//================================================================
+		// State of the entity on the server at a specific frame
+		//================================================================
+		struct Snapshot
+		{
+			FrameIndex   mFrameIndex;
+			btVector3    mPosition;
+			btQuaternion mRotation;
+			btVector3    mVelocity;
+			btVector3    mAngularVelocity;
+		};
+
+		static constexpr int   sMaxSnapshots           = 8;
+		static constexpr float sSmoothing              = 0.1f;	// weight of a new sample in the delay averages
+		static constexpr float sDelayMargin            = 1.f;	// frames, absorbs the jitter of the snapshots
+		static constexpr float sMaxFrameOffsetError    = 10.f;	// beyond this, the frame offset is reset (frame shift)
+		static constexpr float sMaxExtrapolationFrames = 10.f;	// late snapshots are extrapolated, then held
+
+		void            PushSnapshot( const Snapshot& _snapshot, const FrameIndex _receptionFrame );
+		Snapshot        Interpolate( const FrameIndex _currentFrame, const float _logicDelta ) const;
+		float           GetRenderDelay() const { return mFrameOffset + mSnapshotPeriod + sDelayMargin; }
+		const Snapshot& GetNewest() const { return mSnapshots[mNumSnapshots - 1]; }
+		bool            Empty() const { return mNumSnapshots == 0; }
+
+		Snapshot mSnapshots[sMaxSnapshots];	// sorted by frame index, oldest first
+		int      mNumSnapshots;
+		float    mFrameOffset;		// average delay in frames between the client frame & the received snapshots frames
+		float    mSnapshotPeriod;	// smallest number of frames between two buffered snapshots, smoothed
+	};
+}
@@ -16,5 +16,7 @@ namespace fan
 		EntityReplication& replication = static_cast<EntityReplication&>( _component );
 		replication.mExclude = 0;
 		replication.mComponentTypes.clear();
+		replication.mRelevanceDistance = 0.f;
+		replication.mSpawnInfo = SpawnInfo();
 	}
 }
\ No newline at end of file
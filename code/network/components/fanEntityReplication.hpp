@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/ecs/fanEcsComponent.hpp"
+#include "network/singletons/fanSpawnManager.hpp"
 
 namespace fan
 {
@@ -10,6 +11,7 @@ namespace fan
 	// All entities that have an EntityReplication component will be saved
 	// in a packet using NetSave / NetLoad methods.
 	// Then, data will be replicated on other hosts
+	// Entities with a relevance distance are only spawned & replicated on hosts whose ship is close enough
 	//========================================================================================================
 	struct EntityReplication : public EcsComponent
 	{
@@ -19,5 +21,7 @@ namespace fan
 
 		std::vector<uint32_t> mComponentTypes;
 		EcsHandle             mExclude; // host handle to exclude for replication
+		float                 mRelevanceDistance;	// 0 : replicated on all hosts
+		SpawnInfo             mSpawnInfo;			// spawns the entity on hosts it becomes relevant for
 	};
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "network/components/fanHostConnection.hpp"
+
+#include <algorithm>
 #include "network/singletons/fanTime.hpp"
+#include "network/fanUDPSocket.hpp"
 
 namespace fan
 {
@@ -20,12 +23,16 @@ namespace fan
 		hostConnection.mState              = State::Disconnected;
 		hostConnection.mLastResponseTime   = 0.f;
 		hostConnection.mLastPingTime       = 0.f;
+		hostConnection.mLastPingFrame      = 0;
 		hostConnection.mLastDisconnectTime = 0.f;
 		hostConnection.mRtt                = -1.f;
 		hostConnection.mBandwidth          = 0.f;
+		hostConnection.mBandwidthBudget    = 64.f;
+		hostConnection.mAvailableBytes     = 0.f;
 		hostConnection.mPingDelay          = .2f;
 		hostConnection.mDisconnectDelay    = 1.f;
 		hostConnection.mTimeoutDelay       = 5.f;
+		hostConnection.mStatsIndex         = -1;
 
 		hostConnection.mSynced           = false;
 		hostConnection.mLastSync         = 0.f;
@@ -34,6 +41,16 @@ namespace fan
 		hostConnection.mNextDeltaIndex   = 0;
 	}
 
+	//========================================================================================================
+	// the budget is refilled every frame, the burst is large enough to send at least one full datagram
+	//========================================================================================================
+	void HostConnection::UpdateBandwidthBudget( const float _logicDelta )
+	{
+		const float bytesPerFrame = 1000.f * mBandwidthBudget * _logicDelta;
+		const float maxBytes = std::max( sMaxBurstFrames * bytesPerFrame, float( UdpSocket::maxPacketSize ) );
+		mAvailableBytes = std::min( mAvailableBytes + bytesPerFrame, maxBytes );
+	}
+
 	//========================================================================================================
 	// sends a login packet to the clients needing approval
 	// regularly sends ping to clients to calculate RTT & sync frame index
@@ -50,8 +67,8 @@ namespace fan
 			PacketLoginSuccess packetLogin;
 			packetLogin.mPlayerId = handle;
 			packetLogin.Write( _packet );			
-			_packet.mOnSuccess.Connect( &HostConnection::OnLoginSuccess, _world, handle );
-			_packet.mOnFail.Connect( &HostConnection::OnLoginFail, _world, handle );
+			_packet.mOnSuccess.Connect( &HostConnection::OnLoginSuccess, handle );
+			_packet.mOnFail.Connect( &HostConnection::OnLoginFail, handle );
             mState = HostConnection::PendingApprouval;
 		}
 		else if( mState == HostConnection::Connected )
@@ -61,6 +78,7 @@ namespace fan
 			if( currentTime - mLastPingTime > mPingDelay )
 			{
                 mLastPingTime = currentTime;
+                mLastPingFrame = time.mFrameIndex;
 
 				PacketPing packetPing;
 				packetPing.mPreviousRtt = mRtt;
@@ -103,13 +121,16 @@ namespace fan
 	//========================================================================================================
     void HostConnection::ProcessPacket( const PacketPing& _packetPing,
                                         const FrameIndex _frameIndex,
-                                        const float _logicDelta )
+                                        const float _logicDelta,
+                                        const double _receiveTime )
 	{
         // number of frames elapsed between sending & receiving
 		const FrameIndex delta = _frameIndex - _packetPing.mServerFrame;
 		const FrameIndex clientCurrentFrameIndex = _packetPing.mClientFrame + delta / 2;
 
-        mRtt = _logicDelta * delta;
+        // the reception time is more accurate than the frame delta, but only the last ping send time is known
+        mRtt = _packetPing.mServerFrame == mLastPingFrame ? float( _receiveTime - mLastPingTime )
+                                                          : _logicDelta * delta;
         mFramesDelta[mNextDeltaIndex] = _frameIndex - clientCurrentFrameIndex;
         mNextDeltaIndex = ( mNextDeltaIndex + 1 ) % int( mFramesDelta.size() );
 	}
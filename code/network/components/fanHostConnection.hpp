@@ -16,6 +16,9 @@ namespace fan
 		static void Init( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component );
 		static FrameIndex CalculatePerfectSpawnTiming( const HostConnection& _connection, const Time& _time );
 
+		static constexpr int sMaxPacketsPerFrame = 4;	// datagrams sent to the client each frame at most
+		static constexpr int sMaxBurstFrames     = 4;	// unused budget accumulates for this number of frames
+
 		enum State
 		{
 			Disconnected,		// Requires a hello packet from the client to start connection process
@@ -30,12 +33,16 @@ namespace fan
 		State       mState;
 		double      mLastResponseTime;	// last time the client answered back
 		double      mLastPingTime;		// last time the client was sent a ping
+		FrameIndex  mLastPingFrame;		// server frame of the last ping
 		double      mLastDisconnectTime;	// last time the client was sent a disconnect packet
 		float       mRtt;
 		float       mBandwidth;			// Ko/s send to the client
+		float       mBandwidthBudget;	// Ko/s that can be sent to the client at most
+		float       mAvailableBytes;	// bytes the budget allows to send, negative when overspent
 		float       mPingDelay;			// send a ping to clients every X seconds
 		float       mDisconnectDelay;	// send a disconnect packet to clients every X seconds
 		float       mTimeoutDelay;		// disconnects clients after X seconds without a response
+		int         mStatsIndex;		// slot in NetStats::mHosts, -1 when all slots are taken
 
 		// client frame index synchronization
 		bool               mSynced;				// true if the client has been synced
@@ -45,8 +52,12 @@ namespace fan
 		int                mNextDeltaIndex;		// next delta to update in the array
 
 		void Write( EcsWorld& _world, EcsEntity _entity, Packet& _packet );
+		void UpdateBandwidthBudget( const float _logicDelta );
 		void ProcessPacket	( const PacketHello& _packetHello );
-		void ProcessPacket	( const PacketPing&  _packetPing, const FrameIndex _frameIndex, const float _logicDelta );
+		void ProcessPacket	( const PacketPing&  _packetPing,
+							  const FrameIndex _frameIndex,
+							  const float _logicDelta,
+							  const double _receiveTime );
 		void OnSyncSuccess	();
 		void OnLoginFail	( const PacketTag );
 		void OnLoginSuccess	( const PacketTag );
@@ -1,5 +1,7 @@
 #include "network/components/fanHostGameData.hpp"
 
+#include <limits>
+
 namespace fan
 {
 	//========================================================================================================
@@ -15,33 +17,36 @@ namespace fan
 		HostGameData& hostGameData = static_cast<HostGameData&>( _component );
 		hostGameData.mSpaceshipID          = 0;
 		hostGameData.mSpaceshipHandle      = 0;
-		hostGameData.mInputs               = std::queue<PacketInput::InputData>();
+		for( PacketInput::InputData& inputData : hostGameData.mInputs )
+		{
+			inputData.mFrameIndex = std::numeric_limits<FrameIndex>::max();
+		}
 		hostGameData.mNextPlayerState      = PacketPlayerGameState();
 		hostGameData.mNextPlayerStateFrame = 0;
 	}
 
 	//========================================================================================================
+	// inputs that are too old or too far ahead are dropped
 	//========================================================================================================
-	void HostGameData::ProcessPacket( PacketInput& _packet )
+	void HostGameData::ProcessPacket( const PacketInput& _packet, const FrameIndex _currentFrame )
 	{
-		if( mInputs.empty() )
-		{
-			for ( const PacketInput::InputData& inputData : _packet.mInputs )
-			{
-				mInputs.push( inputData );
-			}			
-		}
-		else
+		static_assert( ( sInputRingSize & ( sInputRingSize - 1 ) ) == 0 );
+		for( int i = 0; i < _packet.mNumInputs; i++ )
 		{
-			for ( const PacketInput::InputData& inputData : _packet.mInputs )
+			const PacketInput::InputData& inputData = _packet.mInputs[i];
+			if( inputData.mFrameIndex >= _currentFrame && inputData.mFrameIndex - _currentFrame < sInputRingSize )
 			{
-				const FrameIndex mostRecentFrame = mInputs.back().mFrameIndex;
-				//fanAssert( inputData.frameIndex <= mostRecentFrame + 1 );
-				if( inputData.mFrameIndex == mostRecentFrame + 1 )
-				{
-					mInputs.push( inputData );
-				} 				
+				mInputs[inputData.mFrameIndex & ( sInputRingSize - 1 )] = inputData;
 			}
-		}	
+		}
+	}
+
+	//========================================================================================================
+	// returns nullptr if the input of this frame was not received
+	//========================================================================================================
+	const PacketInput::InputData* HostGameData::GetInput( const FrameIndex _frameIndex ) const
+	{
+		const PacketInput::InputData& inputData = mInputs[_frameIndex & ( sInputRingSize - 1 )];
+		return inputData.mFrameIndex == _frameIndex ? &inputData : nullptr;
 	}
 }
\ No newline at end of file
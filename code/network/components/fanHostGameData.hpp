@@ -1,6 +1,5 @@
 #pragma  once
 
-#include <queue>
 #include "core/ecs/fanEcsComponent.hpp"
 #include "network/fanPacket.hpp"
 
@@ -8,6 +7,7 @@ namespace fan
 {
 	//========================================================================================================
 	// [Server] All game info for a remote player
+	// received inputs are stored in a ring indexed by frame, from the current frame to sInputRingSize frames ahead
 	//========================================================================================================
 	struct HostGameData : public EcsComponent
 	{
@@ -15,12 +15,15 @@ namespace fan
 		static void SetInfo( EcsComponentInfo& _info );
 		static void Init( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component );
 
-		NetID                                mSpaceshipID;
-		EcsHandle                            mSpaceshipHandle;
-		std::queue< PacketInput::InputData > mInputs;
-		PacketPlayerGameState                mNextPlayerState;
-		FrameIndex                           mNextPlayerStateFrame; // save  player game state on this frame
+		static constexpr int sInputRingSize = 64;	// power of two
 
-		void ProcessPacket( PacketInput& _packet );
+		NetID                  mSpaceshipID;
+		EcsHandle              mSpaceshipHandle;
+		PacketInput::InputData mInputs[sInputRingSize];	// the slot of a frame is not valid if its frame index differs
+		PacketPlayerGameState  mNextPlayerState;
+		FrameIndex             mNextPlayerStateFrame; // save  player game state on this frame
+
+		void ProcessPacket( const PacketInput& _packet, const FrameIndex _currentFrame );
+		const PacketInput::InputData* GetInput( const FrameIndex _frameIndex ) const;
 	};
 }
\ No newline at end of file
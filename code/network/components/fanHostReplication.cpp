@@ -1,8 +1,26 @@
 #include "network/components/fanHostReplication.hpp"
+
+#include <algorithm>
+#include <bitset>
 #include "network/singletons/fanLinkingContext.hpp"
+#include "network/singletons/fanNetStats.hpp"
+#include "network/singletons/fanTime.hpp"
+#include "network/fanBitStream.hpp"
 
 namespace fan
 {
+	//========================================================================================================
+	//========================================================================================================
+	static HostReplication::ComponentBaseline* FindBaseline( std::vector<HostReplication::ComponentBaseline>& _baselines,
+                                                             const uint32_t _type )
+	{
+		for( HostReplication::ComponentBaseline& baseline : _baselines )
+		{
+			if( baseline.mType == _type ) { return &baseline; }
+		}
+		return nullptr;
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void HostReplication::SetInfo( EcsComponentInfo& /*_info*/ )
@@ -16,6 +34,13 @@ namespace fan
 		HostReplication& hostReplication = static_cast<HostReplication&>( _component );
 		hostReplication.mPendingReplication.clear();
 		hostReplication.mNextReplication.clear();
+		hostReplication.mBaselines.clear();
+		hostReplication.mPendingDeltas.clear();
+		hostReplication.mNextEntityDeltas.clear();
+		hostReplication.mRelevantEntities.clear();
+		hostReplication.mNumStarvedEntities = 0;
+		hostReplication.mMaxPriority        = 0.f;
+		hostReplication.mNumRetransmissions = 0;
 	}
 
 	//========================================================================================================
@@ -24,14 +49,31 @@ namespace fan
 	// ( ResendUntilReplicated flag must be on )
 	//========================================================================================================
 	Signal<>& HostReplication::Replicate( const PacketReplication& _packet, const ReplicationFlags _flags )
+	{
+		return Replicate( std::make_shared<const ReplicationPayload>( _packet ), _flags );
+	}
+
+	//========================================================================================================
+	// the payload is shared, replicating it on many hosts does not copy its data
+	//========================================================================================================
+	Signal<>& HostReplication::Replicate( const ReplicationPayloadPtr& _payload, const ReplicationFlags _flags )
 	{
 		mNextReplication.emplace_back();
 		ReplicationData& replicationData = mNextReplication[mNextReplication.size() - 1];
-		replicationData.mFlags  = _flags;
-		replicationData.mPacket = _packet;
+		replicationData.mFlags   = _flags;
+		replicationData.mPayload = _payload;
 		return replicationData.mOnSuccess;
 	}
 
+	//========================================================================================================
+	// the spawn rpc of an entity entering the relevance of the host, its ack is reported in the relevance
+	//========================================================================================================
+	void HostReplication::ReplicateRelevanceSpawn( const PacketReplication& _packet, const NetID _netID )
+	{
+		Replicate( _packet, ResendUntilReplicated );
+		mNextReplication[mNextReplication.size() - 1].mSpawnNetID = _netID;
+	}
+
 	//========================================================================================================
 	// Builds & returns a replication packet to replicate an ecs singleton
 	//========================================================================================================
@@ -50,38 +92,163 @@ namespace fan
 	}
 
 	//========================================================================================================
-	// Builds & returns a replication packet to replicate a list of components on an entity
+	// Serializes the replicated components of an entity once, the snapshot is then shared by all hosts
+	// each component is bit packed & padded to a byte so it can be compared & copied as a whole
+	// returns false if the entity has no net id
 	//========================================================================================================
-    PacketReplication HostReplication::BuildEntityPacket( EcsWorld& _world,
-                                                          const EcsHandle _handle,
-                                                          const std::vector<uint32_t>& _componentTypeInfo )
+    bool HostReplication::BuildEntitySnapshot( EcsWorld& _world,
+                                               const EcsHandle _handle,
+                                               const std::vector<uint32_t>& _componentTypeInfo,
+                                               EntitySnapshot& _outSnapshot )
 	{
-		const LinkingContext& linkingContext = _world.GetSingleton< LinkingContext> ();
+		LinkingContext& linkingContext = _world.GetSingleton< LinkingContext> ();
+		const auto it = linkingContext.mEcsHandleToNetID.find( _handle );
+		if( it == linkingContext.mEcsHandleToNetID.end() ) { return false; }
+
 		const EcsEntity entity = _world.GetEntity( _handle );
+		const EcsWorld& constWorld = _world;	// read only access, components versions are left unchanged
+		_outSnapshot.mNetID = it->second;
+		_outSnapshot.mFrameIndex = _world.GetSingleton<Time>().mFrameIndex;
+		_outSnapshot.mComponentTypes = _componentTypeInfo;
+		_outSnapshot.mNetIndices.clear();
+		_outSnapshot.mOffsets.clear();
+		_outSnapshot.mData.clear();
 
-		PacketReplication packet;
-		packet.mReplicationType = PacketReplication::ReplicationType::Entity;
-		packet.mPacketData.clear();
+		BitWriter writer;
+		for( const uint32_t typeInfo : _componentTypeInfo )
+		{
+			const EcsComponentInfo& info = _world.GetComponentInfo( typeInfo );
+			const EcsComponent& component = constWorld.GetComponent( entity, typeInfo );
+			const int netIndex = linkingContext.GetNetComponentIndex( _world, typeInfo );
+            fanAssert( netIndex >= 0 );
+			writer.Clear();
+			info.netSave( component, writer );
+            fanAssert( !writer.IsOverflow() );
+
+			const uint8_t* data = writer.GetData();
+			_outSnapshot.mNetIndices.push_back( uint8_t( netIndex ) );
+			_outSnapshot.mOffsets.push_back( uint32_t( _outSnapshot.mData.size() ) );
+			_outSnapshot.mData.insert( _outSnapshot.mData.end(), data, data + writer.GetNumBytes() );
+		}
+		_outSnapshot.mOffsets.push_back( uint32_t( _outSnapshot.mData.size() ) );
+		return true;
+	}
+
+	//========================================================================================================
+	// Builds the entity replication payload containing the components of the mask
+	// layout : net id ( var uint ), frame index ( var uint ), components count,
+	//          [ net component index, component bytes ]...
+	//========================================================================================================
+	ReplicationPayloadPtr HostReplication::BuildEntityPayload( const EntitySnapshot& _snapshot,
+                                                               const uint32_t _componentsMask )
+	{
+		BitWriter writer;
+		writer.WriteVarUint( _snapshot.mNetID );
+		writer.WriteVarUint( _snapshot.mFrameIndex );
+		writer.WriteBits( uint32_t( std::bitset<32>( _componentsMask ).count() ), 8 );
+
+		std::vector<ReplicationPayload::ComponentRange> components;
+		for( int i = 0; i < (int)_snapshot.mComponentTypes.size(); i++ )
+		{
+			if( ( _componentsMask & ( 1u << i ) ) == 0 ) { continue; }
 
-		// Serializes net id
-		 const auto it = linkingContext.mEcsHandleToNetID.find( _handle );
-		 if( it != linkingContext.mEcsHandleToNetID.end() )
-		 {
-			 const NetID netID = it->second;
-			 packet.mPacketData << netID;
-			 packet.mPacketData << sf::Uint8( _componentTypeInfo.size() );
-			 if( it != linkingContext.mEcsHandleToNetID.end() )
-			 {
-				 for( const uint32_t typeInfo : _componentTypeInfo )
-				 {
-					 const EcsComponentInfo& info = _world.GetComponentInfo( typeInfo );
-					 EcsComponent& component = _world.GetComponent( entity, typeInfo );
-					 packet.mPacketData << sf::Uint32( info.mType );
-					 info.netSave( component, packet.mPacketData );
-				 }
-			 }
-		 }
-		 return packet;
+			const uint8_t* begin = _snapshot.mData.data() + _snapshot.mOffsets[i];
+			const uint8_t* end   = _snapshot.mData.data() + _snapshot.mOffsets[i + 1];
+			writer.WriteBits( _snapshot.mNetIndices[i], 8 );
+			const uint32_t rangeBegin = uint32_t( writer.GetNumBytes() );
+			writer.WriteBytes( begin, end - begin );
+			components.push_back( { _snapshot.mComponentTypes[i],
+									rangeBegin,
+									uint32_t( writer.GetNumBytes() ),
+									_snapshot.mNetIndices[i] } );
+		}
+        fanAssert( !writer.IsOverflow() );
+
+		std::shared_ptr<ReplicationPayload> payload = std::make_shared<ReplicationPayload>(
+			PacketReplication::ReplicationType::Entity,
+			writer.GetData(),
+			writer.GetNumBytes() );
+		payload->mComponents = std::move( components );
+		return payload;
+	}
+
+	//========================================================================================================
+	// Returns the mask of the components of the snapshot that must be sent to the host
+	// a component in flight is only sent again if it differs from the in flight data, otherwise it waits
+	// for the packet to be acknowledged or dropped. Other components are sent when they differ from the
+	// state acknowledged by the host. Unchanged entities are not sent at all
+	//========================================================================================================
+	uint32_t HostReplication::GetChangedComponents( const EntitySnapshot& _snapshot )
+	{
+		static constexpr int sMaxComponents = 32;
+        fanAssert( _snapshot.mComponentTypes.size() <= sMaxComponents );
+
+		std::vector<ComponentBaseline>& baselines = mBaselines[_snapshot.mNetID].mComponents;
+		uint32_t changedMask = 0;
+		for( int i = 0; i < (int)_snapshot.mComponentTypes.size(); i++ )
+		{
+			const uint32_t type = _snapshot.mComponentTypes[i];
+			ComponentBaseline* baseline = FindBaseline( baselines, type );
+			if( baseline == nullptr )
+			{
+				baselines.emplace_back();
+				baseline = &baselines.back();
+				baseline->mType = type;
+			}
+
+			const uint8_t* begin = _snapshot.mData.data() + _snapshot.mOffsets[i];
+			const uint8_t* end   = _snapshot.mData.data() + _snapshot.mOffsets[i + 1];
+			const bool changed = baseline->mIsInFlight
+                                 ? ! std::equal( begin, end, baseline->mInFlight.begin(), baseline->mInFlight.end() )
+                                 : ! baseline->mIsAcked
+                                   || ! std::equal( begin, end, baseline->mAcked.begin(), baseline->mAcked.end() );
+			if( changed )
+			{
+				changedMask |= 1u << i;
+			}
+		}
+		return changedMask;
+	}
+
+	//========================================================================================================
+	// Replicates an entity payload built from the changed components of the host
+	// the payload is only referenced, by the packet & by the baselines once acknowledged
+	// the priority accumulates every frame the entity waits to be sent
+	//========================================================================================================
+	void HostReplication::ReplicateDelta( const ReplicationPayloadPtr& _payload,
+                                          const NetID _netID,
+                                          const float _priority )
+	{
+		EntityBaseline& baseline = mBaselines[_netID];
+		baseline.mPriority += _priority;
+		mNextEntityDeltas.push_back( { _netID, _payload, baseline.mPriority, false } );
+	}
+
+	//========================================================================================================
+	// for entities with a relevance distance, see SUpdateRelevance
+	//========================================================================================================
+	bool HostReplication::IsReplicatedThisFrame( const NetID _netID ) const
+	{
+		auto it = mRelevantEntities.find( _netID );
+		return it != mRelevantEntities.end() && it->second.mIsReplicated;
+	}
+
+	//========================================================================================================
+	// Removes the baselines of entities that are not in the linking context anymore
+	//========================================================================================================
+	void HostReplication::RemoveBaselines( const LinkingContext& _linkingContext )
+	{
+		for( auto it = mBaselines.begin(); it != mBaselines.end(); )
+		{
+			if( _linkingContext.mNetIDToEcsHandle.find( it->first ) == _linkingContext.mNetIDToEcsHandle.end() )
+			{
+				it = mBaselines.erase( it );
+			}
+			else
+			{
+				++it;
+			}
+		}
 	}
 
 	//========================================================================================================
@@ -98,22 +265,125 @@ namespace fan
 	}
 
 	//========================================================================================================
-	// Sends all new replication packed
+	// Writes the replication data that fits in the packet without exceeding _maxSize bytes
+	// data that does not fit is written in the next packet
 	//========================================================================================================
-	void HostReplication::Write( EcsWorld& _world, EcsEntity _entity, Packet& _packet )
+	void HostReplication::Write( EcsWorld& _world, EcsEntity _entity, Packet& _packet, const size_t _maxSize )
 	{
-		for( ReplicationData& data : mNextReplication )
+		const EcsHandle handle = _world.GetHandle( _entity );
+		NetStats& stats = _world.GetSingleton<NetStats>();
+
+		// replication data & rpc are written in order
+		bool hasReliableData = false;
+		size_t numWritten = 0;
+		for( ; numWritten < mNextReplication.size(); numWritten++ )
 		{
-			data.mPacket.Write( _packet );
+			ReplicationData& data = mNextReplication[numWritten];
+			if( _packet.GetSize() + data.mPayload->GetWriteSize() > _maxSize ) { break; }
+
+			data.mPayload->Write( _packet );
+			stats.mSentReplication[int( data.mPayload->mReplicationType )].Add( data.mPayload->GetWriteSize() );
 			if( data.mFlags & ReplicationFlags::ResendUntilReplicated )
 			{
 				mPendingReplication.insert( { _packet.mTag , data } );
-				const EcsHandle& handle = _world.GetHandle( _entity );
-				_packet.mOnSuccess.Connect( &HostReplication::OnReplicationSuccess, _world, handle );
-				_packet.mOnFail.Connect( &HostReplication::OnReplicationFail, _world, handle );
+				hasReliableData = true;
 			}
 		}
-		mNextReplication.clear();
+		mNextReplication.erase( mNextReplication.begin(), mNextReplication.begin() + numWritten );
+		if( hasReliableData )
+		{
+			_packet.mOnSuccess.Connect( &HostReplication::OnReplicationSuccess, handle );
+			_packet.mOnFail.Connect( &HostReplication::OnReplicationFail, handle );
+		}
+
+		// entity deltas by decreasing priority, smaller deltas can fill the space left by bigger ones
+		// sorting is only needed when the deltas do not all fit
+		size_t deltasSize = 0;
+		for( const EntityDelta& delta : mNextEntityDeltas )
+		{
+			if( !delta.mIsSent ) { deltasSize += delta.mPayload->GetWriteSize(); }
+		}
+		if( _packet.GetSize() + deltasSize > _maxSize )
+		{
+            std::sort( mNextEntityDeltas.begin(),
+                       mNextEntityDeltas.end(),
+                       []( const EntityDelta& _a, const EntityDelta& _b )
+                       {
+                           return _a.mPriority > _b.mPriority ||
+                                  ( _a.mPriority == _b.mPriority && _a.mNetID < _b.mNetID );
+                       } );
+		}
+		std::vector<DeltaRecord>* records = nullptr;
+		for( EntityDelta& delta : mNextEntityDeltas )
+		{
+			if( delta.mIsSent ) { continue; }
+			if( _packet.GetSize() + delta.mPayload->GetWriteSize() > _maxSize ) { continue; }
+
+			delta.mPayload->Write( _packet );
+			delta.mIsSent = true;
+			stats.mSentReplication[int( delta.mPayload->mReplicationType )].Add( delta.mPayload->GetWriteSize() );
+
+			if( records == nullptr ) { records = &mPendingDeltas[_packet.mTag]; }
+			auto baselinesIt = mBaselines.find( delta.mNetID );
+			if( baselinesIt != mBaselines.end() ) { baselinesIt->second.mPriority = 0.f; }
+			for( const ReplicationPayload::ComponentRange& range : delta.mPayload->mComponents )
+			{
+				DeltaRecord record;
+				record.mNetID = delta.mNetID;
+				record.mType  = range.mType;
+				record.mData  = { delta.mPayload, range.mBegin, range.mEnd };
+				records->push_back( record );
+				if( range.mNetIndex < NetStats::sMaxComponents )
+				{
+					// the net index byte is written before the component data
+					stats.mSentComponents[range.mNetIndex].Add( range.mEnd - range.mBegin + 1 );
+				}
+
+				ComponentBaseline* baseline = baselinesIt == mBaselines.end()
+                                              ? nullptr
+                                              : FindBaseline( baselinesIt->second.mComponents, range.mType );
+				if( baseline != nullptr )
+				{
+					baseline->mIsInFlight  = true;
+					baseline->mInFlightTag = _packet.mTag;
+					baseline->mInFlight    = record.mData;
+				}
+			}
+		}
+		if( records != nullptr )
+		{
+			_packet.mOnSuccess.Connect( &HostReplication::OnDeltaSuccess, handle );
+			_packet.mOnFail.Connect( &HostReplication::OnDeltaFail, handle );
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	bool HostReplication::HasDataToSend() const
+	{
+		if( !mNextReplication.empty() ) { return true; }
+		for( const EntityDelta& delta : mNextEntityDeltas )
+		{
+			if( !delta.mIsSent ) { return true; }
+		}
+		return false;
+	}
+
+	//========================================================================================================
+	// Called once all the packets of the frame are written
+	// unsent entity deltas are discarded, their accumulated priority is kept for the next frame
+	//========================================================================================================
+	void HostReplication::ClearUnsentEntities()
+	{
+		mNumStarvedEntities = 0;
+		mMaxPriority        = 0.f;
+		for( const EntityDelta& delta : mNextEntityDeltas )
+		{
+			if( delta.mIsSent ) { continue; }
+			mNumStarvedEntities++;
+			mMaxPriority = std::max( mMaxPriority, delta.mPriority );
+		}
+		mNextEntityDeltas.clear();
 	}
 
 	//========================================================================================================
@@ -127,6 +397,11 @@ namespace fan
 		{
 			ReplicationData& data = it->second;
 			data.mOnSuccess.Emmit();
+			if( data.mSpawnNetID != 0 )
+			{
+				auto relevanceIt = mRelevantEntities.find( data.mSpawnNetID );
+				if( relevanceIt != mRelevantEntities.end() ) { relevanceIt->second.mIsSpawnAcked = true; }
+			}
 		}
 		mPendingReplication.erase( _packetTag );
 		//Debug::Highlight() << "success: " << _packetTag << Debug::Endl();
@@ -143,8 +418,61 @@ namespace fan
 		{
 			ReplicationData& data = it->second;
 			mNextReplication.push_back( data );
+			mNumRetransmissions++;
 		}
 		mPendingReplication.erase( _packetTag );
 		//Debug::Warning() << "fail: " << _packetTag << Debug::Endl();
 	}
+
+	//========================================================================================================
+	// Delta packet has arrived, its components data become the new baselines
+	//========================================================================================================
+	void HostReplication::OnDeltaSuccess( const PacketTag _packetTag )
+	{
+		auto pendingIt = mPendingDeltas.find( _packetTag );
+		if( pendingIt == mPendingDeltas.end() ) { return; }
+
+		for( DeltaRecord& record : pendingIt->second )
+		{
+			auto it = mBaselines.find( record.mNetID );
+			if( it == mBaselines.end() ) { continue; }
+			ComponentBaseline* baseline = FindBaseline( it->second.mComponents, record.mType );
+			if( baseline == nullptr ) { continue; }
+			if( !baseline->mIsAcked || _packetTag > baseline->mAckedTag )
+			{
+				baseline->mAcked    = std::move( record.mData );
+				baseline->mAckedTag = _packetTag;
+				baseline->mIsAcked  = true;
+			}
+			if( baseline->mIsInFlight && baseline->mInFlightTag == _packetTag )
+			{
+				baseline->mIsInFlight = false;
+				baseline->mInFlight   = PayloadRange();
+			}
+		}
+		mPendingDeltas.erase( pendingIt );
+	}
+
+	//========================================================================================================
+	// Delta packet has dropped, nothing to resend : components that still differ from their baseline
+	// are replicated again on the next update
+	//========================================================================================================
+	void HostReplication::OnDeltaFail( const PacketTag _packetTag )
+	{
+		auto pendingIt = mPendingDeltas.find( _packetTag );
+		if( pendingIt == mPendingDeltas.end() ) { return; }
+
+		for( const DeltaRecord& record : pendingIt->second )
+		{
+			auto it = mBaselines.find( record.mNetID );
+			if( it == mBaselines.end() ) { continue; }
+			ComponentBaseline* baseline = FindBaseline( it->second.mComponents, record.mType );
+			if( baseline != nullptr && baseline->mIsInFlight && baseline->mInFlightTag == _packetTag )
+			{
+				baseline->mIsInFlight = false;
+				baseline->mInFlight   = PayloadRange();
+			}
+		}
+		mPendingDeltas.erase( pendingIt );
+	}
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma  once
 
+#include <map>
+#include <unordered_map>
 #include "core/ecs/fanEcsComponent.hpp"
 #include "network/fanPacket.hpp"
 
 namespace fan
 {
+	struct LinkingContext;
+
 	//========================================================================================================
 	// [Server] Sends packets to clients to replicates objects / run RPC
 	//========================================================================================================
@@ -25,24 +29,133 @@ namespace fan
 		//================================================================
 		struct ReplicationData
 		{
-			ReplicationFlags  mFlags = ReplicationFlags::None;	// replication parameters
-			PacketReplication mPacket;							// saved replication data
-			Signal<>          mOnSuccess;
+			ReplicationFlags      mFlags = ReplicationFlags::None;	// replication parameters
+			ReplicationPayloadPtr mPayload;							// saved replication data
+			Signal<>              mOnSuccess;
+			NetID                 mSpawnNetID = 0;							// relevance spawn, see Relevance::mIsSpawnAcked
+		};
+
+		//================================================================
+		// netSave output of the replicated components of an entity
+		// built once per replication and compared against the baselines of each host
+		//================================================================
+		struct EntitySnapshot
+		{
+			NetID                 mNetID = 0;
+			FrameIndex            mFrameIndex = 0;	// clients interpolate between the snapshots frames
+			std::vector<uint32_t> mComponentTypes;
+			std::vector<uint8_t>  mNetIndices;	// see LinkingContext::GetNetComponentIndex
+			std::vector<uint32_t> mOffsets;		// begin of each component in mData, one more than the types
+			std::vector<uint8_t>  mData;
+		};
+
+		//================================================================
+		// component data inside a shared payload
+		//================================================================
+		struct PayloadRange
+		{
+			ReplicationPayloadPtr mPayload;
+			uint32_t              mBegin = 0;
+			uint32_t              mEnd   = 0;
+
+			const uint8_t* begin() const { return mPayload->mData.data() + mBegin; }
+			const uint8_t* end() const { return mPayload->mData.data() + mEnd; }
+		};
+
+		//================================================================
+		// last state of an entity component known to be received by the host
+		// only components that differ from their baseline are replicated,
+		// a component equal to the data in flight is not sent again until that packet is acked or dropped
+		//================================================================
+		struct ComponentBaseline
+		{
+			uint32_t     mType;
+			PayloadRange mAcked;
+			PayloadRange mInFlight;		// data of the last packet sending this component
+			PacketTag    mAckedTag    = 0;
+			PacketTag    mInFlightTag = 0;
+			bool         mIsAcked     = false;
+			bool         mIsInFlight  = false;
+		};
+
+		//================================================================
+		// baselines of the replicated components of an entity
+		//================================================================
+		struct EntityBaseline
+		{
+			std::vector<ComponentBaseline> mComponents;
+			float                          mPriority = 0.f;	// accumulates while the entity waits to be sent
+		};
+
+		//================================================================
+		// component data written in a packet, becomes the baseline when the packet is acknowledged
+		//================================================================
+		struct DeltaRecord
+		{
+			NetID        mNetID;
+			uint32_t     mType;
+			PayloadRange mData;
+		};
+
+		//================================================================
+		// entity delta waiting to be sent, entities are sent by decreasing accumulated priority
+		// deltas that do not fit in the frame packets are discarded & rebuilt from a fresh snapshot
+		// on the next frame, only their accumulated priority is kept ( EntityBaseline ) so they are not starved
+		//================================================================
+		struct EntityDelta
+		{
+			NetID                 mNetID;
+			ReplicationPayloadPtr mPayload;
+			float                 mPriority;
+			bool                  mIsSent;
+		};
+
+		//================================================================
+		// entity with a relevance distance that the host perceives
+		// entities with a relevance distance that are not in the map are not replicated on the host
+		//================================================================
+		struct Relevance
+		{
+			FrameIndex mSpawnFrame   = 0;		// replication starts once the entity is spawned on the host
+			bool       mIsSpawnAcked = false;	// the entity can't leave the relevance before its spawn rpc is received
+			bool       mIsFar        = false;	// replicated at a lower rate
+			bool       mIsReplicated = false;	// replicated on this frame
+			bool       mIsVisited    = false;
 		};
 
 		std::multimap< PacketTag, ReplicationData> mPendingReplication; // sent, waiting for a status
 		std::vector<ReplicationData>               mNextReplication;	// waiting to be sent
+		std::unordered_map< NetID, EntityBaseline >                 mBaselines;
+		std::map< PacketTag, std::vector<DeltaRecord> >            mPendingDeltas;	// sent, waiting for a status
+		std::vector<EntityDelta>                                    mNextEntityDeltas;	// waiting to be sent
+		std::unordered_map< NetID, Relevance >                      mRelevantEntities;
+		int                                                         mNumStarvedEntities;// not sent on the last frame
+		float                                                       mMaxPriority;		// of the starved entities
+		uint32_t                                                    mNumRetransmissions;// not published to the NetStats yet
 	
-		void		Write( EcsWorld& _world, EcsEntity _entity, Packet& _packet );
+		void		Write( EcsWorld& _world, EcsEntity _entity, Packet& _packet, const size_t _maxSize );
+		bool		HasDataToSend() const;
+		void		ClearUnsentEntities();
 
 		Signal<>&	Replicate( const PacketReplication& _packet, const ReplicationFlags _flags );
+		Signal<>&	Replicate( const ReplicationPayloadPtr& _payload, const ReplicationFlags _flags );
+		void		ReplicateRelevanceSpawn( const PacketReplication& _packet, const NetID _netID );
+		uint32_t	GetChangedComponents( const EntitySnapshot& _snapshot );
+		void		ReplicateDelta( const ReplicationPayloadPtr& _payload, const NetID _netID, const float _priority = 1.f );
+		void		RemoveBaselines( const LinkingContext& _linkingContext );
+		bool		IsReplicatedThisFrame( const NetID _netID ) const;
 		void		OnReplicationSuccess( const PacketTag _packetTag );
 		void		OnReplicationFail( const PacketTag _packetTag );
+		void		OnDeltaSuccess( const PacketTag _packetTag );
+		void		OnDeltaFail( const PacketTag _packetTag );
 
 		static PacketReplication BuildSingletonPacket( const EcsWorld& _world, const uint32_t _staticID );
-        static PacketReplication BuildEntityPacket( EcsWorld& _world,
-                                                    const EcsHandle _handle,
-                                                    const std::vector<uint32_t>& _componentTypeInfo );
+        static bool BuildEntitySnapshot( EcsWorld& _world,
+                                         const EcsHandle _handle,
+                                         const std::vector<uint32_t>& _componentTypeInfo,
+                                         EntitySnapshot& _outSnapshot );
+        static ReplicationPayloadPtr BuildEntityPayload( const EntitySnapshot& _snapshot,
+                                                         const uint32_t _componentsMask );
 		static PacketReplication BuildRPCPacket( sf::Packet& _dataRPC );
 	};
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "network/components/fanReliabilityLayer.hpp"
 #include "network/singletons/fanTime.hpp"
+#include "network/singletons/fanNetStats.hpp"
 
 namespace fan
 {
@@ -16,8 +17,14 @@ namespace fan
 	void ReliabilityLayer::Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
 	{
 		ReliabilityLayer& reliabilityLayer = static_cast<ReliabilityLayer&>( _component );
-		reliabilityLayer.mNextPacketTag     = 0;
-		reliabilityLayer.mExpectedPacketTag = 0;
+		reliabilityLayer.mNextPacketTag      = 0;
+		reliabilityLayer.mExpectedPacketTag  = 0;
+		reliabilityLayer.mAck                = PacketAck();
+		reliabilityLayer.mHasReceivedPacket  = false;
+		reliabilityLayer.mHasNewAck          = false;
+		reliabilityLayer.mInFlightPackets.resize( sMaxInFlightPackets );
+		reliabilityLayer.mOldestInFlightTag  = 0;
+		reliabilityLayer.mNumInFlightPackets = 0;
 	}
 
 	//========================================================================================================
@@ -28,30 +35,38 @@ namespace fan
 	{
 		if( _packet.mOnlyContainsAck ) return true;
 
-		if( _packet.mTag == mExpectedPacketTag )	// packet is perfect \o/
+		if( _packet.mTag < mExpectedPacketTag ) // silently drop old packet.
 		{
-			mExpectedPacketTag++;
-			mPendingAck.push_back( _packet.mTag );
-			return true;
+			return false;
 		}
-		else if( _packet.mTag < mExpectedPacketTag ) // silently drop old packet.
+		mExpectedPacketTag = _packet.mTag + 1;	// we may have missed some packets
+
+		// shifts the previous acks in the bitfield
+		const PacketTag shift = _packet.mTag - mAck.mLatestTag;
+		if( !mHasReceivedPacket || _packet.mTag <= mAck.mLatestTag ) // first packet or tags were reset ( hello )
 		{
-			return false;
+			mAck.mAckBits = 0;
+		}
+		else if( shift <= PacketTag( PacketAck::sAckBits ) )
+		{
+			const uint64_t bits = ( uint64_t( mAck.mAckBits ) << shift ) | ( uint64_t( 1 ) << ( shift - 1 ) );
+			mAck.mAckBits = PacketAck::AckBits( bits );
 		}
-		else //we missed some packets
+		else
 		{
-            fanAssert( _packet.mTag > mExpectedPacketTag );
-            mExpectedPacketTag = _packet.mTag + 1;
-			mPendingAck.push_back( _packet.mTag );
-			return true;
+			mAck.mAckBits = 0;
 		}
+		mAck.mLatestTag    = _packet.mTag;
+		mHasReceivedPacket = true;
+		mHasNewAck         = true;
+		return true;
 	}
 
 	//========================================================================================================
 	// Registers the packet as an inFlightPacket.
 	// allows timeout and delivery notification to be issued
 	//========================================================================================================
-	void ReliabilityLayer::RegisterPacket( Packet& _packet )
+	void ReliabilityLayer::RegisterPacket( EcsWorld& _world, Packet& _packet )
 	{
 		if( _packet.mOnlyContainsAck )
 		{
@@ -59,54 +74,87 @@ namespace fan
 			return;
 		}
 
-		InFlightPacket inFlightPacket;
+		if( mNumInFlightPackets == 0 )
+		{
+			mOldestInFlightTag = _packet.mTag;
+		}
+		else if( mNumInFlightPackets == sMaxInFlightPackets )
+		{
+			PopOldestInFlightPacket( _world, false );
+		}
+		fanAssert( _packet.mTag == mOldestInFlightTag + PacketTag( mNumInFlightPackets ) );
+
+		InFlightPacket& inFlightPacket = GetInFlightPacket( _packet.mTag );
 		inFlightPacket.mTag          = _packet.mTag;
 		inFlightPacket.mOnFailure    = _packet.mOnFail;
 		inFlightPacket.mOnSuccess    = _packet.mOnSuccess;
 		inFlightPacket.mTimeDispatch = Time::ElapsedSinceStartup();
-		mInFlightPackets.push( inFlightPacket );
+		mNumInFlightPackets++;
+	}
+
+	//========================================================================================================
+	// the packet is removed before calling its callbacks
+	//========================================================================================================
+	void ReliabilityLayer::PopOldestInFlightPacket( EcsWorld& _world, const bool _success )
+	{
+		fanAssert( mNumInFlightPackets > 0 );
+		const InFlightPacket inFlightPacket = GetInFlightPacket( mOldestInFlightTag );
+		mOldestInFlightTag++;
+		mNumInFlightPackets--;
+		if( _success )
+		{
+			const float ackLatency = float( Time::ElapsedSinceStartup() - inFlightPacket.mTimeDispatch );
+			_world.GetSingleton<NetStats>().mAckLatency.Add( ackLatency );
+			inFlightPacket.mOnSuccess.Emmit( _world, inFlightPacket.mTag );
+		}
+		else
+		{
+			inFlightPacket.mOnFailure.Emmit( _world, inFlightPacket.mTag );
+		}
 	}
 
 	//========================================================================================================
 	// Process incoming acknowledgments and notify modules about which packets were received or dropped
+	// packets older than the latest acked packet can't be received anymore ( out of order packets are dropped )
+	// packets older than the bitfield are considered dropped
 	//========================================================================================================
-	void ReliabilityLayer::ProcessPacket( const PacketAck& _packetAck )
+	void ReliabilityLayer::ProcessPacket( EcsWorld& _world, const PacketAck& _packetAck )
 	{
-		int ackIndex = 0;
-		while( ackIndex < (int)_packetAck.mTags.size() && !mInFlightPackets.empty() )
+		while( mNumInFlightPackets > 0 && mOldestInFlightTag <= _packetAck.mLatestTag )
 		{
-			const PacketTag ackPacketTag = _packetAck.mTags[ackIndex];
-			/*const*/ InFlightPacket& inFlightPacket = mInFlightPackets.front();
-			if( inFlightPacket.mTag == ackPacketTag ) // packet was received ! \o/
-			{
-				inFlightPacket.mOnSuccess.Emmit( inFlightPacket.mTag );
-				mInFlightPackets.pop();
-				ackIndex++;
-			}
-			else if( inFlightPacket.mTag < ackPacketTag ) // packet was dropped or too old
-			{
-				inFlightPacket.mOnFailure.Emmit( inFlightPacket.mTag );
-				mInFlightPackets.pop();
-			}
-			else // inFlightPacket was already removed (maybe from timeout)	
-			{
-                fanAssert( inFlightPacket.mTag > ackPacketTag );
-				ackIndex++;
-			}
+			PopOldestInFlightPacket( _world, _packetAck.IsAcked( mOldestInFlightTag ) );
 		}
 	}
 
 	//========================================================================================================
-	// Send out an acknowledgment for each validated packet 
+	// packets are sorted, so all timed out packets are the oldest
+	//========================================================================================================
+	void ReliabilityLayer::ProcessTimedOutPackets( EcsWorld& _world, const double _timeoutTime )
+	{
+		while( mNumInFlightPackets > 0 && GetInFlightPacket( mOldestInFlightTag ).mTimeDispatch < _timeoutTime )
+		{
+			PopOldestInFlightPacket( _world, false );
+		}
+	}
+
+	//========================================================================================================
+	// size of the acknowledgment written in the next packet
+	//========================================================================================================
+	size_t ReliabilityLayer::GetAckSize() const
+	{
+		return mHasReceivedPacket ? PacketAck::sSize : 0;
+	}
+
+	//========================================================================================================
+	// the acknowledgment is sent with each packet once a packet was received
+	// packets that only contain the ack are only sent when new packets were validated
 	//========================================================================================================
 	void ReliabilityLayer::Write( Packet& _packet )
 	{
-		if( !mPendingAck.empty() )
+		if( mHasReceivedPacket && ( mHasNewAck || !_packet.mOnlyContainsAck ) )
 		{
-			PacketAck packetAck;
-			packetAck.mTags = mPendingAck;
-			packetAck.Write( _packet );
-			mPendingAck.clear();
+			mAck.Write( _packet );
+			mHasNewAck = false;
 		}
 	}
-}
\ No newline at end of file
+}
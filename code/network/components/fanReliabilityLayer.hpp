@@ -1,6 +1,6 @@
 #pragma  once
 
-#include <queue>
+#include <vector>
 #include "core/ecs/fanEcsComponent.hpp"
 #include "network/fanPacket.hpp"
 
@@ -8,7 +8,7 @@ namespace fan
 {
 	//========================================================================================================
 	// [Server] Uniquely identify and tag each packet send out
-	// Send out an acknowledgment for each validated packet 
+	// Send out an acknowledgment of the latest validated packets in each packet ( latest tag & bitfield )
 	// Process incoming acknowledgments and notify modules about which packets were received or dropped
 	// Ensure packets are never processed out of order. Old packets arriving after newer packets are dropped.
 	//========================================================================================================
@@ -23,22 +23,38 @@ namespace fan
 		//================================================================
 		struct InFlightPacket
 		{
-			PacketTag           mTag;
-			double              mTimeDispatch;
-			Signal< PacketTag > mOnFailure;
-			Signal< PacketTag > mOnSuccess;
+			PacketTag       mTag;
+			double          mTimeDispatch;
+			PacketCallbacks mOnFailure;
+			PacketCallbacks mOnSuccess;
 		};
 
+		// in flight packets have consecutive tags & are stored in a ring indexed by tag
+		// when the ring is full the oldest packet is considered dropped
+		static constexpr int         sMaxInFlightPackets = 256;
 		static const float           sTimeoutDuration;		// time after which a packet is considered dropped
 		PacketTag                    mNextPacketTag;		// the tag of the next packet being send
 		PacketTag                    mExpectedPacketTag;	// the expected tag of the next received packet
-		std::vector<PacketTag>       mPendingAck;			// validated packets waiting for ack dispatch @todo change into a range to gain space
-		std::queue< InFlightPacket > mInFlightPackets;		// list of packets pending success/drop status
+		PacketAck                    mAck;					// acknowledgment of the validated packets
+		bool                         mHasReceivedPacket;	// mAck is valid
+		bool                         mHasNewAck;			// a packet was validated since the last ack was sent
+		std::vector<InFlightPacket>  mInFlightPackets;		// ring of packets pending success/drop status
+		PacketTag                    mOldestInFlightTag;
+		int                          mNumInFlightPackets;
 
-		void		RegisterPacket( Packet& _packet );
+		void		RegisterPacket( EcsWorld& _world, Packet& _packet );
 		bool		ValidatePacket( Packet& _packet );
 		PacketTag	GetNextPacketTag() { return mNextPacketTag++; }
-		void		ProcessPacket( const PacketAck& _packetAck );
+		size_t		GetAckSize() const;
+		void		ProcessPacket( EcsWorld& _world, const PacketAck& _packetAck );
+		void		ProcessTimedOutPackets( EcsWorld& _world, const double _timeoutTime );
 		void		Write( Packet& _packet );
+
+	private:
+		InFlightPacket& GetInFlightPacket( const PacketTag _tag )
+		{
+			return mInFlightPackets[_tag & ( sMaxInFlightPackets - 1 )];
+		}
+		void PopOldestInFlightPacket( EcsWorld& _world, const bool _success );
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,164 @@
+#include "network/fanBitStream.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include "core/fanAssert.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	//========================================================================================================
+	void BitWriter::Clear()
+	{
+		mNumBits  = 0;
+		mOverflow = false;
+	}
+
+	//========================================================================================================
+	// bytes are cleared when the writing reaches them, the buffer does not need to be zeroed
+	//========================================================================================================
+	void BitWriter::WriteBits( const uint32_t _value, const int _numBits )
+	{
+		fanAssert( _numBits > 0 && _numBits <= 32 );
+		if( mOverflow || mNumBits + _numBits > 8 * sCapacity )
+		{
+			mOverflow = true;
+			return;
+		}
+
+		uint64_t value = uint64_t( _value ) & ( ( uint64_t( 1 ) << _numBits ) - 1 );
+		int numBits = _numBits;
+		while( numBits > 0 )
+		{
+			const int byteIndex = mNumBits >> 3;
+			const int bitOffset = mNumBits & 7;
+			const int numBitsInByte = std::min( 8 - bitOffset, numBits );
+			if( bitOffset == 0 ) { mBuffer[byteIndex] = 0; }
+			mBuffer[byteIndex] |= uint8_t( ( value & ( ( 1u << numBitsInByte ) - 1 ) ) << bitOffset );
+			value >>= numBitsInByte;
+			numBits -= numBitsInByte;
+			mNumBits += numBitsInByte;
+		}
+	}
+
+	//========================================================================================================
+	// full precision
+	//========================================================================================================
+	void BitWriter::WriteFloat( const float _value )
+	{
+		uint32_t bits;
+		std::memcpy( &bits, &_value, sizeof( bits ) );
+		WriteBits( bits, 32 );
+	}
+
+	//========================================================================================================
+	// groups of 7 bits followed by a continuation bit, small values take one byte
+	//========================================================================================================
+	void BitWriter::WriteVarUint( uint32_t _value )
+	{
+		while( _value >= 0x80 )
+		{
+			WriteBits( ( _value & 0x7F ) | 0x80, 8 );
+			_value >>= 7;
+		}
+		WriteBits( _value, 8 );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void BitWriter::WriteBytes( const void* _data, const size_t _size )
+	{
+		const uint8_t* data = static_cast<const uint8_t*>( _data );
+		for( size_t i = 0; i < _size; i++ )
+		{
+			WriteBits( data[i], 8 );
+		}
+	}
+
+	//========================================================================================================
+	// pads with zeros up to the next byte
+	//========================================================================================================
+	void BitWriter::Align()
+	{
+		const int padding = ( 8 - ( mNumBits & 7 ) ) & 7;
+		if( padding != 0 ) { WriteBits( 0, padding ); }
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	BitReader::BitReader( const void* _data, const size_t _size ) :
+		mData( static_cast<const uint8_t*>( _data ) ),
+		mNumBits( int( 8 * _size ) ),
+		mNumBitsRead( 0 ),
+		mOverflow( false )
+	{}
+
+	//========================================================================================================
+	//========================================================================================================
+	uint32_t BitReader::ReadBits( const int _numBits )
+	{
+		fanAssert( _numBits > 0 && _numBits <= 32 );
+		if( mOverflow || mNumBitsRead + _numBits > mNumBits )
+		{
+			mOverflow = true;
+			return 0;
+		}
+
+		uint64_t value = 0;
+		int numBits = 0;
+		while( numBits < _numBits )
+		{
+			const int byteIndex = mNumBitsRead >> 3;
+			const int bitOffset = mNumBitsRead & 7;
+			const int numBitsInByte = std::min( 8 - bitOffset, _numBits - numBits );
+			const uint64_t bits = ( mData[byteIndex] >> bitOffset ) & ( ( 1u << numBitsInByte ) - 1 );
+			value |= bits << numBits;
+			numBits += numBitsInByte;
+			mNumBitsRead += numBitsInByte;
+		}
+		return uint32_t( value );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	float BitReader::ReadFloat()
+	{
+		const uint32_t bits = ReadBits( 32 );
+		float value;
+		std::memcpy( &value, &bits, sizeof( value ) );
+		return value;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	uint32_t BitReader::ReadVarUint()
+	{
+		uint32_t value = 0;
+		for( int shift = 0; shift < 35; shift += 7 )
+		{
+			const uint32_t byte = ReadBits( 8 );
+			value |= ( byte & 0x7F ) << shift;
+			if( ( byte & 0x80 ) == 0 ) { break; }
+		}
+		return value;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void BitReader::ReadBytes( void* _data, const size_t _size )
+	{
+		uint8_t* data = static_cast<uint8_t*>( _data );
+		for( size_t i = 0; i < _size; i++ )
+		{
+			data[i] = uint8_t( ReadBits( 8 ) );
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void BitReader::Align()
+	{
+		const int padding = ( 8 - ( mNumBitsRead & 7 ) ) & 7;
+		if( padding != 0 ) { ReadBits( padding ); }
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "network/fanUDPSocket.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// Writes values with an arbitrary number of bits in a fixed size buffer, never allocates
+	// bits are packed from the least significant bit of each byte
+	// writing past the capacity sets the overflow flag & drops the value
+	//========================================================================================================
+	class BitWriter
+	{
+	public:
+		static constexpr int sCapacity = int( UdpSocket::maxPacketSize );
+
+		BitWriter() { Clear(); }
+
+		void Clear();
+		void WriteBits( const uint32_t _value, const int _numBits );
+		void WriteBool( const bool _value ) { WriteBits( _value ? 1 : 0, 1 ); }
+		void WriteFloat( const float _value );
+		void WriteVarUint( uint32_t _value );
+		void WriteBytes( const void* _data, const size_t _size );
+		void Align();
+
+		const uint8_t* GetData() const		{ return mBuffer; }
+		int            GetNumBits() const	{ return mNumBits; }
+		int            GetNumBytes() const	{ return ( mNumBits + 7 ) / 8; }
+		bool           IsOverflow() const	{ return mOverflow; }
+
+	private:
+		uint8_t mBuffer[sCapacity];
+		int     mNumBits;
+		bool    mOverflow;
+	};
+
+	//========================================================================================================
+	// Reads the values written by a BitWriter from a buffer it does not own
+	// reading past the end sets the overflow flag & returns zeros
+	//========================================================================================================
+	class BitReader
+	{
+	public:
+		BitReader( const void* _data, const size_t _size );
+
+		uint32_t ReadBits( const int _numBits );
+		bool     ReadBool() { return ReadBits( 1 ) != 0; }
+		float    ReadFloat();
+		uint32_t ReadVarUint();
+		void     ReadBytes( void* _data, const size_t _size );
+		void     Align();
+
+		int  GetNumBitsRead() const		{ return mNumBitsRead; }
+		int  GetNumBitsLeft() const		{ return mNumBits - mNumBitsRead; }
+		bool IsOverflow() const			{ return mOverflow; }
+
+	private:
+		const uint8_t* mData;
+		int            mNumBits;
+		int            mNumBitsRead;
+		bool           mOverflow;
+	};
+}
@@ -0,0 +1,179 @@
+#include "network/fanLoopbackTransport.hpp"
+
+#include <algorithm>
+#include <functional>
+#include "core/fanAssert.hpp"
+#include "network/fanUDPSocket.hpp"
+#include "network/singletons/fanTime.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// the address is ignored, all the sockets of the network are on the local host
+	//========================================================================================================
+	LoopbackTransport::Status LoopbackTransport::Bind( const Port _port, const IpAddress& /*_address*/ )
+	{
+		return mNetwork.Bind( *this, _port ) ? Status::Done : Status::Error;
+	}
+
+	//========================================================================================================
+	// pending datagrams are lost
+	//========================================================================================================
+	void LoopbackTransport::Unbind()
+	{
+		mNetwork.Unbind( *this );
+		mQueue.clear();
+	}
+
+	//========================================================================================================
+	// returns NotReady when no datagram has arrived yet
+	//========================================================================================================
+	LoopbackTransport::Status LoopbackTransport::Receive( Packet& _packet,
+														  IpAddress& _remoteAddress,
+														  Port& _remotePort )
+	{
+		if( mQueue.empty() || mQueue.front().mDeliveryTime > mNetwork.Now() )
+		{
+			return Status::NotReady;
+		}
+
+		std::pop_heap( mQueue.begin(), mQueue.end(), std::greater<Datagram>() );
+		Datagram& datagram = mQueue.back();
+		_packet.Clear();
+		_packet.Append( datagram.mData.data(), datagram.mData.size() );
+		_packet >> _packet.mTag;
+		_remoteAddress = IpAddress::LocalHost;
+		_remotePort    = datagram.mSourcePort;
+		mNumBytesReceived += datagram.mData.size();
+		mNumReceived++;
+		mQueue.pop_back();
+		return Status::Done;
+	}
+
+	//========================================================================================================
+	// binds on an ephemeral port if needed ( like an os socket )
+	// datagrams sent to a port that is not bound are lost
+	//========================================================================================================
+	LoopbackTransport::Status LoopbackTransport::Send( Packet& _packet,
+													   const IpAddress& /*_remoteAddress*/,
+													   const Port _remotePort )
+	{
+		if( mPort == 0 && !mNetwork.Bind( *this, 0 ) )
+		{
+			return Status::Error;
+		}
+
+		const size_t size = _packet.GetSize();
+		mNetwork.Send( *this, _remotePort, _packet.ToSfml().getData(), size );
+		mNumBytesSent += size;
+		mNumSent++;
+		return Status::Done;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void LoopbackTransport::Push( Datagram& _datagram )
+	{
+		mQueue.push_back( std::move( _datagram ) );
+		std::push_heap( mQueue.begin(), mQueue.end(), std::greater<Datagram>() );
+	}
+
+	//========================================================================================================
+	// the socket takes ownership of its transport
+	//========================================================================================================
+	void LoopbackNetwork::OnCreateSocket( UdpSocket& _socket )
+	{
+		_socket.SetTransport( new LoopbackTransport( *this ) );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	double LoopbackNetwork::Now() const
+	{
+		return mUseRealTime ? Time::ElapsedSinceStartup() : mTime;
+	}
+
+	//========================================================================================================
+	// port 0 binds on the first free ephemeral port
+	//========================================================================================================
+	bool LoopbackNetwork::Bind( LoopbackTransport& _transport, const Port _port )
+	{
+		fanAssert( _transport.mPort == 0 );
+		Port port = _port;
+		if( port == 0 )
+		{
+			for( port = sFirstEphemeralPort; Find( port ) != nullptr; port++ )
+			{
+				if( port == std::numeric_limits<Port>::max() ) { return false; }
+			}
+		}
+		else if( Find( port ) != nullptr )
+		{
+			return false;
+		}
+
+		mTransports[port] = &_transport;
+		_transport.mPort  = port;
+		return true;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void LoopbackNetwork::Unbind( LoopbackTransport& _transport )
+	{
+		if( _transport.mPort != 0 )
+		{
+			mTransports.erase( _transport.mPort );
+			_transport.mPort = 0;
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	LoopbackTransport* LoopbackNetwork::Find( const Port _port )
+	{
+		auto it = mTransports.find( _port );
+		return it != mTransports.end() ? it->second : nullptr;
+	}
+
+	//========================================================================================================
+	// applies the network conditions & queues the datagram in the destination transport
+	//========================================================================================================
+	void LoopbackNetwork::Send( const LoopbackTransport& _source,
+								const Port _destination,
+								const void* _data,
+								const size_t _size )
+	{
+		if( Random( mConditions.mLossRate ) )
+		{
+			mNumDropped++;
+			return;
+		}
+		LoopbackTransport* destination = Find( _destination );
+		if( destination == nullptr ) { return; }
+
+		const int numCopies = Random( mConditions.mDuplicateRate ) ? 2 : 1;
+		if( numCopies == 2 ) { mNumDuplicated++; }
+		for( int i = 0; i < numCopies; i++ )
+		{
+			LoopbackTransport::Datagram datagram;
+			datagram.mDeliveryTime = Now() + mConditions.mLatency + mConditions.mJitter * mDistribution( mRandom );
+			if( Random( mConditions.mReorderRate ) )
+			{
+				datagram.mDeliveryTime += mConditions.mReorderDelay;
+				mNumReordered++;
+			}
+			datagram.mSequence   = mNextSequence++;
+			datagram.mSourcePort = _source.mPort;
+			datagram.mData.assign( static_cast<const uint8_t*>( _data ), static_cast<const uint8_t*>( _data ) + _size );
+			destination->Push( datagram );
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	bool LoopbackNetwork::Random( const float _probability )
+	{
+		return _probability > 0.f && mDistribution( mRandom ) < _probability;
+	}
+}
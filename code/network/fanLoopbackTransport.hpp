@@ -0,0 +1,108 @@
+#pragma once
+
+#include <map>
+#include <random>
+#include <vector>
+#include "network/fanTransport.hpp"
+
+namespace fan
+{
+	class UdpSocket;
+	class LoopbackNetwork;
+
+	//========================================================================================================
+	// Transport of a socket bound on a LoopbackNetwork
+	// received datagrams wait in a queue sorted by delivery time
+	//========================================================================================================
+	class LoopbackTransport : public ITransport
+	{
+	public:
+		LoopbackTransport( LoopbackNetwork& _network ) : mNetwork( _network ) {}
+		~LoopbackTransport() override { Unbind(); }
+
+		Status Bind( const Port _port, const IpAddress& _address ) override;
+		void   Unbind() override;
+		Port   GetPort() const override { return mPort; }
+		Status Receive( Packet& _packet, IpAddress& _remoteAddress, Port& _remotePort ) override;
+		Status Send( Packet& _packet, const IpAddress& _remoteAddress, const Port _remotePort ) override;
+
+		//================================================================
+		//================================================================
+		struct Datagram
+		{
+			double               mDeliveryTime;
+			uint64_t             mSequence;		// keeps the send order of datagrams delivered at the same time
+			Port                 mSourcePort;
+			std::vector<uint8_t> mData;
+
+			bool operator>( const Datagram& _other ) const
+			{
+				return mDeliveryTime != _other.mDeliveryTime ? mDeliveryTime > _other.mDeliveryTime
+															 : mSequence > _other.mSequence;
+			}
+		};
+
+		void Push( Datagram& _datagram );
+
+		Port                  mPort = 0;	// 0 when not bound
+		std::vector<Datagram> mQueue;		// min heap on the delivery time
+		uint64_t              mNumBytesSent     = 0;
+		uint64_t              mNumBytesReceived = 0;
+		int                   mNumSent          = 0;
+		int                   mNumReceived      = 0;
+
+	private:
+		LoopbackNetwork& mNetwork;
+	};
+
+	//========================================================================================================
+	// In-process network simulating the conditions of a real one ( latency, jitter, loss, duplication... )
+	// connect OnCreateSocket to UdpSocket::sOnCreate to make new sockets use the loopback
+	// the network must outlive its sockets & is not thread safe, the NetworkThread is not used with it
+	//========================================================================================================
+	class LoopbackNetwork
+	{
+	public:
+		//================================================================
+		//================================================================
+		struct Conditions
+		{
+			float mLatency       = 0.f;		// (seconds) one way delay
+			float mJitter        = 0.f;		// (seconds) random delay added to the latency
+			float mLossRate      = 0.f;		// [0-1] probability for a datagram to be dropped
+			float mDuplicateRate = 0.f;		// [0-1] probability for a datagram to be delivered twice
+			float mReorderRate   = 0.f;		// [0-1] probability for a datagram to be delivered late
+			float mReorderDelay  = 0.02f;	// (seconds) delay of the late datagrams
+		};
+
+		LoopbackNetwork( const uint32_t _seed = 42 ) : mRandom( _seed ) {}
+		LoopbackNetwork( LoopbackNetwork const& ) = delete;
+		LoopbackNetwork& operator=( LoopbackNetwork const& ) = delete;
+
+		void   OnCreateSocket( UdpSocket& _socket );
+		double Now() const;
+		void   SetTime( const double _time ) { mUseRealTime = false; mTime = _time; }
+
+		bool   Bind( LoopbackTransport& _transport, const Port _port );
+		void   Unbind( LoopbackTransport& _transport );
+		void   Send( const LoopbackTransport& _source, const Port _destination, const void* _data, const size_t _size );
+		LoopbackTransport* Find( const Port _port );
+
+		Conditions mConditions;
+		int        mNumDropped    = 0;
+		int        mNumDuplicated = 0;
+		int        mNumReordered  = 0;
+
+		static constexpr Port sFirstEphemeralPort = 49152;
+
+	private:
+		bool Random( const float _probability );
+
+		std::map< Port, LoopbackTransport* > mTransports;
+		std::mt19937                         mRandom;
+		std::uniform_real_distribution<float> mDistribution;
+		uint64_t                             mNextSequence = 0;
+		bool                                 mUseRealTime  = true;
+		double                               mTime         = 0.;	// used when the time is set manually
+	};
+}
@@ -0,0 +1,233 @@
+#include "network/fanNetworkThread.hpp"
+
+#include <cstring>
+#include "core/fanAssert.hpp"
+#include "network/singletons/fanTime.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
+namespace fan
+{
+#ifdef __linux__
+	const bool NetworkThread::sIsAvailable = true;
+#else
+	const bool NetworkThread::sIsAvailable = false;
+#endif
+
+	//========================================================================================================
+	//========================================================================================================
+	NetworkThread::NetworkThread() : mNumReceived( 0 ), mNumSent( 0 ), mNumDropped( 0 ), mExit( false ) {}
+
+	//========================================================================================================
+	// the socket must be bound & must not be used directly until Stop() is called
+	// sockets using a transport have no os handle, they are used directly on the calling thread
+	//========================================================================================================
+	void NetworkThread::Start( UdpSocket& _socket )
+	{
+		fanAssert( !IsRunning() );
+		mSocket = &_socket;
+		if( !sIsAvailable || _socket.HasTransport() ) { return; }
+
+		mExit = false;
+		mThread = std::thread( &NetworkThread::Run, this );
+	}
+
+	//========================================================================================================
+	// datagrams left in the rings are discarded
+	//========================================================================================================
+	void NetworkThread::Stop()
+	{
+		if( IsRunning() )
+		{
+			mExit = true;
+			mThread.join();
+			while( mReceived.Front() != nullptr ) { mReceived.Pop(); }
+			while( mToSend.Front() != nullptr ) { mToSend.Pop(); }
+		}
+		mSocket = nullptr;
+	}
+
+	//========================================================================================================
+	// returns NotReady when no datagram is left
+	//========================================================================================================
+	UdpSocket::Status NetworkThread::Receive( Packet& _packet,
+											  IpAddress& _address,
+											  Port& _port,
+											  double& _receiveTime )
+	{
+		fanAssert( mSocket != nullptr );
+		if( !IsRunning() )
+		{
+			_receiveTime = Time::ElapsedSinceStartup();
+			return mSocket->Receive( _packet, _address, _port );
+		}
+
+		for( Datagram* datagram = mReceived.Front(); datagram != nullptr; datagram = mReceived.Front() )
+		{
+			if( datagram->mSize == 0 )
+			{
+				mReceived.Pop();
+				continue;
+			}
+
+			_packet.Clear();
+			_packet.Append( datagram->mData, datagram->mSize );
+			_packet >> _packet.mTag;
+			_address     = IpAddress( datagram->mAddress );
+			_port        = datagram->mPort;
+			_receiveTime = datagram->mTime;
+			mReceived.Pop();
+			return UdpSocket::Status::Done;
+		}
+		return UdpSocket::Status::NotReady;
+	}
+
+	//========================================================================================================
+	// the datagram is copied, returns NotReady when the send ring is full
+	//========================================================================================================
+	UdpSocket::Status NetworkThread::Send( Packet& _packet, const IpAddress& _address, const Port _port )
+	{
+		fanAssert( mSocket != nullptr );
+		if( !IsRunning() )
+		{
+			return mSocket->Send( _packet, _address, _port );
+		}
+
+		const size_t size = _packet.GetSize();
+		fanAssert( size <= sMaxDatagramSize );
+		Datagram* datagram = mToSend.BeginPush();
+		if( datagram == nullptr || size > sMaxDatagramSize )
+		{
+			mNumDropped++;
+			return UdpSocket::Status::NotReady;
+		}
+
+		datagram->mAddress = _address.toInteger();
+		datagram->mPort    = _port;
+		datagram->mSize    = sf::Uint16( size );
+		std::memcpy( datagram->mData, _packet.ToSfml().getData(), size );
+		mToSend.EndPush();
+		return UdpSocket::Status::Done;
+	}
+
+#ifdef __linux__
+	//========================================================================================================
+	// waits for incoming datagrams at most sPollTimeoutMs, then flushes the send ring
+	//========================================================================================================
+	void NetworkThread::Run()
+	{
+		while( !mExit )
+		{
+			// stop polling when the receive ring is full, datagrams wait in the socket buffer
+			pollfd pollFd;
+			pollFd.fd      = mSocket->GetHandle();
+			pollFd.events  = mReceived.BeginPush() != nullptr ? POLLIN : 0;
+			pollFd.revents = 0;
+			if( poll( &pollFd, 1, sPollTimeoutMs ) > 0 && ( pollFd.revents & POLLIN ) )
+			{
+				ReceiveBatch();
+			}
+
+			while( SendBatch() == sBatchSize ) {}
+		}
+	}
+
+	//========================================================================================================
+	// receives directly in the free slots of the ring
+	//========================================================================================================
+	void NetworkThread::ReceiveBatch()
+	{
+		mmsghdr     messages[sBatchSize];
+		iovec       buffers[sBatchSize];
+		sockaddr_in addresses[sBatchSize];
+		int count = 0;
+		for( ; count < sBatchSize; count++ )
+		{
+			Datagram* datagram = mReceived.BeginPush( count );
+			if( datagram == nullptr ) { break; }
+
+			buffers[count].iov_base = datagram->mData;
+			buffers[count].iov_len  = sMaxDatagramSize;
+			std::memset( &messages[count], 0, sizeof( mmsghdr ) );
+			messages[count].msg_hdr.msg_name    = &addresses[count];
+			messages[count].msg_hdr.msg_namelen = sizeof( sockaddr_in );
+			messages[count].msg_hdr.msg_iov     = &buffers[count];
+			messages[count].msg_hdr.msg_iovlen  = 1;
+		}
+		if( count == 0 ) { return; }
+
+		const int numReceived = recvmmsg( mSocket->GetHandle(), messages, count, MSG_DONTWAIT, nullptr );
+		if( numReceived <= 0 ) { return; }
+
+		const double time = Time::ElapsedSinceStartup();
+		for( int i = 0; i < numReceived; i++ )
+		{
+			const bool isTruncated = ( messages[i].msg_hdr.msg_flags & MSG_TRUNC ) != 0;
+			Datagram& datagram = *mReceived.BeginPush( i );
+			datagram.mAddress = ntohl( addresses[i].sin_addr.s_addr );
+			datagram.mPort    = ntohs( addresses[i].sin_port );
+			datagram.mSize    = isTruncated ? 0 : sf::Uint16( messages[i].msg_len );
+			datagram.mTime    = time;
+			if( isTruncated ) { mNumDropped++; }
+		}
+		mReceived.EndPush( numReceived );
+		mNumReceived += numReceived;
+	}
+
+	//========================================================================================================
+	// sends directly from the ring, returns the number of datagrams removed from the ring
+	// datagrams are kept in the ring when the socket buffer is full
+	//========================================================================================================
+	int NetworkThread::SendBatch()
+	{
+		mmsghdr     messages[sBatchSize];
+		iovec       buffers[sBatchSize];
+		sockaddr_in addresses[sBatchSize];
+		int count = 0;
+		for( ; count < sBatchSize; count++ )
+		{
+			Datagram* datagram = mToSend.Front( count );
+			if( datagram == nullptr ) { break; }
+
+			std::memset( &addresses[count], 0, sizeof( sockaddr_in ) );
+			addresses[count].sin_family      = AF_INET;
+			addresses[count].sin_addr.s_addr = htonl( datagram->mAddress );
+			addresses[count].sin_port        = htons( datagram->mPort );
+			buffers[count].iov_base = datagram->mData;
+			buffers[count].iov_len  = datagram->mSize;
+			std::memset( &messages[count], 0, sizeof( mmsghdr ) );
+			messages[count].msg_hdr.msg_name    = &addresses[count];
+			messages[count].msg_hdr.msg_namelen = sizeof( sockaddr_in );
+			messages[count].msg_hdr.msg_iov     = &buffers[count];
+			messages[count].msg_hdr.msg_iovlen  = 1;
+		}
+		if( count == 0 ) { return 0; }
+
+		int numSent = sendmmsg( mSocket->GetHandle(), messages, count, MSG_DONTWAIT );
+		if( numSent < 0 )
+		{
+			if( errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ) { return 0; }
+
+			// the first datagram cannot be sent ( unreachable host... ), drop it
+			mNumDropped++;
+			mToSend.Pop();
+			return 1;
+		}
+		mToSend.Pop( numSent );
+		mNumSent += numSent;
+		return numSent;
+	}
+#else
+	//========================================================================================================
+	// the thread is never started without batched system calls
+	//========================================================================================================
+	void NetworkThread::Run() {}
+	void NetworkThread::ReceiveBatch() {}
+	int  NetworkThread::SendBatch() { return 0; }
+#endif
+}
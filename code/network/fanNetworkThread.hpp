@@ -0,0 +1,61 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include "core/fanSpscRing.hpp"
+#include "network/fanUDPSocket.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// Owns the io of a bound UdpSocket on a dedicated thread
+	// received datagrams are timestamped & handed to the logic thread through a lock-free ring,
+	// outgoing datagrams go through another ring & are sent in batches
+	// uses recvmmsg/sendmmsg when they are available ( linux ), otherwise the thread is not started
+	// and Receive/Send use the socket directly on the calling thread ( also when the socket uses a transport )
+	//========================================================================================================
+	class NetworkThread
+	{
+	public:
+		static constexpr size_t sMaxDatagramSize = 1472;	// ethernet mtu minus the ip & udp headers
+		static constexpr int    sBatchSize       = 32;		// max datagrams per system call
+		static constexpr int    sPollTimeoutMs   = 1;		// max delay before sending a datagram
+		static const bool       sIsAvailable;
+
+		struct Datagram
+		{
+			sf::Uint32 mAddress;
+			Port       mPort;
+			sf::Uint16 mSize;	// zero if the datagram was truncated
+			double     mTime;	// reception time
+			uint8_t    mData[sMaxDatagramSize];
+		};
+		using Ring = SpscRing< Datagram, 256 >;
+
+		NetworkThread();
+		~NetworkThread() { Stop(); }
+		NetworkThread( NetworkThread const& ) = delete;
+		NetworkThread& operator=( NetworkThread const& ) = delete;
+
+		void Start( UdpSocket& _socket );
+		void Stop();
+		bool IsRunning() const { return mThread.joinable(); }
+		UdpSocket::Status Receive( Packet& _packet, IpAddress& _address, Port& _port, double& _receiveTime );
+		UdpSocket::Status Send( Packet& _packet, const IpAddress& _address, const Port _port );
+
+		std::atomic<int> mNumReceived;
+		std::atomic<int> mNumSent;
+		std::atomic<int> mNumDropped;	// send ring was full, datagram was truncated or could not be sent
+
+	private:
+		void Run();
+		void ReceiveBatch();
+		int  SendBatch();
+
+		UdpSocket*        mSocket = nullptr;
+		std::thread       mThread;
+		std::atomic<bool> mExit;
+		Ring              mReceived;	// network thread -> logic thread
+		Ring              mToSend;		// logic thread -> network thread
+	};
+}
@@ -1,5 +1,8 @@
 #include "network/fanPacket.hpp"
 
+#include <algorithm>
+#include "network/fanQuantization.hpp"
+
 namespace fan
 {
 	//========================================================================================================
@@ -19,6 +22,30 @@ namespace fan
 		return PacketType( intType );
 	}
 
+	//========================================================================================================
+	//========================================================================================================
+	void Packet::WriteType( const PacketType _type )
+	{
+		fanAssert( _type != PacketType::COUNT );
+		if( mLastMessageType != PacketType::COUNT )
+		{
+			mMessagesSize[int( mLastMessageType )] += sf::Uint16( GetSize() - mLastMessageBegin );
+		}
+		mLastMessageType  = _type;
+		mLastMessageBegin = GetSize();
+		mMessagesCount[int( _type )]++;
+		mPacket << PacketTypeInt( _type );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	size_t Packet::GetMessagesSize( const PacketType _type ) const
+	{
+		size_t size = mMessagesSize[int( _type )];
+		if( _type == mLastMessageType ) { size += GetSize() - mLastMessageBegin; }
+		return size;
+	}
+
 	//========================================================================================================
 	//========================================================================================================
 	void Packet::Clear()
@@ -28,6 +55,22 @@ namespace fan
         mOnlyContainsAck = false;
 		mOnFail.Clear();
 		mOnSuccess.Clear();
+		std::fill( std::begin( mMessagesSize ), std::end( mMessagesSize ), sf::Uint16( 0 ) );
+		std::fill( std::begin( mMessagesCount ), std::end( mMessagesCount ), sf::Uint16( 0 ) );
+		mLastMessageType  = PacketType::COUNT;
+		mLastMessageBegin = 0;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void PacketCallbacks::Emmit( EcsWorld& _world, const PacketTag _tag ) const
+	{
+		for( int i = 0; i < mCount; i++ )
+		{
+			const Callback& callback = mCallbacks[i];
+			EcsComponent& component = _world.GetComponent( _world.GetEntity( callback.mHandle ), callback.mType );
+			( component.*( callback.mMethod ) )( _tag );
+		}
 	}
 
 	//========================================================================================================
@@ -63,16 +106,221 @@ namespace fan
         fanAssert( mPacketData.getDataSize() < std::numeric_limits<sf::Uint8>::max() );
         fanAssert( mReplicationType != ReplicationType::Count );
  
- 		_packet << PacketTypeInt( PacketType::Replication );
+ 		_packet.WriteType( PacketType::Replication );
  		_packet << sf::Uint8( mReplicationType );
  		_packet << sf::Uint8( mPacketData.getDataSize() );
- 		
-		sf::Packet packetCpy = mPacketData;
-		for( int i = 0; i < (int)mPacketData.getDataSize(); i++ )
+		_packet.Append( mPacketData.getData(), mPacketData.getDataSize() );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	ReplicationPayload::ReplicationPayload( const PacketReplication& _packet )
+	{
+		mReplicationType = _packet.mReplicationType;
+		const uint8_t* data = static_cast<const uint8_t*>( _packet.mPacketData.getData() );
+		mData.assign( data, data + _packet.mPacketData.getDataSize() );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+    ReplicationPayload::ReplicationPayload( const PacketReplication::ReplicationType _type,
+                                            const void* _data,
+                                            const size_t _size )
+	{
+		mReplicationType = _type;
+		const uint8_t* data = static_cast<const uint8_t*>( _data );
+		mData.assign( data, data + _size );
+	}
+
+	//========================================================================================================
+	// same layout as PacketReplication::Write, read on the client with PacketReplication::Read
+	//========================================================================================================
+	void ReplicationPayload::Write( Packet& _packet ) const
+	{
+        fanAssert( mData.size() < std::numeric_limits<sf::Uint8>::max() );
+        fanAssert( mReplicationType != PacketReplication::ReplicationType::Count );
+
+		_packet.WriteType( PacketType::Replication );
+		_packet << sf::Uint8( mReplicationType );
+		_packet << sf::Uint8( mData.size() );
+		_packet.Append( mData.data(), mData.size() );
+	}
+
+	// input stream encoding
+	static constexpr QuantizedDirection sNetOrientation = { 12 };	// ~0.09 degrees precision
+	static constexpr int sNumInputsBits  = 7;	// PacketInput::sMaxInputs included
+	static constexpr int sNumKeyBits     = 6;
+	static constexpr int sRunLengthBits  = 6;	// runs of 1 to PacketInput::sMaxInputs inputs
+	static constexpr int sSmallDeltaBits = 6;	// orientation deltas in [-32, 32[
+	static constexpr int sSmallDeltaMax  = 1 << ( sSmallDeltaBits - 1 );
+	static_assert( PacketInput::sMaxInputs < ( 1 << sNumInputsBits ) );
+	static_assert( PacketInput::sMaxInputs <= ( 1 << sRunLengthBits ) );
+
+	//========================================================================================================
+	//========================================================================================================
+	sf::Uint8 PacketInput::InputData::GetKeyBits() const
+	{
+		return sf::Uint8( mLeft		<< 0 |
+						  mRight	<< 1 |
+						  mForward	<< 2 |
+						  mBackward	<< 3 |
+						  mBoost	<< 4 |
+						  mFire		<< 5 );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void PacketInput::InputData::SetKeyBits( const sf::Uint8 _keyBits )
+	{
+		mLeft     = _keyBits & ( 1 << 0 );
+		mRight    = _keyBits & ( 1 << 1 );
+		mForward  = _keyBits & ( 1 << 2 );
+		mBackward = _keyBits & ( 1 << 3 );
+		mBoost    = _keyBits & ( 1 << 4 );
+		mFire     = _keyBits & ( 1 << 5 );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	sf::Uint16 PacketInput::QuantizeOrientation( const btVector3& _orientation )
+	{
+		return sf::Uint16( sNetOrientation.Quantize( _orientation ) );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	btVector3 PacketInput::DequantizeOrientation( const sf::Uint16 _orientation )
+	{
+		return sNetOrientation.Dequantize( _orientation );
+	}
+
+	//========================================================================================================
+	// a bit set if the orientation changed, then a bit set for a small delta or the full orientation
+	//========================================================================================================
+	static void WriteOrientation( BitWriter& _writer, const sf::Uint16 _previous, const sf::Uint16 _orientation )
+	{
+		const int delta = sNetOrientation.Delta( _previous, _orientation );
+		_writer.WriteBool( delta != 0 );
+		if( delta == 0 ) { return; }
+
+		const bool isSmall = delta >= -sSmallDeltaMax && delta < sSmallDeltaMax;
+		_writer.WriteBool( isSmall );
+		if( isSmall )
 		{
-			sf::Uint8 data;
-			packetCpy >> data;
-			_packet << data;
+			_writer.WriteBits( uint32_t( delta + sSmallDeltaMax ), sSmallDeltaBits );
+		}
+		else
+		{
+			_writer.WriteBits( _orientation, sNetOrientation.mNumBits );
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	static sf::Uint16 ReadOrientation( BitReader& _reader, const sf::Uint16 _previous )
+	{
+		if( !_reader.ReadBool() ) { return _previous; }
+		if( _reader.ReadBool() )
+		{
+			const int delta = int( _reader.ReadBits( sSmallDeltaBits ) ) - sSmallDeltaMax;
+			return sf::Uint16( ( _previous + delta ) & ( sNetOrientation.GetNumSteps() - 1 ) );
+		}
+		return sf::Uint16( _reader.ReadBits( sNetOrientation.mNumBits ) );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void PacketInput::Write( Packet& _packet ) const
+	{
+		fanAssert( mNumInputs >= 0 && mNumInputs <= sMaxInputs );
+
+		BitWriter writer;
+		writer.WriteBits( uint32_t( mNumInputs ), sNumInputsBits );
+		if( mNumInputs > 0 )
+		{
+			writer.WriteBits( mInputs[0].mFrameIndex, 32 );
+			writer.WriteBits( mInputs[0].mOrientation, sNetOrientation.mNumBits );
+			for( int i = 1; i < mNumInputs; i++ )
+			{
+				const InputData& previous = mInputs[i - 1];
+				const InputData& input    = mInputs[i];
+				const bool isNextFrame = input.mFrameIndex == previous.mFrameIndex + 1;
+				writer.WriteBool( isNextFrame );
+				if( !isNextFrame ) { writer.WriteBits( input.mFrameIndex, 32 ); }
+				WriteOrientation( writer, previous.mOrientation, input.mOrientation );
+			}
+
+			// key bits runs : key bits & run length
+			int runStart = 0;
+			for( int i = 1; i <= mNumInputs; i++ )
+			{
+				if( i == mNumInputs || mInputs[i].GetKeyBits() != mInputs[runStart].GetKeyBits() )
+				{
+					writer.WriteBits( mInputs[runStart].GetKeyBits(), sNumKeyBits );
+					writer.WriteBits( uint32_t( i - runStart - 1 ), sRunLengthBits );
+					runStart = i;
+				}
+			}
+		}
+        fanAssert( !writer.IsOverflow() );
+        fanAssert( writer.GetNumBytes() <= std::numeric_limits<sf::Uint8>::max() );
+
+		_packet.WriteType( PacketType::PlayerInput );
+		_packet << sf::Uint8( writer.GetNumBytes() );
+		_packet.Append( writer.GetData(), writer.GetNumBytes() );
+	}
+
+	//========================================================================================================
+	// decodes in place without allocation, a malformed stream results in no input
+	//========================================================================================================
+	void PacketInput::Read( Packet& _packet )
+	{
+		sf::Uint8 dataSize = 0;
+		_packet >> dataSize;
+		uint8_t data[std::numeric_limits<sf::Uint8>::max()];
+		for( int i = 0; i < dataSize && _packet.IsValid(); i++ )
+		{
+			_packet >> data[i];
+		}
+		if( !_packet.IsValid() )
+		{
+			mNumInputs = 0;
+			return;
+		}
+
+		BitReader reader( data, dataSize );
+		mNumInputs = int( reader.ReadBits( sNumInputsBits ) );
+		if( mNumInputs > sMaxInputs )
+		{
+			mNumInputs = 0;
+			return;
+		}
+		if( mNumInputs == 0 ) { return; }
+
+		mInputs[0].mFrameIndex  = reader.ReadBits( 32 );
+		mInputs[0].mOrientation = sf::Uint16( reader.ReadBits( sNetOrientation.mNumBits ) );
+		for( int i = 1; i < mNumInputs; i++ )
+		{
+			const InputData& previous = mInputs[i - 1];
+			InputData& input = mInputs[i];
+			input.mFrameIndex  = reader.ReadBool() ? previous.mFrameIndex + 1 : reader.ReadBits( 32 );
+			input.mOrientation = ReadOrientation( reader, previous.mOrientation );
+		}
+
+		int inputIndex = 0;
+		while( inputIndex < mNumInputs && !reader.IsOverflow() )
+		{
+			const sf::Uint8 keyBits = sf::Uint8( reader.ReadBits( sNumKeyBits ) );
+			const int runLength = int( reader.ReadBits( sRunLengthBits ) ) + 1;
+			for( int i = 0; i < runLength && inputIndex < mNumInputs; i++ )
+			{
+				mInputs[inputIndex++].SetKeyBits( keyBits );
+			}
+		}
+
+		if( reader.IsOverflow() )
+		{
+			mNumInputs = 0;
 		}
 	}
-}
\ No newline at end of file
+}
@@ -2,6 +2,8 @@
 
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <vector>
 #include <type_traits>
 #include "bullet/LinearMath/btVector3.h"
 #include "core/ecs/fanSignal.hpp"
@@ -12,6 +14,39 @@ namespace fan
 {
 	struct Client;
 
+	//========================================================================================================
+	// Component methods called when a packet is received or dropped
+	// stored inline without allocation, the component is found from its handle & type when emitted
+	//========================================================================================================
+	struct PacketCallbacks
+	{
+		static constexpr int sMaxCallbacks = 4;
+		using Method = void ( EcsComponent::* )( const PacketTag );
+
+		struct Callback
+		{
+			Method    mMethod;
+			EcsHandle mHandle;
+			uint32_t  mType;
+		};
+
+		template< typename _ComponentType >
+		void Connect( void ( _ComponentType::* _method )( const PacketTag ), const EcsHandle _handle )
+		{
+			static_assert( std::is_base_of<EcsComponent, _ComponentType>::value );
+			fanAssert( _handle != 0 );
+			fanAssert( mCount < sMaxCallbacks );
+			mCallbacks[mCount++] = { static_cast<Method>( _method ), _handle, _ComponentType::Info::sType };
+		}
+		void Emmit( EcsWorld& _world, const PacketTag _tag ) const;
+		void Clear() { mCount = 0; }
+		int  Count() const { return mCount; }
+
+	private:
+		Callback mCallbacks[sMaxCallbacks];
+		int      mCount = 0;
+	};
+
 	//========================================================================================================
 	//========================================================================================================
 	struct Packet
@@ -34,44 +69,61 @@ namespace fan
 		}
 
 		bool		EndOfPacket() const { return mPacket.endOfPacket(); }
+		bool		IsValid() const { return mPacket ? true : false; }	// false once a read went past the end
+		void		Append( const void* _data, const size_t _size ) { mPacket.append( _data, _size ); }
 		sf::Packet& ToSfml() { return mPacket; }
 		void		Clear();
 		PacketType  ReadType();
+		void        WriteType( const PacketType _type );
 		size_t		GetSize() const{ return mPacket.getDataSize(); }
+		size_t      GetMessagesSize( const PacketType _type ) const;
+		int         GetMessagesCount( const PacketType _type ) const { return mMessagesCount[int( _type )]; }
 
-		PacketTag           mTag;
-		Signal< PacketTag > mOnFail;		// packet was dropped
-		Signal< PacketTag > mOnSuccess;	// packet was received
-		bool                mOnlyContainsAck = false;
+		PacketTag       mTag;
+		PacketCallbacks mOnFail;		// packet was dropped
+		PacketCallbacks mOnSuccess;		// packet was received
+		bool            mOnlyContainsAck = false;
 	private:
 		sf::Packet mPacket;
+
+		// bytes & number of the messages of each type written, see NetStats
+		// a message ends where the next one begins, the last one ends with the packet
+		sf::Uint16 mMessagesSize[int( PacketType::COUNT )]  = {};
+		sf::Uint16 mMessagesCount[int( PacketType::COUNT )] = {};
+		PacketType mLastMessageType                         = PacketType::COUNT;
+		size_t     mLastMessageBegin                        = 0;
 	};
 
 	//========================================================================================================
+	// Acknowledges the latest received packet & the sAckBits packets before it
+	// bit i of mAckBits is set if the packet mLatestTag - 1 - i was received
 	//========================================================================================================
 	struct PacketAck
 	{
-		void Write( Packet& _packet )
+		using AckBits = sf::Uint32;
+		static constexpr int sAckBits = 8 * sizeof( AckBits );
+		static constexpr size_t sSize = sizeof( PacketTypeInt ) + sizeof( PacketTag ) + sizeof( AckBits );
+
+		void Write( Packet& _packet ) const
 		{
-			_packet << PacketTypeInt( PacketType::Ack );
-			_packet << sf::Uint16( mTags.size() );
-			for( PacketTag tag : mTags )
-			{
-				_packet << tag;
-			}
+			_packet.WriteType( PacketType::Ack );
+			_packet << mLatestTag;
+			_packet << mAckBits;
 		}
 		void Read( Packet& _packet )
 		{
-			sf::Uint16 size;
-			_packet >> size;
-			mTags.resize( size );
-			for( int i = 0; i < size; i++ )
-			{
-				_packet >> mTags[i];
-			}
+			_packet >> mLatestTag;
+			_packet >> mAckBits;
+		}
+		bool IsAcked( const PacketTag _tag ) const
+		{
+			if( _tag == mLatestTag ) { return true; }
+			if( _tag > mLatestTag || mLatestTag - _tag > PacketTag( sAckBits ) ) { return false; }
+			return ( mAckBits & ( AckBits( 1 ) << ( mLatestTag - _tag - 1 ) ) ) != 0;
 		}
 
-		std::vector<PacketTag> mTags;
+		PacketTag mLatestTag = 0;
+		AckBits   mAckBits   = 0;
 	};
 
 	//========================================================================================================
@@ -89,7 +141,7 @@ namespace fan
 
 		void Write( Packet& _packet ) const
 		{ 
-			_packet << PacketTypeInt( PacketType::Ping );
+			_packet.WriteType( PacketType::Ping );
 			_packet << mServerFrame;
 			_packet << mClientFrame;
 			_packet << mPreviousRtt;
@@ -109,7 +161,7 @@ namespace fan
 	{
 		void Write( Packet& _packet ) const
 		{
-			_packet << PacketTypeInt( PacketType::Hello );
+			_packet.WriteType( PacketType::Hello );
 			_packet << mName;
 		}
 		void Read( Packet& _packet )
@@ -128,7 +180,7 @@ namespace fan
 	{
 		void Write( Packet& _packet ) const
 		{
-			_packet << PacketTypeInt( PacketType::Disconnect );
+			_packet.WriteType( PacketType::Disconnect );
 		}
 		void Read( Packet& /*_packet*/ ){}
 	};	
@@ -141,7 +193,7 @@ namespace fan
 	{
 		void Write( Packet& _packet ) const
 		{
-			_packet << PacketTypeInt( PacketType::LoggedIn );
+			_packet.WriteType( PacketType::LoggedIn );
 			_packet << mPlayerId;
 		}
 		void Read( Packet& _packet )
@@ -174,9 +226,41 @@ namespace fan
 	};
 
 	//========================================================================================================
+	// server side replication data, serialized once & shared between all the hosts it is replicated on
+	// immutable once built, the packets being sent & the hosts baselines only hold references to it
+	//========================================================================================================
+	struct ReplicationPayload
+	{
+		// location of a component data in an entity payload
+		struct ComponentRange
+		{
+			uint32_t mType;
+			uint32_t mBegin;
+			uint32_t mEnd;
+			uint8_t  mNetIndex;	// see LinkingContext::GetNetComponentIndex
+		};
+
+		ReplicationPayload( const PacketReplication& _packet );
+        ReplicationPayload( const PacketReplication::ReplicationType _type, const void* _data, const size_t _size );
+		void   Write( Packet& _packet ) const;
+		size_t GetWriteSize() const { return sizeof( PacketTypeInt ) + 2 * sizeof( sf::Uint8 ) + mData.size(); }
+
+		PacketReplication::ReplicationType mReplicationType;
+		std::vector<uint8_t>               mData;
+		std::vector<ComponentRange>        mComponents;	// entity payloads only
+	};
+	using ReplicationPayloadPtr = std::shared_ptr< const ReplicationPayload >;
+
+	//========================================================================================================
+	// the last inputs of the player, sent every frame for redundancy
+	// layout ( bit stream ) : inputs count, frame index of the first input, then for each input:
+	// a bit set if its frame follows the previous one ( otherwise the full frame index ),
+	// its orientation as a delta with the previous one & the run-length encoded key bits of all inputs
 	//========================================================================================================
 	struct PacketInput
 	{
+		static constexpr int sMaxInputs = 64;
+
 		struct InputData
 		{
 			bool         mLeft : 1;
@@ -185,56 +269,22 @@ namespace fan
 			bool         mBackward : 1;
 			bool         mBoost : 1;
 			bool         mFire : 1;
-			sf::Vector2f mOrientation;
+			sf::Uint16   mOrientation;	// quantized angle, see QuantizeOrientation
 			FrameIndex   mFrameIndex;
+
+			sf::Uint8 GetKeyBits() const;
+			void      SetKeyBits( const sf::Uint8 _keyBits );
 		}; 
 
-		std::vector<InputData> mInputs;
+		InputData mInputs[sMaxInputs];	// from the oldest to the most recent
+		int       mNumInputs = 0;
 
-		void Read( Packet& _packet )
-		{
-			sf::Uint8 size;
-			_packet >> size;
-
-			mInputs.resize( size );
-			for( int i = 0; i < size; i++ )
-			{
-				InputData& inputData = mInputs[i];
-				_packet >> inputData.mFrameIndex;
-				_packet >> inputData.mOrientation.x >> inputData.mOrientation.y;
-				sf::Uint8 keyBits;
-				_packet >> keyBits;
-
-				inputData.mLeft     = keyBits & (1<<0);
-				inputData.mRight    = keyBits & (1<<1);
-				inputData.mForward  = keyBits & (1<<2);
-				inputData.mBackward = keyBits & (1<<3);
-				inputData.mBoost    = keyBits & (1<<4);
-				inputData.mFire     = keyBits & (1<<5);
-			}
-		}
+		void Read( Packet& _packet );
+		void Write( Packet& _packet ) const;
 
-		void Write( Packet& _packet ) const
-		{
-			_packet << PacketTypeInt( PacketType::PlayerInput );
-			_packet << sf::Uint8( mInputs.size());
-
-			for( int i = 0; i < (int)mInputs.size(); i++ )
-			{
-				const InputData& inputData = mInputs[i];
-				const sf::Uint8 keyBits =
-                                        inputData.mLeft		<< 0 |
-                                        inputData.mRight		<< 1 |
-                                        inputData.mForward	<< 2 |
-                                        inputData.mBackward	<< 3 |
-                                        inputData.mBoost		<< 4 |
-                                        inputData.mFire		<< 5;
-
-				_packet << inputData.mFrameIndex;
-				_packet << inputData.mOrientation.x << inputData.mOrientation.y;
-				_packet << keyBits;
-			}
-		}
+		// the client uses the dequantized orientation to simulate exactly like the server
+		static sf::Uint16 QuantizeOrientation( const btVector3& _orientation );
+		static btVector3  DequantizeOrientation( const sf::Uint16 _orientation );
 	};
 
 	//========================================================================================================
@@ -252,7 +302,7 @@ namespace fan
 
 		void Write( Packet& _packet ) const
 		{
-			_packet << PacketTypeInt( PacketType::PlayerGameState );
+			_packet.WriteType( PacketType::PlayerGameState );
 			_packet << mFrameIndex;
 			_packet << mPosition[0]			<< mPosition[1]			<< mPosition[2];
 			_packet << mOrientation[0]		<< mOrientation[1]		<< mOrientation[2];
@@ -0,0 +1,98 @@
+#include "network/fanQuantization.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include "core/fanAssert.hpp"
+
+namespace fan
+{
+	// the three smallest components of a unit quaternion are in [-1/sqrt(2), 1/sqrt(2)]
+	static constexpr float sSmallestThreeBound = float( SIMDSQRT12 );
+
+	//========================================================================================================
+	//========================================================================================================
+	uint32_t QuantizedFloat::Quantize( const float _value ) const
+	{
+		fanAssert( mNumBits > 1 && mNumBits <= 24 );
+		fanAssert( mMax > mMin );
+		const float normalized = ( std::clamp( _value, mMin, mMax ) - mMin ) / ( mMax - mMin );
+		return uint32_t( normalized * float( GetNumSteps() ) + 0.5f );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	float QuantizedFloat::Dequantize( const uint32_t _value ) const
+	{
+		const uint32_t value = std::min( _value, GetNumSteps() );
+		return mMin + float( value ) * ( mMax - mMin ) / float( GetNumSteps() );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	uint32_t QuantizedDirection::Quantize( const btVector3& _direction ) const
+	{
+		fanAssert( mNumBits > 1 && mNumBits <= 24 );
+		const float angle = std::atan2( float( _direction.z() ), float( _direction.x() ) ); // [-pi, pi]
+		const float steps = float( GetNumSteps() ) * angle / float( SIMD_2_PI );
+		return uint32_t( int32_t( std::lround( steps ) ) ) & ( GetNumSteps() - 1 );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	btVector3 QuantizedDirection::Dequantize( const uint32_t _value ) const
+	{
+		const float angle = float( SIMD_2_PI ) * float( _value & ( GetNumSteps() - 1 ) ) / float( GetNumSteps() );
+		return btVector3( std::cos( angle ), 0.f, std::sin( angle ) );
+	}
+
+	//========================================================================================================
+	// result in [-steps/2, steps/2[
+	//========================================================================================================
+	int QuantizedDirection::Delta( const uint32_t _from, const uint32_t _to ) const
+	{
+		const uint32_t mask  = GetNumSteps() - 1;
+		const uint32_t delta = ( _to - _from ) & mask;
+		return delta < GetNumSteps() / 2 ? int( delta ) : int( delta ) - int( GetNumSteps() );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void QuantizedQuaternion::Write( BitWriter& _writer, const btQuaternion& _quaternion ) const
+	{
+		const btQuaternion quaternion = _quaternion.normalized();
+
+		int largestIndex = 0;
+		for( int i = 1; i < 4; i++ )
+		{
+			if( std::abs( quaternion[i] ) > std::abs( quaternion[largestIndex] ) ) { largestIndex = i; }
+		}
+		const float sign = quaternion[largestIndex] < 0.f ? -1.f : 1.f;
+
+		const QuantizedFloat component = { -sSmallestThreeBound, sSmallestThreeBound, mNumBits };
+		_writer.WriteBits( uint32_t( largestIndex ), 2 );
+		for( int i = 0; i < 4; i++ )
+		{
+			if( i != largestIndex ) { component.Write( _writer, sign * quaternion[i] ); }
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	btQuaternion QuantizedQuaternion::Read( BitReader& _reader ) const
+	{
+		const QuantizedFloat component = { -sSmallestThreeBound, sSmallestThreeBound, mNumBits };
+		const int largestIndex = int( _reader.ReadBits( 2 ) );
+
+		float values[4];
+		float sqrLength = 0.f;
+		for( int i = 0; i < 4; i++ )
+		{
+			if( i == largestIndex ) { continue; }
+			values[i] = component.Read( _reader );
+			sqrLength += values[i] * values[i];
+		}
+		values[largestIndex] = std::sqrt( std::max( 0.f, 1.f - sqrLength ) );
+
+		return btQuaternion( values[0], values[1], values[2], values[3] ).normalized();
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include "bullet/LinearMath/btQuaternion.h"
+#include "network/fanBitStream.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// Float bounded in [mMin, mMax] sent on mNumBits bits, values out of the range are clamped
+	// the range is split in an even number of steps so the middle of a symmetric range ( zero ) is exact
+	// ex: static constexpr QuantizedFloat sNetPosition = { -1024.f, 1024.f, 18 };
+	//========================================================================================================
+	struct QuantizedFloat
+	{
+		float mMin;
+		float mMax;
+		int   mNumBits;
+
+		uint32_t Quantize( const float _value ) const;
+		float    Dequantize( const uint32_t _value ) const;
+		float    GetPrecision() const { return ( mMax - mMin ) / float( GetNumSteps() ); }
+		uint32_t GetNumSteps() const  { return ( 1u << mNumBits ) - 2; }
+
+		void  Write( BitWriter& _writer, const float _value ) const { _writer.WriteBits( Quantize( _value ), mNumBits ); }
+		float Read( BitReader& _reader ) const                      { return Dequantize( _reader.ReadBits( mNumBits ) ); }
+	};
+
+	//========================================================================================================
+	// Direction in the xz plane sent as an angle on mNumBits bits, the angle wraps around the circle
+	// Delta returns the shortest signed difference between two quantized angles ( delta coding )
+	// the dequantized direction is a unit vector, a null direction is sent as the x axis
+	//========================================================================================================
+	struct QuantizedDirection
+	{
+		int mNumBits;
+
+		uint32_t  Quantize( const btVector3& _direction ) const;
+		btVector3 Dequantize( const uint32_t _value ) const;
+		int       Delta( const uint32_t _from, const uint32_t _to ) const;
+		uint32_t  GetNumSteps() const { return 1u << mNumBits; }
+	};
+
+	//========================================================================================================
+	// Unit quaternion sent with the smallest three method :
+	// the index of the largest component on 2 bits & the three others on mNumBits bits each
+	// the largest component is rebuilt from the unit length, its sign is lost as q & -q are the same rotation
+	//========================================================================================================
+	struct QuantizedQuaternion
+	{
+		int mNumBits;
+
+		void         Write( BitWriter& _writer, const btQuaternion& _quaternion ) const;
+		btQuaternion Read( BitReader& _reader ) const;
+	};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "network/fanPacket.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// Replaces the os socket of a UdpSocket
+	// allows running clients & server in the same process without real network ( tests & benchmarks )
+	//========================================================================================================
+	class ITransport
+	{
+	public:
+		using Status = sf::Socket::Status;
+
+		virtual ~ITransport() = default;
+
+		virtual Status Bind( const Port _port, const IpAddress& _address ) = 0;
+		virtual void   Unbind() = 0;
+		virtual Port   GetPort() const = 0;
+		virtual Status Receive( Packet& _packet, IpAddress& _remoteAddress, Port& _remotePort ) = 0;
+		virtual Status Send( Packet& _packet, const IpAddress& _remoteAddress, const Port _remotePort ) = 0;
+	};
+}
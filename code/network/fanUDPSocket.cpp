@@ -2,11 +2,14 @@
 
 namespace fan
 {
+	Signal< UdpSocket& > UdpSocket::sOnCreate;
+
 	//========================================================================================================
 	//========================================================================================================
 	UdpSocket::UdpSocket()
 	{
 		mSocket.setBlocking( false );
+		sOnCreate.Emmit( *this );
 	}
 
 
@@ -14,15 +17,36 @@ namespace fan
     //========================================================================================================
     UdpSocket::Status	UdpSocket::Bind( unsigned short _port, const IpAddress& _address )
     {
+	    if( mTransport != nullptr ) { return mTransport->Bind( _port, _address ); }
 	    return mSocket.bind( _port, _address );
     }
 
+    //========================================================================================================
+    //========================================================================================================
+    void UdpSocket::Unbind()
+    {
+	    if( mTransport != nullptr )
+	    {
+		    mTransport->Unbind();
+		    return;
+	    }
+	    mSocket.unbind();
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    unsigned short UdpSocket::GetPort() const
+    {
+	    return mTransport != nullptr ? mTransport->GetPort() : mSocket.getLocalPort();
+    }
+
 	//========================================================================================================
 	//========================================================================================================
     UdpSocket::Status UdpSocket::Receive( Packet& _packet,
                                           IpAddress& _remoteAddress,
                                           unsigned short& _remotePort )
 	{ 
+		if( mTransport != nullptr ) { return mTransport->Receive( _packet, _remoteAddress, _remotePort ); }
 		const Status status = mSocket.receive( _packet.ToSfml(), _remoteAddress, _remotePort );
 		
 		// Read tag
@@ -39,6 +63,7 @@ namespace fan
                                        const IpAddress& _remoteAddress,
                                        unsigned short _remotePort )
     {
+	    if( mTransport != nullptr ) { return mTransport->Send( _packet, _remoteAddress, _remotePort ); }
 	    return mSocket.send( _packet.ToSfml(), _remoteAddress, _remotePort );
     }
 }
\ No newline at end of file
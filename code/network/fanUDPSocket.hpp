@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory>
 #include "network/fanPacket.hpp"
+#include "network/fanTransport.hpp"
 
 namespace fan
 {
 	//========================================================================================================
 	// A classic Udp socket 
+	// a transport can replace the os socket, sOnCreate is emitted when a socket is created to set it
 	//========================================================================================================
 	class UdpSocket
 	{
@@ -14,14 +17,22 @@ namespace fan
 		using Status = sf::Socket::Status;
 
 		static constexpr size_t maxPacketSize = 508;
+		static Signal< UdpSocket& > sOnCreate;
 
 		Status	Bind( unsigned short _port, const IpAddress& _address = IpAddress::Any );
-		void	Unbind() { mSocket.unbind(); }
-		unsigned short GetPort() const { return mSocket.getLocalPort(); }
+		void	Unbind();
+		unsigned short GetPort() const;
+		sf::SocketHandle GetHandle() const { return mSocket.getHandle(); }
+		void	SetTransport( ITransport* _transport ) { mTransport.reset( _transport ); }
+		bool	HasTransport() const { return mTransport != nullptr; }
 		Status	Receive( Packet& _packet, IpAddress& _remoteAddress, unsigned short& _remotePort );
  		Status	Send( Packet& _packet, const IpAddress& _remoteAddress, unsigned short _remotePort );
 
 	private:
-		sf::UdpSocket mSocket;
+		// exposes the native handle for batched system calls ( NetworkThread )
+		struct Socket : sf::UdpSocket { using sf::UdpSocket::getHandle; };
+
+		Socket                      mSocket;
+		std::unique_ptr<ITransport> mTransport;	// replaces mSocket when set
 	};
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "network/components/fanHostConnection.hpp"
 #include "network/components/fanHostReplication.hpp"
 #include "network/components/fanReliabilityLayer.hpp"
+#include "network/singletons/fanNetStats.hpp"
 
 namespace fan
 {
@@ -45,6 +46,7 @@ namespace fan
 		HostConnection& hostConnection = _world.AddComponent< HostConnection >( entity );
 		hostConnection.mIp   = _ip;
 		hostConnection.mPort = _port;
+		hostConnection.mStatsIndex = _world.GetSingleton<NetStats>().AddHost( hostNode.mHandle );
 
 		return hostNode.mHandle;
 	}
@@ -58,7 +60,7 @@ namespace fan
 		_world.Kill( entity );
 
 		// Delete the host spaceship if spawned
-		HostGameData hostGameData = _world.GetComponent<HostGameData>( entity );
+		HostGameData hostGameData = _world.GetComponent<const HostGameData>( entity );
 		if( hostGameData.mSpaceshipHandle != 0 )
 		{
 			const EcsEntity spaceshipID = _world.GetEntity( hostGameData.mSpaceshipHandle );
@@ -70,6 +72,8 @@ namespace fan
 		auto it = mHostHandles.find( { hostConnection.mIp, hostConnection.mPort } );
         fanAssert( it != mHostHandles.end() );
 		mHostHandles.erase( it );
+		_world.GetSingleton<NetStats>().RemoveHost( hostConnection.mStatsIndex );
+		hostConnection.mStatsIndex = -1;
 
 		Debug::Log() << "host disconnected "
 		             << hostConnection.mIp.toString()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/ecs/fanEcsSingleton.hpp"
+#include "core/math/fanSpatialGrid.hpp"
 #include "network/fanPacket.hpp"
 
 namespace fan
@@ -35,6 +36,7 @@ namespace fan
 
 		std::unordered_map < IPPort, EcsHandle, IPPort > mHostHandles;		// links host ip-port to its entity handle
 		EcsHandle                                        mNetRootNodeHandle; // host entity nodes are placed below the net root node
+		SpatialGrid                                      mRelevanceGrid;		// see SUpdateRelevance
 
 		EcsHandle CreateHost( EcsWorld& _world, const IpAddress _ip, const Port _port );
 		void	  DeleteHost( EcsWorld& _world, const EcsHandle _hostHandle );
@@ -1,5 +1,8 @@
 #include "network/singletons/fanLinkingContext.hpp"
 
+#include <algorithm>
+#include "core/ecs/fanEcsWorld.hpp"
+
 namespace fan
 {
 	//========================================================================================================
@@ -16,6 +19,7 @@ namespace fan
 		linkingContext.mNetIDToEcsHandle.clear();
 		linkingContext.mEcsHandleToNetID.clear();
 		linkingContext.mNextNetID = 1;
+		linkingContext.mNetComponentTypes.clear();
 	}
 
 	//========================================================================================================
@@ -42,4 +46,39 @@ namespace fan
 			mEcsHandleToNetID.erase( _handle );
 		}
 	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void LinkingContext::BuildNetComponentTypes( const EcsWorld& _world )
+	{
+		mNetComponentTypes.clear();
+		for( const EcsComponentInfo& info : _world.GetComponentInfos() )
+		{
+			if( info.netSave != nullptr ) { mNetComponentTypes.push_back( info.mType ); }
+		}
+		std::sort( mNetComponentTypes.begin(), mNetComponentTypes.end() );
+        fanAssert( mNetComponentTypes.size() <= std::numeric_limits<sf::Uint8>::max() );
+	}
+
+	//========================================================================================================
+	// returns -1 if the component type is not replicated
+	//========================================================================================================
+	int LinkingContext::GetNetComponentIndex( const EcsWorld& _world, const uint32_t _type )
+	{
+		if( mNetComponentTypes.empty() ) { BuildNetComponentTypes( _world ); }
+		auto it = std::lower_bound( mNetComponentTypes.begin(), mNetComponentTypes.end(), _type );
+		if( it == mNetComponentTypes.end() || *it != _type ) { return -1; }
+		return int( it - mNetComponentTypes.begin() );
+	}
+
+	//========================================================================================================
+	// returns false if the index is out of range ( corrupted packet or different replicated types )
+	//========================================================================================================
+	bool LinkingContext::GetNetComponentType( const EcsWorld& _world, const int _netIndex, uint32_t& _outType )
+	{
+		if( mNetComponentTypes.empty() ) { BuildNetComponentTypes( _world ); }
+		if( _netIndex < 0 || _netIndex >= (int)mNetComponentTypes.size() ) { return false; }
+		_outType = mNetComponentTypes[_netIndex];
+		return true;
+	}
 }
\ No newline at end of file
@@ -9,6 +9,8 @@ namespace fan
 {
 	//========================================================================================================
 	// Links net ID's to entities handles
+	// Replicated component types are sent as their index in the sorted types of the components with a netSave
+	// both worlds must register the same replicated component types
 	//========================================================================================================
 	struct LinkingContext : public EcsSingleton
 	{
@@ -19,8 +21,13 @@ namespace fan
 		std::unordered_map<NetID, EcsHandle > mNetIDToEcsHandle;
 		std::unordered_map<EcsHandle, NetID > mEcsHandleToNetID;
 		NetID                                 mNextNetID;
+		std::vector<uint32_t>                 mNetComponentTypes; // built on first use
 
 		void AddEntity( const EcsHandle _handle, const NetID _netID );
 		void RemoveEntity( const EcsHandle _handle );
+		int  GetNetComponentIndex( const EcsWorld& _world, const uint32_t _type );
+		bool GetNetComponentType( const EcsWorld& _world, const int _netIndex, uint32_t& _outType );
+	private:
+		void BuildNetComponentTypes( const EcsWorld& _world );
 	};
 }
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include "network/singletons/fanNetStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include "core/ecs/fanEcsWorld.hpp"
+#include "network/singletons/fanTime.hpp"
+#include "network/singletons/fanLinkingContext.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	//========================================================================================================
+	const float NetHistogram::sBucketsMs[sNumBuckets] = { 1.f, 2.f, 5.f, 10.f, 20.f, 35.f, 50.f, 75.f,
+														  100.f, 150.f, 250.f, 500.f, 1000.f, INFINITY };
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetCounter::Reset()
+	{
+		mBytes.store( 0, std::memory_order_relaxed );
+		mCount.store( 0, std::memory_order_relaxed );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetHistogram::Add( const float _seconds )
+	{
+		const float ms = 1000.f * std::max( 0.f, _seconds );
+		int bucket = 0;
+		while( bucket < sNumBuckets - 1 && ms >= sBucketsMs[bucket] ) { bucket++; }
+		mBuckets[bucket].fetch_add( 1, std::memory_order_relaxed );
+		mCount.fetch_add( 1, std::memory_order_relaxed );
+		if( std::isfinite( ms ) ) { mSumUs.fetch_add( uint64_t( 1000.f * ms ), std::memory_order_relaxed ); }
+	}
+
+	//========================================================================================================
+	// returns the upper bound in milliseconds of the bucket containing the percentile ( 0-1 )
+	//========================================================================================================
+	float NetHistogram::GetPercentile( const float _percentile ) const
+	{
+		const uint64_t count = GetCount();
+		if( count == 0 ) { return 0.f; }
+
+		const uint64_t rank = std::max( uint64_t( 1 ), uint64_t( std::ceil( _percentile * float( count ) ) ) );
+		uint64_t cumulated = 0;
+		for( int i = 0; i < sNumBuckets; i++ )
+		{
+			cumulated += mBuckets[i].load( std::memory_order_relaxed );
+			if( cumulated >= rank ) { return sBucketsMs[i]; }
+		}
+		return sBucketsMs[sNumBuckets - 1];
+	}
+
+	//========================================================================================================
+	// in milliseconds
+	//========================================================================================================
+	float NetHistogram::GetMean() const
+	{
+		const uint64_t count = GetCount();
+		return count == 0 ? 0.f : float( mSumUs.load( std::memory_order_relaxed ) ) / float( count ) / 1000.f;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetHistogram::Reset()
+	{
+		for( std::atomic<uint64_t>& bucket : mBuckets ) { bucket.store( 0, std::memory_order_relaxed ); }
+		mCount.store( 0, std::memory_order_relaxed );
+		mSumUs.store( 0, std::memory_order_relaxed );
+	}
+
+	//========================================================================================================
+	// the handle is kept, the slot still belongs to the same host
+	//========================================================================================================
+	void NetHostStats::Reset()
+	{
+		mSent.Reset();
+		mReceived.Reset();
+		mRetransmissions.store( 0, std::memory_order_relaxed );
+		mRtt.store( 0.f, std::memory_order_relaxed );
+		mJitter.store( 0.f, std::memory_order_relaxed );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetStats::SetInfo( EcsSingletonInfo& /*_info*/ )
+	{
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetStats::Init( EcsWorld& /*_world*/, EcsSingleton& _component )
+	{
+		NetStats& stats = static_cast<NetStats&>( _component );
+		for( NetHostStats& host : stats.mHosts ) { host.mHandle.store( 0, std::memory_order_relaxed ); }
+		stats.Reset();
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	const char* NetStats::GetPacketTypeName( const PacketType _type )
+	{
+		switch( _type )
+		{
+			case PacketType::Ping:            return "ping";
+			case PacketType::Ack:             return "ack";
+			case PacketType::Hello:           return "hello";
+			case PacketType::Disconnect:      return "disconnect";
+			case PacketType::LoggedIn:        return "logged in";
+			case PacketType::Replication:     return "replication";
+			case PacketType::PlayerInput:     return "player input";
+			case PacketType::PlayerGameState: return "player game state";
+			default:                          return "invalid";
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	const char* NetStats::GetReplicationTypeName( const PacketReplication::ReplicationType _type )
+	{
+		switch( _type )
+		{
+			case PacketReplication::ReplicationType::SingletonComponent: return "singleton";
+			case PacketReplication::ReplicationType::Entity:             return "entity";
+			case PacketReplication::ReplicationType::RPC:                return "rpc";
+			default:                                                     return "invalid";
+		}
+	}
+
+	//========================================================================================================
+	// claims a free host slot, returns -1 if there is none left
+	//========================================================================================================
+	int NetStats::AddHost( const EcsHandle _handle )
+	{
+		fanAssert( _handle != 0 );
+		for( int i = 0; i < sMaxHosts; i++ )
+		{
+			EcsHandle freeHandle = 0;
+			if( mHosts[i].mHandle.compare_exchange_strong( freeHandle, _handle, std::memory_order_relaxed ) )
+			{
+				mHosts[i].Reset();
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetStats::RemoveHost( const int _hostIndex )
+	{
+		if( _hostIndex < 0 ) { return; }
+		fanAssert( _hostIndex < sMaxHosts );
+		mHosts[_hostIndex].mHandle.store( 0, std::memory_order_relaxed );
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetStats::OnSend( const Packet& _packet, const int _hostIndex )
+	{
+		mSent.Add( _packet.GetSize() );
+		for( int i = 0; i < sNumTypes; i++ )
+		{
+			const int count = _packet.GetMessagesCount( PacketType( i ) );
+			if( count != 0 ) { mSentTypes[i].Add( _packet.GetMessagesSize( PacketType( i ) ), count ); }
+		}
+		if( _hostIndex >= 0 ) { mHosts[_hostIndex].mSent.Add( _packet.GetSize() ); }
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetStats::OnReceive( const Packet& _packet, const int _hostIndex )
+	{
+		mReceived.Add( _packet.GetSize() );
+		if( _hostIndex >= 0 ) { mHosts[_hostIndex].mReceived.Add( _packet.GetSize() ); }
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetStats::OnReceive( const PacketType _type )
+	{
+		if( int( _type ) < sNumTypes ) { mReceivedTypes[int( _type )].fetch_add( 1, std::memory_order_relaxed ); }
+	}
+
+	//========================================================================================================
+	// the jitter is the variation between two consecutive rtt of the same connection
+	//========================================================================================================
+	void NetStats::AddRtt( const float _rtt, const int _hostIndex )
+	{
+		std::atomic<float>& lastRtt    = _hostIndex >= 0 ? mHosts[_hostIndex].mRtt : mLastRtt;
+		const float         previous   = lastRtt.load( std::memory_order_relaxed );
+		const bool          hasLastRtt = previous > 0.f;
+		const float         variation  = std::abs( _rtt - previous );
+		lastRtt.store( _rtt, std::memory_order_relaxed );
+		mRtt.Add( _rtt );
+		if( !hasLastRtt ) { return; }
+
+		mJitter.Add( variation );
+		if( _hostIndex >= 0 )
+		{
+			std::atomic<float>& jitter = mHosts[_hostIndex].mJitter;
+			const float lastJitter = jitter.load( std::memory_order_relaxed );
+			jitter.store( lastJitter + ( variation - lastJitter ) / 16.f, std::memory_order_relaxed );
+		}
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetStats::AddRetransmissions( const uint32_t _count, const int _hostIndex )
+	{
+		if( _count == 0 ) { return; }
+		mRetransmissions.fetch_add( _count, std::memory_order_relaxed );
+		if( _hostIndex >= 0 ) { mHosts[_hostIndex].mRetransmissions.fetch_add( _count, std::memory_order_relaxed ); }
+	}
+
+	//========================================================================================================
+	//========================================================================================================
+	void NetStats::Reset()
+	{
+		mSent.Reset();
+		mReceived.Reset();
+		for( NetCounter& counter : mSentTypes ) { counter.Reset(); }
+		for( std::atomic<uint64_t>& count : mReceivedTypes ) { count.store( 0, std::memory_order_relaxed ); }
+		for( NetCounter& counter : mSentReplication ) { counter.Reset(); }
+		for( NetCounter& counter : mSentComponents ) { counter.Reset(); }
+		mRetransmissions.store( 0, std::memory_order_relaxed );
+		mRtt.Reset();
+		mJitter.Reset();
+		mAckLatency.Reset();
+		mLastRtt.store( 0.f, std::memory_order_relaxed );
+		for( NetHostStats& host : mHosts ) { host.Reset(); }
+		mResetTime.store( Time::ElapsedSinceStartup(), std::memory_order_relaxed );
+	}
+
+	//========================================================================================================
+	// human readable report, used by the headless server
+	//========================================================================================================
+	void NetStats::Dump( EcsWorld& _world, std::ostream& _stream ) const
+	{
+		const double duration = std::max( 0.001, Time::ElapsedSinceStartup() - mResetTime.load() );
+		auto rate = [duration]( const NetCounter& _counter )
+		{
+			return double( _counter.GetBytes() ) / duration / 1000.;
+		};
+
+		_stream << std::fixed << std::setprecision( 1 );
+		_stream << "net stats over " << duration << "s\n";
+		_stream << "  sent     " << mSent.GetCount() << " datagrams " << mSent.GetBytes() << " bytes "
+				<< rate( mSent ) << " Ko/s\n";
+		_stream << "  received " << mReceived.GetCount() << " datagrams " << mReceived.GetBytes() << " bytes "
+				<< rate( mReceived ) << " Ko/s\n";
+
+		_stream << "  packet types (sent messages / bytes / received messages)\n";
+		for( int i = 0; i < sNumTypes; i++ )
+		{
+			const uint64_t received = mReceivedTypes[i].load( std::memory_order_relaxed );
+			if( mSentTypes[i].GetCount() == 0 && received == 0 ) { continue; }
+			_stream << "    " << std::left << std::setw( 18 ) << GetPacketTypeName( PacketType( i ) ) << " " << std::right
+					<< mSentTypes[i].GetCount() << " / " << mSentTypes[i].GetBytes() << " / " << received << "\n";
+		}
+
+		_stream << "  replication (sent messages / bytes)\n";
+		for( int i = 0; i < sNumReplicationTypes; i++ )
+		{
+			if( mSentReplication[i].GetCount() == 0 ) { continue; }
+			_stream << "    " << std::left << std::setw( 18 )
+					<< GetReplicationTypeName( PacketReplication::ReplicationType( i ) ) << " " << std::right
+					<< mSentReplication[i].GetCount() << " / " << mSentReplication[i].GetBytes() << "\n";
+		}
+
+		LinkingContext& linkingContext = _world.GetSingleton<LinkingContext>();
+		for( int i = 0; i < sMaxComponents; i++ )
+		{
+			uint32_t type;
+			if( mSentComponents[i].GetCount() == 0 || !linkingContext.GetNetComponentType( _world, i, type ) )
+			{
+				continue;
+			}
+			_stream << "      " << std::left << std::setw( 16 ) << _world.GetComponentInfo( type ).mName << " " << std::right
+					<< mSentComponents[i].GetCount() << " / " << mSentComponents[i].GetBytes() << "\n";
+		}
+
+		auto histogram = [&_stream]( const char* _name, const NetHistogram& _histogram )
+		{
+			_stream << "  " << std::left << std::setw( 12 ) << _name << " " << std::right
+					<< "mean " << _histogram.GetMean() << "ms p50 " << _histogram.GetPercentile( .5f )
+					<< "ms p95 " << _histogram.GetPercentile( .95f ) << "ms p99 " << _histogram.GetPercentile( .99f )
+					<< "ms (" << _histogram.GetCount() << ")\n";
+		};
+		histogram( "rtt", mRtt );
+		histogram( "jitter", mJitter );
+		histogram( "ack latency", mAckLatency );
+		_stream << "  retransmissions " << mRetransmissions.load( std::memory_order_relaxed ) << "\n";
+
+		for( const NetHostStats& host : mHosts )
+		{
+			const EcsHandle handle = host.mHandle.load( std::memory_order_relaxed );
+			if( handle == 0 ) { continue; }
+			_stream << "  host " << handle << ": sent " << host.mSent.GetBytes() << " bytes " << rate( host.mSent )
+					<< " Ko/s, received " << host.mReceived.GetBytes() << " bytes, rtt "
+					<< 1000.f * host.mRtt.load( std::memory_order_relaxed ) << "ms jitter "
+					<< 1000.f * host.mJitter.load( std::memory_order_relaxed ) << "ms, retransmissions "
+					<< host.mRetransmissions.load( std::memory_order_relaxed ) << "\n";
+		}
+	}
+}
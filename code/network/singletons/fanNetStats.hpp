@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <ostream>
+#include "core/ecs/fanEcsSingleton.hpp"
+#include "network/fanPacket.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// Bytes & number of messages
+	//========================================================================================================
+	struct NetCounter
+	{
+		void Add( const size_t _bytes, const uint64_t _count = 1 )
+		{
+			mBytes.fetch_add( _bytes, std::memory_order_relaxed );
+			mCount.fetch_add( _count, std::memory_order_relaxed );
+		}
+		uint64_t GetBytes() const { return mBytes.load( std::memory_order_relaxed ); }
+		uint64_t GetCount() const { return mCount.load( std::memory_order_relaxed ); }
+		void     Reset();
+
+		std::atomic<uint64_t> mBytes { 0 };
+		std::atomic<uint64_t> mCount { 0 };
+	};
+
+	//========================================================================================================
+	// Distribution of a duration, bucket i counts the values lower than sBucketsMs[i]
+	//========================================================================================================
+	struct NetHistogram
+	{
+		static constexpr int sNumBuckets = 14;
+		static const float   sBucketsMs[sNumBuckets];	// upper bounds in milliseconds, the last one is infinite
+
+		void     Add( const float _seconds );
+		float    GetPercentile( const float _percentile ) const;
+		float    GetMean() const;
+		uint64_t GetCount() const { return mCount.load( std::memory_order_relaxed ); }
+		void     Reset();
+
+		std::atomic<uint64_t> mBuckets[sNumBuckets] {};
+		std::atomic<uint64_t> mCount { 0 };
+		std::atomic<uint64_t> mSumUs { 0 };	// microseconds
+	};
+
+	//========================================================================================================
+	// Traffic of one host, see HostConnection::mStatsIndex
+	//========================================================================================================
+	struct NetHostStats
+	{
+		void Reset();
+
+		std::atomic<EcsHandle> mHandle { 0 };	// 0 when the slot is free
+		NetCounter             mSent;			// datagrams
+		NetCounter             mReceived;		// datagrams
+		std::atomic<uint64_t>  mRetransmissions { 0 };
+		std::atomic<float>     mRtt { 0.f };
+		std::atomic<float>     mJitter { 0.f };	// smoothed rtt variation, RFC 3550
+	};
+
+	//========================================================================================================
+	// Network instrumentation of a world : bytes & messages sent per packet type, replication type & component
+	// rtt, jitter & ack latency histograms, retransmissions & per host traffic
+	// counters are relaxed atomics written by the game thread, they can be read from any thread without locking
+	// only the sent bytes of each packet type are known, received messages are read without a read position
+	//========================================================================================================
+	struct NetStats : public EcsSingleton
+	{
+		ECS_SINGLETON( NetStats )
+		static void SetInfo( EcsSingletonInfo& _info );
+		static void Init( EcsWorld& _world, EcsSingleton& _component );
+
+		static constexpr int sMaxHosts      = 64;
+		static constexpr int sMaxComponents = 64;	// net component indices, see LinkingContext
+		static constexpr int sNumTypes      = int( PacketType::COUNT );
+		static constexpr int sNumReplicationTypes = int( PacketReplication::ReplicationType::Count );
+
+		static const char* GetPacketTypeName( const PacketType _type );
+		static const char* GetReplicationTypeName( const PacketReplication::ReplicationType _type );
+
+		NetCounter            mSent;		// datagrams
+		NetCounter            mReceived;	// datagrams
+		NetCounter            mSentTypes[sNumTypes];
+		std::atomic<uint64_t> mReceivedTypes[sNumTypes] {};
+		NetCounter            mSentReplication[sNumReplicationTypes];
+		NetCounter            mSentComponents[sMaxComponents];	// inside entities replication
+		std::atomic<uint64_t> mRetransmissions { 0 };
+		NetHistogram          mRtt;
+		NetHistogram          mJitter;
+		NetHistogram          mAckLatency;
+		std::atomic<float>    mLastRtt { 0.f };	// rtt of the connection to the server on clients
+		NetHostStats          mHosts[sMaxHosts];
+		std::atomic<double>   mResetTime { 0. };
+
+		int  AddHost( const EcsHandle _handle );
+		void RemoveHost( const int _hostIndex );
+		void OnSend( const Packet& _packet, const int _hostIndex = -1 );
+		void OnReceive( const Packet& _packet, const int _hostIndex = -1 );
+		void OnReceive( const PacketType _type );
+		void AddRtt( const float _rtt, const int _hostIndex = -1 );
+		void AddRetransmissions( const uint32_t _count, const int _hostIndex );
+		void Reset();
+		void Dump( EcsWorld& _world, std::ostream& _stream ) const;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "core/ecs/fanEcsSingleton.hpp"
 #include "network/fanUdpSocket.hpp"
+#include "network/fanNetworkThread.hpp"
 #include "network/fanPacket.hpp"
 
 namespace fan
@@ -17,7 +18,8 @@ namespace fan
 		static void SetInfo( EcsSingletonInfo& _info );
 		static void Init( EcsWorld& _world, EcsSingleton& _component );
 
-		UdpSocket mSocket;
-		Port      mServerPort;
+		UdpSocket     mSocket;
+		NetworkThread mNetworkThread;	// use it to send & receive once the socket is bound
+		Port          mServerPort;
 	};
 }
\ No newline at end of file
@@ -36,10 +36,10 @@ namespace fan
 		const Time& time = _world.GetSingleton<Time>();
 		SpawnManager& spawnManager = _world.GetSingleton<SpawnManager>();
 
-		// spawn
-		for (int spawnIndex = int(spawnManager.spawns.size()) - 1; spawnIndex >= 0 ; spawnIndex--)
+		// spawn in the order of reception, missed spawns can depend on each other ( a ship & its bullets )
+		for (int spawnIndex = 0; spawnIndex < int(spawnManager.spawns.size()); )
 		{
-			SpawnInfo& spawnInfo = spawnManager.spawns[spawnIndex];
+			const SpawnInfo spawnInfo = spawnManager.spawns[spawnIndex];
 			if( time.mFrameIndex >= spawnInfo.spawnFrameIndex )
 			{
 				if( time.mFrameIndex > spawnInfo.spawnFrameIndex )
@@ -49,8 +49,12 @@ namespace fan
 					                 << Debug::Endl();
 				}
 
-				spawnManager.spawnMethods.at( spawnInfo.spawnID )( _world, spawnInfo.data );
 				spawnManager.spawns.erase( spawnManager.spawns.begin() + spawnIndex );
+				spawnManager.spawnMethods.at( spawnInfo.spawnID )( _world, spawnInfo.data );
+			}
+			else
+			{
+				spawnIndex++;
 			}
  		}
 
@@ -1,6 +1,8 @@
 #include "network/singletons/fanTime.hpp"
 
+#include <algorithm>
 #include <sstream>
+#include "core/fanAssert.hpp"
 
 namespace fan
 {
@@ -30,6 +32,7 @@ namespace fan
 		// timeScaleIncrement -> it takes 20 frames to time scale one frame ( 5% faster/slower )
 		gameTime.mTimeScaleIncrement = gameTime.mLogicDelta / 20.f;
 		gameTime.mLastLogicTime      = 0.;
+		gameTime.mSnapshotRate       = 20.f;
 	}
 
 	//========================================================================================================
@@ -64,4 +67,26 @@ namespace fan
             mTimeScaleDelta = _framesDelta * mLogicDelta;
 		}
 	}
+
+	//========================================================================================================
+	// client & server must run at the same tick rate
+	// the physics runs one step per tick, sPhysicsDelta is shared by all the worlds of the process
+	//========================================================================================================
+	void Time::SetTickRate( const float _tickRate )
+	{
+		fanAssert( _tickRate > 0.f );
+		mLogicDelta         = 1.f / _tickRate;
+		mTimeScaleIncrement = mLogicDelta / 20.f;
+		sPhysicsDelta       = mLogicDelta;
+	}
+
+	//========================================================================================================
+	// returns the number of frames between two entities snapshots, at least one
+	// a snapshot rate of 0 or higher than the tick rate replicates the entities every frame
+	//========================================================================================================
+	int Time::GetSnapshotPeriod() const
+	{
+		if( mSnapshotRate <= 0.f ) { return 1; }
+		return std::max( 1, int( 1.f / ( mSnapshotRate * mLogicDelta ) + 0.5f ) );
+	}
 }
\ No newline at end of file
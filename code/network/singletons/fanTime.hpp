@@ -1,7 +1,7 @@
 #pragma once
 
-#include "glfw/glfw3.h"
 #include "core/ecs/fanEcsSingleton.hpp"
+#include "core/time/fanClock.hpp"
 #include "network/fanNetConfig.hpp"
 
 namespace fan
@@ -20,6 +20,7 @@ namespace fan
 		float      mTimeScaleDelta;		// (seconds) accelerate, decelerates the logic frame rate to resync frame index with server
 		float      mTimeScaleIncrement; // the maximum amount that can be added to each frame
 		double     mLastLogicTime;		// last time the logic step was called
+		float      mSnapshotRate;		// [SERVER] entities snapshots replicated per second, see SUpdateReplication
 
 		static const int sMaxFrameDeltaBeforeShift = 20; // if the server/client frame delta > this, shift frameIndex. Otherwise use timescale
 		static float     sRenderDelta;
@@ -29,9 +30,12 @@ namespace fan
 		static uint32_t  sRealFramerateLastSecond;
 		static double    sLastLogFrameTime;
 
-		static double		ElapsedSinceStartup() { return glfwGetTime(); }
+		static double		ElapsedSinceStartup() { return Clock::SecondsSinceStartup(); }
 		static void			RegisterFrameDrawn();
 
 		void OnShiftFrameIndex( const int _framesDelta );
+		void SetTickRate( const float _tickRate );
+		int  GetSnapshotPeriod() const;
+		bool IsSnapshotFrame() const { return mFrameIndex % GetSnapshotPeriod() == 0; }
 	};
 }
\ No newline at end of file
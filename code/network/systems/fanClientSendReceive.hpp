@@ -4,6 +4,7 @@
 #include "network/components/fanReliabilityLayer.hpp"
 #include "network/components/fanClientReplication.hpp"
 #include "network/singletons/fanTime.hpp"
+#include "network/singletons/fanNetStats.hpp"
 
 namespace fan
 {
@@ -25,6 +26,7 @@ namespace fan
 			if( _delta == 0.f ) { return; }
 
 			Time& time = _world.GetSingleton<Time>();
+			NetStats& stats = _world.GetSingleton<NetStats>();
 
 			auto reliabilityLayerIt = _view.begin<ReliabilityLayer>();
 			auto connectionIt = _view.begin<ClientConnection>();
@@ -51,12 +53,13 @@ namespace fan
 				// send packet, don't send empty packets
 				if( packet.GetSize() > sizeof( PacketTag ) )
 				{
-					reliabilityLayer.RegisterPacket( packet );
+					reliabilityLayer.RegisterPacket( _world, packet );
                     connection.mBandwidth = 1.f /
                                             time.mLogicDelta *
                                             float( packet.GetSize() )
                                             / 1000.f; // in Ko/s
 					connection.mSocket->Send( packet, connection.mServerIP, connection.mServerPort );
+					stats.OnSend( packet );
 				}
 				else
 				{
@@ -85,6 +88,7 @@ namespace fan
 			if( _delta == 0.f ) { return; }
 
 			const Time& time = _world.GetSingleton<Time>();
+			NetStats& stats = _world.GetSingleton<NetStats>();
 
 			auto reliabilityLayerIt = _view.begin<ReliabilityLayer>();
 			auto connectionIt = _view.begin<ClientConnection>();
@@ -120,6 +124,7 @@ namespace fan
 					case sf::UdpSocket::Done:
 					{
 						connection.mServerLastResponse = Time::ElapsedSinceStartup();
+						stats.OnReceive( packet );
 
 						// read the first packet type separately
 						PacketType packetType = packet.ReadType();
@@ -142,19 +147,21 @@ namespace fan
 						bool packetValid = true;
 						while( packetValid )
 						{
+							stats.OnReceive( packetType );
 							switch( packetType )
 							{
 							case PacketType::Ack:
 							{
 								PacketAck packetAck;
 								packetAck.Read( packet );
-								reliabilityLayer.ProcessPacket( packetAck );
+								reliabilityLayer.ProcessPacket( _world, packetAck );
 							}break;
 							case PacketType::Ping:
 							{
 								PacketPing packetPing;
 								packetPing.Read( packet );
 								connection.ProcessPacket( packetPing, time.mFrameIndex );
+								if( packetPing.mPreviousRtt > 0.f ) { stats.AddRtt( packetPing.mPreviousRtt ); }
 							} break;
 							case PacketType::LoggedIn:
 							{
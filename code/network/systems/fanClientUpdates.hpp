@@ -3,11 +3,13 @@
 #include "network/components/fanClientConnection.hpp"
 #include "network/components/fanClientGameData.hpp"
 #include "network/components/fanClientRPC.hpp"
+#include "network/components/fanEntityInterpolation.hpp"
 #include "network/singletons/fanTime.hpp"
 #include "game/components/fanPlayerInput.hpp"
 #include "engine/components/fanTransform.hpp"
 #include "engine/components/fanRigidbody.hpp"
 #include "network/singletons/fanLinkingContext.hpp"
+#include "network/fanBitStream.hpp"
 
 namespace fan
 {
@@ -38,8 +40,8 @@ namespace fan
 					const EcsEntity spaceshipID = _world.GetEntity( gameData.sSpaceshipHandle );
 
 					// saves previous player state
-					const Rigidbody& rb = _world.GetComponent<Rigidbody>( spaceshipID );
-					const Transform& transform = _world.GetComponent<Transform>( spaceshipID );
+					const Rigidbody& rb = _world.GetComponent<const Rigidbody>( spaceshipID );
+					const Transform& transform = _world.GetComponent<const Transform>( spaceshipID );
                     fanAssert( rb.mRigidbody->getTotalForce().isZero() );
 					PacketPlayerGameState playerState;
 					playerState.mFrameIndex      = time.mFrameIndex;
@@ -76,12 +78,14 @@ namespace fan
 				if( gameData.sSpaceshipHandle != 0 && gameData.mFrameSynced )
 				{
 					const EcsEntity spaceshipID = _world.GetEntity( gameData.sSpaceshipHandle );
-					const PlayerInput& input = _world.GetComponent<PlayerInput>( spaceshipID );
+					PlayerInput& input = _world.GetComponent<PlayerInput>( spaceshipID );
 
 					// streams input to the server
+					// the client simulates with the quantized orientation received by the server
 					PacketInput::InputData inputData;
 					inputData.mFrameIndex  = time.mFrameIndex;
-					inputData.mOrientation = sf::Vector2f( input.mOrientation.x(), input.mOrientation.z() );
+					inputData.mOrientation = PacketInput::QuantizeOrientation( input.mOrientation );
+					input.mOrientation     = PacketInput::DequantizeOrientation( inputData.mOrientation );
 					inputData.mLeft        = input.mLeft > 0;
 					inputData.mRight       = input.mLeft < 0;
 					inputData.mForward     = input.mForward > 0;
@@ -108,6 +112,7 @@ namespace fan
 			if( _delta == 0.f ) { return; }
 
 			LinkingContext& linkingContext = _world.GetSingleton<LinkingContext>();
+			const Time& time = _world.GetSingleton<Time>();
 
 			auto rpcIt = _view.begin<ClientRPC>();
 			auto replicationIt = _view.begin<ClientReplication>();
@@ -129,13 +134,12 @@ namespace fan
 				replication.mReplicationListSingletons.clear();
 
 				// replicate entities
-				for( PacketReplication packet : replication.mReplicationListEntities )
+				for( const PacketReplication& packet : replication.mReplicationListEntities )
 				{
-					NetID netID;
-					sf::Uint8 numComponents;
-
-					packet.mPacketData >> netID;
-					packet.mPacketData >> numComponents;
+					BitReader reader( packet.mPacketData.getData(), packet.mPacketData.getDataSize() );
+					const NetID netID = reader.ReadVarUint();
+					const FrameIndex frameIndex = reader.ReadVarUint();
+					const int numComponents = int( reader.ReadBits( 8 ) );
 
 					auto it = linkingContext.mNetIDToEcsHandle.find( netID );
 					if( it != linkingContext.mNetIDToEcsHandle.end() )
@@ -149,13 +153,48 @@ namespace fan
 						}
 
 
+						// interpolated entities buffer the snapshot, components missing from the payload didn't change
+						EntityInterpolation* interpolation = _world.HasComponent<EntityInterpolation>( replicatedID )
+							? &_world.GetComponent<EntityInterpolation>( replicatedID )
+							: nullptr;
+						EntityInterpolation::Snapshot snapshot;
+						if( interpolation != nullptr )
+						{
+							snapshot = interpolation->Empty()
+								? GetState( _world, replicatedID )
+								: interpolation->GetNewest();
+							snapshot.mFrameIndex = frameIndex;
+						}
+
 						for( int i = 0; i < numComponents; i++ )
 						{
-							sf::Uint32 staticIndex;
-							packet.mPacketData >> staticIndex;
+							uint32_t staticIndex;
+							const int netIndex = int( reader.ReadBits( 8 ) );
+							if( !linkingContext.GetNetComponentType( _world, netIndex, staticIndex ) ) { break; }
 							const EcsComponentInfo& info = _world.GetComponentInfo( staticIndex );
 							EcsComponent& component = _world.GetComponent( replicatedID, staticIndex );
-							info.netLoad( component, packet.mPacketData );
+							info.netLoad( component, reader );
+							reader.Align();
+
+							if( interpolation != nullptr )
+							{
+								const EntityInterpolation::Snapshot state = GetState( _world, replicatedID );
+								if( staticIndex == Transform::Info::sType )
+								{
+									snapshot.mPosition = state.mPosition;
+									snapshot.mRotation = state.mRotation;
+								}
+								else if( staticIndex == Rigidbody::Info::sType )
+								{
+									snapshot.mVelocity        = state.mVelocity;
+									snapshot.mAngularVelocity = state.mAngularVelocity;
+								}
+							}
+						}
+                        fanAssert( !reader.IsOverflow() );
+						if( interpolation != nullptr && !reader.IsOverflow() )
+						{
+							interpolation->PushSnapshot( snapshot, time.mFrameIndex );
 						}
 					}
 				}
@@ -169,6 +208,58 @@ namespace fan
 				replication.mReplicationListRPC.clear();
 			}
 		}
+
+		// returns the replicated state of an interpolated entity
+		static EntityInterpolation::Snapshot GetState( EcsWorld& _world, const EcsEntity _entity )
+		{
+			const Transform& transform = _world.GetComponent<const Transform>( _entity );
+			const Rigidbody& rigidbody = _world.GetComponent<const Rigidbody>( _entity );
+			EntityInterpolation::Snapshot state;
+			state.mFrameIndex      = 0;
+			state.mPosition        = transform.GetPosition();
+			state.mRotation        = transform.GetRotationQuat();
+			state.mVelocity        = rigidbody.GetVelocity();
+			state.mAngularVelocity = rigidbody.GetAngularVelocity();
+			return state;
+		}
+	};
+
+	//========================================================================================================
+	// Blends the interpolated entities between their replicated snapshots, runs after the physics
+	// entities are displayed in the past & velocities are blended for the effects that depend on them
+	//========================================================================================================
+	struct SInterpolateReplicatedEntities : EcsSystem
+	{
+		static EcsSignature GetSignature( const EcsWorld& _world )
+		{
+			return
+				_world.GetSignature<EntityInterpolation>() |
+				_world.GetSignature<Transform>() |
+				_world.GetSignature<Rigidbody>();
+		}
+		static void Run( EcsWorld& _world, const EcsView& _view, const float _delta )
+		{
+			if( _delta == 0.f ) { return; }
+
+			const Time& time = _world.GetSingleton<Time>();
+			auto interpolationIt = _view.begin<EntityInterpolation>();
+			auto transformIt = _view.begin<Transform>();
+			auto rigidbodyIt = _view.begin<Rigidbody>();
+			for( ; interpolationIt != _view.end<EntityInterpolation>(); ++interpolationIt, ++transformIt, ++rigidbodyIt )
+			{
+				const EntityInterpolation& interpolation = *interpolationIt;
+				if( interpolation.Empty() ) { continue; }
+
+				Transform& transform = *transformIt;
+				Rigidbody& rigidbody = *rigidbodyIt;
+				const EntityInterpolation::Snapshot state = interpolation.Interpolate( time.mFrameIndex,
+																					   time.mLogicDelta );
+				transform.SetPosition( state.mPosition );
+				transform.SetRotationQuat( state.mRotation );
+				rigidbody.SetVelocity( state.mVelocity );
+				rigidbody.SetAngularVelocity( state.mAngularVelocity );
+			}
+		}
 	};
 
 	//========================================================================================================
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "core/ecs/fanEcsSystem.hpp"
+#include "core/math/fanSpatialGrid.hpp"
+#include "engine/components/fanTransform.hpp"
+#include "network/singletons/fanHostManager.hpp"
+#include "network/singletons/fanLinkingContext.hpp"
+#include "network/singletons/fanTime.hpp"
+#include "network/components/fanHostReplication.hpp"
+#include "network/components/fanHostGameData.hpp"
+#include "network/components/fanEntityReplication.hpp"
+#include "network/components/fanClientRPC.hpp"
+
+namespace fan
+{
+	//========================================================================================================
+	// Interest management, runs before SUpdateReplication on the snapshot frames
+	// Selects the entities with a relevance distance that each host's ship perceives
+	// Entities entering the relevance of a host are spawned on it, entities leaving it are despawned
+	// Far entities are replicated at a lower rate
+	//========================================================================================================
+	struct SUpdateRelevance : EcsSystem
+	{
+		static constexpr float sLeaveRatio       = 1.2f;	// hysteresis, prevents spawn/despawn on the border
+		static constexpr float sFarRatio         = 0.5f;	// beyond this ratio of the distance, entities are far
+		static constexpr int   sFarPeriod        = 4;		// far entities are replicated every sFarPeriod snapshots
+		static constexpr int   sSpawnFrameDelay  = 60;		// same delay as the ship spawn
+
+		static EcsSignature GetSignature( const EcsWorld& _world )
+		{
+			return _world.GetSignature<EntityReplication>() | _world.GetSignature<Transform>();
+		}
+
+		// entity with a relevance distance
+		struct RelevantEntity
+		{
+			NetID                    netID;
+			float                    distance;
+			float                    x;
+			float                    z;
+			const EntityReplication* entityReplication;
+		};
+
+		static void Run( EcsWorld& _world, const EcsView& _view )
+		{
+			const LinkingContext& linkingContext = _world.GetSingleton<LinkingContext>();
+			HostManager& hostManager = _world.GetSingleton<HostManager>();
+			const Time& time = _world.GetSingleton<Time>();
+			const FrameIndex snapshotIndex = time.mFrameIndex / time.GetSnapshotPeriod();
+
+			// collects the entities with a relevance distance
+			std::vector<RelevantEntity> entities;
+			float maxDistance = 0.f;
+			auto replicationIt = _view.begin<const EntityReplication>();
+			auto transformIt = _view.begin<const Transform>();
+			for( ; replicationIt != _view.end<const EntityReplication>(); ++replicationIt, ++transformIt )
+			{
+				const EntityReplication& entityReplication = *replicationIt;
+				if( entityReplication.mRelevanceDistance <= 0.f ) { continue; }
+				const auto netIt = linkingContext.mEcsHandleToNetID.find( _world.GetHandle( replicationIt.GetEntity() ) );
+				if( netIt == linkingContext.mEcsHandleToNetID.end() ) { continue; }
+
+				const btVector3 position = ( *transformIt ).GetPosition();
+				entities.push_back( { netIt->second,
+									  entityReplication.mRelevanceDistance,
+									  position.x(),
+									  position.z(),
+									  &entityReplication } );
+				maxDistance = std::max( maxDistance, entityReplication.mRelevanceDistance );
+			}
+
+			// grid cells have the size of the largest query
+			SpatialGrid& grid = hostManager.mRelevanceGrid;
+			grid.Clear( maxDistance > 0.f ? sLeaveRatio * maxDistance : 1.f );
+			for( int i = 0; i < (int)entities.size(); i++ )
+			{
+				grid.Insert( i, entities[i].x, entities[i].z );
+			}
+			grid.Build();
+
+			for( const std::pair<HostManager::IPPort, EcsHandle>& pair : hostManager.mHostHandles )
+			{
+				const EcsHandle hostHandle = pair.second;
+				const EcsEntity hostEntity = _world.GetEntity( hostHandle );
+				HostReplication& hostReplication = _world.GetComponent<HostReplication>( hostEntity );
+				const HostGameData& hostData = _world.GetComponent<const HostGameData>( hostEntity );
+
+				// without a ship, the host keeps perceiving what it perceived
+				const bool hasShip = hostData.mSpaceshipHandle != 0 &&
+									 _world.HasComponent<Transform>( _world.GetEntity( hostData.mSpaceshipHandle ) );
+				for( auto& relevancePair : hostReplication.mRelevantEntities )
+				{
+					relevancePair.second.mIsVisited = !hasShip;
+				}
+
+				if( hasShip )
+				{
+					const EcsEntity shipEntity = _world.GetEntity( hostData.mSpaceshipHandle );
+					const btVector3 shipPosition = _world.GetComponent<const Transform>( shipEntity ).GetPosition();
+					grid.Query( shipPosition.x(),
+								shipPosition.z(),
+								sLeaveRatio * maxDistance,
+								[&]( const int _index, const float _sqrDistance )
+					{
+						const RelevantEntity& entity = entities[_index];
+						if( entity.entityReplication->mExclude == hostHandle ) { return; }
+
+						const float enterDistance = entity.distance;
+						const float leaveDistance = sLeaveRatio * entity.distance;
+						auto it = hostReplication.mRelevantEntities.find( entity.netID );
+						if( it == hostReplication.mRelevantEntities.end() )
+						{
+							if( _sqrDistance > enterDistance * enterDistance ) { return; }
+
+							// enters relevance
+							SpawnInfo spawnInfo = entity.entityReplication->mSpawnInfo;
+							spawnInfo.spawnFrameIndex = time.mFrameIndex + sSpawnFrameDelay;
+							hostReplication.ReplicateRelevanceSpawn( ClientRPC::RPCSpawn( spawnInfo ), entity.netID );
+							HostReplication::Relevance& relevance = hostReplication.mRelevantEntities[entity.netID];
+							relevance.mSpawnFrame = spawnInfo.spawnFrameIndex;
+							it = hostReplication.mRelevantEntities.find( entity.netID );
+						}
+						else if( _sqrDistance > leaveDistance * leaveDistance )
+						{
+							return;
+						}
+
+						const float farDistance = sFarRatio * entity.distance;
+						it->second.mIsVisited = true;
+						it->second.mIsFar     = _sqrDistance > farDistance * farDistance;
+					} );
+				}
+
+				// leaves relevance, once spawned on the host so that the despawn can't overtake the spawn
+				for( auto it = hostReplication.mRelevantEntities.begin(); it != hostReplication.mRelevantEntities.end(); )
+				{
+					const NetID netID = it->first;
+					HostReplication::Relevance& relevance = it->second;
+					const bool isAlive = linkingContext.mNetIDToEcsHandle.find( netID ) !=
+										 linkingContext.mNetIDToEcsHandle.end();
+					const bool isSpawned = relevance.mIsSpawnAcked && time.mFrameIndex >= relevance.mSpawnFrame;
+					if( ( !relevance.mIsVisited && isSpawned ) || !isAlive )
+					{
+						if( isAlive )
+						{
+							hostReplication.Replicate( ClientRPC::RPCDespawn( netID ),
+													   HostReplication::ResendUntilReplicated );
+						}
+						hostReplication.mBaselines.erase( netID );
+						it = hostReplication.mRelevantEntities.erase( it );
+					}
+					else
+					{
+						relevance.mIsReplicated = time.mFrameIndex >= relevance.mSpawnFrame &&
+												  ( !relevance.mIsFar || ( snapshotIndex + netID ) % sFarPeriod == 0 );
+						++it;
+					}
+				}
+			}
+		}
+
+	};
+}
@@ -4,6 +4,7 @@
 #include "network/singletons/fanHostManager.hpp"
 #include "network/components/fanHostReplication.hpp"
 #include "network/components/fanEntityReplication.hpp"
+#include "network/singletons/fanLinkingContext.hpp"
 
 namespace fan
 {
@@ -25,6 +26,7 @@ namespace fan
                          const HostReplication::ReplicationFlags _flags,
                          const EcsHandle _excludeHandle = 0 )
 		{
+			const ReplicationPayloadPtr payload = std::make_shared<const ReplicationPayload>( _packet );
 			auto hostReplicationIt = _view.begin<HostReplication>();
 			for( ; hostReplicationIt != _view.end<HostReplication>(); ++hostReplicationIt )
 			{
@@ -32,7 +34,7 @@ namespace fan
 				if( handle != _excludeHandle )
 				{
 					HostReplication& hostReplication = *hostReplicationIt;
-					hostReplication.Replicate( _packet, _flags );
+					hostReplication.Replicate( payload, _flags );
 				}
 			}
 		}
@@ -40,6 +42,9 @@ namespace fan
 
 	//========================================================================================================
 	// Replicates all entities that have an EntityReplication component on all hosts
+	// each entity is serialized once, hosts only receive the components that changed since their last ack
+	// payloads are shared between hosts that need the same components
+	// entities with a relevance distance are only replicated on the hosts selected by SUpdateRelevance
 	//========================================================================================================
 	struct SUpdateReplication : EcsSystem
 	{
@@ -55,6 +60,13 @@ namespace fan
 			HostReplication& hostReplication;
 		};
 
+		// payload built for the hosts that need the components of the mask
+		struct MaskPayloadPair
+		{
+			uint32_t              mask;
+			ReplicationPayloadPtr payload;
+		};
+
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
 			// Get all HostManager/EcsHandle pairs
@@ -70,6 +82,8 @@ namespace fan
 			}
 
 			// Replicates entities on all hosts
+			HostReplication::EntitySnapshot snapshot;
+			std::vector< MaskPayloadPair >  payloads;
 			auto replicationIt = _view.begin<EntityReplication>();
 			for( ; replicationIt != _view.end<EntityReplication>(); ++replicationIt )
 			{
@@ -77,20 +91,48 @@ namespace fan
 				const EcsHandle handle = _world.GetHandle( entity );
 				const EntityReplication& entityReplication = *replicationIt;
                 fanAssert( handle != 0 );
-                const PacketReplication packet = HostReplication::BuildEntityPacket( _world,
-                                                                                     handle,
-                                                                                     entityReplication.mComponentTypes );
-				if( packet.mPacketData.getDataSize() > 0 )
+                if( HostReplication::BuildEntitySnapshot( _world,
+                                                          handle,
+                                                          entityReplication.mComponentTypes,
+                                                          snapshot ) )
 				{
+					// hosts in the same state share the same payload
+					payloads.clear();
 					for( HostManagerHandlePair& pair : hostReplications )
 					{
 						if( pair.handle != entityReplication.mExclude ) // do not replicate on this host
 						{
-							pair.hostReplication.Replicate( packet, HostReplication::None );
+							if( entityReplication.mRelevanceDistance > 0.f &&
+								!pair.hostReplication.IsReplicatedThisFrame( snapshot.mNetID ) )
+							{
+								continue;
+							}
+
+							const uint32_t changedMask = pair.hostReplication.GetChangedComponents( snapshot );
+							if( changedMask == 0 ) { continue; }
+
+							ReplicationPayloadPtr payload;
+							for( const MaskPayloadPair& maskPayload : payloads )
+							{
+								if( maskPayload.mask == changedMask ) { payload = maskPayload.payload; break; }
+							}
+							if( payload == nullptr )
+							{
+								payload = HostReplication::BuildEntityPayload( snapshot, changedMask );
+								payloads.push_back( { changedMask, payload } );
+							}
+							pair.hostReplication.ReplicateDelta( payload, snapshot.mNetID );
 						}
 					}
 				}
 			}
+
+			// forget the baselines of destroyed entities
+			const LinkingContext& linkingContext = _world.GetSingleton<LinkingContext>();
+			for( HostManagerHandlePair& pair : hostReplications )
+			{
+				pair.hostReplication.RemoveBaselines( linkingContext );
+			}
 		}
 	};
 }
\ No newline at end of file
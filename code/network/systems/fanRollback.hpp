@@ -1,5 +1,7 @@
+#include <algorithm>
 #include "core/ecs/fanEcsSystem.hpp"
 #include "network/components/fanClientRollback.hpp"
+#include "network/components/fanClientGameData.hpp"
 #include "network/singletons/fanTime.hpp"
 #include "game/singletons/fanClientNetworkManager.hpp"
 
@@ -9,6 +11,7 @@ namespace fan
 	// iterates over all ClientRollback components to save the state of the entity for the current frame
 	// EcsComponentInfo can contain rollback load/save methods for serializing rollback state,
 	// we need to iterate over all components to call them
+	// states are written directly in the frame buffer of the rollback ring
 	//========================================================================================================
 	struct SRollbackStateSave : EcsSystem
 	{
@@ -22,6 +25,7 @@ namespace fan
 			if( _delta == 0.f ) { return; }
 
 			const Time& time = _world.GetSingleton<Time>();
+			const EcsWorld& constWorld = _world;	// read only access, components versions are left unchanged
 
 			auto clientRollbackIt = _view.begin<ClientRollback>();
 			for( ; clientRollbackIt != _view.end<ClientRollback>(); ++clientRollbackIt )
@@ -29,6 +33,7 @@ namespace fan
 				ClientRollback& clientRollback = *clientRollbackIt;
 				const EcsEntity entity = clientRollbackIt.GetEntity();
 				const EcsSignature& signature = entity.mArchetype->GetSignature();
+				ClientRollback::FrameStates& frameStates = clientRollback.BeginFrameStates( time.mFrameIndex );
 
 				// iterates over all components and saves rollback state
 				for (int i = 0; i < _world.NumComponents(); i++)
@@ -38,15 +43,10 @@ namespace fan
 						const EcsComponentInfo& componentInfo = _world.IndexedGetComponentInfo( i );
 						if( componentInfo.rollbackSave != nullptr )
 						{
-							ClientRollback::RollbackData rollbackData;
-							rollbackData.mFrameIndex     = time.mFrameIndex;
-							rollbackData.mComponentIndex = i;
-
-							// save rollback state
-							const EcsComponent&  component = _world.IndexedGetComponent( entity, i );
-							componentInfo.rollbackSave( component, rollbackData.mData );
-                            fanAssert( rollbackData.mData.getDataSize() > 0 );
-							clientRollback.mRollbackDatas.push_back( rollbackData );
+							fanAssert( componentInfo.mRollbackSize > 0 );
+							const EcsComponent& component = constWorld.IndexedGetComponent( entity, i );
+							void* state = frameStates.Allocate( i, componentInfo.mRollbackSize );
+							componentInfo.rollbackSave( component, state );
 						}
 					}
 				}
@@ -56,7 +56,7 @@ namespace fan
 
 	//========================================================================================================
 	// iterates over all ClientRollback components
-	// to remove rollback states older than the current server state frame index
+	// to remove the frames older than the current server state frame index
 	//========================================================================================================
 	struct SRollbackRemoveOldStates : EcsSystem
 	{
@@ -73,20 +73,16 @@ namespace fan
 			const ClientNetworkManager& netManager = _world.GetSingleton<ClientNetworkManager>();
 			if( netManager.mPersistentHandle == 0 ){ return; }
 			const EcsEntity entity = _world.GetEntity( netManager.mPersistentHandle );
-			const ClientGameData& clientData = _world.GetComponent<ClientGameData>( entity );
+			const ClientGameData& clientData = _world.GetComponent<const ClientGameData>( entity );
 			const FrameIndex lastFrameIndex = clientData.mLastServerState.mFrameIndex;
 
 			auto clientRollbackIt = _view.begin<ClientRollback>();
 			for( ; clientRollbackIt != _view.end<ClientRollback>(); ++clientRollbackIt )
 			{
 				ClientRollback& clientRollback = *clientRollbackIt;
-
-				// remove older game states in the rollback components 
-                while( !clientRollback.mRollbackDatas.empty() &&
-                       ( ( clientRollback.mRollbackDatas.front().mFrameIndex < lastFrameIndex ) ||
-                         ( clientRollback.mRollbackDatas.size() > ClientRollback::sRollbackDatasMaxSize ) ) )
+				while( !clientRollback.Empty() && clientRollback.OldestFrameIndex() < lastFrameIndex )
 				{
-					clientRollback.mRollbackDatas.pop_front();
+					clientRollback.RemoveOldestFrameStates();
 				}
 			}
 		}
@@ -108,20 +104,20 @@ namespace fan
 			for( ; clientRollbackIt != _view.end<ClientRollback>(); ++clientRollbackIt )
 			{				
 				ClientRollback& clientRollback = *clientRollbackIt;
+				const ClientRollback::FrameStates* frameStates = clientRollback.GetFrameStates( _frameIndex );
+				if( frameStates == nullptr ) { continue; }
+
 				const EcsEntity entity = clientRollbackIt.GetEntity();
 				const EcsSignature& signature = entity.mArchetype->GetSignature();
-
-				// Iterates over all rollback Datas and load the ones with the correct frame index
-				for ( const ClientRollback::RollbackData& rollbackData : clientRollback.mRollbackDatas)
+				for( const ClientRollback::RollbackState& rollbackState : frameStates->mStates )
 				{
-					if( rollbackData.mFrameIndex == _frameIndex && signature[rollbackData.mComponentIndex] )
+					if( signature[rollbackState.mComponentIndex] )
 					{
-						const EcsComponentInfo& componentInfo = _world.IndexedGetComponentInfo( rollbackData.mComponentIndex );
+						const EcsComponentInfo& componentInfo = _world.IndexedGetComponentInfo( rollbackState.mComponentIndex );
 						fanAssert( componentInfo.rollbackLoad != nullptr );
 
-						EcsComponent& component = _world.IndexedGetComponent( entity, rollbackData.mComponentIndex );
-						sf::Packet dataCpy = rollbackData.mData;
-						componentInfo.rollbackLoad( component, dataCpy );												
+						EcsComponent& component = _world.IndexedGetComponent( entity, rollbackState.mComponentIndex );
+						componentInfo.rollbackLoad( component, frameStates->GetData( rollbackState ) );
 					}
 				}
 			}
@@ -130,7 +126,7 @@ namespace fan
 
 	//========================================================================================================
 	// Initialize rollback data :
-	// only keep the first frame of all entity rollback data if the RollbackNoOverwrite is not set
+	// only keep the oldest frame of all entity rollback data if the RollbackNoOverwrite is not set
 	// For now RollbackNoOverwrite is used only for player input,
 	// that way the player input is restored every frame and all other data (position, speed etc )
 	// is overridden with new state except for the first one
@@ -144,38 +140,24 @@ namespace fan
 
 		static void Run( EcsWorld& _world, const EcsView& _view )
 		{
-			std::vector<bool> firstStateFound( _world.NumComponents() );
-
 			auto clientRollbackIt = _view.begin<ClientRollback>();
 			for( ; clientRollbackIt != _view.end<ClientRollback>(); ++clientRollbackIt )
 			{
 				ClientRollback& clientRollback = *clientRollbackIt;
-				std::fill( firstStateFound.begin(), firstStateFound.end(), false );
+				if( clientRollback.Empty() ) { continue; }
 
-				// iterate over all components and only keep the first rollback state
-				// when RollbackNoOverwrite is not set
-				for (int i = 0; i < (int)clientRollback.mRollbackDatas.size();)
+				// the data of the removed states stays in the frame buffer until the frame is saved again
+				for( FrameIndex frameIndex = clientRollback.OldestFrameIndex() + 1;
+					 frameIndex <= clientRollback.NewestFrameIndex();
+					 frameIndex++ )
 				{
-					const ClientRollback::RollbackData& rollbackData = clientRollback.mRollbackDatas[i];
-					const EcsComponentInfo& componentInfo = _world.IndexedGetComponentInfo( rollbackData.mComponentIndex );
-					if( ( componentInfo.mFlags & EcsComponentInfo::RollbackNoOverwrite ) == 0 )
-					{
-						if( firstStateFound[rollbackData.mComponentIndex] )
+					std::vector<ClientRollback::RollbackState>& states = clientRollback.GetFrameStates( frameIndex )->mStates;
+					states.erase( std::remove_if( states.begin(), states.end(),
+						[&_world]( const ClientRollback::RollbackState& _state )
 						{
-							clientRollback.mRollbackDatas.erase( clientRollback.mRollbackDatas.begin() + i );
-							// do not increment i,
-							// we already advanced to the next element by erasing the current element.
-						}
-						else
-						{
-							firstStateFound[rollbackData.mComponentIndex] = true;
-							++i;
-						}
-					}
-					else
-					{
-						++i;
-					}
+							const EcsComponentInfo& info = _world.IndexedGetComponentInfo( _state.mComponentIndex );
+							return ( info.mFlags & EcsComponentInfo::RollbackNoOverwrite ) == 0;
+						} ), states.end() );
 				}
 			}
 		}
@@ -1,14 +1,17 @@
 #include "core/ecs/fanEcsSystem.hpp"
+#include "network/fanUDPSocket.hpp"
 #include "network/components/fanHostConnection.hpp"
 #include "network/components/fanHostGameData.hpp"
 #include "network/components/fanHostReplication.hpp"
 #include "network/components/fanReliabilityLayer.hpp"
+#include "network/singletons/fanNetStats.hpp"
 #include "game/singletons/fanGame.hpp"
 
 namespace fan
 {
 	//========================================================================================================
 	// Sends packets to all hosts
+	// replication data is split in datagrams of UdpSocket::maxPacketSize bytes within the host bandwidth budget
 	//========================================================================================================
 	struct SServerSend : EcsSystem
 	{
@@ -27,6 +30,7 @@ namespace fan
 
 			const Time& time = _world.GetSingleton<Time>();
 			ServerConnection& connection = _world.GetSingleton<ServerConnection>();
+			NetStats& stats = _world.GetSingleton<NetStats>();
 
 			auto hostConnectionIt = _view.begin<HostConnection>();
 			auto hostDataIt = _view.begin<HostGameData>();
@@ -40,46 +44,70 @@ namespace fan
 				HostReplication& hostReplication = *hostReplicationIt;
 				ReliabilityLayer& reliabilityLayer = *reliabilityLayerIt;
 
-				// create new packet			
-				Packet packet( reliabilityLayer.GetNextPacketTag() );
-
-				// write game data
-				if( hostData.mSpaceshipID != 0 )
+				// the budget only limits the replication, game & connection data are always sent
+				hostConnection.UpdateBandwidthBudget( time.mLogicDelta );
+				const EcsEntity entity = hostDataIt.GetEntity();
+				size_t sentBytes = 0;
+				for( int packetIndex = 0; packetIndex < HostConnection::sMaxPacketsPerFrame; packetIndex++ )
 				{
-					if( hostData.mNextPlayerState.mFrameIndex == time.mFrameIndex )
+					// create new packet
+					const bool isFirstPacket = packetIndex == 0;
+					Packet packet( reliabilityLayer.GetNextPacketTag() );
+					size_t maxSize = UdpSocket::maxPacketSize;
+
+					// write game data
+					if( isFirstPacket )
 					{
-						hostData.mNextPlayerState.Write( packet );
+						if( hostData.mSpaceshipID != 0 )
+						{
+							if( hostData.mNextPlayerState.mFrameIndex == time.mFrameIndex )
+							{
+								hostData.mNextPlayerState.Write( packet );
+							}
+						}
+						hostConnection.Write( _world, entity, packet );
+						maxSize -= std::min( maxSize, reliabilityLayer.GetAckSize() );
 					}
-				}
 
-				const EcsEntity entity = hostDataIt.GetEntity();
-				hostConnection.Write( _world, entity, packet );
-				hostReplication.Write( _world, entity, packet );
+					// fills the packet with replication data
+					const size_t budget = packet.GetSize() + size_t( std::max( 0.f, hostConnection.mAvailableBytes ) );
+					hostReplication.Write( _world, entity, packet, std::min( maxSize, budget ) );
 
-				// write ack
-				if( packet.GetSize() == sizeof( PacketTag ) ) { packet.mOnlyContainsAck = true; }
-				reliabilityLayer.Write( packet );
+					// write ack
+					if( isFirstPacket )
+					{
+						if( packet.GetSize() == sizeof( PacketTag ) ) { packet.mOnlyContainsAck = true; }
+						reliabilityLayer.Write( packet );
+					}
 
-				// send packet
-				if( packet.GetSize() > sizeof( PacketTag ) )// don't send empty packets
-				{
-					reliabilityLayer.RegisterPacket( packet );
-                    hostConnection.mBandwidth = 1.f /
-                                                time.mLogicDelta *
-                                                float( packet.GetSize() ) /
-                                                1000.f; // in Ko/s
-					connection.mSocket.Send( packet, hostConnection.mIp, hostConnection.mPort );
-				}
-				else
-				{
-					reliabilityLayer.mNextPacketTag--;
+					// send packet
+					if( packet.GetSize() > sizeof( PacketTag ) )// don't send empty packets
+					{
+						reliabilityLayer.RegisterPacket( _world, packet );
+						connection.mNetworkThread.Send( packet, hostConnection.mIp, hostConnection.mPort );
+						stats.OnSend( packet, hostConnection.mStatsIndex );
+						sentBytes += packet.GetSize();
+						hostConnection.mAvailableBytes -= float( packet.GetSize() );
+					}
+					else
+					{
+						reliabilityLayer.mNextPacketTag--;
+						break;
+					}
+
+					if( !hostReplication.HasDataToSend() || hostConnection.mAvailableBytes <= 0.f ) { break; }
 				}
+				hostReplication.ClearUnsentEntities();
+				stats.AddRetransmissions( hostReplication.mNumRetransmissions, hostConnection.mStatsIndex );
+				hostReplication.mNumRetransmissions = 0;
+                hostConnection.mBandwidth = 1.f / time.mLogicDelta * float( sentBytes ) / 1000.f; // in Ko/s
 			}
 		}
 	};
 
 	//========================================================================================================
 	// Receives packets from all hosts
+	// datagrams are received by the network thread & timestamped on reception
 	//========================================================================================================
 	struct SServerReceive : EcsSystem
 	{
@@ -90,17 +118,19 @@ namespace fan
 			HostManager& hostManager = _world.GetSingleton<HostManager>();
 			ServerConnection& connection = _world.GetSingleton<ServerConnection>();
 			Time& time = _world.GetSingleton<Time>();
+			NetStats& stats = _world.GetSingleton<NetStats>();
 
 			// receive
 			Packet			packet;
 			sf::IpAddress	receiveIP;
 			unsigned short	receivePort;
+			double			receiveTime;
 
 			sf::Socket::Status socketStatus;
 			do
 			{
 				packet.Clear();
-				socketStatus = connection.mSocket.Receive( packet, receiveIP, receivePort );
+				socketStatus = connection.mNetworkThread.Receive( packet, receiveIP, receivePort, receiveTime );
 
 				// Don't receive from itself
 				if( receivePort == connection.mServerPort ) { continue; }
@@ -120,7 +150,8 @@ namespace fan
 					HostGameData& hostData = _world.GetComponent< HostGameData >( entity );
 					ReliabilityLayer& reliabilityLayer = _world.GetComponent<ReliabilityLayer>( entity );
 					HostConnection& hostConnection = _world.GetComponent<HostConnection>( entity );
-					hostConnection.mLastResponseTime = Time::ElapsedSinceStartup();
+					hostConnection.mLastResponseTime = receiveTime;
+					stats.OnReceive( packet, hostConnection.mStatsIndex );
 
 					// read the first packet type separately
 					PacketType packetType = packet.ReadType();
@@ -145,13 +176,14 @@ namespace fan
 					bool packetValid = true;
 					while( packetValid )
 					{
+						stats.OnReceive( packetType );
 						switch( packetType )
 						{
 						case PacketType::Ack:
 						{
 							PacketAck packetAck;
 							packetAck.Read( packet );
-							reliabilityLayer.ProcessPacket( packetAck );
+							reliabilityLayer.ProcessPacket( _world, packetAck );
 						}break;
 						case PacketType::Hello:
 						{
@@ -165,7 +197,7 @@ namespace fan
 							packetDisconnect.Read( packet );
 							hostManager.DeleteHost( _world, clientHandle );
 							EcsEntity clientEntity = _world.GetEntity( clientHandle );
-							const HostGameData& hostGameData = _world.GetComponent< HostGameData>( clientEntity );
+							const HostGameData& hostGameData = _world.GetComponent< const HostGameData>( clientEntity );
 							if( hostGameData.mSpaceshipID != 0 )
 							{
                                 _world.Run<SReplicateOnAllHosts>( ClientRPC::RPCDespawn( hostGameData.mSpaceshipID ),
@@ -177,7 +209,8 @@ namespace fan
 						{
 							PacketPing packetPing;
 							packetPing.Read( packet );
-							hostConnection.ProcessPacket( packetPing, time.mFrameIndex, time.mLogicDelta );
+							hostConnection.ProcessPacket( packetPing, time.mFrameIndex, time.mLogicDelta, receiveTime );
+							stats.AddRtt( hostConnection.mRtt, hostConnection.mStatsIndex );
 						} break;
 						case PacketType::PlayerInput:
 						{
@@ -185,7 +218,7 @@ namespace fan
 							packetInput.Read( packet );
 							if( hostConnection.mState == HostConnection::Connected )
 							{
-								hostData.ProcessPacket( packetInput );
+								hostData.ProcessPacket( packetInput, time.mFrameIndex );
 							}
 						} break;
 						default:
@@ -31,7 +31,6 @@ namespace fan
 
 			LinkingContext& linkingContext = _world.GetSingleton<LinkingContext>();
 			SpawnManager& spawnManager = _world.GetSingleton<SpawnManager>();
-			HostManager& hostManager = _world.GetSingleton<HostManager>();
 			const Time& time = _world.GetSingleton<Time>();
 
 			auto hostConnectionIt = _view.begin<HostConnection>();
@@ -59,36 +58,8 @@ namespace fan
 					hostData.mNextPlayerStateFrame = spawnFrame + 60; // timing of the first state snapshot
 					spawnManager.spawns.push_back( spawnInfo );		  // triggers spaceship spawn on server
 					
-					// spawn new ship on all hosts
-                    _world.Run<SReplicateOnAllHosts>( ClientRPC::RPCSpawn( spawnInfo ),
-                                                      HostReplication::ResendUntilReplicated );
-
-					// replicate all other hosts on new host
-					for( const auto& pair : hostManager.mHostHandles )
-					{
-						// do not replicate  itself
-						const EcsHandle otherHostHandle = pair.second;
-						if( otherHostHandle == hostHandle )
-						{
-							continue;
-						}	
-
-						// replicate all other ships that are already spawned
-						EcsEntity otherHostEntity = _world.GetEntity( otherHostHandle );
-						HostGameData& otherHostData = _world.GetComponent< HostGameData >( otherHostEntity );
-						if( otherHostData.mSpaceshipID != 0 )
-						{
-                            const SpawnInfo otherHostspawnInfo = spawn::SpawnShip::GenerateInfo(
-                                    otherHostHandle,
-                                    spawnFrame,
-                                    otherHostData.mSpaceshipID,
-                                    btVector3::Zero() );
-							hostReplication.Replicate(
-								ClientRPC::RPCSpawn( otherHostspawnInfo )
-								, HostReplication::ResendUntilReplicated
-							);
-						}						
-					}
+					// spawn new ship on its host, other hosts spawn it when it becomes relevant ( SUpdateRelevance )
+					hostReplication.Replicate( ClientRPC::RPCSpawn( spawnInfo ), HostReplication::ResendUntilReplicated );
 
 					// replicates solar eruption spawn
 					const SolarEruption& solarEruption = _world.GetSingleton<SolarEruption>();
@@ -201,8 +172,8 @@ namespace fan
 				if( hostData.mSpaceshipHandle != 0 && time.mFrameIndex >= hostData.mNextPlayerStateFrame )
 				{
 					const EcsEntity shipEntityID = _world.GetEntity( hostData.mSpaceshipHandle );
-					const Rigidbody& rb = _world.GetComponent<Rigidbody>( shipEntityID );
-					const Transform& transform = _world.GetComponent<Transform>( shipEntityID );
+					const Rigidbody& rb = _world.GetComponent<const Rigidbody>( shipEntityID );
+					const Transform& transform = _world.GetComponent<const Transform>( shipEntityID );
 					hostData.mNextPlayerState.mFrameIndex      = time.mFrameIndex;
 					hostData.mNextPlayerState.mPosition        = transform.GetPosition();
 					hostData.mNextPlayerState.mOrientation     = transform.GetRotationEuler();
@@ -234,44 +205,21 @@ namespace fan
                  hostDataIt != _view.end<HostGameData>();
                  ++hostDataIt )
 			{
-				HostGameData& hostData = *hostDataIt;
+				const HostGameData& hostData = *hostDataIt;
 
-				if( hostData.mSpaceshipID != 0 )
+				if( hostData.mSpaceshipID != 0 && hostData.mSpaceshipHandle != 0 )
 				{
-					// Get the current input (current frame) for this client
-					while( !hostData.mInputs.empty() )
+					// Updates spaceship input with the input of the current frame for this client
+					const PacketInput::InputData* inputData = hostData.GetInput( time.mFrameIndex );
+					if( inputData != nullptr )
 					{
-						const PacketInput::InputData& inputData = hostData.mInputs.front();
-                        if( inputData.mFrameIndex < time.mFrameIndex ||
-                            inputData.mFrameIndex > time.mFrameIndex + 60 )
-						{
-							hostData.mInputs.pop();
-						}
-						else
-						{
-							break;
-						}
-					}
-
-					if( hostData.mSpaceshipHandle != 0 )
-					{
-						// Updates spaceship input
-                        if( !hostData.mInputs.empty() &&
-                            hostData.mInputs.front().mFrameIndex == time.mFrameIndex )
-						{
-							const PacketInput::InputData& inputData = hostData.mInputs.front();
-							hostData.mInputs.pop();
-
-							const EcsEntity shipEntityID = _world.GetEntity( hostData.mSpaceshipHandle );
-							PlayerInput& input = _world.GetComponent<PlayerInput>( shipEntityID );
-                            input.mOrientation = btVector3( inputData.mOrientation.x,
-                                                            0.f,
-                                                            inputData.mOrientation.y );
-							input.mLeft        = inputData.mLeft ? 1.f : ( inputData.mRight ? -1.f : 0.f );
-							input.mForward     = inputData.mForward ? 1.f : ( inputData.mBackward ? -1.f : 0.f );
-							input.mBoost       = inputData.mBoost;
-							input.mFire        = inputData.mFire;
-						}
+						const EcsEntity shipEntityID = _world.GetEntity( hostData.mSpaceshipHandle );
+						PlayerInput& input = _world.GetComponent<PlayerInput>( shipEntityID );
+						input.mOrientation = PacketInput::DequantizeOrientation( inputData->mOrientation );
+						input.mLeft        = inputData->mLeft ? 1.f : ( inputData->mRight ? -1.f : 0.f );
+						input.mForward     = inputData->mForward ? 1.f : ( inputData->mBackward ? -1.f : 0.f );
+						input.mBoost       = inputData->mBoost;
+						input.mFire        = inputData->mFire;
 					}
 				}
 			}
@@ -64,30 +64,14 @@ namespace fan
 		{
 			return _world.GetSignature<ReliabilityLayer>();
 		}
-		static void Run( EcsWorld& /*_world*/, const EcsView& _view )
+		static void Run( EcsWorld& _world, const EcsView& _view )
         {
+            const double timoutTime = Time::ElapsedSinceStartup() - ReliabilityLayer::sTimeoutDuration;
             for( auto reliabilityLayerIt = _view.begin<ReliabilityLayer>();
                  reliabilityLayerIt != _view.end<ReliabilityLayer>();
                  ++reliabilityLayerIt )
 			{
-				ReliabilityLayer& reliabilityLayer = *reliabilityLayerIt;
-
-				const double timoutTime = Time::ElapsedSinceStartup() - reliabilityLayer.sTimeoutDuration;
-
-				//packets are sorted, so all timed out packets must be at front
-				while( !reliabilityLayer.mInFlightPackets.empty() )
-				{
-					ReliabilityLayer::InFlightPacket& inFlightPacket = reliabilityLayer.mInFlightPackets.front();
-					if( inFlightPacket.mTimeDispatch < timoutTime ) // packet timed out
-					{
-						inFlightPacket.mOnFailure.Emmit( inFlightPacket.mTag );
-						reliabilityLayer.mInFlightPackets.pop();
-					}
-					else // no packets beyond could be timed out
-					{
-						break;
-					}
-				}
+				( *reliabilityLayerIt ).ProcessTimedOutPackets( _world, timoutTime );
 			}
 		}
 	};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "core/unit_tests/fanBenchmark.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "core/ecs/fanEcsComponent.hpp"
+#include "network/fanBitStream.hpp"
+#include "network/components/fanHostReplication.hpp"
+#include "network/components/fanEntityReplication.hpp"
+#include "network/singletons/fanHostManager.hpp"
+#include "network/singletons/fanLinkingContext.hpp"
+#include "network/singletons/fanNetStats.hpp"
+#include "network/singletons/fanTime.hpp"
+#include "network/systems/fanHostReplication.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // replicated the same way as a transform ( position + rotation )
+    //========================================================================================================
+    struct BenchmarkReplicatedComponent : public EcsComponent
+    {
+        ECS_COMPONENT( BenchmarkReplicatedComponent )
+        static void SetInfo( EcsComponentInfo& _info )
+        {
+            _info.netSave = &BenchmarkReplicatedComponent::NetSave;
+            _info.netLoad = &BenchmarkReplicatedComponent::NetLoad;
+        }
+        static void Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
+        {
+            BenchmarkReplicatedComponent& replicated = static_cast<BenchmarkReplicatedComponent&>( _component );
+            for( int i = 0; i < 6; i++ ){ replicated.mValues[i] = 0.f; }
+        }
+        static void NetSave( const EcsComponent& _component, BitWriter& _writer )
+        {
+            const BenchmarkReplicatedComponent& replicated = static_cast<const BenchmarkReplicatedComponent&>( _component );
+            for( int i = 0; i < 6; i++ ){ _writer.WriteFloat( replicated.mValues[i] ); }
+        }
+        static void NetLoad( EcsComponent& _component, BitReader& _reader )
+        {
+            BenchmarkReplicatedComponent& replicated = static_cast<BenchmarkReplicatedComponent&>( _component );
+            for( int i = 0; i < 6; i++ ){ replicated.mValues[i] = _reader.ReadFloat(); }
+        }
+        float mValues[6];
+    };
+
+    //========================================================================================================
+    // replicates entities on hosts like the server does every frame, half of the entities are moving
+    // packets are acknowledged right after being written, their size is not limited
+    //========================================================================================================
+    class BenchmarkReplication : public Benchmark<BenchmarkReplication>
+    {
+    public:
+        static std::vector<BenchmarkMethod> GetBenchmarks()
+        {
+            return { { &BenchmarkReplication::BenchmarkReplicate, "replication" } };
+        }
+        void Create() override {}
+        void Destroy() override {}
+
+        static constexpr int    sNumFrames     = 60;
+        static constexpr size_t sUnlimitedSize = std::numeric_limits<size_t>::max(); // measures the whole replication
+
+        //====================================================================================================
+        //====================================================================================================
+        static void CreateWorld( EcsWorld& _world, const int _numHosts, const int _numEntities )
+        {
+            _world.AddComponentType<BenchmarkReplicatedComponent>();
+            _world.AddComponentType<HostReplication>();
+            _world.AddComponentType<EntityReplication>();
+            _world.AddSingletonType<LinkingContext>();
+            _world.AddSingletonType<HostManager>();
+            _world.AddSingletonType<Time>();
+            _world.AddSingletonType<NetStats>();
+
+            HostManager& hostManager = _world.GetSingleton<HostManager>();
+            for( int i = 0; i < _numHosts; i++ )
+            {
+                EcsEntity entity = _world.CreateEntity();
+                _world.AddComponent<HostReplication>( entity );
+                const EcsHandle handle = _world.AddHandle( entity );
+                hostManager.mHostHandles[{ IpAddress( sf::Uint32( i + 1 ) ), Port( 1000 ) }] = handle;
+            }
+
+            LinkingContext& linkingContext = _world.GetSingleton<LinkingContext>();
+            for( int i = 0; i < _numEntities; i++ )
+            {
+                EcsEntity entity = _world.CreateEntity();
+                _world.AddComponent<BenchmarkReplicatedComponent>( entity );
+                EntityReplication& entityReplication = _world.AddComponent<EntityReplication>( entity );
+                entityReplication.mComponentTypes = { BenchmarkReplicatedComponent::Info::sType };
+                linkingContext.AddEntity( _world.AddHandle( entity ), linkingContext.mNextNetID++ );
+            }
+            _world.ApplyTransitions();
+        }
+
+        //====================================================================================================
+        //====================================================================================================
+        void BenchmarkReplicate()
+        {
+            for( int numHosts : { 1, 8, 32 } )
+            {
+                for( int numEntities : { 100, 1000 } )
+                {
+                    EcsWorld world;
+                    CreateWorld( world, numHosts, numEntities );
+                    const EcsView hostsView = world.Match( world.GetSignature<HostReplication>() );
+                    const EcsView entitiesView = world.Match( world.GetSignature<BenchmarkReplicatedComponent>() );
+                    PacketTag tag = 0;
+
+                    const std::string name = std::to_string( numHosts ) + " hosts x " +
+                                             std::to_string( numEntities ) + " entities";
+                    Measure( name, sNumFrames, [&]()
+                    {
+                        int index = 0;
+                        auto it = entitiesView.begin<BenchmarkReplicatedComponent>();
+                        for( ; it != entitiesView.end<BenchmarkReplicatedComponent>(); ++it, ++index )
+                        {
+                            if( index % 2 == 0 ) { ( *it ).mValues[0] += 1.f; }
+                        }
+
+                        world.Run<SUpdateReplication>();
+
+                        auto hostIt = hostsView.begin<HostReplication>();
+                        for( ; hostIt != hostsView.end<HostReplication>(); ++hostIt )
+                        {
+                            Packet packet( tag++ );
+                            ( *hostIt ).Write( world, hostIt.GetEntity(), packet, sUnlimitedSize );
+                            ( *hostIt ).ClearUnsentEntities();
+                            packet.mOnSuccess.Emmit( world, packet.mTag );
+                        }
+                    } );
+                }
+            }
+        }
+    };
+}
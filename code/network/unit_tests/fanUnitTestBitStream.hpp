@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cmath>
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "network/fanBitStream.hpp"
+#include "network/fanQuantization.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    class UnitTestBitStream : public UnitTest<UnitTestBitStream>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestBitStream::TestBits,                "Bits" },
+                     { &UnitTestBitStream::TestVarUint,             "Var uint" },
+                     { &UnitTestBitStream::TestAlign,               "Align" },
+                     { &UnitTestBitStream::TestOverflow,            "Overflow" },
+                     { &UnitTestBitStream::TestQuantizedFloat,      "Quantized float" },
+                     { &UnitTestBitStream::TestQuantizedQuaternion, "Quantized quaternion" },
+                     { &UnitTestBitStream::TestQuantizedDirection,  "Quantized direction" },
+            };
+        }
+        void Create() override {}
+        void Destroy() override {}
+
+        BitWriter mWriter;
+
+        void TestBits()
+        {
+            mWriter.Clear();
+            mWriter.WriteBits( 5, 3 );
+            mWriter.WriteBool( true );
+            mWriter.WriteBits( 0xABCDEF12, 32 );
+            mWriter.WriteBits( 0x3FF, 10 );
+            mWriter.WriteFloat( -3.25f );
+            TEST_ASSERT( mWriter.GetNumBits() == 3 + 1 + 32 + 10 + 32 );
+            TEST_ASSERT( mWriter.GetNumBytes() == 10 );
+
+            BitReader reader( mWriter.GetData(), mWriter.GetNumBytes() );
+            TEST_ASSERT( reader.ReadBits( 3 ) == 5 );
+            TEST_ASSERT( reader.ReadBool() );
+            TEST_ASSERT( reader.ReadBits( 32 ) == 0xABCDEF12 );
+            TEST_ASSERT( reader.ReadBits( 10 ) == 0x3FF );
+            TEST_ASSERT( reader.ReadFloat() == -3.25f );
+            TEST_ASSERT( !reader.IsOverflow() );
+        }
+
+        void TestVarUint()
+        {
+            mWriter.Clear();
+            mWriter.WriteVarUint( 0 );
+            mWriter.WriteVarUint( 127 );
+            TEST_ASSERT( mWriter.GetNumBytes() == 2 );
+            mWriter.WriteVarUint( 128 );
+            TEST_ASSERT( mWriter.GetNumBytes() == 4 );
+            mWriter.WriteVarUint( 0xFFFFFFFF );
+
+            BitReader reader( mWriter.GetData(), mWriter.GetNumBytes() );
+            TEST_ASSERT( reader.ReadVarUint() == 0 );
+            TEST_ASSERT( reader.ReadVarUint() == 127 );
+            TEST_ASSERT( reader.ReadVarUint() == 128 );
+            TEST_ASSERT( reader.ReadVarUint() == 0xFFFFFFFF );
+            TEST_ASSERT( !reader.IsOverflow() );
+        }
+
+        void TestAlign()
+        {
+            mWriter.Clear();
+            mWriter.WriteBits( 1, 1 );
+            mWriter.Align();
+            TEST_ASSERT( mWriter.GetNumBits() == 8 );
+            mWriter.Align();
+            TEST_ASSERT( mWriter.GetNumBits() == 8 );
+            const uint8_t bytes[3] = { 1, 2, 3 };
+            mWriter.WriteBytes( bytes, 3 );
+
+            BitReader reader( mWriter.GetData(), mWriter.GetNumBytes() );
+            TEST_ASSERT( reader.ReadBool() );
+            reader.Align();
+            uint8_t readBytes[3];
+            reader.ReadBytes( readBytes, 3 );
+            TEST_ASSERT( readBytes[0] == 1 && readBytes[1] == 2 && readBytes[2] == 3 );
+            TEST_ASSERT( reader.GetNumBitsLeft() == 0 );
+        }
+
+        void TestOverflow()
+        {
+            mWriter.Clear();
+            for( int i = 0; i < BitWriter::sCapacity / 4; i++ ) { mWriter.WriteBits( i, 32 ); }
+            TEST_ASSERT( !mWriter.IsOverflow() );
+            mWriter.WriteBool( true );
+            TEST_ASSERT( mWriter.IsOverflow() );
+            TEST_ASSERT( mWriter.GetNumBytes() == BitWriter::sCapacity );
+
+            const uint8_t data[2] = { 0xFF, 0xFF };
+            BitReader reader( data, 2 );
+            TEST_ASSERT( reader.ReadBits( 12 ) == 0xFFF );
+            TEST_ASSERT( reader.ReadBits( 8 ) == 0 );
+            TEST_ASSERT( reader.IsOverflow() );
+        }
+
+        void TestQuantizedFloat()
+        {
+            const QuantizedFloat quantized = { -64.f, 64.f, 12 };
+            TEST_ASSERT( quantized.Dequantize( quantized.Quantize( 0.f ) ) == 0.f );
+            TEST_ASSERT( quantized.Dequantize( quantized.Quantize( 64.f ) ) == 64.f );
+            TEST_ASSERT( quantized.Dequantize( quantized.Quantize( -64.f ) ) == -64.f );
+            TEST_ASSERT( quantized.Dequantize( quantized.Quantize( 1000.f ) ) == 64.f );
+
+            mWriter.Clear();
+            for( float value = -70.f; value < 70.f; value += 1.37f ) { quantized.Write( mWriter, value ); }
+            BitReader reader( mWriter.GetData(), mWriter.GetNumBytes() );
+            for( float value = -70.f; value < 70.f; value += 1.37f )
+            {
+                const float expected = std::fmax( -64.f, std::fmin( 64.f, value ) );
+                TEST_ASSERT( std::abs( quantized.Read( reader ) - expected ) <= 0.5f * quantized.GetPrecision() + 1e-4f );
+            }
+        }
+
+        void TestQuantizedDirection()
+        {
+            const QuantizedDirection quantized = { 12 };
+            TEST_ASSERT( quantized.Quantize( btVector3( 1, 0, 0 ) ) == 0 );
+            TEST_ASSERT( quantized.Quantize( btVector3( 0, 0, 0 ) ) == 0 );
+            TEST_ASSERT( quantized.Quantize( btVector3( 0, 0, 1 ) ) == 1024 );
+            TEST_ASSERT( quantized.Quantize( btVector3( -1, 0, 0 ) ) == 2048 );
+            TEST_ASSERT( quantized.Quantize( btVector3( 0, 0, -1 ) ) == 3072 );
+            TEST_ASSERT( quantized.Delta( 4090, 5 ) == 11 );
+            TEST_ASSERT( quantized.Delta( 5, 4090 ) == -11 );
+
+            for( float angle = -3.f; angle < 3.f; angle += 0.1f )
+            {
+                const btVector3 direction( std::cos( angle ), 0.f, std::sin( angle ) );
+                const uint32_t  value  = quantized.Quantize( 5.f * direction );
+                const btVector3 result = quantized.Dequantize( value );
+                TEST_ASSERT( std::abs( result.length() - 1.f ) < 1e-5f );
+                TEST_ASSERT( result.angle( direction ) < SIMD_PI / quantized.GetNumSteps() + 1e-4f );
+                TEST_ASSERT( quantized.Quantize( result ) == value );   // stable once quantized
+            }
+        }
+
+        void TestQuantizedQuaternion()
+        {
+            const QuantizedQuaternion quantized = { 10 };
+            const btQuaternion quaternions[] = { btQuaternion::getIdentity(),
+                                                 btQuaternion( btVector3( 0, 1, 0 ), 2.5f ),
+                                                 btQuaternion( btVector3( 0, 1, 0 ), -1.f ),
+                                                 btQuaternion( btVector3( 1, 2, 3 ).normalized(), 1.2f ),
+                                                 btQuaternion( -0.1f, 0.2f, -0.9f, 0.3f ).normalized() };
+            mWriter.Clear();
+            for( const btQuaternion& quaternion : quaternions ) { quantized.Write( mWriter, quaternion ); }
+            TEST_ASSERT( mWriter.GetNumBits() == 5 * ( 2 + 3 * 10 ) );
+
+            BitReader reader( mWriter.GetData(), mWriter.GetNumBytes() );
+            for( const btQuaternion& quaternion : quaternions )
+            {
+                const btQuaternion result = quantized.Read( reader );
+                TEST_ASSERT( std::abs( std::abs( result.dot( quaternion ) ) - 1.f ) < 1e-4f );
+            }
+        }
+    };
+}
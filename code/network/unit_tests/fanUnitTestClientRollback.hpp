@@ -0,0 +1,183 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "network/components/fanClientRollback.hpp"
+#include "network/systems/fanRollback.hpp"
+#include "network/singletons/fanTime.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // rollback methods of the test components, the rollback state is a single int
+    //========================================================================================================
+    template< typename _ComponentType >
+    struct TestRollbackMethods
+    {
+        static void SetInfo( EcsComponentInfo& _info )
+        {
+            _info.rollbackSave  = &RollbackSave;
+            _info.rollbackLoad  = &RollbackLoad;
+            _info.mRollbackSize = sizeof( int );
+        }
+        static void Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
+        {
+            static_cast<_ComponentType&>( _component ).mValue = 0;
+        }
+        static void RollbackSave( const EcsComponent& _component, void* _state )
+        {
+            *static_cast<int*>( _state ) = static_cast<const _ComponentType&>( _component ).mValue;
+        }
+        static void RollbackLoad( EcsComponent& _component, const void* _state )
+        {
+            static_cast<_ComponentType&>( _component ).mValue = *static_cast<const int*>( _state );
+        }
+    };
+
+    //========================================================================================================
+    //========================================================================================================
+    struct TestRollbackState : public EcsComponent
+    {
+        ECS_COMPONENT( TestRollbackState )
+        static void SetInfo( EcsComponentInfo& _info ) { TestRollbackMethods<TestRollbackState>::SetInfo( _info ); }
+        static void Init( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component )
+        {
+            TestRollbackMethods<TestRollbackState>::Init( _world, _entity, _component );
+        }
+        int mValue;
+    };
+
+    //========================================================================================================
+    // restored every frame during a rollback, like the player input
+    //========================================================================================================
+    struct TestRollbackInput : public EcsComponent
+    {
+        ECS_COMPONENT( TestRollbackInput )
+        static void SetInfo( EcsComponentInfo& _info )
+        {
+            TestRollbackMethods<TestRollbackInput>::SetInfo( _info );
+            _info.mFlags |= EcsComponentInfo::RollbackNoOverwrite;
+        }
+        static void Init( EcsWorld& _world, EcsEntity _entity, EcsComponent& _component )
+        {
+            TestRollbackMethods<TestRollbackInput>::Init( _world, _entity, _component );
+        }
+        int mValue;
+    };
+
+    //========================================================================================================
+    //========================================================================================================
+    class UnitTestClientRollback : public UnitTest<UnitTestClientRollback>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestClientRollback::TestFrameRing,    "Frame ring" },
+                     { &UnitTestClientRollback::TestSkippedFrames, "Skipped frames" },
+                     { &UnitTestClientRollback::TestSaveRestore,  "Save restore" },
+                     { &UnitTestClientRollback::TestInit,         "Init" },
+            };
+        }
+        void Create() override
+        {
+            mWorld = new EcsWorld();
+            mWorld->AddSingletonType<Time>();
+            mWorld->AddComponentType<ClientRollback>();
+            mWorld->AddComponentType<TestRollbackState>();
+            mWorld->AddComponentType<TestRollbackInput>();
+            EcsEntity entity = mWorld->CreateEntity();
+            mWorld->AddComponent<ClientRollback>( entity );
+            mWorld->AddComponent<TestRollbackState>( entity );
+            mWorld->AddComponent<TestRollbackInput>( entity );
+            mHandle = mWorld->AddHandle( entity );
+            mWorld->ApplyTransitions();
+        }
+        void Destroy() override { delete mWorld; }
+
+        EcsWorld* mWorld;
+        EcsHandle mHandle;
+
+        template< typename _ComponentType > _ComponentType& Get()
+        {
+            return mWorld->GetComponent<_ComponentType>( mWorld->GetEntity( mHandle ) );
+        }
+
+        // saves the frame with both values set to _value
+        void SaveFrame( const FrameIndex _frameIndex, const int _value )
+        {
+            mWorld->GetSingleton<Time>().mFrameIndex = _frameIndex;
+            Get<TestRollbackState>().mValue = _value;
+            Get<TestRollbackInput>().mValue = _value;
+            mWorld->Run<SRollbackStateSave>( 1.f );
+        }
+
+        void TestFrameRing()
+        {
+            ClientRollback& rollback = Get<ClientRollback>();
+            TEST_ASSERT( rollback.Empty() );
+            TEST_ASSERT( rollback.GetFrameStates( 0 ) == nullptr );
+
+            for( FrameIndex i = 10; i < 10 + ClientRollback::sMaxFrames + 5; i++ ) { SaveFrame( i, i ); }
+            TEST_ASSERT( rollback.NumFrames() == ClientRollback::sMaxFrames );
+            TEST_ASSERT( rollback.OldestFrameIndex() == 15 );
+            TEST_ASSERT( rollback.GetFrameStates( 14 ) == nullptr );
+            TEST_ASSERT( rollback.GetFrameStates( 15 ) != nullptr );
+            TEST_ASSERT( rollback.GetFrameStates( 15 )->mStates.size() == 2 );
+
+            rollback.RemoveOldestFrameStates();
+            TEST_ASSERT( rollback.OldestFrameIndex() == 16 );
+            TEST_ASSERT( rollback.GetFrameStates( 15 ) == nullptr );
+
+            // overwrites a saved frame without changing the range
+            SaveFrame( 20, 42 );
+            TEST_ASSERT( rollback.NumFrames() == ClientRollback::sMaxFrames - 1 );
+            TEST_ASSERT( rollback.NewestFrameIndex() == 10 + ClientRollback::sMaxFrames + 4 );
+        }
+
+        void TestSkippedFrames()
+        {
+            ClientRollback& rollback = Get<ClientRollback>();
+            SaveFrame( 1, 1 );
+            SaveFrame( 2, 2 );
+            SaveFrame( 10, 10 );
+            TEST_ASSERT( rollback.NumFrames() == 1 );
+            TEST_ASSERT( rollback.OldestFrameIndex() == 10 );
+            TEST_ASSERT( rollback.GetFrameStates( 2 ) == nullptr );
+        }
+
+        void TestSaveRestore()
+        {
+            for( FrameIndex i = 0; i < 5; i++ ) { SaveFrame( i, 100 + i ); }
+            mWorld->Run<SRollbackRestoreState>( FrameIndex( 2 ) );
+            TEST_ASSERT( Get<TestRollbackState>().mValue == 102 );
+            TEST_ASSERT( Get<TestRollbackInput>().mValue == 102 );
+
+            mWorld->Run<SRollbackRestoreState>( FrameIndex( 7 ) ); // not saved, nothing happens
+            TEST_ASSERT( Get<TestRollbackState>().mValue == 102 );
+        }
+
+        void TestInit()
+        {
+            for( FrameIndex i = 0; i < 5; i++ ) { SaveFrame( i, 100 + i ); }
+            mWorld->Run<SRollbackInit>();
+
+            ClientRollback& rollback = Get<ClientRollback>();
+            TEST_ASSERT( rollback.GetFrameStates( 0 )->mStates.size() == 2 );
+            TEST_ASSERT( rollback.GetFrameStates( 3 )->mStates.size() == 1 );
+
+            // only the input is restored after the first frame
+            Get<TestRollbackState>().mValue = 0;
+            mWorld->Run<SRollbackRestoreState>( FrameIndex( 3 ) );
+            TEST_ASSERT( Get<TestRollbackState>().mValue == 0 );
+            TEST_ASSERT( Get<TestRollbackInput>().mValue == 103 );
+
+            // resimulation overwrites the frame
+            SaveFrame( 3, 7 );
+            TEST_ASSERT( rollback.GetFrameStates( 3 )->mStates.size() == 2 );
+            TEST_ASSERT( rollback.NewestFrameIndex() == 4 );
+            Get<TestRollbackState>().mValue = 0;
+            mWorld->Run<SRollbackRestoreState>( FrameIndex( 3 ) );
+            TEST_ASSERT( Get<TestRollbackState>().mValue == 7 );
+        }
+    };
+}
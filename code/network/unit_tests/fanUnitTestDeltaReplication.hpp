@@ -0,0 +1,149 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "network/unit_tests/fanBenchmarkReplication.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // one host & one replicated entity, packets statuses are given by hand
+    //========================================================================================================
+    class UnitTestDeltaReplication : public UnitTest<UnitTestDeltaReplication>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestDeltaReplication::TestStaticEntity, "Static entity" },
+                     { &UnitTestDeltaReplication::TestInFlight,     "In flight" },
+                     { &UnitTestDeltaReplication::TestDropped,      "Dropped" },
+                     { &UnitTestDeltaReplication::TestRelevanceSpawn, "Relevance spawn" },
+            };
+        }
+        void Create() override
+        {
+            mWorld = new EcsWorld();
+            BenchmarkReplication::CreateWorld( *mWorld, 1, 1 );
+            mTag = 0;
+        }
+        void Destroy() override { delete mWorld; }
+
+        EcsWorld* mWorld;
+        PacketTag mTag;
+
+        HostReplication& GetHostReplication( EcsEntity& _outEntity )
+        {
+            const EcsView view = mWorld->Match( mWorld->GetSignature<HostReplication>() );
+            _outEntity = view.begin<HostReplication>().GetEntity();
+            return *view.begin<HostReplication>();
+        }
+
+        void SetValue( const float _value )
+        {
+            const EcsView view = mWorld->Match( mWorld->GetSignature<BenchmarkReplicatedComponent>() );
+            ( *view.begin<BenchmarkReplicatedComponent>() ).mValues[0] = _value;
+        }
+
+        // replicates & writes one packet, returns the number of entities written in it
+        int SendFrame( PacketTag& _outTag )
+        {
+            mWorld->Run<SUpdateReplication>();
+            EcsEntity entity;
+            HostReplication& hostReplication = GetHostReplication( entity );
+            Packet packet( mTag++ );
+            hostReplication.Write( *mWorld, entity, packet, BenchmarkReplication::sUnlimitedSize );
+            hostReplication.ClearUnsentEntities();
+            _outTag = packet.mTag;
+            return int( packet.GetMessagesCount( PacketType::Replication ) );
+        }
+
+        void Ack( const PacketTag _tag )
+        {
+            EcsEntity entity;
+            GetHostReplication( entity ).OnDeltaSuccess( _tag );
+        }
+
+        void Drop( const PacketTag _tag )
+        {
+            EcsEntity entity;
+            GetHostReplication( entity ).OnDeltaFail( _tag );
+        }
+
+        void TestStaticEntity()
+        {
+            PacketTag tag;
+            TEST_ASSERT( SendFrame( tag ) == 1 );
+            Ack( tag );
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+            SetValue( 1.f );
+            TEST_ASSERT( SendFrame( tag ) == 1 );
+            Ack( tag );
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+        }
+
+        // unchanged components are not sent again while they are in flight
+        void TestInFlight()
+        {
+            PacketTag firstTag;
+            TEST_ASSERT( SendFrame( firstTag ) == 1 );
+            PacketTag tag;
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+
+            // a change while in flight is sent right away
+            SetValue( 2.f );
+            PacketTag changedTag;
+            TEST_ASSERT( SendFrame( changedTag ) == 1 );
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+
+            // the first packet arrives late, the component is still in flight
+            Ack( firstTag );
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+            Ack( changedTag );
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+        }
+
+        // dropped components are sent again if they differ from the acknowledged state
+        void TestDropped()
+        {
+            PacketTag tag;
+            TEST_ASSERT( SendFrame( tag ) == 1 );
+            Ack( tag );
+
+            SetValue( 3.f );
+            TEST_ASSERT( SendFrame( tag ) == 1 );
+            Drop( tag );
+            TEST_ASSERT( SendFrame( tag ) == 1 );
+            Ack( tag );
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+
+            // back to the acknowledged state before the drop, nothing to send
+            SetValue( 4.f );
+            TEST_ASSERT( SendFrame( tag ) == 1 );
+            SetValue( 3.f );
+            Drop( tag );
+            TEST_ASSERT( SendFrame( tag ) == 0 );
+        }
+
+        // the relevance keeps track of the spawn rpc ack, a dropped spawn is resent
+        void TestRelevanceSpawn()
+        {
+            EcsEntity entity;
+            HostReplication& hostReplication = GetHostReplication( entity );
+            const NetID netID = 42;
+            hostReplication.mRelevantEntities[netID].mSpawnFrame = 0;
+            sf::Packet dataRPC;
+            dataRPC << sf::Uint32( netID );
+            hostReplication.ReplicateRelevanceSpawn( HostReplication::BuildRPCPacket( dataRPC ), netID );
+
+            Packet packet( mTag++ );
+            hostReplication.Write( *mWorld, entity, packet, BenchmarkReplication::sUnlimitedSize );
+            hostReplication.OnReplicationFail( packet.mTag );
+            TEST_ASSERT( !hostReplication.mRelevantEntities[netID].mIsSpawnAcked );
+
+            Packet resentPacket( mTag++ );
+            hostReplication.Write( *mWorld, entity, resentPacket, BenchmarkReplication::sUnlimitedSize );
+            hostReplication.OnReplicationSuccess( resentPacket.mTag );
+            TEST_ASSERT( hostReplication.mRelevantEntities[netID].mIsSpawnAcked );
+        }
+    };
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "network/components/fanEntityInterpolation.hpp"
+#include "network/singletons/fanTime.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // snapshots of an entity moving along x at one unit per frame, received sLatency frames after their frame
+    //========================================================================================================
+    class UnitTestInterpolation : public UnitTest<UnitTestInterpolation>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestInterpolation::TestSnapshotPeriod, "Snapshot period" },
+                     { &UnitTestInterpolation::TestOrdering,       "Ordering" },
+                     { &UnitTestInterpolation::TestDelay,          "Delay" },
+                     { &UnitTestInterpolation::TestInterpolate,    "Interpolate" },
+                     { &UnitTestInterpolation::TestExtrapolate,    "Extrapolate" },
+            };
+        }
+        void Create() override
+        {
+            mWorld = new EcsWorld();
+            mWorld->AddComponentType<EntityInterpolation>();
+            EcsEntity entity = mWorld->CreateEntity();
+            mWorld->AddComponent<EntityInterpolation>( entity );
+            mHandle = mWorld->AddHandle( entity );
+            mWorld->ApplyTransitions();
+        }
+        void Destroy() override { delete mWorld; }
+
+        static constexpr int        sPeriod     = 3;
+        static constexpr int        sLatency    = 5;
+        static constexpr FrameIndex sFirstFrame = 1000;
+        static constexpr float      sDelta      = 1.f / 60.f;
+        EcsWorld* mWorld;
+        EcsHandle mHandle;
+
+        EntityInterpolation& GetInterpolation()
+        {
+            return mWorld->GetComponent<EntityInterpolation>( mWorld->GetEntity( mHandle ) );
+        }
+
+        static EntityInterpolation::Snapshot MakeSnapshot( const FrameIndex _frameIndex )
+        {
+            EntityInterpolation::Snapshot snapshot;
+            snapshot.mFrameIndex      = _frameIndex;
+            snapshot.mPosition        = btVector3( float( _frameIndex - sFirstFrame ), 0.f, 0.f );
+            snapshot.mRotation        = btQuaternion::getIdentity();
+            snapshot.mVelocity        = btVector3( 1.f / sDelta, 0.f, 0.f );
+            snapshot.mAngularVelocity = btVector3( 0.f, 0.f, 0.f );
+            return snapshot;
+        }
+
+        // pushes the snapshots of the frames [sFirstFrame, _lastFrame] every sPeriod frames
+        void PushSnapshots( const FrameIndex _lastFrame )
+        {
+            for( FrameIndex frame = sFirstFrame; frame <= _lastFrame; frame += sPeriod )
+            {
+                GetInterpolation().PushSnapshot( MakeSnapshot( frame ), frame + sLatency );
+            }
+        }
+
+        static bool IsNear( const float _value, const float _expected )
+        {
+            return std::abs( _value - _expected ) < 0.001f;
+        }
+
+        void TestSnapshotPeriod()
+        {
+            Time time;
+            time.mFrameIndex   = 0;
+            time.mLogicDelta   = sDelta;
+            time.mSnapshotRate = 20.f;
+            TEST_ASSERT( time.GetSnapshotPeriod() == 3 );
+            time.mSnapshotRate = 0.f;
+            TEST_ASSERT( time.GetSnapshotPeriod() == 1 );
+            time.mSnapshotRate = 120.f;
+            TEST_ASSERT( time.GetSnapshotPeriod() == 1 );
+
+            time.mSnapshotRate = 20.f;
+            int numSnapshots = 0;
+            for( time.mFrameIndex = 0; time.mFrameIndex < 60; time.mFrameIndex++ )
+            {
+                if( time.IsSnapshotFrame() ) { numSnapshots++; }
+            }
+            TEST_ASSERT( numSnapshots == 20 );
+        }
+
+        void TestOrdering()
+        {
+            EntityInterpolation& interpolation = GetInterpolation();
+            interpolation.PushSnapshot( MakeSnapshot( sFirstFrame + 6 ), 0 );
+            interpolation.PushSnapshot( MakeSnapshot( sFirstFrame ), 0 );
+            interpolation.PushSnapshot( MakeSnapshot( sFirstFrame + 3 ), 0 );
+            interpolation.PushSnapshot( MakeSnapshot( sFirstFrame + 3 ), 0 );	// duplicate
+            TEST_ASSERT( interpolation.mNumSnapshots == 3 );
+            TEST_ASSERT( interpolation.mSnapshots[0].mFrameIndex == sFirstFrame );
+            TEST_ASSERT( interpolation.mSnapshots[1].mFrameIndex == sFirstFrame + 3 );
+            TEST_ASSERT( interpolation.mSnapshots[2].mFrameIndex == sFirstFrame + 6 );
+
+            // a full buffer drops its oldest snapshots & snapshots older than all of them
+            for( int i = 3; i < 3 + EntityInterpolation::sMaxSnapshots; i++ )
+            {
+                interpolation.PushSnapshot( MakeSnapshot( sFirstFrame + sPeriod * i ), 0 );
+            }
+            TEST_ASSERT( interpolation.mNumSnapshots == EntityInterpolation::sMaxSnapshots );
+            TEST_ASSERT( interpolation.mSnapshots[0].mFrameIndex == sFirstFrame + sPeriod * 3 );
+            interpolation.PushSnapshot( MakeSnapshot( sFirstFrame + 1 ), 0 );
+            TEST_ASSERT( interpolation.mSnapshots[0].mFrameIndex == sFirstFrame + sPeriod * 3 );
+            TEST_ASSERT( interpolation.GetNewest().mFrameIndex ==
+                         sFirstFrame + sPeriod * ( 2 + EntityInterpolation::sMaxSnapshots ) );
+        }
+
+        void TestDelay()
+        {
+            EntityInterpolation& interpolation = GetInterpolation();
+            PushSnapshots( sFirstFrame + 30 );
+            TEST_ASSERT( IsNear( interpolation.mFrameOffset, float( sLatency ) ) );
+            TEST_ASSERT( IsNear( interpolation.mSnapshotPeriod, float( sPeriod ) ) );
+            TEST_ASSERT( IsNear( interpolation.GetRenderDelay(),
+                                 float( sLatency + sPeriod ) + EntityInterpolation::sDelayMargin ) );
+
+            // reordered snapshots don't change the delay
+            interpolation.PushSnapshot( MakeSnapshot( sFirstFrame + 28 ), sFirstFrame + 60 );
+            TEST_ASSERT( IsNear( interpolation.mFrameOffset, float( sLatency ) ) );
+
+            // a frame shift resets the delay
+            interpolation.PushSnapshot( MakeSnapshot( sFirstFrame + 33 ), sFirstFrame + 133 );
+            TEST_ASSERT( IsNear( interpolation.mFrameOffset, 100.f ) );
+        }
+
+        void TestInterpolate()
+        {
+            EntityInterpolation& interpolation = GetInterpolation();
+            // a single snapshot is held
+            interpolation.PushSnapshot( MakeSnapshot( sFirstFrame ), sFirstFrame + sLatency );
+            TEST_ASSERT( interpolation.Interpolate( sFirstFrame + sLatency, sDelta ).mPosition.x() == 0.f );
+
+            // the render frame follows the entity without gaps between the snapshots
+            PushSnapshots( sFirstFrame + 30 );
+            const float renderDelay = interpolation.GetRenderDelay();
+            for( FrameIndex frame = sFirstFrame + 20; frame < sFirstFrame + 30 + sLatency; frame++ )
+            {
+                const EntityInterpolation::Snapshot state = interpolation.Interpolate( frame, sDelta );
+                TEST_ASSERT( IsNear( state.mPosition.x(), float( frame - sFirstFrame ) - renderDelay ) );
+            }
+
+            // before the oldest snapshot
+            TEST_ASSERT( interpolation.Interpolate( sFirstFrame, sDelta ).mPosition ==
+                         interpolation.mSnapshots[0].mPosition );
+        }
+
+        void TestExtrapolate()
+        {
+            EntityInterpolation& interpolation = GetInterpolation();
+            PushSnapshots( sFirstFrame + 30 );
+            const float renderDelay = interpolation.GetRenderDelay();
+
+            // the next snapshot is late, the entity keeps moving at its velocity
+            const FrameIndex lateFrame = sFirstFrame + 30 + FrameIndex( renderDelay ) + 4;
+            const EntityInterpolation::Snapshot late = interpolation.Interpolate( lateFrame, sDelta );
+            TEST_ASSERT( IsNear( late.mPosition.x(), float( lateFrame - sFirstFrame ) - renderDelay ) );
+
+            // then stops
+            const FrameIndex lostFrame = lateFrame + 100;
+            const EntityInterpolation::Snapshot lost = interpolation.Interpolate( lostFrame, sDelta );
+            TEST_ASSERT( IsNear( lost.mPosition.x(), 30.f + EntityInterpolation::sMaxExtrapolationFrames ) );
+        }
+    };
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "network/fanLoopbackTransport.hpp"
+#include "network/fanUDPSocket.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // the time of the network is set manually, sockets are created while connected to it
+    //========================================================================================================
+    class UnitTestLoopback : public UnitTest<UnitTestLoopback>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestLoopback::TestSendReceive, "Send receive" },
+                     { &UnitTestLoopback::TestLatency,     "Latency" },
+                     { &UnitTestLoopback::TestLoss,        "Loss" },
+                     { &UnitTestLoopback::TestDuplication, "Duplication" },
+                     { &UnitTestLoopback::TestReordering,  "Reordering" },
+                     { &UnitTestLoopback::TestBind,        "Bind" },
+            };
+        }
+        void Create() override
+        {
+            mNetwork = new LoopbackNetwork();
+            mNetwork->SetTime( 0. );
+            UdpSocket::sOnCreate.Connect( &LoopbackNetwork::OnCreateSocket, mNetwork );
+            mServer = new UdpSocket();
+            mClient = new UdpSocket();
+            UdpSocket::sOnCreate.Disconnect( size_t( mNetwork ) );
+            mServer->Bind( sServerPort );
+        }
+        void Destroy() override
+        {
+            delete mServer;
+            delete mClient;
+            delete mNetwork;
+        }
+
+        static constexpr Port sServerPort = 53000;
+        LoopbackNetwork* mNetwork;
+        UdpSocket*       mServer;
+        UdpSocket*       mClient;
+
+        void Send( const PacketTag _tag )
+        {
+            Packet packet( _tag );
+            mClient->Send( packet, IpAddress::LocalHost, sServerPort );
+        }
+
+        // returns the tags of the received packets
+        std::vector<PacketTag> Receive()
+        {
+            std::vector<PacketTag> tags;
+            Packet    packet;
+            IpAddress address;
+            Port      port;
+            while( mServer->Receive( packet, address, port ) == UdpSocket::Status::Done )
+            {
+                tags.push_back( packet.mTag );
+            }
+            return tags;
+        }
+
+        void TestSendReceive()
+        {
+            TEST_ASSERT( mServer->HasTransport() );
+            TEST_ASSERT( mServer->GetPort() == sServerPort );
+            TEST_ASSERT( mClient->GetPort() == 0 );
+
+            Packet packet( 7 );
+            packet << sf::Uint32( 42 );
+            TEST_ASSERT( mClient->Send( packet, IpAddress::LocalHost, sServerPort ) == UdpSocket::Status::Done );
+            TEST_ASSERT( mClient->GetPort() == LoopbackNetwork::sFirstEphemeralPort );
+
+            Packet    received;
+            IpAddress address;
+            Port      port;
+            TEST_ASSERT( mServer->Receive( received, address, port ) == UdpSocket::Status::Done );
+            TEST_ASSERT( received.mTag == 7 );
+            sf::Uint32 value = 0;
+            received >> value;
+            TEST_ASSERT( value == 42 );
+            TEST_ASSERT( address == IpAddress::LocalHost );
+            TEST_ASSERT( port == mClient->GetPort() );
+            TEST_ASSERT( mServer->Receive( received, address, port ) == UdpSocket::Status::NotReady );
+
+            // the answer goes back to the client
+            Packet answer( 8 );
+            mServer->Send( answer, address, port );
+            TEST_ASSERT( mClient->Receive( received, address, port ) == UdpSocket::Status::Done );
+            TEST_ASSERT( received.mTag == 8 );
+            TEST_ASSERT( port == sServerPort );
+        }
+
+        void TestLatency()
+        {
+            mNetwork->mConditions.mLatency = 0.1f;
+            mNetwork->mConditions.mJitter  = 0.05f;
+            for( PacketTag i = 0; i < 10; i++ ) { Send( i ); }
+            mNetwork->SetTime( 0.099 );
+            TEST_ASSERT( Receive().empty() );
+            mNetwork->SetTime( 0.151 );
+            TEST_ASSERT( Receive().size() == 10 );
+        }
+
+        void TestLoss()
+        {
+            mNetwork->mConditions.mLossRate = 0.25f;
+            for( PacketTag i = 0; i < 1000; i++ ) { Send( i ); }
+            const size_t numReceived = Receive().size();
+            TEST_ASSERT( numReceived + mNetwork->mNumDropped == 1000 );
+            TEST_ASSERT( numReceived > 650 && numReceived < 850 );
+
+            // datagrams sent to a port that is not bound are lost
+            mServer->Unbind();
+            Send( 0 );
+            mServer->Bind( sServerPort );
+            TEST_ASSERT( Receive().empty() );
+        }
+
+        void TestDuplication()
+        {
+            mNetwork->mConditions.mDuplicateRate = 1.f;
+            Send( 3 );
+            const std::vector<PacketTag> tags = Receive();
+            TEST_ASSERT( tags.size() == 2 );
+            TEST_ASSERT( tags[0] == 3 && tags[1] == 3 );
+            TEST_ASSERT( mNetwork->mNumDuplicated == 1 );
+        }
+
+        void TestReordering()
+        {
+            Send( 0 );
+            mNetwork->mConditions.mReorderRate = 1.f;
+            Send( 1 );
+            mNetwork->mConditions.mReorderRate = 0.f;
+            Send( 2 );
+            TEST_ASSERT( Receive() == std::vector<PacketTag>( { 0, 2 } ) );
+            mNetwork->SetTime( mNetwork->mConditions.mReorderDelay );
+            TEST_ASSERT( Receive() == std::vector<PacketTag>( { 1 } ) );
+            TEST_ASSERT( mNetwork->mNumReordered == 1 );
+        }
+
+        void TestBind()
+        {
+            TEST_ASSERT( mClient->Bind( sServerPort ) == UdpSocket::Status::Error );
+            TEST_ASSERT( mClient->Bind( 0 ) == UdpSocket::Status::Done );
+            TEST_ASSERT( mClient->GetPort() == LoopbackNetwork::sFirstEphemeralPort );
+            mClient->Unbind();
+            TEST_ASSERT( mClient->GetPort() == 0 );
+            TEST_ASSERT( mNetwork->Find( LoopbackNetwork::sFirstEphemeralPort ) == nullptr );
+
+            // a destroyed socket frees its port
+            delete mServer;
+            mServer = nullptr;
+            TEST_ASSERT( mNetwork->Find( sServerPort ) == nullptr );
+            TEST_ASSERT( mClient->Bind( sServerPort ) == UdpSocket::Status::Done );
+        }
+    };
+}
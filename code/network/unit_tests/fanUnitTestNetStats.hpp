@@ -0,0 +1,146 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "network/singletons/fanNetStats.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    class UnitTestNetStats : public UnitTest<UnitTestNetStats>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestNetStats::TestCounter,       "Counter" },
+                     { &UnitTestNetStats::TestHistogram,     "Histogram" },
+                     { &UnitTestNetStats::TestPacketTypes,   "Packet types" },
+                     { &UnitTestNetStats::TestHosts,         "Hosts" },
+                     { &UnitTestNetStats::TestRttJitter,     "Rtt & jitter" },
+            };
+        }
+        void Create() override
+        {
+            mStats = new NetStats();
+            mStats->Reset();
+        }
+        void Destroy() override { delete mStats; }
+
+        NetStats* mStats;
+
+        void TestCounter()
+        {
+            NetCounter counter;
+            counter.Add( 10 );
+            counter.Add( 20, 3 );
+            TEST_ASSERT( counter.GetBytes() == 30 );
+            TEST_ASSERT( counter.GetCount() == 4 );
+            counter.Reset();
+            TEST_ASSERT( counter.GetBytes() == 0 && counter.GetCount() == 0 );
+        }
+
+        void TestHistogram()
+        {
+            NetHistogram histogram;
+            TEST_ASSERT( histogram.GetPercentile( .5f ) == 0.f );
+            for( int i = 0; i < 90; i++ ) { histogram.Add( 0.003f ); }	// 3ms    -> below 5ms
+            for( int i = 0; i < 9; i++ ) { histogram.Add( 0.060f ); }	// 60ms   -> below 75ms
+            histogram.Add( 2.f );									// 2000ms -> last bucket
+            TEST_ASSERT( histogram.GetCount() == 100 );
+            TEST_ASSERT( histogram.GetPercentile( .5f ) == 5.f );
+            TEST_ASSERT( histogram.GetPercentile( .95f ) == 75.f );
+            TEST_ASSERT( histogram.GetPercentile( 1.f ) == NetHistogram::sBucketsMs[NetHistogram::sNumBuckets - 1] );
+            TEST_ASSERT( std::abs( histogram.GetMean() - ( 90 * 3.f + 9 * 60.f + 2000.f ) / 100.f ) < 0.01f );
+            histogram.Reset();
+            TEST_ASSERT( histogram.GetCount() == 0 && histogram.GetMean() == 0.f );
+
+            // infinite durations stay in the last bucket
+            histogram.Add( INFINITY );
+            TEST_ASSERT( histogram.GetCount() == 1 );
+            TEST_ASSERT( histogram.GetPercentile( 1.f ) == NetHistogram::sBucketsMs[NetHistogram::sNumBuckets - 1] );
+        }
+
+        // each message is accounted up to the next one, the last one up to the end of the packet
+        void TestPacketTypes()
+        {
+            Packet packet( 42 );
+            PacketPing ping;
+            ping.mServerFrame = 1;
+            ping.mClientFrame = 2;
+            ping.mPreviousRtt = 0.1f;
+            ping.Write( packet );
+            ping.Write( packet );
+            PacketAck ack;
+            ack.Write( packet );
+
+            const size_t pingSize = packet.GetMessagesSize( PacketType::Ping );
+            TEST_ASSERT( packet.GetMessagesCount( PacketType::Ping ) == 2 );
+            TEST_ASSERT( packet.GetMessagesCount( PacketType::Ack ) == 1 );
+            TEST_ASSERT( packet.GetMessagesSize( PacketType::Ack ) == PacketAck::sSize );
+            TEST_ASSERT( pingSize + PacketAck::sSize + sizeof( PacketTag ) == packet.GetSize() );
+
+            mStats->OnSend( packet );
+            mStats->OnSend( packet );
+            TEST_ASSERT( mStats->mSent.GetCount() == 2 );
+            TEST_ASSERT( mStats->mSent.GetBytes() == 2 * packet.GetSize() );
+            TEST_ASSERT( mStats->mSentTypes[int( PacketType::Ping )].GetCount() == 4 );
+            TEST_ASSERT( mStats->mSentTypes[int( PacketType::Ping )].GetBytes() == 2 * pingSize );
+            TEST_ASSERT( mStats->mSentTypes[int( PacketType::Hello )].GetCount() == 0 );
+
+            packet.Clear();
+            TEST_ASSERT( packet.GetMessagesCount( PacketType::Ping ) == 0 );
+            TEST_ASSERT( packet.GetMessagesSize( PacketType::Ack ) == 0 );
+
+            mStats->Reset();
+            TEST_ASSERT( mStats->mSentTypes[int( PacketType::Ping )].GetCount() == 0 );
+        }
+
+        void TestHosts()
+        {
+            const int first = mStats->AddHost( 10 );
+            const int second = mStats->AddHost( 11 );
+            TEST_ASSERT( first >= 0 && second >= 0 && first != second );
+
+            Packet packet( 0 );
+            PacketAck().Write( packet );
+            mStats->OnSend( packet, first );
+            mStats->OnReceive( packet, second );
+            mStats->AddRetransmissions( 3, first );
+            TEST_ASSERT( mStats->mHosts[first].mSent.GetBytes() == packet.GetSize() );
+            TEST_ASSERT( mStats->mHosts[second].mReceived.GetBytes() == packet.GetSize() );
+            TEST_ASSERT( mStats->mHosts[first].mRetransmissions == 3 );
+            TEST_ASSERT( mStats->mRetransmissions == 3 );
+
+            // a released slot is reused with cleared stats
+            mStats->RemoveHost( first );
+            TEST_ASSERT( mStats->AddHost( 12 ) == first );
+            TEST_ASSERT( mStats->mHosts[first].mSent.GetCount() == 0 );
+
+            // hosts beyond the slots are not tracked individually
+            for( int i = 2; i < NetStats::sMaxHosts; i++ ) { mStats->AddHost( EcsHandle( 100 + i ) ); }
+            TEST_ASSERT( mStats->AddHost( 1000 ) == -1 );
+            mStats->OnSend( packet, -1 );
+            TEST_ASSERT( mStats->mSent.GetCount() == 2 );
+        }
+
+        void TestRttJitter()
+        {
+            const int host = mStats->AddHost( 10 );
+            mStats->AddRtt( 0.100f, host );
+            TEST_ASSERT( mStats->mRtt.GetCount() == 1 );
+            TEST_ASSERT( mStats->mJitter.GetCount() == 0 );	// needs two rtt
+
+            mStats->AddRtt( 0.116f, host );
+            TEST_ASSERT( mStats->mJitter.GetCount() == 1 );
+            TEST_ASSERT( std::abs( mStats->mHosts[host].mJitter.load() - 0.001f ) < 0.0001f );	// 16ms / 16
+            TEST_ASSERT( std::abs( mStats->mHosts[host].mRtt.load() - 0.116f ) < 0.0001f );
+
+            // the connection of a client to its server
+            mStats->AddRtt( 0.050f );
+            TEST_ASSERT( mStats->mJitter.GetCount() == 1 );
+            mStats->AddRtt( 0.060f );
+            TEST_ASSERT( mStats->mJitter.GetCount() == 2 );
+            TEST_ASSERT( mStats->mJitter.GetPercentile( 1.f ) == 20.f );	// 16ms
+        }
+    };
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "network/fanPacket.hpp"
+#include "network/components/fanHostGameData.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    class UnitTestPacketInput : public UnitTest<UnitTestPacketInput>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestPacketInput::TestRoundTrip,  "Round trip" },
+                     { &UnitTestPacketInput::TestFrameGap,   "Frame gap" },
+                     { &UnitTestPacketInput::TestSize,       "Size" },
+                     { &UnitTestPacketInput::TestMalformed,  "Malformed" },
+                     { &UnitTestPacketInput::TestHostRing,   "Host ring" },
+            };
+        }
+        void Create() override
+        {
+            mWorld = new EcsWorld();
+            mWorld->AddComponentType<HostGameData>();
+            EcsEntity entity = mWorld->CreateEntity();
+            mWorld->AddComponent<HostGameData>( entity );
+            mHandle = mWorld->AddHandle( entity );
+            mWorld->ApplyTransitions();
+        }
+        void Destroy() override { delete mWorld; }
+
+        EcsWorld* mWorld;
+        EcsHandle mHandle;
+
+        // input of a player turning & pressing keys every 4 frames
+        static PacketInput::InputData MakeInput( const FrameIndex _frameIndex )
+        {
+            PacketInput::InputData inputData;
+            inputData.SetKeyBits( sf::Uint8( ( _frameIndex / 4 ) % 64 ) );
+            inputData.mOrientation = sf::Uint16( ( 4000 + 3 * _frameIndex ) % 4096 );
+            inputData.mFrameIndex  = _frameIndex;
+            return inputData;
+        }
+
+        static bool Equal( const PacketInput::InputData& _a, const PacketInput::InputData& _b )
+        {
+            return _a.mFrameIndex == _b.mFrameIndex
+                   && _a.mOrientation == _b.mOrientation
+                   && _a.GetKeyBits() == _b.GetKeyBits();
+        }
+
+        // writes & reads back the packet, returns the size of the input data with its header
+        static size_t WriteRead( const PacketInput& _input, PacketInput& _output )
+        {
+            Packet packet( 0 );
+            _input.Write( packet );
+            const size_t size = packet.GetSize() - sizeof( PacketTag );
+            packet >> packet.mTag;
+            TEST_ASSERT( packet.ReadType() == PacketType::PlayerInput );
+            _output.Read( packet );
+            TEST_ASSERT( packet.EndOfPacket() );
+            return size;
+        }
+
+        void TestRoundTrip()
+        {
+            PacketInput input;
+            input.mNumInputs = PacketInput::sMaxInputs;
+            for( int i = 0; i < input.mNumInputs; i++ ) { input.mInputs[i] = MakeInput( 1000 + i ); }
+            input.mInputs[10].mOrientation = 2000;    // large orientation delta
+
+            PacketInput output;
+            WriteRead( input, output );
+            TEST_ASSERT( output.mNumInputs == input.mNumInputs );
+            for( int i = 0; i < input.mNumInputs; i++ ) { TEST_ASSERT( Equal( input.mInputs[i], output.mInputs[i] ) ); }
+
+            // no input
+            input.mNumInputs = 0;
+            WriteRead( input, output );
+            TEST_ASSERT( output.mNumInputs == 0 );
+        }
+
+        void TestFrameGap()
+        {
+            // the client frame index was shifted between two inputs
+            PacketInput input;
+            input.mNumInputs = 4;
+            input.mInputs[0] = MakeInput( 50 );
+            input.mInputs[1] = MakeInput( 51 );
+            input.mInputs[2] = MakeInput( 45 );
+            input.mInputs[3] = MakeInput( 46 );
+
+            PacketInput output;
+            WriteRead( input, output );
+            TEST_ASSERT( output.mNumInputs == 4 );
+            for( int i = 0; i < 4; i++ ) { TEST_ASSERT( Equal( input.mInputs[i], output.mInputs[i] ) ); }
+        }
+
+        void TestSize()
+        {
+            // 10 redundant inputs used to take 13 bytes each + 2 bytes of header
+            PacketInput input;
+            input.mNumInputs = 10;
+            for( int i = 0; i < input.mNumInputs; i++ ) { input.mInputs[i] = MakeInput( 1000 + i ); }
+            PacketInput output;
+            const size_t size = WriteRead( input, output );
+            TEST_ASSERT( 5 * size < 2 + 10 * 13 );
+        }
+
+        void TestMalformed()
+        {
+            Packet packet( 0 );
+            packet << PacketTypeInt( PacketType::PlayerInput );
+            packet << sf::Uint8( 2 ) << sf::Uint8( 10 ) << sf::Uint8( 0 ); // 10 inputs announced, no data
+            packet >> packet.mTag;
+            packet.ReadType();
+            PacketInput output;
+            output.Read( packet );
+            TEST_ASSERT( output.mNumInputs == 0 );
+
+            // truncated datagram, the announced data size is not available
+            PacketInput input;
+            input.mNumInputs = 20;
+            for( int i = 0; i < input.mNumInputs; i++ ) { input.mInputs[i] = MakeInput( 1000 + i ); }
+            Packet fullPacket( 0 );
+            input.Write( fullPacket );
+            Packet truncatedPacket;
+            truncatedPacket.Append( fullPacket.ToSfml().getData(), fullPacket.GetSize() - 4 );
+            truncatedPacket >> truncatedPacket.mTag;
+            truncatedPacket.ReadType();
+            output.mNumInputs = 5;
+            output.Read( truncatedPacket );
+            TEST_ASSERT( output.mNumInputs == 0 );
+        }
+
+        void TestHostRing()
+        {
+            HostGameData& hostData = mWorld->GetComponent<HostGameData>( mWorld->GetEntity( mHandle ) );
+            TEST_ASSERT( hostData.GetInput( 0 ) == nullptr );
+
+            PacketInput input;
+            input.mNumInputs = 10;
+            for( int i = 0; i < input.mNumInputs; i++ ) { input.mInputs[i] = MakeInput( 95 + i ); }
+            input.mInputs[9] = MakeInput( 100 + HostGameData::sInputRingSize );
+            hostData.ProcessPacket( input, 100 );
+
+            TEST_ASSERT( hostData.GetInput( 99 ) == nullptr );     // too old
+            TEST_ASSERT( hostData.GetInput( 100 ) != nullptr );
+            TEST_ASSERT( Equal( *hostData.GetInput( 103 ), input.mInputs[8] ) );
+            TEST_ASSERT( hostData.GetInput( 104 ) == nullptr );
+            TEST_ASSERT( hostData.GetInput( 100 + HostGameData::sInputRingSize ) == nullptr );   // too far ahead
+        }
+    };
+}
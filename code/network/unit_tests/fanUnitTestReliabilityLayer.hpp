@@ -0,0 +1,203 @@
+#pragma once
+
+#include "core/unit_tests/fanUnitTest.hpp"
+#include "core/ecs/fanEcsWorld.hpp"
+#include "network/components/fanReliabilityLayer.hpp"
+#include "network/singletons/fanTime.hpp"
+#include "network/singletons/fanNetStats.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    // counts the delivery notifications of its packets
+    //========================================================================================================
+    struct TestDeliveryComponent : public EcsComponent
+    {
+        ECS_COMPONENT( TestDeliveryComponent )
+        static void SetInfo( EcsComponentInfo& /*_info*/ ) {}
+        static void Init( EcsWorld& /*_world*/, EcsEntity /*_entity*/, EcsComponent& _component )
+        {
+            TestDeliveryComponent& delivery = static_cast<TestDeliveryComponent&>( _component );
+            delivery.mReceived.clear();
+            delivery.mDropped.clear();
+        }
+        void OnSuccess( const PacketTag _tag ) { mReceived.push_back( _tag ); }
+        void OnFail( const PacketTag _tag ) { mDropped.push_back( _tag ); }
+
+        std::vector<PacketTag> mReceived;
+        std::vector<PacketTag> mDropped;
+    };
+
+    //========================================================================================================
+    //========================================================================================================
+    class UnitTestReliabilityLayer : public UnitTest<UnitTestReliabilityLayer>
+    {
+    public:
+        static std::vector<TestMethod> GetTests()
+        {
+            return { { &UnitTestReliabilityLayer::TestAckBits,       "Ack bits" },
+                     { &UnitTestReliabilityLayer::TestOldPackets,    "Old packets" },
+                     { &UnitTestReliabilityLayer::TestWriteAck,      "Write ack" },
+                     { &UnitTestReliabilityLayer::TestDelivery,      "Delivery" },
+                     { &UnitTestReliabilityLayer::TestOutOfWindow,   "Out of window" },
+                     { &UnitTestReliabilityLayer::TestTimeout,       "Timeout" },
+                     { &UnitTestReliabilityLayer::TestRingOverflow,  "Ring overflow" },
+            };
+        }
+        void Create() override
+        {
+            mWorld = new EcsWorld();
+            mWorld->AddComponentType<ReliabilityLayer>();
+            mWorld->AddComponentType<TestDeliveryComponent>();
+            mWorld->AddSingletonType<NetStats>();
+            EcsEntity entity = mWorld->CreateEntity();
+            mWorld->AddComponent<ReliabilityLayer>( entity );
+            mWorld->AddComponent<TestDeliveryComponent>( entity );
+            mHandle = mWorld->AddHandle( entity );
+            mWorld->ApplyTransitions();
+        }
+        void Destroy() override { delete mWorld; }
+
+        EcsWorld* mWorld;
+        EcsHandle mHandle;
+
+        ReliabilityLayer& GetLayer()
+        {
+            return mWorld->GetComponent<ReliabilityLayer>( mWorld->GetEntity( mHandle ) );
+        }
+        TestDeliveryComponent& GetDelivery()
+        {
+            return mWorld->GetComponent<TestDeliveryComponent>( mWorld->GetEntity( mHandle ) );
+        }
+
+        void Validate( ReliabilityLayer& _layer, const PacketTag _tag )
+        {
+            Packet packet( _tag );
+            _layer.ValidatePacket( packet );
+        }
+
+        void Send( ReliabilityLayer& _layer )
+        {
+            Packet packet( _layer.GetNextPacketTag() );
+            packet << sf::Uint8( 0 );
+            packet.mOnSuccess.Connect( &TestDeliveryComponent::OnSuccess, mHandle );
+            packet.mOnFail.Connect( &TestDeliveryComponent::OnFail, mHandle );
+            _layer.RegisterPacket( *mWorld, packet );
+        }
+
+        void TestAckBits()
+        {
+            ReliabilityLayer& layer = GetLayer();
+            for( PacketTag tag : { 0, 1, 2, 4, 5 } ) { Validate( layer, tag ); }
+            TEST_ASSERT( layer.mAck.mLatestTag == 5 );
+            TEST_ASSERT( layer.mAck.mAckBits == 0b11101 );
+            TEST_ASSERT( layer.mAck.IsAcked( 5 ) && layer.mAck.IsAcked( 4 ) && layer.mAck.IsAcked( 0 ) );
+            TEST_ASSERT( !layer.mAck.IsAcked( 3 ) );
+            TEST_ASSERT( !layer.mAck.IsAcked( 6 ) );
+
+            Validate( layer, 5 + PacketAck::sAckBits );
+            TEST_ASSERT( layer.mAck.IsAcked( 5 ) );
+            TEST_ASSERT( !layer.mAck.IsAcked( 4 ) );
+            Validate( layer, 100 );
+            TEST_ASSERT( layer.mAck.mAckBits == 0 );
+        }
+
+        void TestOldPackets()
+        {
+            ReliabilityLayer& layer = GetLayer();
+            Packet packet5( 5 );
+            Packet packet3( 3 );
+            TEST_ASSERT( layer.ValidatePacket( packet5 ) );
+            TEST_ASSERT( !layer.ValidatePacket( packet3 ) );
+            TEST_ASSERT( !layer.mAck.IsAcked( 3 ) );
+        }
+
+        void TestWriteAck()
+        {
+            ReliabilityLayer& layer = GetLayer();
+            TEST_ASSERT( layer.GetAckSize() == 0 );
+            Validate( layer, 0 );
+            Validate( layer, 2 );
+            TEST_ASSERT( layer.GetAckSize() == PacketAck::sSize );
+
+            Packet packet( 0 );
+            packet.mOnlyContainsAck = true;
+            layer.Write( packet );
+            TEST_ASSERT( packet.GetSize() == sizeof( PacketTag ) + PacketAck::sSize );
+
+            Packet emptyPacket( 1 );
+            emptyPacket.mOnlyContainsAck = true;
+            layer.Write( emptyPacket );
+            TEST_ASSERT( emptyPacket.GetSize() == sizeof( PacketTag ) ); // no new ack
+
+            PacketTag tag;
+            packet >> tag;
+            TEST_ASSERT( packet.ReadType() == PacketType::Ack );
+            PacketAck packetAck;
+            packetAck.Read( packet );
+            TEST_ASSERT( packetAck.mLatestTag == 2 && packetAck.mAckBits == 0b10 );
+            TEST_ASSERT( packet.EndOfPacket() );
+        }
+
+        void TestDelivery()
+        {
+            ReliabilityLayer& layer = GetLayer();
+            for( int i = 0; i < 6; i++ ) { Send( layer ); }
+            TEST_ASSERT( layer.mNumInFlightPackets == 6 );
+
+            PacketAck packetAck;
+            packetAck.mLatestTag = 4;
+            packetAck.mAckBits   = 0b1101;	// 3, 1 & 0 received, 2 dropped
+            layer.ProcessPacket( *mWorld, packetAck );
+
+            TestDeliveryComponent& delivery = GetDelivery();
+            TEST_ASSERT( delivery.mReceived == std::vector<PacketTag>( { 0, 1, 3, 4 } ) );
+            TEST_ASSERT( delivery.mDropped == std::vector<PacketTag>( { 2 } ) );
+            TEST_ASSERT( layer.mNumInFlightPackets == 1 );
+
+            layer.ProcessPacket( *mWorld, packetAck ); // duplicated ack
+            TEST_ASSERT( delivery.mReceived.size() == 4 );
+        }
+
+        void TestOutOfWindow()
+        {
+            ReliabilityLayer& layer = GetLayer();
+            for( int i = 0; i < 40; i++ ) { Send( layer ); }
+
+            PacketAck packetAck;
+            packetAck.mLatestTag = 39;
+            packetAck.mAckBits   = ~PacketAck::AckBits( 0 );
+            layer.ProcessPacket( *mWorld, packetAck );
+
+            TestDeliveryComponent& delivery = GetDelivery();
+            TEST_ASSERT( delivery.mDropped.size() == 40 - 1 - PacketAck::sAckBits );
+            TEST_ASSERT( delivery.mReceived.size() == 1 + PacketAck::sAckBits );
+            TEST_ASSERT( layer.mNumInFlightPackets == 0 );
+        }
+
+        void TestTimeout()
+        {
+            ReliabilityLayer& layer = GetLayer();
+            for( int i = 0; i < 3; i++ ) { Send( layer ); }
+            layer.ProcessTimedOutPackets( *mWorld, Time::ElapsedSinceStartup() - 1000. );
+            TEST_ASSERT( layer.mNumInFlightPackets == 3 );
+            layer.ProcessTimedOutPackets( *mWorld, Time::ElapsedSinceStartup() + 1000. );
+            TEST_ASSERT( layer.mNumInFlightPackets == 0 );
+            TEST_ASSERT( GetDelivery().mDropped.size() == 3 );
+        }
+
+        void TestRingOverflow()
+        {
+            ReliabilityLayer& layer = GetLayer();
+            for( int i = 0; i < ReliabilityLayer::sMaxInFlightPackets + 10; i++ ) { Send( layer ); }
+            TEST_ASSERT( layer.mNumInFlightPackets == ReliabilityLayer::sMaxInFlightPackets );
+            TEST_ASSERT( GetDelivery().mDropped == std::vector<PacketTag>( { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 } ) );
+
+            PacketAck packetAck;
+            packetAck.mLatestTag = layer.mNextPacketTag - 1;
+            layer.ProcessPacket( *mWorld, packetAck );
+            TEST_ASSERT( GetDelivery().mReceived.size() == 1 );
+            TEST_ASSERT( layer.mNumInFlightPackets == 0 );
+        }
+    };
+}
@@ -49,37 +49,23 @@ namespace fan
 
     //========================================================================================================
     //========================================================================================================
-    void Mesh2DManager::Clear( Device& _device )
+    void Mesh2DManager::Clear()
     {
         for ( Mesh2D* mesh : mMeshes )
         {
-            mesh->Destroy( _device );
             delete mesh;
         }
         mMeshes.clear();
-        DestroyRemovedMeshes( _device );
+        DestroyRemovedMeshes();
     }
 
     //========================================================================================================
+    // meshes were never uploaded to a device ( headless ), only their cpu side is released
     //========================================================================================================
-    void Mesh2DManager::CreateNewMeshes( Device& _device )
-    {
-        for( Mesh2D * mesh : mMeshes )
-        {
-            if( mesh->mBuffersOutdated )
-            {
-                mesh->Create( _device );
-            }
-        }
-    }
-
-    //========================================================================================================
-    //========================================================================================================
-    void Mesh2DManager::DestroyRemovedMeshes( Device& _device )
+    void Mesh2DManager::DestroyRemovedMeshes()
     {
         for( Mesh2D* mesh : mDestroyList )
         {
-            mesh->Destroy( _device );
             delete mesh;
         }
         mDestroyList.clear();
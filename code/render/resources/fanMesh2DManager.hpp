@@ -19,6 +19,7 @@ namespace fan
         Mesh2DManager& operator=( Mesh2DManager const& ) = delete;
 
 		void Clear( Device& _device );
+		void Clear();	// meshes were never uploaded to a device ( headless )
         Mesh2D* Get( const std::string& _path ) const;
         void Add( Mesh2D* _mesh, const std::string& _name );
         void Remove( const std::string& _path );
@@ -27,6 +28,7 @@ namespace fan
 
         void CreateNewMeshes( Device& _device );
         void DestroyRemovedMeshes( Device& _device );
+        void DestroyRemovedMeshes();
 
         int DestroyListSize() const  { return (int)mDestroyList.size(); }
         const std::vector< Mesh2D * >& GetMeshes() const { return mMeshes; }
@@ -0,0 +1,44 @@
+#include "render/resources/fanMesh2DManager.hpp"
+
+#include "render/resources/fanMesh2D.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    void Mesh2DManager::Clear( Device& _device )
+    {
+        for ( Mesh2D* mesh : mMeshes )
+        {
+            mesh->Destroy( _device );
+            delete mesh;
+        }
+        mMeshes.clear();
+        DestroyRemovedMeshes( _device );
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void Mesh2DManager::CreateNewMeshes( Device& _device )
+    {
+        for( Mesh2D * mesh : mMeshes )
+        {
+            if( mesh->mBuffersOutdated )
+            {
+                mesh->Create( _device );
+            }
+        }
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void Mesh2DManager::DestroyRemovedMeshes( Device& _device )
+    {
+        for( Mesh2D* mesh : mDestroyList )
+        {
+            mesh->Destroy( _device );
+            delete mesh;
+        }
+        mDestroyList.clear();
+    }
+}
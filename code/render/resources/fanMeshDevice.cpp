@@ -0,0 +1,98 @@
+#include "render/resources/fanMesh.hpp"
+
+#include "render/core/fanDevice.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    void Mesh::Destroy( Device & _device )
+    {
+        for( int i = 0 ; i < SwapChain::sMaxFramesInFlight; i++)
+        {
+            mIndexBuffer[i].Destroy( _device );
+            mVertexBuffer[i].Destroy( _device );
+        }
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void Mesh::Create( Device& _device )
+    {
+	    mBuffersOutdated = false;
+
+        if ( mIndices.empty() || mVertices.empty() ) { return; }
+
+        mCurrentBuffer = ( mCurrentBuffer + 1 ) % SwapChain::sMaxFramesInFlight;
+
+        const VkMemoryPropertyFlags memPropertyFlags = ( mHostVisible ?
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT :
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+        Buffer& vertexBuffer = mVertexBuffer[ mCurrentBuffer ];
+        const VkDeviceSize requiredVertexSize = sizeof( mVertices[ 0 ] ) * mVertices.size();
+        if ( vertexBuffer.mBuffer == VK_NULL_HANDLE || vertexBuffer.mSize < requiredVertexSize )
+        {
+            vertexBuffer.Destroy( _device );
+            mVertexBuffer[ mCurrentBuffer ].Create(
+                    _device,
+                    requiredVertexSize,
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                    memPropertyFlags
+            );
+            _device.AddDebugName( (uint64_t)vertexBuffer.mBuffer, "mesh vertex buffer" );
+            _device.AddDebugName( (uint64_t)vertexBuffer.mMemory, "mesh vertex buffer" );
+        }
+
+        Buffer& indexBuffer = mIndexBuffer[ mCurrentBuffer ];
+        const VkDeviceSize requiredIndexSize = sizeof( mIndices[ 0 ] ) * mIndices.size();
+        if ( indexBuffer.mBuffer == VK_NULL_HANDLE || indexBuffer.mSize < requiredIndexSize )
+        {
+            indexBuffer.Destroy( _device );
+            indexBuffer.Create( _device,
+                                requiredIndexSize,
+                                VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                memPropertyFlags
+            );
+            _device.AddDebugName( (uint64_t)indexBuffer.mBuffer, "mesh index buffer" );
+            _device.AddDebugName( (uint64_t)indexBuffer.mMemory, "mesh index buffer" );
+        }
+
+        if ( mHostVisible )
+        {
+            indexBuffer.SetData( _device, mIndices.data(), requiredIndexSize );
+            vertexBuffer.SetData( _device, mVertices.data(), requiredVertexSize );
+        }
+        else
+        {
+            {
+                Buffer stagingBuffer;
+                stagingBuffer.Create(
+                        _device,
+                        requiredIndexSize,
+                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                );
+                stagingBuffer.SetData( _device, mIndices.data(), requiredIndexSize );
+                VkCommandBuffer cmd = _device.BeginSingleTimeCommands();
+                stagingBuffer.CopyBufferTo( cmd, indexBuffer.mBuffer, requiredIndexSize );
+                _device.EndSingleTimeCommands( cmd );
+                stagingBuffer.Destroy( _device );
+            }
+            {
+                Buffer stagingBuffer2;
+                stagingBuffer2.Create(
+                        _device,
+                        requiredVertexSize,
+                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                );
+                stagingBuffer2.SetData( _device, mVertices.data(), requiredVertexSize );
+                VkCommandBuffer cmd2 = _device.BeginSingleTimeCommands();
+                stagingBuffer2.CopyBufferTo( cmd2, vertexBuffer.mBuffer, requiredVertexSize );
+                _device.EndSingleTimeCommands( cmd2 );
+                stagingBuffer2.Destroy( _device );
+            }
+        }
+    }
+}
@@ -3,7 +3,6 @@
 #include "core/fanAssert.hpp"
 #include "render/resources/fanMesh.hpp"
 #include "render/fanRenderResourcePtr.hpp"
-#include "render/core/fanDevice.hpp"
 
 namespace fan
 {
@@ -82,37 +81,23 @@ namespace fan
 
     //========================================================================================================
     //========================================================================================================
-    void MeshManager::Clear( Device& _device )
+    void MeshManager::Clear()
     {
         for ( Mesh* mesh : mMeshes )
         {
-            mesh->Destroy( _device );
             delete mesh;
         }
         mMeshes.clear();
-        DestroyRemovedMeshes( _device );
+        DestroyRemovedMeshes();
     }
 
     //========================================================================================================
+    // meshes were never uploaded to a device ( headless ), only their cpu side is released
     //========================================================================================================
-    void MeshManager::CreateNewMeshes( Device& _device )
-    {
-        for( Mesh * mesh : mMeshes )
-        {
-            if( mesh->mBuffersOutdated )
-            {
-                mesh->Create( _device );
-            }
-        }
-    }
-
-    //========================================================================================================
-    //========================================================================================================
-    void MeshManager::DestroyRemovedMeshes( Device& _device )
+    void MeshManager::DestroyRemovedMeshes()
     {
         for( Mesh* mesh : mDestroyList )
         {
-            mesh->Destroy( _device );
             delete mesh;
         }
         mDestroyList.clear();
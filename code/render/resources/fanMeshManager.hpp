@@ -26,11 +26,13 @@ namespace fan
         void   Add( Mesh* _mesh, const std::string& _name );
         void   Remove( const std::string& _path );
         void   Clear( Device& _device);
+        void   Clear();	// meshes were never uploaded to a device ( headless )
         bool   Empty() const { return mMeshes.empty(); }
         void   ResolvePtr( ResourcePtr<Mesh>& _resourcePtr );
 
         void CreateNewMeshes( Device& _device );
         void DestroyRemovedMeshes( Device& _device );
+        void DestroyRemovedMeshes();
 
         int DestroyListSize() const  { return (int)mDestroyList.size(); }
         const std::vector< Mesh * >& GetMeshes() const { return mMeshes; }
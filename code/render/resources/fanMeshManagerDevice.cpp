@@ -0,0 +1,45 @@
+#include "render/resources/fanMeshManager.hpp"
+
+#include "render/resources/fanMesh.hpp"
+#include "render/core/fanDevice.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    void MeshManager::Clear( Device& _device )
+    {
+        for ( Mesh* mesh : mMeshes )
+        {
+            mesh->Destroy( _device );
+            delete mesh;
+        }
+        mMeshes.clear();
+        DestroyRemovedMeshes( _device );
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void MeshManager::CreateNewMeshes( Device& _device )
+    {
+        for( Mesh * mesh : mMeshes )
+        {
+            if( mesh->mBuffersOutdated )
+            {
+                mesh->Create( _device );
+            }
+        }
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void MeshManager::DestroyRemovedMeshes( Device& _device )
+    {
+        for( Mesh* mesh : mDestroyList )
+        {
+            mesh->Destroy( _device );
+            delete mesh;
+        }
+        mDestroyList.clear();
+    }
+}
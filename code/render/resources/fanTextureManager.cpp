@@ -1,6 +1,5 @@
 #include "render/resources/fanTextureManager.hpp"
 #include "render/fanRenderResourcePtr.hpp"
-#include "render/core/fanDevice.hpp"
 
 namespace fan
 {
@@ -84,19 +83,6 @@ namespace fan
         }
     }
 
-    //========================================================================================================
-    //========================================================================================================
-    void TextureManager::Clear( Device& _device )
-    {
-        for ( Texture* texture : mTextures )
-        {
-            texture->Destroy( _device );
-            delete texture;
-        }
-        mTextures.clear();
-        DestroyRemovedTextures( _device );
-    }
-
     //========================================================================================================
     //========================================================================================================
     void TextureManager::ResolvePtr( ResourcePtr<Texture >& _resourcePtr )
@@ -113,27 +99,23 @@ namespace fan
 
     //========================================================================================================
     //========================================================================================================
-    bool TextureManager::CreateNewTextures( Device& _device )
+    void TextureManager::Clear()
     {
-        bool textureCreated = false;
-        for( Texture * texture : mTextures )
+        for ( Texture* texture : mTextures )
         {
-            if( texture->mBuffersOutdated )
-            {
-                texture->Create( _device );
-                textureCreated = true;
-            }
+            delete texture;
         }
-        return textureCreated;
+        mTextures.clear();
+        DestroyRemovedTextures();
     }
 
     //========================================================================================================
+    // textures were never uploaded to a device ( headless ), only their cpu side is released
     //========================================================================================================
-    void TextureManager::DestroyRemovedTextures( Device& _device )
+    void TextureManager::DestroyRemovedTextures()
     {
         for( Texture* texture : mDestroyList )
         {
-            texture->Destroy( _device );
             delete texture;
         }
         mDestroyList.clear();
@@ -22,11 +22,13 @@ namespace fan
         void        Add( Texture* _texture, const std::string& _name );
         void        Remove( const std::string& _path );
 	    void        Clear( Device& _device );
+	    void        Clear();	// textures were never uploaded to a device ( headless )
         bool        Empty() const { return mTextures.empty(); }
         void	    ResolvePtr( ResourcePtr< Texture >& _resourcePtr );
 
         bool        CreateNewTextures( Device& _device );
         void        DestroyRemovedTextures( Device& _device );
+        void        DestroyRemovedTextures();
 
         int         DestroyListSize() const  { return (int)mDestroyList.size(); }
         const std::vector< Texture * >& GetTextures() const { return mTextures; }
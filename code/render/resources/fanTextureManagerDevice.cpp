@@ -0,0 +1,48 @@
+#include "render/resources/fanTextureManager.hpp"
+
+#include "render/resources/fanTexture.hpp"
+#include "render/core/fanDevice.hpp"
+
+namespace fan
+{
+    //========================================================================================================
+    //========================================================================================================
+    void TextureManager::Clear( Device& _device )
+    {
+        for ( Texture* texture : mTextures )
+        {
+            texture->Destroy( _device );
+            delete texture;
+        }
+        mTextures.clear();
+        DestroyRemovedTextures( _device );
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    bool TextureManager::CreateNewTextures( Device& _device )
+    {
+        bool textureCreated = false;
+        for( Texture * texture : mTextures )
+        {
+            if( texture->mBuffersOutdated )
+            {
+                texture->Create( _device );
+                textureCreated = true;
+            }
+        }
+        return textureCreated;
+    }
+
+    //========================================================================================================
+    //========================================================================================================
+    void TextureManager::DestroyRemovedTextures( Device& _device )
+    {
+        for( Texture* texture : mDestroyList )
+        {
+            texture->Destroy( _device );
+            delete texture;
+        }
+        mDestroyList.clear();
+    }
+}
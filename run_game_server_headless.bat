@@ -0,0 +1 @@
+START fengine_server.exe -scene "content/scenes/game00.scene" -tick_rate 60
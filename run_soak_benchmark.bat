@@ -0,0 +1 @@
+START fengine_soak.exe -scene "content/scenes/game00.scene" -tick_rate 60 -bots 16 -duration 60 -latency 50 -jitter 10 -loss 2